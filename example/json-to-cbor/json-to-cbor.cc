@@ -326,6 +326,11 @@ class Callbacks : public wuffs_aux::DecodeJsonCallbacks {
     return write_dst(val.data(), val.size());
   }
 
+  std::string AppendTextStringView(const char* ptr, size_t len) override {
+    TRY(Append(len, 0x60));
+    return write_dst(ptr, len);
+  }
+
   std::string Push(uint32_t flags) override {
     return write_dst(
         (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST) ? "\x9F" : "\xBF",
@@ -157,6 +157,8 @@ for a C++ compiler $CXX, such as clang++ or g++.
 
 static const char* g_eod = "main: end of data";
 
+static const char* g_no_match = "main: no match for query";
+
 static const char* g_usage =
     "Usage: jsonptr -flags input.json\n"
     "\n"
@@ -170,6 +172,7 @@ static const char* g_usage =
     "            -input-allow-comments\n"
     "            -input-allow-extra-comma\n"
     "            -input-allow-inf-nan-numbers\n"
+    "            -input-json-lines\n"
     "            -input-jwcc\n"
     "            -jwcc\n"
     "            -output-comments\n"
@@ -204,6 +207,15 @@ static const char* g_usage =
     "numbers (infinities and not-a-numbers) within JSON input. This flag\n"
     "requires that -output-inf-nan-numbers also be set.\n"
     "\n"
+    "The -input-json-lines flag treats the input as newline-delimited JSON\n"
+    "(also known as NDJSON or JSON Lines): a sequence of JSON values, one per\n"
+    "line. Each value is formatted (and queried) separately and the results\n"
+    "are written one after another, separated by new lines. Blank lines are\n"
+    "skipped, as are values that have no match for a -query=STR. An invalid\n"
+    "value, or one that spans multiple lines, is still an error, whose message\n"
+    "gives the value's line number. This flag cannot be combined with\n"
+    "-input-allow-comments.\n"
+    "\n"
     "The -output-comments flag copies any input comments to the output. It\n"
     "has no effect unless -input-allow-comments was also set. Comments look\n"
     "better after commas than before them, but a closing \"]\" or \"}\" can\n"
@@ -503,6 +515,24 @@ uint64_t g_num_input_blank_lines;
 
 bool g_is_after_comment;
 
+// g_skip_rest_of_json_line is whether, with -input-json-lines and a non-empty
+// query, the query has been resolved and so the rest of the line's tokens are
+// only decoded (to check that they are valid JSON), not processed.
+bool g_skip_rest_of_json_line;
+
+// g_json_line_number is the 1-based line number of the current
+// -input-json-lines value's first byte. It is zero before next_json_line
+// finds the first value.
+uint64_t g_json_line_number;
+
+// g_json_line_has_new_line is whether the current -input-json-lines value's
+// tokens so far include a '\n' byte. Only filler tokens can, and the '\n'
+// that ends a value is the value's last token, so any token after it means
+// that the value spans multiple lines.
+bool g_json_line_has_new_line;
+
+char g_json_line_error_array[2048];
+
 uint32_t g_suppress_write_dst;
 bool g_wrote_to_dst;
 
@@ -774,6 +804,7 @@ struct {
   bool input_allow_comments;
   bool input_allow_extra_comma;
   bool input_allow_inf_nan_numbers;
+  bool input_json_lines;
   bool output_comments;
   bool output_extra_comma;
   bool output_inf_nan_numbers;
@@ -854,6 +885,10 @@ parse_flags(int argc, char** argv) {
       g_flags.input_allow_inf_nan_numbers = true;
       continue;
     }
+    if (!strcmp(arg, "input-json-lines")) {
+      g_flags.input_json_lines = true;
+      continue;
+    }
     if (!strcmp(arg, "input-jwcc")) {
       g_flags.input_allow_comments = true;
       g_flags.input_allow_extra_comma = true;
@@ -916,6 +951,15 @@ parse_flags(int argc, char** argv) {
   return nullptr;
 }
 
+void  //
+reset_query() {
+  g_query.reset(g_flags.query_c_string);
+
+  // If the query is non-empty, suppress writing to stdout until we've
+  // completed the query.
+  g_suppress_write_dst = g_query.next_fragment() ? 1 : 0;
+}
+
 const char*  //
 initialize_globals(int argc, char** argv) {
   g_dst = wuffs_base__make_io_buffer(
@@ -940,6 +984,12 @@ initialize_globals(int argc, char** argv) {
 
   g_is_after_comment = false;
 
+  g_skip_rest_of_json_line = false;
+
+  g_json_line_number = 0;
+
+  g_json_line_has_new_line = false;
+
   TRY(parse_flags(argc, argv));
   if (g_flags.fail_if_unsandboxed && !g_sandboxed) {
     return "main: unsandboxed";
@@ -953,6 +1003,10 @@ initialize_globals(int argc, char** argv) {
     return "main: -input-allow-inf-nan-numbers requires "
            "-output-inf-nan-numbers";
   }
+  if (g_flags.input_json_lines && g_flags.input_allow_comments) {
+    return "main: -input-json-lines cannot be combined with "
+           "-input-allow-comments";
+  }
   const int stdin_fd = 0;
   if (g_flags.remaining_argc >
       ((g_input_file_descriptor != stdin_fd) ? 1 : 0)) {
@@ -964,11 +1018,7 @@ initialize_globals(int argc, char** argv) {
                                               : TWO_NEW_LINES_THEN_256_SPACES;
   g_bytes_per_indent_depth = g_flags.tabs ? 1 : g_flags.spaces;
 
-  g_query.reset(g_flags.query_c_string);
-
-  // If the query is non-empty, suppress writing to stdout until we've
-  // completed the query.
-  g_suppress_write_dst = g_query.next_fragment() ? 1 : 0;
+  reset_query();
   g_wrote_to_dst = false;
 
   TRY(g_dec.initialize(sizeof__wuffs_json__decoder(), WUFFS_VERSION, 0)
@@ -985,11 +1035,18 @@ initialize_globals(int argc, char** argv) {
     g_dec.set_quirk(WUFFS_JSON__QUIRK_ALLOW_INF_NAN_NUMBERS, 1);
   }
 
-  // Consume any optional trailing whitespace and comments. This isn't part of
-  // the JSON spec, but it works better with line oriented Unix tools (such as
-  // "echo 123 | jsonptr" where it's "echo", not "echo -n") or hand-edited JSON
-  // files which can accidentally contain trailing whitespace.
-  g_dec.set_quirk(WUFFS_JSON__QUIRK_ALLOW_TRAILING_FILLER, 1);
+  if (g_flags.input_json_lines) {
+    // Stop after each value's trailing '\n'. The next_json_line function
+    // then restarts decoding for the next line.
+    g_dec.set_quirk(WUFFS_JSON__QUIRK_EXPECT_TRAILING_NEW_LINE_OR_EOF, 1);
+  } else {
+    // Consume any optional trailing whitespace and comments. This isn't part
+    // of the JSON spec, but it works better with line oriented Unix tools
+    // (such as "echo 123 | jsonptr" where it's "echo", not "echo -n") or
+    // hand-edited JSON files which can accidentally contain trailing
+    // whitespace.
+    g_dec.set_quirk(WUFFS_JSON__QUIRK_ALLOW_TRAILING_FILLER, 1);
+  }
 
   return nullptr;
 }
@@ -1130,7 +1187,7 @@ handle_token(wuffs_base__token t, bool start_of_token_chain) {
     if ((vbc == WUFFS_BASE__TOKEN__VBC__STRUCTURE) &&
         (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__POP)) {
       if (g_query.is_at(g_depth)) {
-        return "main: no match for query";
+        return g_no_match;
       }
       if (g_depth <= 0) {
         return "main: internal error: inconsistent g_depth";
@@ -1219,11 +1276,16 @@ handle_token(wuffs_base__token t, bool start_of_token_chain) {
         g_suppress_write_dst = 0;
         g_ctx = context::none;
         g_depth = 0;
+        // With -input-json-lines, separate this result from any earlier
+        // line's result. Lines without a match write nothing at all.
+        if (g_flags.input_json_lines && g_wrote_to_dst) {
+          TRY(write_dst("\n", 1));
+        }
       } else if ((vbc != WUFFS_BASE__TOKEN__VBC__STRUCTURE) ||
                  !(vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__PUSH)) {
         // The query has moved on to the next fragment but the upcoming JSON
         // value is not a container.
-        return "main: no match for query";
+        return g_no_match;
       }
     }
 
@@ -1303,10 +1365,70 @@ after_value:
   return nullptr;
 }
 
+// json_line_error returns msg annotated with the current -input-json-lines
+// value's line number.
+const char*  //
+json_line_error(const char* msg) {
+  snprintf(g_json_line_error_array, sizeof(g_json_line_error_array),
+           "%s (on line %llu)", msg,
+           static_cast<unsigned long long>(g_json_line_number));
+  return g_json_line_error_array;
+}
+
+// next_json_line skips any blank lines before the first -input-json-lines
+// value or after a subsequent one. If there is another value, it resets the
+// per-value state so that main1 can decode it. Otherwise, it sets *eof.
+//
+// After the first value, the decoder has already consumed the previous
+// value's trailing '\n'.
+const char*  //
+next_json_line(bool* eof) {
+  g_json_line_number++;
+  while (true) {
+    for (; g_src.meta.ri < g_src.meta.wi; g_src.meta.ri++) {
+      uint8_t c = g_src.data.ptr[g_src.meta.ri];
+      if (c == '\n') {
+        g_json_line_number++;
+        continue;
+      } else if ((c == ' ') || (c == '\t') || (c == '\r')) {
+        continue;
+      }
+      g_cursor_index = g_src.meta.ri;
+      g_depth = 0;
+      g_ctx = context::none;
+      g_num_input_blank_lines = 0;
+      g_skip_rest_of_json_line = false;
+      g_json_line_has_new_line = false;
+      reset_query();
+      g_dec.reset_end_of_data();
+      // With an empty query, output starts straight away. Otherwise, it
+      // starts (and writes its separator) when the query resolves.
+      if ((g_suppress_write_dst == 0) && g_wrote_to_dst) {
+        TRY(write_dst("\n", 1));
+      }
+      *eof = false;
+      return nullptr;
+    }
+    if (g_src.meta.closed) {
+      *eof = true;
+      return nullptr;
+    }
+    TRY(read_src());
+  }
+}
+
 const char*  //
 main1(int argc, char** argv) {
   TRY(initialize_globals(argc, argv));
 
+  if (g_flags.input_json_lines) {
+    bool eof = false;
+    TRY(next_json_line(&eof));
+    if (eof) {
+      return nullptr;
+    }
+  }
+
   bool start_of_token_chain = true;
   while (true) {
     wuffs_base__status status = g_dec.decode_tokens(
@@ -1321,6 +1443,24 @@ main1(int argc, char** argv) {
       }
       g_cursor_index += token_length;
 
+      // Like wuffs_aux::DecodeJsonLines, and so that g_json_line_number stays
+      // accurate, -input-json-lines values have to fit on a single line.
+      if (g_flags.input_json_lines) {
+        if (g_json_line_has_new_line) {
+          return json_line_error(
+              "main: -input-json-lines value spans multiple lines");
+        } else if ((t.value_base_category() ==
+                    WUFFS_BASE__TOKEN__VBC__FILLER) &&
+                   memchr(g_src.data.ptr + g_cursor_index - token_length, '\n',
+                          token_length)) {
+          g_json_line_has_new_line = true;
+        }
+      }
+
+      if (g_skip_rest_of_json_line) {
+        continue;
+      }
+
       // Handle filler tokens (e.g. whitespace, punctuation and comments).
       // These are skipped, unless -output-comments is enabled.
       if (t.value_base_category() == WUFFS_BASE__TOKEN__VBC__FILLER) {
@@ -1382,12 +1522,20 @@ main1(int argc, char** argv) {
       start_of_token_chain = !t.continued();
       if (z == nullptr) {
         continue;
+      } else if ((z == g_no_match) && g_flags.input_json_lines) {
+        // A line without a match is skipped, not fatal, but the rest of its
+        // tokens are still decoded to find where the line's JSON value ends.
+        g_skip_rest_of_json_line = true;
       } else if (z != g_eod) {
         return z;
       } else if (g_flags.query_c_string && *g_flags.query_c_string) {
         // With a non-empty g_query, don't try to consume trailing filler or
-        // confirm that we've processed all the tokens.
-        return nullptr;
+        // confirm that we've processed all the tokens. With -input-json-lines,
+        // we still have to find where the line's JSON value ends.
+        if (!g_flags.input_json_lines) {
+          return nullptr;
+        }
+        g_skip_rest_of_json_line = true;
       }
       g_ctx = context::end_of_data;
     }
@@ -1396,6 +1544,15 @@ main1(int argc, char** argv) {
       if (g_ctx != context::end_of_data) {
         return "main: internal error: unexpected end of token stream";
       }
+      if (g_flags.input_json_lines) {
+        bool eof = false;
+        TRY(next_json_line(&eof));
+        if (!eof) {
+          start_of_token_chain = true;
+          continue;
+        }
+        return nullptr;
+      }
       // Check that we've exhausted the input.
       if ((g_src.meta.ri == g_src.meta.wi) && !g_src.meta.closed) {
         TRY(read_src());
@@ -1413,6 +1570,14 @@ main1(int argc, char** argv) {
       g_cursor_index = g_src.meta.ri;
     } else if (status.repr == wuffs_base__suspension__short_write) {
       g_tok.compact();
+    } else if (g_flags.input_json_lines) {
+      // The decoder has seen the end of the line (or of the input) before
+      // the end of the JSON value.
+      if (g_json_line_has_new_line) {
+        return json_line_error(
+            "main: -input-json-lines value spans multiple lines");
+      }
+      return json_line_error(status.message());
     } else {
       return status.message();
     }
@@ -1481,6 +1646,11 @@ main(int argc, char** argv) {
 
   const char* z = main1(argc, argv);
   if (g_wrote_to_dst) {
+    // With -input-json-lines, an earlier line's result can be followed by a
+    // line whose output is still suppressed (e.g. it had no match).
+    if (g_flags.input_json_lines) {
+      g_suppress_write_dst = 0;
+    }
     const char* z1 = g_is_after_comment ? nullptr : write_dst("\n", 1);
     const char* z2 = flush_dst();
     z = z ? z : (z1 ? z1 : z2);
@@ -83,10 +83,16 @@ const uint32_t pixfmts[] = {
     WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
     WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
     WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+    WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE,
     WUFFS_BASE__PIXEL_FORMAT__BGRX,
     WUFFS_BASE__PIXEL_FORMAT__RGB,
     WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
     WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+    WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE,
+    WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16,
+    WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR,
+    WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32,
+    WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR,
 };
 
 const wuffs_base__pixel_blend blends[] = {
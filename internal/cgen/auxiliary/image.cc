@@ -17,6 +17,7 @@
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__IMAGE)
 
 #include <utility>
+#include <vector>
 
 namespace wuffs_aux {
 
@@ -45,6 +46,12 @@ DecodeImageCallbacks::AllocPixbufResult::AllocPixbufResult(
       pixbuf(wuffs_base__null_pixel_buffer()),
       error_message(std::move(error_message0)) {}
 
+DecodeImageCallbacks::SelectResamplingResult::SelectResamplingResult(
+    uint32_t width0,
+    uint32_t height0,
+    wuffs_base__pixel_resampling_filter filter0)
+    : width(width0), height(height0), filter(filter0) {}
+
 DecodeImageCallbacks::AllocWorkbufResult::AllocWorkbufResult(
     MemOwner&& mem_owner0,
     wuffs_base__slice_u8 workbuf0)
@@ -121,6 +128,14 @@ DecodeImageCallbacks::SelectPixfmt(
   return wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL);
 }
 
+DecodeImageCallbacks::SelectResamplingResult  //
+DecodeImageCallbacks::SelectResampling(
+    const wuffs_base__image_config& image_config) {
+  return SelectResamplingResult(image_config.pixcfg.width(),
+                                image_config.pixcfg.height(),
+                                WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3);
+}
+
 DecodeImageCallbacks::AllocPixbufResult  //
 DecodeImageCallbacks::AllocPixbuf(const wuffs_base__image_config& image_config,
                                   bool allow_uninitialized_memory) {
@@ -249,6 +264,14 @@ DecodeImageArgMaxInclMetadataLength::DefaultValue() {
   return DecodeImageArgMaxInclMetadataLength(16777215);
 }
 
+DecodeImageArgColorTransform::DecodeImageArgColorTransform(bool repr0)
+    : repr(repr0) {}
+
+DecodeImageArgColorTransform  //
+DecodeImageArgColorTransform::DefaultValue() {
+  return DecodeImageArgColorTransform(false);
+}
+
 // --------
 
 namespace {
@@ -278,23 +301,104 @@ DIHM0(void* self,
       static_cast<wuffs_base__image_decoder*>(self), a_dst, a_minfo, a_src);
 }
 
+// DecodeImageMetadata sits between the image decoder's metadata and the
+// callbacks. When color_transform is true, it records the color metadata
+// (which DecodeImage0 asks for regardless of flags) and only forwards it to
+// callbacks.HandleMetadata if the caller opted in to it via flags.
+struct DecodeImageMetadata {
+  DecodeImageMetadata(DecodeImageCallbacks& callbacks0,
+                      uint64_t flags0,
+                      bool color_transform0)
+      : callbacks(callbacks0),
+        flags(flags0),
+        color_transform(color_transform0),
+        have_chrm(false),
+        have_gama(false),
+        have_srgb(false),
+        chrm{0},
+        gama(0) {}
+
+  DecodeImageCallbacks& callbacks;
+  uint64_t flags;
+  bool color_transform;
+
+  bool have_chrm;
+  bool have_gama;
+  bool have_srgb;
+  int32_t chrm[8];
+  uint32_t gama;
+  std::vector<uint8_t> iccp;
+};
+
 std::string  //
 DIHM1(void* self,
       const wuffs_base__more_information* minfo,
       wuffs_base__slice_u8 raw) {
-  return static_cast<DecodeImageCallbacks*>(self)->HandleMetadata(*minfo, raw);
+  DecodeImageMetadata* m = static_cast<DecodeImageMetadata*>(self);
+  if (m->color_transform) {
+    uint64_t flag = 0;
+    switch (minfo->metadata__fourcc()) {
+      case WUFFS_BASE__FOURCC__CHRM:
+        flag = DecodeImageArgFlags::REPORT_METADATA_CHRM;
+        m->have_chrm = true;
+        for (uint32_t i = 0; i < 8; i++) {
+          m->chrm[i] = minfo->metadata_parsed__chrm(i);
+        }
+        break;
+      case WUFFS_BASE__FOURCC__GAMA:
+        flag = DecodeImageArgFlags::REPORT_METADATA_GAMA;
+        m->have_gama = true;
+        m->gama = minfo->metadata_parsed__gama();
+        break;
+      case WUFFS_BASE__FOURCC__ICCP:
+        flag = DecodeImageArgFlags::REPORT_METADATA_ICCP;
+        m->iccp.assign(raw.ptr, raw.ptr + raw.len);
+        break;
+      case WUFFS_BASE__FOURCC__SRGB:
+        flag = DecodeImageArgFlags::REPORT_METADATA_SRGB;
+        m->have_srgb = true;
+        break;
+    }
+    if ((flag != 0) && ((m->flags & flag) == 0)) {
+      return "";
+    }
+  }
+  return m->callbacks.HandleMetadata(*minfo, raw);
 }
 
 std::string  //
 DecodeImageHandleMetadata(wuffs_base__image_decoder::unique_ptr& image_decoder,
-                          DecodeImageCallbacks& callbacks,
+                          DecodeImageMetadata& metadata,
                           sync_io::Input& input,
                           wuffs_base__io_buffer& io_buf,
                           sync_io::DynIOBuffer& raw_metadata_buf) {
   return private_impl::HandleMetadata(DecodeImageErrorMessages, input, io_buf,
                                       raw_metadata_buf, DIHM0,
                                       static_cast<void*>(image_decoder.get()),
-                                      DIHM1, static_cast<void*>(&callbacks));
+                                      DIHM1, static_cast<void*>(&metadata));
+}
+
+// DecodeImageSetColorTransform sets t from the recorded color metadata,
+// returning whether t is a non-identity transform.
+bool  //
+DecodeImageSetColorTransform(wuffs_base__color_transform& t,
+                             const DecodeImageMetadata& metadata) {
+  if (!metadata.iccp.empty()) {
+    wuffs_base__status status = t.set_from_icc_profile(
+        wuffs_base__make_slice_u8(const_cast<uint8_t*>(metadata.iccp.data()),
+                                  metadata.iccp.size()));
+    if (status.is_ok()) {
+      return !t.is_identity();
+    }
+    // Fall back to any gAMA and cHRM metadata, as the PNG spec allows.
+  }
+  if (metadata.have_srgb || (!metadata.have_gama && !metadata.have_chrm)) {
+    return false;
+  }
+  wuffs_base__status status = t.set_from_gama_chrm(
+      metadata.have_gama ? metadata.gama : 0,
+      metadata.have_chrm ? metadata.chrm : nullptr);
+  return status.is_ok() && !t.is_identity();
 }
 
 DecodeImageResult  //
@@ -307,7 +411,8 @@ DecodeImage0(wuffs_base__image_decoder::unique_ptr& image_decoder,
              wuffs_base__pixel_blend pixel_blend,
              wuffs_base__color_u32_argb_premul background_color,
              uint32_t max_incl_dimension,
-             uint64_t max_incl_metadata_length) {
+             uint64_t max_incl_metadata_length,
+             bool color_transform) {
   // Check args.
   switch (pixel_blend) {
     case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -319,6 +424,7 @@ DecodeImage0(wuffs_base__image_decoder::unique_ptr& image_decoder,
 
   wuffs_base__image_config image_config = wuffs_base__null_image_config();
   sync_io::DynIOBuffer raw_metadata_buf(max_incl_metadata_length);
+  DecodeImageMetadata metadata(callbacks, flags, color_transform);
   uint64_t start_pos = io_buf.reader_position();
   bool interested_in_metadata_after_the_frame = false;
   bool redirected = false;
@@ -389,7 +495,13 @@ redirect:
       image_decoder->set_quirk(quirks.ptr[i], 1);
     }
 
-    // Apply flags.
+    // Apply flags. The color transform needs its metadata regardless.
+    if (color_transform) {
+      image_decoder->set_report_metadata(WUFFS_BASE__FOURCC__CHRM, true);
+      image_decoder->set_report_metadata(WUFFS_BASE__FOURCC__GAMA, true);
+      image_decoder->set_report_metadata(WUFFS_BASE__FOURCC__ICCP, true);
+      image_decoder->set_report_metadata(WUFFS_BASE__FOURCC__SRGB, true);
+    }
     if (flags != 0) {
       if (flags & DecodeImageArgFlags::REPORT_METADATA_CHRM) {
         image_decoder->set_report_metadata(WUFFS_BASE__FOURCC__CHRM, true);
@@ -431,7 +543,7 @@ redirect:
         goto redirect;
       } else if (id_dic_status.repr == wuffs_base__note__metadata_reported) {
         std::string error_message = DecodeImageHandleMetadata(
-            image_decoder, callbacks, input, io_buf, raw_metadata_buf);
+            image_decoder, metadata, input, io_buf, raw_metadata_buf);
         if (!error_message.empty()) {
           return DecodeImageResult(std::move(error_message));
         }
@@ -465,9 +577,15 @@ redirect:
       case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
       case WUFFS_BASE__PIXEL_FORMAT__RGB:
       case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR:
         break;
       default:
         return DecodeImageResult(DecodeImage_UnsupportedPixelFormat);
@@ -476,18 +594,78 @@ redirect:
                             WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, w, h);
   }
 
+  // Select the pixel buffer's dimensions. If they differ from the image's, we
+  // decode into an image-sized scratch buffer and then resample. Decoders do
+  // not report rows as they complete, so the two steps cannot overlap.
+  DecodeImageCallbacks::SelectResamplingResult select_resampling_result =
+      callbacks.SelectResampling(image_config);
+  uint32_t dst_w = select_resampling_result.width;
+  uint32_t dst_h = select_resampling_result.height;
+  bool resampling = (dst_w != w) || (dst_h != h);
+  wuffs_base__image_config dst_image_config = image_config;
+  if (resampling) {
+    if ((dst_w == 0) || (dst_h == 0)) {
+      return DecodeImageResult(DecodeImage_UnsupportedPixelConfiguration);
+    } else if ((dst_w > max_incl_dimension) || (dst_h > max_incl_dimension)) {
+      return DecodeImageResult(DecodeImage_MaxInclDimensionExceeded);
+    }
+    switch (pixel_format.repr) {
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+        break;
+      default:
+        return DecodeImageResult(DecodeImage_UnsupportedPixelFormat);
+    }
+    dst_image_config.pixcfg.set(pixel_format.repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, dst_w,
+                                dst_h);
+  }
+
   // Allocate the pixel buffer.
   bool valid_background_color =
       wuffs_base__color_u32_argb_premul__is_valid(background_color);
   DecodeImageCallbacks::AllocPixbufResult alloc_pixbuf_result =
-      callbacks.AllocPixbuf(image_config, valid_background_color);
+      callbacks.AllocPixbuf(dst_image_config,
+                            valid_background_color || resampling);
   if (!alloc_pixbuf_result.error_message.empty()) {
     return DecodeImageResult(std::move(alloc_pixbuf_result.error_message));
   }
   wuffs_base__pixel_buffer pixel_buffer = alloc_pixbuf_result.pixbuf;
+
+  // Allocate the scratch buffer (and the resampler's own work buffer), if
+  // resampling. Its initial contents are transparent black.
+  wuffs_base__pixel_buffer scratch_pixel_buffer = pixel_buffer;
+  MemOwner scratch_mem_owner(nullptr, &free);
+  wuffs_base__slice_u8 resampler_workbuf = wuffs_base__empty_slice_u8();
+  if (resampling) {
+    uint64_t scratch_len = image_config.pixcfg.pixbuf_len();
+    uint64_t resampler_workbuf_len = wuffs_base__pixel_resampler__workbuf_len(
+        dst_w, dst_h, w, h, select_resampling_result.filter);
+    if ((scratch_len == 0) || (resampler_workbuf_len == 0)) {
+      return DecodeImageResult(DecodeImage_UnsupportedPixelConfiguration);
+    } else if ((SIZE_MAX < resampler_workbuf_len) ||
+               ((SIZE_MAX - resampler_workbuf_len) < scratch_len)) {
+      return DecodeImageResult(DecodeImage_OutOfMemory);
+    }
+    void* ptr = calloc((size_t)(scratch_len + resampler_workbuf_len), 1);
+    if (!ptr) {
+      return DecodeImageResult(DecodeImage_OutOfMemory);
+    }
+    scratch_mem_owner.reset(ptr);
+    wuffs_base__status sfs_status = scratch_pixel_buffer.set_from_slice(
+        &image_config.pixcfg,
+        wuffs_base__make_slice_u8((uint8_t*)ptr, (size_t)scratch_len));
+    if (!sfs_status.is_ok()) {
+      return DecodeImageResult(sfs_status.message());
+    }
+    resampler_workbuf = wuffs_base__make_slice_u8(
+        ((uint8_t*)ptr) + scratch_len, (size_t)resampler_workbuf_len);
+  }
+
   if (valid_background_color) {
-    wuffs_base__status pb_scufr_status = pixel_buffer.set_color_u32_fill_rect(
-        pixel_buffer.pixcfg.bounds(), background_color);
+    wuffs_base__status pb_scufr_status =
+        scratch_pixel_buffer.set_color_u32_fill_rect(
+            scratch_pixel_buffer.pixcfg.bounds(), background_color);
     if (pb_scufr_status.repr != nullptr) {
       return DecodeImageResult(pb_scufr_status.message());
     }
@@ -513,7 +691,7 @@ redirect:
       break;
     } else if (id_dfc_status.repr == wuffs_base__note__metadata_reported) {
       std::string error_message = DecodeImageHandleMetadata(
-          image_decoder, callbacks, input, io_buf, raw_metadata_buf);
+          image_decoder, metadata, input, io_buf, raw_metadata_buf);
       if (!error_message.empty()) {
         return DecodeImageResult(std::move(error_message));
       }
@@ -538,10 +716,38 @@ redirect:
       frame_config.overwrite_instead_of_blend()) {
     pixel_blend = WUFFS_BASE__PIXEL_BLEND__SRC;
   }
+
+  // Build the color transform. It is about 18 KiB, so it lives on the heap.
+  std::unique_ptr<wuffs_base__color_transform> transform(nullptr);
+  bool transform_after_decoding = false;
+  wuffs_base__decode_frame_options decode_frame_options =
+      wuffs_base__null_decode_frame_options();
+  if (color_transform && (pixel_blend == WUFFS_BASE__PIXEL_BLEND__SRC)) {
+    switch (pixel_format.repr) {
+      case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+        transform.reset(new wuffs_base__color_transform);
+        if (!DecodeImageSetColorTransform(*transform, metadata)) {
+          transform.reset();
+        } else if ((fourcc == WUFFS_BASE__FOURCC__JPEG) ||
+                   (fourcc == WUFFS_BASE__FOURCC__PNG)) {
+          decode_frame_options.set_color_transform(transform.get());
+        } else {
+          transform_after_decoding = true;
+        }
+        break;
+    }
+  }
+
   while (true) {
     wuffs_base__status id_df_status =
-        image_decoder->decode_frame(&pixel_buffer, &io_buf, pixel_blend,
-                                    alloc_workbuf_result.workbuf, nullptr);
+        image_decoder->decode_frame(&scratch_pixel_buffer, &io_buf,
+                                    pixel_blend, alloc_workbuf_result.workbuf,
+                                    &decode_frame_options);
     if (id_df_status.repr == nullptr) {
       break;
     } else if (id_df_status.repr != wuffs_base__suspension__short_read) {
@@ -559,6 +765,29 @@ redirect:
     }
   }
 
+  // Apply the color transform (for decoders that do not apply it themselves)
+  // and resample, even after a (partial success) decoding error.
+  if (transform_after_decoding) {
+    wuffs_base__status t_status =
+        transform->transform_pixel_buffer(&scratch_pixel_buffer);
+    if ((t_status.repr != nullptr) && message.empty()) {
+      message = t_status.message();
+    }
+  }
+  if (resampling) {
+    wuffs_base__pixel_resampler resampler;
+    wuffs_base__status r_status = resampler.prepare(
+        pixel_format, dst_w, dst_h, w, h, select_resampling_result.filter,
+        resampler_workbuf);
+    if (r_status.repr == nullptr) {
+      r_status = resampler.resample(&pixel_buffer, &scratch_pixel_buffer);
+    }
+    if ((r_status.repr != nullptr) && message.empty()) {
+      message = r_status.message();
+    }
+    scratch_mem_owner.reset();
+  }
+
   // Decode any metadata after the frame.
   if (interested_in_metadata_after_the_frame) {
     while (true) {
@@ -570,7 +799,7 @@ redirect:
         continue;
       } else if (id_dfc_status.repr == wuffs_base__note__metadata_reported) {
         std::string error_message = DecodeImageHandleMetadata(
-            image_decoder, callbacks, input, io_buf, raw_metadata_buf);
+            image_decoder, metadata, input, io_buf, raw_metadata_buf);
         if (!error_message.empty()) {
           return DecodeImageResult(std::move(error_message));
         }
@@ -601,7 +830,8 @@ DecodeImage(DecodeImageCallbacks& callbacks,
             DecodeImageArgPixelBlend pixel_blend,
             DecodeImageArgBackgroundColor background_color,
             DecodeImageArgMaxInclDimension max_incl_dimension,
-            DecodeImageArgMaxInclMetadataLength max_incl_metadata_length) {
+            DecodeImageArgMaxInclMetadataLength max_incl_metadata_length,
+            DecodeImageArgColorTransform color_transform) {
   wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
   wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
   std::unique_ptr<uint8_t[]> fallback_io_array(nullptr);
@@ -616,7 +846,8 @@ DecodeImage(DecodeImageCallbacks& callbacks,
   DecodeImageResult result =
       DecodeImage0(image_decoder, callbacks, input, *io_buf, quirks.repr,
                    flags.repr, pixel_blend.repr, background_color.repr,
-                   max_incl_dimension.repr, max_incl_metadata_length.repr);
+                   max_incl_dimension.repr, max_incl_metadata_length.repr,
+                   color_transform.repr);
   callbacks.Done(result, input, *io_buf, std::move(image_decoder));
   return result;
 }
@@ -32,9 +32,10 @@ struct DecodeImageResult {
 //  1. SelectDecoder
 //  2. HandleMetadata
 //  3. SelectPixfmt
-//  4. AllocPixbuf
-//  5. AllocWorkbuf
-//  6. Done
+//  4. SelectResampling
+//  5. AllocPixbuf
+//  6. AllocWorkbuf
+//  7. Done
 //
 // It may return early - the third callback might not be invoked if the second
 // one fails - but the final callback (Done) is always invoked.
@@ -52,6 +53,18 @@ class DecodeImageCallbacks {
     std::string error_message;
   };
 
+  // SelectResamplingResult holds the pixel buffer's dimensions and the filter
+  // used to scale the decoded image to those dimensions.
+  struct SelectResamplingResult {
+    SelectResamplingResult(uint32_t width0,
+                           uint32_t height0,
+                           wuffs_base__pixel_resampling_filter filter0);
+
+    uint32_t width;
+    uint32_t height;
+    wuffs_base__pixel_resampling_filter filter;
+  };
+
   // AllocWorkbufResult holds a memory allocation (the result of malloc or new,
   // a statically allocated pointer, etc), or an error message. The memory is
   // de-allocated when mem_owner goes out of scope and is destroyed.
@@ -123,9 +136,15 @@ class DecodeImageCallbacks {
   //  - WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL
   //  - WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE
   //  - WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL
+  //  - WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE
   //  - WUFFS_BASE__PIXEL_FORMAT__RGB
   //  - WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL
   //  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL
+  //  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE
+  //  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16
+  //  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR
+  //  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32
+  //  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR
   // or return image_config.pixcfg.pixel_format(). The latter means to use the
   // image file's natural pixel format. For example, GIF images' natural pixel
   // format is an indexed one.
@@ -138,6 +157,34 @@ class DecodeImageCallbacks {
   virtual wuffs_base__pixel_format  //
   SelectPixfmt(const wuffs_base__image_config& image_config);
 
+  // SelectResampling returns the pixel buffer's dimensions, which can differ
+  // from the image's, and the filter (one of the
+  // WUFFS_BASE__PIXEL_RESAMPLING_FILTER__ETC constants) used to scale it.
+  //
+  // When the dimensions differ, the image is decoded into an image-sized
+  // scratch buffer (owned by DecodeImage) and then resampled, row by row,
+  // into the pixel buffer. This is not a streaming decode-and-resize: Wuffs'
+  // decoders do not report rows as they complete, so the whole frame is
+  // decoded before any resampling happens and peak memory use includes both
+  // the full-sized scratch buffer (4 bytes per source pixel, allocated by
+  // DecodeImage, not AllocPixbuf) and the pixel buffer. The
+  // max_incl_dimension limit applies to both. Resampling requires that
+  // SelectPixfmt returned
+  // either WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL or
+  // WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL (otherwise DecodeImage fails with
+  // DecodeImage_UnsupportedPixelFormat). The background_color and pixel_blend
+  // then apply to that scratch buffer, whose initial contents are transparent
+  // black, instead of to the pixel buffer.
+  //
+  // Returning a zero width or height, or one greater than max_incl_dimension,
+  // means failure (DecodeImage_UnsupportedPixelConfiguration or
+  // DecodeImage_MaxInclDimensionExceeded).
+  //
+  // The default SelectResampling implementation returns the image's own
+  // dimensions, which means no resampling.
+  virtual SelectResamplingResult  //
+  SelectResampling(const wuffs_base__image_config& image_config);
+
   // AllocPixbuf allocates the pixel buffer.
   //
   // allow_uninitialized_memory will be true if a valid background_color was
@@ -293,6 +340,16 @@ struct DecodeImageArgMaxInclMetadataLength {
   uint64_t repr;
 };
 
+// DecodeImageArgColorTransform wraps an optional argument to DecodeImage.
+struct DecodeImageArgColorTransform {
+  explicit DecodeImageArgColorTransform(bool repr0);
+
+  // DefaultValue returns false.
+  static DecodeImageArgColorTransform DefaultValue();
+
+  bool repr;
+};
+
 // DecodeImage decodes the image data in input. A variety of image file formats
 // can be decoded, depending on what callbacks.SelectDecoder returns.
 //
@@ -337,6 +394,25 @@ struct DecodeImageArgMaxInclMetadataLength {
 // Decoding fails (with DecodeImage_MaxInclDimensionExceeded) if the image's
 // width or height is greater than max_incl_dimension or if any opted-in (via
 // flags bits) metadata is longer than max_incl_metadata_length.
+//
+// If color_transform is true then the decoded pixels are converted to sRGB,
+// based on the image's color metadata (a wuffs_base__color_transform). An
+// ICC profile (iCCP) takes precedence, then an sRGB chunk (which means no
+// conversion) and then gAMA and cHRM. DecodeImage asks the image decoder for
+// that metadata itself, whether or not the corresponding flags bits are set,
+// but only passes it on to callbacks.HandleMetadata if they are. Metadata
+// that Wuffs cannot build a color transform from (such as a CMYK ICC profile)
+// is ignored. The std/jpeg and std/png decoders apply the color transform
+// while decoding. For other decoders, DecodeImage applies it afterwards, as a
+// separate pass. Either way, it only applies when pixel_blend is
+// WUFFS_BASE__PIXEL_BLEND__SRC and callbacks.SelectPixfmt returned one of:
+//  - WUFFS_BASE__PIXEL_FORMAT__BGR
+//  - WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL
+//  - WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL
+//  - WUFFS_BASE__PIXEL_FORMAT__RGB
+//  - WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL
+//  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL
+// Otherwise, the pixels are left in the image's own color space.
 DecodeImageResult  //
 DecodeImage(DecodeImageCallbacks& callbacks,
             sync_io::Input& input,
@@ -349,6 +425,8 @@ DecodeImage(DecodeImageCallbacks& callbacks,
             DecodeImageArgMaxInclDimension max_incl_dimension =
                 DecodeImageArgMaxInclDimension::DefaultValue(),
             DecodeImageArgMaxInclMetadataLength max_incl_metadata_length =
-                DecodeImageArgMaxInclMetadataLength::DefaultValue());
+                DecodeImageArgMaxInclMetadataLength::DefaultValue(),
+            DecodeImageArgColorTransform color_transform =
+                DecodeImageArgColorTransform::DefaultValue());
 
 }  // namespace wuffs_aux
@@ -16,7 +16,15 @@
 
 #if !defined(WUFFS_CONFIG__MODULES) || defined(WUFFS_CONFIG__MODULE__AUX__JSON)
 
+#include <map>
 #include <utility>
+#include <vector>
+
+#if defined(WUFFS_CONFIG__ENABLE_THREADS)
+#include <atomic>
+#include <mutex>
+#include <thread>
+#endif
 
 namespace wuffs_aux {
 
@@ -32,10 +40,23 @@ DecodeJsonCallbacks::Done(DecodeJsonResult& result,
                           sync_io::Input& input,
                           IOBuffer& buffer) {}
 
+std::string  //
+DecodeJsonCallbacks::AppendTextStringView(const char* ptr, size_t len) {
+  return AppendTextString(std::string(ptr, len));
+}
+
+DecodeJsonMultiQueryCallbacks::~DecodeJsonMultiQueryCallbacks() {}
+
 const char DecodeJson_BadJsonPointer[] =  //
     "wuffs_aux::DecodeJson: bad JSON Pointer";
 const char DecodeJson_NoMatch[] =  //
     "wuffs_aux::DecodeJson: no match";
+const char DecodeJsonLines_BadQuirks[] =  //
+    "wuffs_aux::DecodeJsonLines: bad quirks";
+const char DecodeJsonLines_BadRecord[] =  //
+    "wuffs_aux::DecodeJsonLines: bad record";
+const char DecodeJsonLines_MultiLineRecord[] =  //
+    "wuffs_aux::DecodeJsonLines: multi-line record";
 
 DecodeJsonArgQuirks::DecodeJsonArgQuirks(wuffs_base__slice_u32 repr0)
     : repr(repr0) {}
@@ -56,6 +77,10 @@ DecodeJsonArgJsonPointer::DefaultValue() {
   return DecodeJsonArgJsonPointer(std::string());
 }
 
+DecodeJsonArgJsonPointers::DecodeJsonArgJsonPointers(
+    std::vector<std::string> repr0)
+    : repr(std::move(repr0)) {}
+
 // --------
 
 #define WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN                          \
@@ -354,15 +379,68 @@ done:
   return ret_error_message;
 }
 
-}  // namespace
+// --------
+
+// DecodeJson_AppendNumber calls callbacks.AppendI64 or callbacks.AppendF64
+// for a WUFFS_BASE__TOKEN__VBC__NUMBER token.
+std::string  //
+DecodeJson_AppendNumber(DecodeJsonCallbacks& callbacks,
+                        uint64_t vbd,
+                        uint8_t* token_ptr,
+                        size_t token_len) {
+  if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__FORMAT_TEXT) {
+    if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_INTEGER_SIGNED) {
+      wuffs_base__result_i64 r = wuffs_base__parse_number_i64(
+          wuffs_base__make_slice_u8(token_ptr, token_len),
+          WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
+      if (r.status.is_ok()) {
+        return callbacks.AppendI64(r.value);
+      }
+    }
+    if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_FLOATING_POINT) {
+      wuffs_base__result_f64 r = wuffs_base__parse_number_f64(
+          wuffs_base__make_slice_u8(token_ptr, token_len),
+          WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
+      if (r.status.is_ok()) {
+        return callbacks.AppendF64(r.value);
+      }
+    }
+  } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_NEG_INF) {
+    return callbacks.AppendF64(
+        wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
+            0xFFF0000000000000ul));
+  } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_POS_INF) {
+    return callbacks.AppendF64(
+        wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
+            0x7FF0000000000000ul));
+  } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_NEG_NAN) {
+    return callbacks.AppendF64(
+        wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
+            0xFFFFFFFFFFFFFFFFul));
+  } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_POS_NAN) {
+    return callbacks.AppendF64(
+        wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
+            0x7FFFFFFFFFFFFFFFul));
+  }
+  return "wuffs_aux::DecodeJson: internal error: unexpected token";
+}
 
 // --------
 
+// DecodeJson_Impl is DecodeJson with two more arguments. If dec is empty, it
+// is allocated. Otherwise, it is re-used, so that DecodeJsonLines can decode
+// multiple records with one decoder.
+//
+// If drain is true then, after a json_pointer match (or DecodeJson_NoMatch),
+// the rest of the input is still decoded (but not passed to callbacks) until
+// the low-level decoder returns ok, so that dec can be re-used afterwards.
 DecodeJsonResult  //
-DecodeJson(DecodeJsonCallbacks& callbacks,
-           sync_io::Input& input,
-           DecodeJsonArgQuirks quirks,
-           DecodeJsonArgJsonPointer json_pointer) {
+DecodeJson_Impl(DecodeJsonCallbacks& callbacks,
+                sync_io::Input& input,
+                DecodeJsonArgQuirks& quirks,
+                DecodeJsonArgJsonPointer& json_pointer,
+                wuffs_json__decoder::unique_ptr& dec,
+                bool drain) {
   // Prepare the wuffs_base__io_buffer and the resultant error_message.
   wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
   wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
@@ -380,7 +458,9 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
 
   do {
     // Prepare the low-level JSON decoder.
-    wuffs_json__decoder::unique_ptr dec = wuffs_json__decoder::alloc();
+    if (!dec) {
+      dec = wuffs_json__decoder::alloc();
+    }
     if (!dec) {
       ret_error_message = "wuffs_aux::DecodeJson: out of memory";
       goto done;
@@ -426,7 +506,9 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
       ret_error_message = DecodeJson_WalkJsonPointerFragment(
           tok_buf, tok_status, dec, io_buf, io_error_message, cursor_index,
           input, split.first);
-      if (!ret_error_message.empty()) {
+      if (drain && (ret_error_message == DecodeJson_NoMatch)) {
+        goto drain_the_rest;
+      } else if (!ret_error_message.empty()) {
         goto done;
       }
     }
@@ -474,6 +556,29 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
                      WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY) {
             const char* ptr =  // Convert from (uint8_t*).
                 static_cast<const char*>(static_cast<void*>(token_ptr));
+            // If this is the entire string's content (nothing came before
+            // and the next token, already in tok_buf, is the closing '"')
+            // then pass a view of io_buf's bytes instead of copying them to
+            // str. The view is still valid, as decode_tokens (and therefore
+            // io_buf->compact) is not called again before the callback.
+            if (str.empty() && token.continued() &&
+                (tok_buf.meta.ri < tok_buf.meta.wi)) {
+              wuffs_base__token next = tok_buf.data.ptr[tok_buf.meta.ri];
+              uint64_t next_len = next.length();
+              if (!next.continued() &&
+                  (next.value_base_category() ==
+                   WUFFS_BASE__TOKEN__VBC__STRING) &&
+                  (next.value_base_detail() &
+                   WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_0_DST_1_SRC_DROP) &&
+                  (io_buf->meta.ri >= cursor_index) &&
+                  ((io_buf->meta.ri - cursor_index) >= next_len)) {
+                tok_buf.meta.ri++;
+                cursor_index += static_cast<size_t>(next_len);
+                ret_error_message = callbacks.AppendTextStringView(
+                    ptr, static_cast<size_t>(token_len));
+                goto parsed_a_value;
+              }
+            }
             str.append(ptr, static_cast<size_t>(token_len));
           } else {
             goto fail;
@@ -511,49 +616,9 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
         }
 
         case WUFFS_BASE__TOKEN__VBC__NUMBER: {
-          if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__FORMAT_TEXT) {
-            if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_INTEGER_SIGNED) {
-              wuffs_base__result_i64 r = wuffs_base__parse_number_i64(
-                  wuffs_base__make_slice_u8(token_ptr,
-                                            static_cast<size_t>(token_len)),
-                  WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
-              if (r.status.is_ok()) {
-                ret_error_message = callbacks.AppendI64(r.value);
-                goto parsed_a_value;
-              }
-            }
-            if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_FLOATING_POINT) {
-              wuffs_base__result_f64 r = wuffs_base__parse_number_f64(
-                  wuffs_base__make_slice_u8(token_ptr,
-                                            static_cast<size_t>(token_len)),
-                  WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
-              if (r.status.is_ok()) {
-                ret_error_message = callbacks.AppendF64(r.value);
-                goto parsed_a_value;
-              }
-            }
-          } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_NEG_INF) {
-            ret_error_message = callbacks.AppendF64(
-                wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
-                    0xFFF0000000000000ul));
-            goto parsed_a_value;
-          } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_POS_INF) {
-            ret_error_message = callbacks.AppendF64(
-                wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
-                    0x7FF0000000000000ul));
-            goto parsed_a_value;
-          } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_NEG_NAN) {
-            ret_error_message = callbacks.AppendF64(
-                wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
-                    0xFFFFFFFFFFFFFFFFul));
-            goto parsed_a_value;
-          } else if (vbd & WUFFS_BASE__TOKEN__VBD__NUMBER__CONTENT_POS_NAN) {
-            ret_error_message = callbacks.AppendF64(
-                wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
-                    0x7FFFFFFFFFFFFFFFul));
-            goto parsed_a_value;
-          }
-          goto fail;
+          ret_error_message = DecodeJson_AppendNumber(
+              callbacks, vbd, token_ptr, static_cast<size_t>(token_len));
+          goto parsed_a_value;
         }
       }
 
@@ -577,11 +642,20 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
       // further (unexpected) data"). We aren't done yet. Instead, keep the
       // loop running until WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN's
       // decode_tokens returns an ok status.
-      if (!ret_error_message.empty() ||
-          ((depth == 0) && !json_pointer.repr.empty())) {
+      if (!ret_error_message.empty()) {
+        goto done;
+      } else if ((depth == 0) && !json_pointer.repr.empty()) {
+        if (drain) {
+          goto drain_the_rest;
+        }
         goto done;
       }
     }
+
+  drain_the_rest:
+    while (true) {
+      WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN;
+    }
   } while (false);
 
 done:
@@ -592,8 +666,727 @@ done:
   return result;
 }
 
+// --------
+
+// DecodeJsonMultiQuery_Node is a node in the trie of JSON Pointer queries.
+// The root node (the empty JSON Pointer) is at index 0 of a std::vector of
+// nodes and children are referred to by their index in that std::vector.
+//
+// A fragment like "12" can be either a dict key or a list index, so its child
+// node index can be in both dict_children and list_children.
+struct DecodeJsonMultiQuery_Node {
+  std::map<std::string, size_t> dict_children;
+  std::map<uint64_t, size_t> list_children;
+  std::vector<size_t> query_indexes;
+  bool visited = false;
+};
+
+// DecodeJsonMultiQuery_Frame is the state for a dict or list that is being
+// decoded. Its node is SIZE_MAX if no query can match anything inside it.
+struct DecodeJsonMultiQuery_Frame {
+  size_t node;
+  bool is_list;
+  bool expecting_key;
+  uint64_t list_index;
+  size_t value_node;
+};
+
+// DecodeJsonMultiQuery_BuildTrie returns the empty string on success. On
+// failure, it returns DecodeJson_BadJsonPointer.
+std::string  //
+DecodeJsonMultiQuery_BuildTrie(std::vector<DecodeJsonMultiQuery_Node>& nodes,
+                               std::vector<std::string>& json_pointers,
+                               bool allow_tilde_n_tilde_r_tilde_t) {
+  nodes.clear();
+  nodes.emplace_back();
+  for (size_t q = 0; q < json_pointers.size(); q++) {
+    std::string& json_pointer = json_pointers[q];
+    size_t n = 0;
+    for (size_t i = 0; i < json_pointer.size();) {
+      if (json_pointer[i] != '/') {
+        return DecodeJson_BadJsonPointer;
+      }
+      std::pair<std::string, size_t> split = DecodeJson_SplitJsonPointer(
+          json_pointer, i + 1, allow_tilde_n_tilde_r_tilde_t);
+      i = split.second;
+      if (i == 0) {
+        return DecodeJson_BadJsonPointer;
+      }
+
+      auto iter = nodes[n].dict_children.find(split.first);
+      if (iter != nodes[n].dict_children.end()) {
+        n = iter->second;
+        continue;
+      }
+      size_t child = nodes.size();
+      nodes.emplace_back();
+      nodes[n].dict_children.insert(std::make_pair(split.first, child));
+      wuffs_base__result_u64 result_u64 = wuffs_base__parse_number_u64(
+          wuffs_base__make_slice_u8(
+              static_cast<uint8_t*>(static_cast<void*>(
+                  const_cast<char*>(split.first.data()))),
+              split.first.size()),
+          WUFFS_BASE__PARSE_NUMBER_XXX__DEFAULT_OPTIONS);
+      if (result_u64.status.is_ok()) {
+        nodes[n].list_children.insert(std::make_pair(result_u64.value, child));
+      }
+      n = child;
+    }
+    nodes[n].query_indexes.push_back(q);
+  }
+  return "";
+}
+
+// DecodeJsonMultiQuery_Impl walks the token stream once, keeping a stack of
+// frames that track where the JSON Pointer trie is up to. Subtrees that are
+// outside of the trie and outside of any match are skipped without calling
+// any callbacks.
+DecodeJsonResult  //
+DecodeJsonMultiQuery_Impl(DecodeJsonMultiQueryCallbacks& callbacks,
+                          sync_io::Input& input,
+                          DecodeJsonArgJsonPointers& json_pointers,
+                          DecodeJsonArgQuirks& quirks) {
+  // Prepare the wuffs_base__io_buffer and the resultant error_message.
+  wuffs_base__io_buffer* io_buf = input.BringsItsOwnIOBuffer();
+  wuffs_base__io_buffer fallback_io_buf = wuffs_base__empty_io_buffer();
+  std::unique_ptr<uint8_t[]> fallback_io_array(nullptr);
+  if (!io_buf) {
+    fallback_io_array = std::unique_ptr<uint8_t[]>(new uint8_t[4096]);
+    fallback_io_buf = wuffs_base__ptr_u8__writer(fallback_io_array.get(), 4096);
+    io_buf = &fallback_io_buf;
+  }
+  size_t cursor_index = 0;
+  std::string ret_error_message;
+  std::string io_error_message;
+
+  do {
+    // Prepare the low-level JSON decoder.
+    wuffs_json__decoder::unique_ptr dec = wuffs_json__decoder::alloc();
+    if (!dec) {
+      ret_error_message = "wuffs_aux::DecodeJson: out of memory";
+      goto done;
+    } else if (WUFFS_JSON__DECODER_WORKBUF_LEN_MAX_INCL_WORST_CASE != 0) {
+      ret_error_message =
+          "wuffs_aux::DecodeJson: internal error: bad WORKBUF_LEN";
+      goto done;
+    }
+    bool allow_tilde_n_tilde_r_tilde_t = false;
+    for (size_t i = 0; i < quirks.repr.len; i++) {
+      dec->set_quirk(quirks.repr.ptr[i], 1);
+      if (quirks.repr.ptr[i] ==
+          WUFFS_JSON__QUIRK_JSON_POINTER_ALLOW_TILDE_N_TILDE_R_TILDE_T) {
+        allow_tilde_n_tilde_r_tilde_t = true;
+      }
+    }
+
+    // Compile the JSON Pointers.
+    std::vector<DecodeJsonMultiQuery_Node> nodes;
+    ret_error_message = DecodeJsonMultiQuery_BuildTrie(
+        nodes, json_pointers.repr, allow_tilde_n_tilde_r_tilde_t);
+    if (!ret_error_message.empty()) {
+      goto done;
+    }
+
+    // Prepare the wuffs_base__tok_buffer. 256 tokens is 2KiB.
+    wuffs_base__token tok_array[256];
+    wuffs_base__token_buffer tok_buf =
+        wuffs_base__slice_token__writer(wuffs_base__make_slice_token(
+            &tok_array[0], (sizeof(tok_array) / sizeof(tok_array[0]))));
+    wuffs_base__status tok_status =
+        dec->decode_tokens(&tok_buf, io_buf, wuffs_base__empty_slice_u8());
+
+    // Prepare other state. num_unmatched counts the queries whose StartMatch
+    // has not been called yet and num_active counts those whose StartMatch
+    // has been called but whose EndMatch has not. Callbacks (other than
+    // StartMatch and EndMatch) are only called when num_active is positive.
+    std::vector<DecodeJsonMultiQuery_Frame> frames;
+    size_t num_unmatched = json_pointers.repr.size();
+    size_t num_active = 0;
+    bool root_done = false;
+    std::string str;
+
+    // Loop, doing these two things:
+    //  1. Get the next token.
+    //  2. Process that token.
+    while (true) {
+      WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN;
+
+      int64_t vbc = token.value_base_category();
+      uint64_t vbd = token.value_base_detail();
+      switch (vbc) {
+        case WUFFS_BASE__TOKEN__VBC__FILLER:
+          continue;
+
+        case WUFFS_BASE__TOKEN__VBC__STRING: {
+          if (vbd & WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_0_DST_1_SRC_DROP) {
+            // No-op.
+          } else if (vbd &
+                     WUFFS_BASE__TOKEN__VBD__STRING__CONVERT_1_DST_1_SRC_COPY) {
+            const char* ptr =  // Convert from (uint8_t*).
+                static_cast<const char*>(static_cast<void*>(token_ptr));
+            str.append(ptr, static_cast<size_t>(token_len));
+          } else {
+            goto fail;
+          }
+          if (token.continued()) {
+            continue;
+          }
+          break;
+        }
+
+        case WUFFS_BASE__TOKEN__VBC__UNICODE_CODE_POINT: {
+          uint8_t u[WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL];
+          size_t n = wuffs_base__utf_8__encode(
+              wuffs_base__make_slice_u8(
+                  &u[0], WUFFS_BASE__UTF_8__BYTE_LENGTH__MAX_INCL),
+              static_cast<uint32_t>(vbd));
+          const char* ptr =  // Convert from (uint8_t*).
+              static_cast<const char*>(static_cast<void*>(&u[0]));
+          str.append(ptr, n);
+          if (token.continued()) {
+            continue;
+          }
+          goto fail;
+        }
+
+        case WUFFS_BASE__TOKEN__VBC__STRUCTURE:
+          if (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__PUSH) {
+            break;
+          } else if (frames.empty()) {
+            goto fail;
+          }
+          // Pop the innermost dict or list and end its matches, if any.
+          if (num_active > 0) {
+            ret_error_message = callbacks.Pop(static_cast<uint32_t>(vbd));
+            if (!ret_error_message.empty()) {
+              goto done;
+            }
+          }
+          if (frames.back().node != SIZE_MAX) {
+            std::vector<size_t>& qi = nodes[frames.back().node].query_indexes;
+            for (size_t i = qi.size(); i > 0; i--) {
+              ret_error_message = callbacks.EndMatch(qi[i - 1]);
+              if (!ret_error_message.empty()) {
+                goto done;
+              }
+            }
+            num_active -= qi.size();
+          }
+          frames.pop_back();
+          goto parsed_a_value;
+
+        case WUFFS_BASE__TOKEN__VBC__LITERAL:
+        case WUFFS_BASE__TOKEN__VBC__NUMBER:
+          break;
+
+        default:
+          goto fail;
+      }
+
+      // A complete dict key is not a value, but it can select the trie node
+      // for the dict value that follows it.
+      if ((vbc == WUFFS_BASE__TOKEN__VBC__STRING) && !frames.empty() &&
+          frames.back().expecting_key) {
+        DecodeJsonMultiQuery_Frame& f = frames.back();
+        f.expecting_key = false;
+        f.value_node = SIZE_MAX;
+        if (f.node != SIZE_MAX) {
+          auto iter = nodes[f.node].dict_children.find(str);
+          if (iter != nodes[f.node].dict_children.end()) {
+            f.value_node = iter->second;
+          }
+        }
+        if (num_active > 0) {
+          ret_error_message = callbacks.AppendTextString(std::move(str));
+          if (!ret_error_message.empty()) {
+            goto done;
+          }
+        }
+        str.clear();
+        continue;
+      }
+
+      // We are at the start of a value. Find its trie node, if any. As for
+      // DecodeJson, JSON Pointer matching is greedy: only the first value
+      // for a node is considered.
+      {
+        size_t n = SIZE_MAX;
+        if (frames.empty()) {
+          if (root_done) {
+            goto fail;
+          }
+          n = 0;
+        } else if (frames.back().node == SIZE_MAX) {
+          // No-op.
+        } else if (frames.back().is_list) {
+          std::map<uint64_t, size_t>& m =
+              nodes[frames.back().node].list_children;
+          auto iter = m.find(frames.back().list_index);
+          if (iter != m.end()) {
+            n = iter->second;
+          }
+        } else {
+          n = frames.back().value_node;
+        }
+        if (n != SIZE_MAX) {
+          if (nodes[n].visited) {
+            n = SIZE_MAX;
+          } else {
+            nodes[n].visited = true;
+          }
+        }
+
+        if (n != SIZE_MAX) {
+          std::vector<size_t>& qi = nodes[n].query_indexes;
+          for (size_t i = 0; i < qi.size(); i++) {
+            ret_error_message = callbacks.StartMatch(qi[i]);
+            if (!ret_error_message.empty()) {
+              goto done;
+            }
+          }
+          num_active += qi.size();
+          num_unmatched -= qi.size();
+        }
+
+        if (vbc == WUFFS_BASE__TOKEN__VBC__STRUCTURE) {
+          if ((n == SIZE_MAX) && (num_active == 0)) {
+            // Skip the dict or list at token speed.
+            for (uint32_t skip_depth = 1; skip_depth > 0;) {
+              WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN;
+
+              if (token.value_base_category() ==
+                  WUFFS_BASE__TOKEN__VBC__STRUCTURE) {
+                if (token.value_base_detail() &
+                    WUFFS_BASE__TOKEN__VBD__STRUCTURE__PUSH) {
+                  skip_depth++;
+                } else {
+                  skip_depth--;
+                }
+              }
+            }
+            goto parsed_a_value;
+          }
+          if (num_active > 0) {
+            ret_error_message = callbacks.Push(static_cast<uint32_t>(vbd));
+            if (!ret_error_message.empty()) {
+              goto done;
+            }
+          }
+          if (frames.size() >= WUFFS_JSON__DECODER_DEPTH_MAX_INCL) {
+            ret_error_message =
+                "wuffs_aux::DecodeJson: internal error: bad depth";
+            goto done;
+          }
+          DecodeJsonMultiQuery_Frame f;
+          f.node = n;
+          f.is_list = (vbd & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST) != 0;
+          f.expecting_key = !f.is_list;
+          f.list_index = 0;
+          f.value_node = SIZE_MAX;
+          frames.push_back(f);
+          continue;
+        }
+
+        if (num_active > 0) {
+          if (vbc == WUFFS_BASE__TOKEN__VBC__STRING) {
+            ret_error_message = callbacks.AppendTextString(std::move(str));
+          } else if (vbc == WUFFS_BASE__TOKEN__VBC__NUMBER) {
+            ret_error_message = DecodeJson_AppendNumber(
+                callbacks, vbd, token_ptr, static_cast<size_t>(token_len));
+          } else {
+            ret_error_message =
+                (vbd & WUFFS_BASE__TOKEN__VBD__LITERAL__NULL)
+                    ? callbacks.AppendNull()
+                    : callbacks.AppendBool(
+                          vbd & WUFFS_BASE__TOKEN__VBD__LITERAL__TRUE);
+          }
+          if (!ret_error_message.empty()) {
+            goto done;
+          }
+        }
+        str.clear();
+
+        if (n != SIZE_MAX) {
+          std::vector<size_t>& qi = nodes[n].query_indexes;
+          for (size_t i = qi.size(); i > 0; i--) {
+            ret_error_message = callbacks.EndMatch(qi[i - 1]);
+            if (!ret_error_message.empty()) {
+              goto done;
+            }
+          }
+          num_active -= qi.size();
+        }
+      }
+      goto parsed_a_value;
+
+    fail:
+      ret_error_message =
+          "wuffs_aux::DecodeJson: internal error: unexpected token";
+      goto done;
+
+    parsed_a_value:
+      // Once every query has matched (and their matches have ended), there
+      // is no need to decode the rest of the input. Otherwise, keep the loop
+      // running, in case of trailing filler, until
+      // WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN's decode_tokens returns
+      // an ok status.
+      if ((num_unmatched == 0) && (num_active == 0)) {
+        goto done;
+      } else if (frames.empty()) {
+        root_done = true;
+      } else if (frames.back().is_list) {
+        frames.back().list_index++;
+      } else {
+        frames.back().expecting_key = true;
+      }
+    }
+  } while (false);
+
+done:
+  DecodeJsonResult result(
+      std::move(ret_error_message),
+      wuffs_base__u64__sat_add(io_buf->meta.pos, cursor_index));
+  callbacks.Done(result, input, *io_buf);
+  return result;
+}
+
+}  // namespace
+
 #undef WUFFS_AUX__DECODE_JSON__GET_THE_NEXT_TOKEN
 
+// --------
+
+DecodeJsonResult  //
+DecodeJson(DecodeJsonCallbacks& callbacks,
+           sync_io::Input& input,
+           DecodeJsonArgQuirks quirks,
+           DecodeJsonArgJsonPointer json_pointer) {
+  wuffs_json__decoder::unique_ptr dec(nullptr, &free);
+  return DecodeJson_Impl(callbacks, input, quirks, json_pointer, dec, false);
+}
+
+DecodeJsonResult  //
+DecodeJsonMultiQuery(DecodeJsonMultiQueryCallbacks& callbacks,
+                     sync_io::Input& input,
+                     DecodeJsonArgJsonPointers json_pointers,
+                     DecodeJsonArgQuirks quirks) {
+  return DecodeJsonMultiQuery_Impl(callbacks, input, json_pointers, quirks);
+}
+
+// --------
+
+DecodeJsonLinesCallbacks::~DecodeJsonLinesCallbacks() {}
+
+size_t  //
+DecodeJsonLines_NextRecordStart(const uint8_t* ptr, size_t len, size_t i) {
+  if (i >= len) {
+    return len;
+  } else if ((i == 0) || (ptr[i - 1] == '\n')) {
+    return i;
+  }
+  // memchr is typically a SIMD implementation. Valid JSON cannot contain a
+  // raw '\n' byte inside a string (it must be escaped) and DecodeJsonLines
+  // disallows comments, so every '\n' byte is a record boundary.
+  const void* p = memchr(ptr + i, '\n', len - i);
+  return p ? (1 + static_cast<size_t>(static_cast<const uint8_t*>(p) - ptr))
+           : len;
+}
+
+namespace {
+
+// DecodeJsonLines_RecordQuirks appends the per-record quirks (the quirks
+// argument plus WUFFS_JSON__QUIRK_EXPECT_TRAILING_NEW_LINE_OR_EOF) to v. It
+// returns false if quirks contains a conflicting quirk.
+bool  //
+DecodeJsonLines_RecordQuirks(std::vector<uint32_t>& v,
+                             DecodeJsonArgQuirks& quirks) {
+  v.reserve(quirks.repr.len + 1);
+  for (size_t i = 0; i < quirks.repr.len; i++) {
+    uint32_t q = quirks.repr.ptr[i];
+    if ((q == WUFFS_JSON__QUIRK_ALLOW_COMMENT_BLOCK) ||
+        (q == WUFFS_JSON__QUIRK_ALLOW_COMMENT_LINE) ||
+        (q == WUFFS_JSON__QUIRK_ALLOW_TRAILING_FILLER)) {
+      return false;
+    }
+    v.push_back(q);
+  }
+  v.push_back(WUFFS_JSON__QUIRK_EXPECT_TRAILING_NEW_LINE_OR_EOF);
+  return true;
+}
+
+// DecodeJsonLines_IsBlank returns whether ptr[i .. j] is all whitespace.
+bool  //
+DecodeJsonLines_IsBlank(const uint8_t* ptr, size_t i, size_t j) {
+  for (; i < j; i++) {
+    if ((ptr[i] != ' ') && (ptr[i] != '\t') && (ptr[i] != '\r') &&
+        (ptr[i] != '\n')) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// DecodeJsonLines_DecodeRecord decodes the record ptr[i .. j], re-using dec
+// (which is allocated if empty). Its cursor_position is relative to ptr.
+// DecodeJson_NoMatch is not an error, at this level.
+DecodeJsonResult  //
+DecodeJsonLines_DecodeRecord(DecodeJsonCallbacks& record_callbacks,
+                             const uint8_t* ptr,
+                             size_t i,
+                             size_t j,
+                             DecodeJsonArgQuirks& record_quirks,
+                             DecodeJsonArgJsonPointer& json_pointer,
+                             wuffs_json__decoder::unique_ptr& dec) {
+  sync_io::MemoryInput input(ptr + i, j - i);
+  DecodeJsonResult result = DecodeJson_Impl(
+      record_callbacks, input, record_quirks, json_pointer, dec, true);
+
+  // Re-using dec (instead of re-initializing it) also skips repeating its
+  // CPU feature detection, which can be relatively expensive (e.g. on some
+  // virtual machines) compared to decoding one short record.
+  if (dec) {
+    dec->reset_end_of_data();
+  }
+
+  if (result.error_message == DecodeJson_NoMatch) {
+    // No-op. The record's callbacks' Done method has seen the error but
+    // other records may still match.
+  } else if (!result.error_message.empty()) {
+    // Failing at the end of a '\n'-terminated record means that the JSON
+    // value was incomplete, continuing on the next line. Report that at the
+    // '\n', which is on the same line as the rest of the record.
+    if ((result.cursor_position == (j - i)) && (i < j) &&
+        (ptr[j - 1] == '\n')) {
+      return DecodeJsonResult(DecodeJsonLines_MultiLineRecord, j - 1);
+    }
+    return DecodeJsonResult(
+        std::move(result.error_message),
+        wuffs_base__u64__sat_add(i, result.cursor_position));
+  }
+  if (result.cursor_position != (j - i)) {
+    return DecodeJsonResult(
+        DecodeJsonLines_BadRecord,
+        wuffs_base__u64__sat_add(i, result.cursor_position));
+  }
+  return DecodeJsonResult("", j);
+}
+
+}  // namespace
+
+DecodeJsonResult  //
+DecodeJsonLines(DecodeJsonLinesCallbacks& callbacks,
+                const uint8_t* ptr,
+                size_t len,
+                DecodeJsonArgQuirks quirks,
+                DecodeJsonArgJsonPointer json_pointer) {
+  std::vector<uint32_t> quirks_vector;
+  if (!DecodeJsonLines_RecordQuirks(quirks_vector, quirks)) {
+    return DecodeJsonResult(DecodeJsonLines_BadQuirks, 0);
+  }
+  DecodeJsonArgQuirks record_quirks(quirks_vector.data(),
+                                    quirks_vector.size());
+
+  wuffs_json__decoder::unique_ptr dec(nullptr, &free);
+  uint64_t record_index = 0;
+  size_t i = 0;
+  while (i < len) {
+    size_t j = DecodeJsonLines_NextRecordStart(ptr, len, i + 1);
+    if (DecodeJsonLines_IsBlank(ptr, i, j)) {
+      i = j;
+      continue;
+    }
+
+    DecodeJsonCallbacks* record_callbacks =
+        callbacks.StartRecord(record_index, i);
+    if (record_callbacks) {
+      DecodeJsonResult result = DecodeJsonLines_DecodeRecord(
+          *record_callbacks, ptr, i, j, record_quirks, json_pointer, dec);
+      if (!result.error_message.empty()) {
+        return result;
+      }
+    }
+    record_index++;
+    i = j;
+  }
+  return DecodeJsonResult("", len);
+}
+
+#if defined(WUFFS_CONFIG__ENABLE_THREADS)
+
+// --------
+
+DecodeJsonLinesParallelCallbacks::~DecodeJsonLinesParallelCallbacks() {}
+
+namespace {
+
+// DecodeJsonLinesParallel_Record is a decoded record that has not yet been
+// passed to FinishRecord.
+struct DecodeJsonLinesParallel_Record {
+  DecodeJsonLinesParallel_Record(uint64_t position0,
+                                 DecodeJsonCallbacks* record_callbacks0)
+      : position(position0), record_callbacks(record_callbacks0) {}
+
+  uint64_t position;
+  DecodeJsonCallbacks* record_callbacks;
+};
+
+// DecodeJsonLinesParallel_State is shared by the worker threads. The input is
+// split into chunks of roughly chunk_size bytes, adjusted to start and end on
+// record boundaries. Workers claim chunks in increasing order.
+struct DecodeJsonLinesParallel_State {
+  static constexpr size_t chunk_size = 65536;
+
+  DecodeJsonLinesParallelCallbacks& callbacks;
+  const uint8_t* ptr;
+  size_t len;
+  bool ordered;
+  DecodeJsonArgQuirks record_quirks;
+  DecodeJsonArgJsonPointer& json_pointer;
+
+  size_t num_chunks;
+  std::atomic<size_t> next_chunk;
+  std::atomic<bool> stop;
+
+  // These fields are guarded by mutex. When ordered, completed chunks wait
+  // in pending_chunks until every earlier chunk has been delivered.
+  std::mutex mutex;
+  std::map<size_t, std::vector<DecodeJsonLinesParallel_Record>> pending_chunks;
+  size_t next_chunk_to_deliver;
+  size_t error_chunk;
+  DecodeJsonResult error;
+
+  DecodeJsonLinesParallel_State(DecodeJsonLinesParallelCallbacks& callbacks0,
+                                const uint8_t* ptr0,
+                                size_t len0,
+                                bool ordered0,
+                                DecodeJsonArgQuirks record_quirks0,
+                                DecodeJsonArgJsonPointer& json_pointer0)
+      : callbacks(callbacks0),
+        ptr(ptr0),
+        len(len0),
+        ordered(ordered0),
+        record_quirks(record_quirks0),
+        json_pointer(json_pointer0),
+        num_chunks((len0 / chunk_size) + ((len0 % chunk_size) ? 1 : 0)),
+        next_chunk(0),
+        stop(false),
+        next_chunk_to_deliver(0),
+        error_chunk(SIZE_MAX),
+        error("", len0) {}
+};
+
+void  //
+DecodeJsonLinesParallel_Deliver(
+    DecodeJsonLinesParallel_State& s,
+    std::vector<DecodeJsonLinesParallel_Record>& records) {
+  for (auto& r : records) {
+    s.callbacks.FinishRecord(r.position, r.record_callbacks);
+  }
+}
+
+void  //
+DecodeJsonLinesParallel_Work(DecodeJsonLinesParallel_State* s,
+                             size_t worker_index) {
+  wuffs_json__decoder::unique_ptr dec(nullptr, &free);
+  while (!s->stop.load()) {
+    size_t chunk = s->next_chunk.fetch_add(1);
+    if (chunk >= s->num_chunks) {
+      break;
+    }
+    size_t i = DecodeJsonLines_NextRecordStart(
+        s->ptr, s->len, chunk * DecodeJsonLinesParallel_State::chunk_size);
+    size_t end = DecodeJsonLines_NextRecordStart(
+        s->ptr, s->len,
+        (chunk + 1) * DecodeJsonLinesParallel_State::chunk_size);
+
+    std::vector<DecodeJsonLinesParallel_Record> records;
+    DecodeJsonResult result("", end);
+    while (i < end) {
+      size_t j = DecodeJsonLines_NextRecordStart(s->ptr, s->len, i + 1);
+      if (DecodeJsonLines_IsBlank(s->ptr, i, j)) {
+        i = j;
+        continue;
+      }
+      DecodeJsonCallbacks* record_callbacks =
+          s->callbacks.StartRecord(worker_index, i);
+      if (record_callbacks) {
+        result = DecodeJsonLines_DecodeRecord(*record_callbacks, s->ptr, i, j,
+                                              s->record_quirks,
+                                              s->json_pointer, dec);
+        if (!result.error_message.empty()) {
+          break;
+        }
+        records.emplace_back(i, record_callbacks);
+      }
+      i = j;
+    }
+
+    std::lock_guard<std::mutex> lock(s->mutex);
+    if (!result.error_message.empty()) {
+      s->stop.store(true);
+      if (chunk < s->error_chunk) {
+        s->error_chunk = chunk;
+        s->error = std::move(result);
+      }
+    }
+    if (!s->ordered) {
+      DecodeJsonLinesParallel_Deliver(*s, records);
+      continue;
+    }
+    s->pending_chunks[chunk] = std::move(records);
+    while (s->next_chunk_to_deliver <= s->error_chunk) {
+      auto iter = s->pending_chunks.find(s->next_chunk_to_deliver);
+      if (iter == s->pending_chunks.end()) {
+        break;
+      }
+      DecodeJsonLinesParallel_Deliver(*s, iter->second);
+      s->pending_chunks.erase(iter);
+      s->next_chunk_to_deliver++;
+    }
+  }
+}
+
+}  // namespace
+
+DecodeJsonResult  //
+DecodeJsonLinesParallel(DecodeJsonLinesParallelCallbacks& callbacks,
+                        const uint8_t* ptr,
+                        size_t len,
+                        size_t num_workers,
+                        bool ordered,
+                        DecodeJsonArgQuirks quirks,
+                        DecodeJsonArgJsonPointer json_pointer) {
+  std::vector<uint32_t> quirks_vector;
+  if (!DecodeJsonLines_RecordQuirks(quirks_vector, quirks)) {
+    return DecodeJsonResult(DecodeJsonLines_BadQuirks, 0);
+  }
+  if (num_workers == 0) {
+    num_workers = std::thread::hardware_concurrency();
+    if (num_workers == 0) {
+      num_workers = 1;
+    }
+  }
+
+  DecodeJsonLinesParallel_State s(
+      callbacks, ptr, len, ordered,
+      DecodeJsonArgQuirks(quirks_vector.data(), quirks_vector.size()),
+      json_pointer);
+
+  // The calling thread is worker number 0.
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers - 1);
+  for (size_t w = 1; w < num_workers; w++) {
+    threads.emplace_back(DecodeJsonLinesParallel_Work, &s, w);
+  }
+  DecodeJsonLinesParallel_Work(&s, 0);
+  for (auto& t : threads) {
+    t.join();
+  }
+  return std::move(s.error);
+}
+
+#endif  // defined(WUFFS_CONFIG__ENABLE_THREADS)
+
 }  // namespace wuffs_aux
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
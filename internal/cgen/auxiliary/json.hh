@@ -14,6 +14,8 @@
 
 // ---------------- Auxiliary - JSON
 
+#include <vector>
+
 namespace wuffs_aux {
 
 struct DecodeJsonResult {
@@ -37,6 +39,18 @@ class DecodeJsonCallbacks {
   virtual std::string AppendI64(int64_t val) = 0;
   virtual std::string AppendTextString(std::string&& val) = 0;
 
+  // AppendTextStringView is like AppendTextString but the string is passed as
+  // a (ptr, len) view instead of an owned std::string. DecodeJson calls it,
+  // instead of AppendTextString, when the JSON string contains no escapes and
+  // so its bytes are already contiguous in the input buffer. That view is
+  // only valid for the duration of the call: do not keep a reference to ptr
+  // after AppendTextStringView returns.
+  //
+  // Overriding this method avoids a heap allocation per long string (e.g. for
+  // key-heavy JSON). The default AppendTextStringView implementation copies
+  // the view to a std::string and calls AppendTextString.
+  virtual std::string AppendTextStringView(const char* ptr, size_t len);
+
   // Push and Pop are called for container nodes: JSON arrays (lists) and JSON
   // objects (dictionaries).
   //
@@ -68,6 +82,9 @@ class DecodeJsonCallbacks {
 
 extern const char DecodeJson_BadJsonPointer[];
 extern const char DecodeJson_NoMatch[];
+extern const char DecodeJsonLines_BadQuirks[];
+extern const char DecodeJsonLines_BadRecord[];
+extern const char DecodeJsonLines_MultiLineRecord[];
 
 // The FooArgBar types add structure to Foo's optional arguments. They wrap
 // inner representations for several reasons:
@@ -99,6 +116,13 @@ struct DecodeJsonArgJsonPointer {
   std::string repr;
 };
 
+// DecodeJsonArgJsonPointers wraps an argument to DecodeJsonMultiQuery.
+struct DecodeJsonArgJsonPointers {
+  explicit DecodeJsonArgJsonPointers(std::vector<std::string> repr0);
+
+  std::vector<std::string> repr;
+};
+
 // DecodeJson calls callbacks based on the JSON-formatted data in input.
 //
 // On success, the returned error_message is empty and cursor_position counts
@@ -120,4 +144,150 @@ DecodeJson(DecodeJsonCallbacks& callbacks,
            DecodeJsonArgJsonPointer json_pointer =
                DecodeJsonArgJsonPointer::DefaultValue());
 
+// --------
+
+class DecodeJsonMultiQueryCallbacks : public DecodeJsonCallbacks {
+ public:
+  ~DecodeJsonMultiQueryCallbacks() override;
+
+  // StartMatch and EndMatch bracket the AppendXxx, Push and Pop calls for the
+  // JSON value that matches the query_index'th JSON Pointer. The AppendXxx,
+  // Push and Pop methods are only called for matching values (and their
+  // descendents), not for the rest of the input.
+  //
+  // Matches can nest. For example, with "/a" and "/a/b" queries, the "/a/b"
+  // StartMatch and EndMatch calls happen between the "/a" ones. Queries that
+  // are equivalent (e.g. listed twice) are started in query_index order and
+  // ended in reverse order.
+  virtual std::string StartMatch(size_t query_index) = 0;
+  virtual std::string EndMatch(size_t query_index) = 0;
+};
+
+// DecodeJsonMultiQuery is like DecodeJson with a json_pointer query, except
+// that it finds the values for multiple JSON Pointer queries (some of which
+// can be prefixes of others) in one pass over the input. The queries are
+// compiled to a trie (a tree of query fragments) and subtrees of the input
+// that no query can match are skipped without calling callbacks.
+//
+// Each query matches at most one value, and is greedy in the same way as for
+// DecodeJson: only the first match for each '/'-separated fragment is
+// followed. A query with no match is not an error: its StartMatch is simply
+// never called. Decoding stops after the input's root value is complete or
+// after every query has matched, whichever comes first.
+DecodeJsonResult  //
+DecodeJsonMultiQuery(
+    DecodeJsonMultiQueryCallbacks& callbacks,
+    sync_io::Input& input,
+    DecodeJsonArgJsonPointers json_pointers,
+    DecodeJsonArgQuirks quirks = DecodeJsonArgQuirks::DefaultValue());
+
+// --------
+
+class DecodeJsonLinesCallbacks {
+ public:
+  virtual ~DecodeJsonLinesCallbacks();
+
+  // StartRecord is called before decoding each record (each non-blank line).
+  // record_index counts the records seen by this DecodeJsonLines call (not
+  // counting blank lines) and position is the record's byte offset relative
+  // to DecodeJsonLines' ptr argument.
+  //
+  // It returns the callbacks for that record's JSON value, or nullptr to skip
+  // the record without decoding it. The returned callbacks' Done method is
+  // called when that record is complete, before the next StartRecord call.
+  virtual DecodeJsonCallbacks* StartRecord(uint64_t record_index,
+                                           uint64_t position) = 0;
+};
+
+// DecodeJsonLines_NextRecordStart returns the smallest j such that i <= j and
+// either (j == len) or j is just after a '\n' byte in ptr[0 .. len]. A zero
+// i returns zero.
+//
+// Splitting ptr[0 .. len] at j values (e.g. for i values that evenly divide
+// len) gives shards of whole records, which can be passed to separate
+// DecodeJsonLines calls, e.g. on separate threads.
+size_t  //
+DecodeJsonLines_NextRecordStart(const uint8_t* ptr, size_t len, size_t i);
+
+// DecodeJsonLines decodes the newline-delimited JSON (also known as NDJSON or
+// JSON Lines) in ptr[0 .. len], calling callbacks for each record, in order.
+// Every line is a record holding one JSON value, except that blank lines are
+// skipped. The quirks and json_pointer apply to each record separately.
+// WUFFS_JSON__QUIRK_EXPECT_TRAILING_NEW_LINE_OR_EOF is always enabled and the
+// comment and trailing filler quirks (which conflict with that) are rejected.
+//
+// A JSON value cannot span multiple lines. One that continues past its first
+// line's '\n' is a DecodeJsonLines_MultiLineRecord error, positioned at that
+// '\n' (and so on the same line as the start of the record).
+//
+// Decoding stops at the first record that is not valid JSON, returning the
+// error and its cursor_position relative to ptr. A DecodeJson_NoMatch error
+// (for a record that does not match json_pointer) is only passed to that
+// record's callbacks' Done method and does not stop decoding.
+//
+// A DecodeJsonLines call is single-threaded but re-uses one low-level JSON
+// decoder for all of its records. DecodeJsonLinesParallel, below, spreads the
+// records over multiple threads (when WUFFS_CONFIG__ENABLE_THREADS is defined).
+DecodeJsonResult  //
+DecodeJsonLines(
+    DecodeJsonLinesCallbacks& callbacks,
+    const uint8_t* ptr,
+    size_t len,
+    DecodeJsonArgQuirks quirks = DecodeJsonArgQuirks::DefaultValue(),
+    DecodeJsonArgJsonPointer json_pointer =
+        DecodeJsonArgJsonPointer::DefaultValue());
+
+#if defined(WUFFS_CONFIG__ENABLE_THREADS)
+
+// --------
+
+class DecodeJsonLinesParallelCallbacks {
+ public:
+  virtual ~DecodeJsonLinesParallelCallbacks();
+
+  // StartRecord is like DecodeJsonLinesCallbacks::StartRecord but it is
+  // called on a worker thread, concurrently with other StartRecord calls (and
+  // other records' DecodeJsonCallbacks calls). worker_index is less than the
+  // number of workers and identifies the calling thread, so that
+  // implementations can keep per-worker state without locking.
+  //
+  // The returned callbacks must stay valid until they are passed to
+  // FinishRecord (or until DecodeJsonLinesParallel returns).
+  virtual DecodeJsonCallbacks* StartRecord(size_t worker_index,
+                                           uint64_t position) = 0;
+
+  // FinishRecord is called for each successfully decoded record (including
+  // those that did not match json_pointer, whose Done method saw
+  // DecodeJson_NoMatch). FinishRecord calls are never concurrent. When
+  // ordered, they are in input order, otherwise they are in roughly
+  // completion order.
+  virtual void FinishRecord(uint64_t position,
+                            DecodeJsonCallbacks* record_callbacks) = 0;
+};
+
+// DecodeJsonLinesParallel is like DecodeJsonLines but decodes records on
+// num_workers threads (the calling thread and num_workers - 1 new ones), each
+// with its own low-level JSON decoder. A zero num_workers means one per
+// hardware thread. The input is split into chunks of whole records, found by
+// DecodeJsonLines_NextRecordStart, that are claimed by workers in order.
+//
+// On an invalid record, workers stop claiming new chunks and the error for
+// the earliest such record is returned. When ordered, no record after it is
+// passed to FinishRecord, although some may have been decoded.
+//
+// This is only declared if WUFFS_CONFIG__ENABLE_THREADS is defined, as it
+// uses std::thread (which may need linking with e.g. -pthread).
+DecodeJsonResult  //
+DecodeJsonLinesParallel(
+    DecodeJsonLinesParallelCallbacks& callbacks,
+    const uint8_t* ptr,
+    size_t len,
+    size_t num_workers,
+    bool ordered,
+    DecodeJsonArgQuirks quirks = DecodeJsonArgQuirks::DefaultValue(),
+    DecodeJsonArgJsonPointer json_pointer =
+        DecodeJsonArgJsonPointer::DefaultValue());
+
+#endif  // defined(WUFFS_CONFIG__ENABLE_THREADS)
+
 }  // namespace wuffs_aux
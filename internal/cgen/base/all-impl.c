@@ -166,6 +166,18 @@ const uint32_t wuffs_base__pixel_format__bits_per_channel[16] = {
 
 // ¡ INSERT base/pixconv-submodule-ycck.c.
 
+// ¡ INSERT base/pixconv-submodule-resample.c.
+
+// ¡ INSERT base/pixconv-submodule-color.c.
+
+// ¡ INSERT base/pixconv-submodule-dither.c.
+
+// ¡ INSERT base/pixconv-submodule-quantize.c.
+
+// ¡ INSERT base/pixconv-submodule-float.c.
+
+// ¡ INSERT base/pixconv-submodule-arm-neon.c.
+
 // ¡ INSERT base/pixconv-submodule-x86-avx2.c.
 
 #endif  // !defined(WUFFS_CONFIG__MODULES) ||
@@ -247,6 +247,40 @@ wuffs_base__cpu_arch__have_x86_bmi2() {
 #endif  // defined(__BMI2__)
 }
 
+static inline bool  //
+wuffs_base__cpu_arch__have_x86_f16c() {
+#if defined(__F16C__)
+  return true;
+#else
+#if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  // GCC defines these macros but MSVC does not.
+  //  - bit_F16C = (1 << 29)
+  const unsigned int f16c_ecx1 = 0x20000000;
+
+  // clang defines __GNUC__ and clang-cl defines _MSC_VER (but not __GNUC__).
+#if defined(__GNUC__)
+  unsigned int eax1 = 0;
+  unsigned int ebx1 = 0;
+  unsigned int ecx1 = 0;
+  unsigned int edx1 = 0;
+  if (__get_cpuid(1, &eax1, &ebx1, &ecx1, &edx1) &&
+      ((ecx1 & f16c_ecx1) == f16c_ecx1)) {
+    return true;
+  }
+#elif defined(_MSC_VER)  // defined(__GNUC__)
+  int x1[4];
+  __cpuid(x1, 1);
+  if ((((unsigned int)(x1[2])) & f16c_ecx1) == f16c_ecx1) {
+    return true;
+  }
+#else
+#error "WUFFS_BASE__CPU_ARCH__ETC combined with an unsupported compiler"
+#endif  // defined(__GNUC__); defined(_MSC_VER)
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
+  return false;
+#endif  // defined(__F16C__)
+}
+
 static inline bool  //
 wuffs_base__cpu_arch__have_x86_sse42() {
 #if defined(__PCLMUL__) && defined(__POPCNT__) && defined(__SSE4_2__)
@@ -45,6 +45,9 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     wuffs_base__slice_u8 dst_palette,
     uint32_t width,
     uint32_t height,
+    uint32_t y_min_incl,
+    uint32_t y_max_excl,
+    uint32_t src_y_offset,
     wuffs_base__slice_u8 src0,
     wuffs_base__slice_u8 src1,
     wuffs_base__slice_u8 src2,
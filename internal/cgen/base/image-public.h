@@ -157,6 +157,28 @@ wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
          ((b16 >> 8) << 0);
 }
 
+// wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul converts
+// from 4x16LE non-premultiplied alpha to 4x16LE premultiplied alpha. Shifting
+// each channel of the result right by 8 gives the same 4x8 value as the
+// wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul function.
+static inline uint64_t  //
+wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(
+    uint64_t argb_nonpremul) {
+  uint64_t a16 = 0xFFFF & (argb_nonpremul >> 48);
+  if (a16 == 0xFFFF) {
+    return argb_nonpremul;
+  }
+
+  uint64_t r16 = 0xFFFF & (argb_nonpremul >> 32);
+  r16 = (r16 * a16) / 0xFFFF;
+  uint64_t g16 = 0xFFFF & (argb_nonpremul >> 16);
+  g16 = (g16 * a16) / 0xFFFF;
+  uint64_t b16 = 0xFFFF & (argb_nonpremul >> 0);
+  b16 = (b16 * a16) / 0xFFFF;
+
+  return (a16 << 48) | (r16 << 32) | (g16 << 16) | (b16 << 0);
+}
+
 // wuffs_base__color_u32_argb_premul__as__color_u64_argb_nonpremul converts
 // from 4x8 premultiplied alpha to 4x16LE non-premultiplied alpha.
 static inline uint64_t  //
@@ -293,6 +315,33 @@ typedef uint8_t wuffs_base__pixel_blend;
 
 // --------
 
+typedef uint8_t wuffs_base__pixel_dither;
+
+// wuffs_base__pixel_dither encodes how to hide the banding that comes from
+// converting pixels to a destination pixel format with fewer bits per
+// channel, such as BGR_565.
+//
+// ORDERED adds a position-dependent (8x8 Bayer matrix) threshold before
+// truncating. It needs no state, so pixels can be converted in any order.
+//
+// ERROR_DIFFUSION is Floyd-Steinberg: each pixel's rounding error is spread
+// to its right and lower neighbors. It needs a caller-supplied work buffer
+// (see wuffs_base__pixel_dither__error_diffusion_workbuf_len) and is best
+// when rows are converted top to bottom, each left to right.
+#define WUFFS_BASE__PIXEL_DITHER__NONE ((wuffs_base__pixel_dither)0)
+#define WUFFS_BASE__PIXEL_DITHER__ORDERED ((wuffs_base__pixel_dither)1)
+#define WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION ((wuffs_base__pixel_dither)2)
+
+// wuffs_base__pixel_dither__error_diffusion_workbuf_len returns the minimum
+// work buffer length for WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION and a
+// destination pixel buffer with the given width.
+static inline uint64_t  //
+wuffs_base__pixel_dither__error_diffusion_workbuf_len(uint32_t width) {
+  return 64u + (12u * ((uint64_t)width));
+}
+
+// --------
+
 // wuffs_base__pixel_alpha_transparency is a pixel format's alpha channel
 // model. It is a property of the pixel format in general, not of a specific
 // pixel. An RGBA pixel format (with alpha) can still have fully opaque pixels.
@@ -391,6 +440,16 @@ wuffs_base__make_pixel_format(uint32_t repr) {
 #define WUFFS_BASE__PIXEL_FORMAT__CMY 0xC0020888
 #define WUFFS_BASE__PIXEL_FORMAT__CMYK 0xD0038888
 
+// Floating point pixel formats hold little-endian IEEE 754 half (F16) or
+// single (F32) precision samples, nominally in the range [0, 1]. The _LINEAR
+// formats hold linear light, decoding the source's transfer function (assumed
+// to be sRGB) before premultiplying by alpha. The other formats hold the
+// source's encoded values.
+#define WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16 0xA208BBBB
+#define WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR 0xA228BBBB
+#define WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32 0xA208DDDD
+#define WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR 0xA228DDDD
+
 extern const uint32_t wuffs_base__pixel_format__bits_per_channel[16];
 
 static inline bool  //
@@ -600,6 +659,8 @@ typedef struct wuffs_base__pixel_config__struct {
   inline wuffs_base__rect_ie_u32 bounds() const;
   inline uint32_t width() const;
   inline uint32_t height() const;
+  inline uint32_t plane_width(uint32_t p) const;
+  inline uint32_t plane_height(uint32_t p) const;
   inline uint64_t pixbuf_len() const;
 #endif  // __cplusplus
 
@@ -697,17 +758,63 @@ wuffs_base__pixel_config__height(const wuffs_base__pixel_config* c) {
   return c ? c->private_impl.height : 0;
 }
 
-// TODO: this is the right API for planar (not interleaved) pixbufs? Should it
-// allow decoding into a color model different from the format's intrinsic one?
-// For example, decoding a JPEG image straight to RGBA instead of to YCbCr?
+// wuffs_base__pixel_config__plane_width and wuffs_base__pixel_config__
+// plane_height return the number of samples per row and per column of the
+// p'th plane, accounting for pixel subsampling. For interleaved pixel formats,
+// these are the pixel width and height (for p == 0).
+static inline uint32_t  //
+wuffs_base__pixel_config__plane_width(const wuffs_base__pixel_config* c,
+                                      uint32_t p) {
+  if (!c || (c->private_impl.width == 0)) {
+    return 0;
+  }
+  uint32_t n = c->private_impl.width - 1;
+  uint32_t b =
+      wuffs_base__pixel_subsampling__bias_x(&c->private_impl.pixsub, p);
+  uint32_t d =
+      wuffs_base__pixel_subsampling__denominator_x(&c->private_impl.pixsub, p);
+  return (uint32_t)(((((uint64_t)n) + b) / d) + 1);
+}
+
+static inline uint32_t  //
+wuffs_base__pixel_config__plane_height(const wuffs_base__pixel_config* c,
+                                       uint32_t p) {
+  if (!c || (c->private_impl.height == 0)) {
+    return 0;
+  }
+  uint32_t n = c->private_impl.height - 1;
+  uint32_t b =
+      wuffs_base__pixel_subsampling__bias_y(&c->private_impl.pixsub, p);
+  uint32_t d =
+      wuffs_base__pixel_subsampling__denominator_y(&c->private_impl.pixsub, p);
+  return (uint32_t)(((((uint64_t)n) + b) / d) + 1);
+}
+
+// wuffs_base__pixel_config__pixbuf_len returns the number of bytes needed to
+// hold every plane of the pixel buffer, tightly packed (with each plane's
+// stride equal to its width). Planar pixel formats, such as
+// WUFFS_BASE__PIXEL_FORMAT__YCBCR, are supported if each plane has 8 bits per
+// sample. Their chroma planes are typically smaller than the luma plane, due
+// to the pixel subsampling.
 static inline uint64_t  //
 wuffs_base__pixel_config__pixbuf_len(const wuffs_base__pixel_config* c) {
   if (!c) {
     return 0;
   }
   if (wuffs_base__pixel_format__is_planar(&c->private_impl.pixfmt)) {
-    // TODO: support planar pixel formats, concious of pixel subsampling.
-    return 0;
+    uint64_t n = 0;
+    uint32_t num_planes =
+        wuffs_base__pixel_format__num_planes(&c->private_impl.pixfmt);
+    uint32_t p;
+    for (p = 0; p < num_planes; p++) {
+      if (wuffs_base__pixel_format__bits_per_channel
+              [0x0F & (c->private_impl.pixfmt.repr >> (4 * p))] != 8) {
+        return 0;
+      }
+      n += ((uint64_t)wuffs_base__pixel_config__plane_width(c, p)) *
+           ((uint64_t)wuffs_base__pixel_config__plane_height(c, p));
+    }
+    return n;
   }
   uint32_t bits_per_pixel =
       wuffs_base__pixel_format__bits_per_pixel(&c->private_impl.pixfmt);
@@ -780,6 +887,16 @@ wuffs_base__pixel_config::height() const {
   return wuffs_base__pixel_config__height(this);
 }
 
+inline uint32_t  //
+wuffs_base__pixel_config::plane_width(uint32_t p) const {
+  return wuffs_base__pixel_config__plane_width(this, p);
+}
+
+inline uint32_t  //
+wuffs_base__pixel_config::plane_height(uint32_t p) const {
+  return wuffs_base__pixel_config__plane_height(this, p);
+}
+
 inline uint64_t  //
 wuffs_base__pixel_config::pixbuf_len() const {
   return wuffs_base__pixel_config__pixbuf_len(this);
@@ -1202,6 +1319,8 @@ typedef struct wuffs_base__pixel_buffer__struct {
   inline wuffs_base__status set_color_u32_fill_rect(
       wuffs_base__rect_ie_u32 rect,
       wuffs_base__color_u32_argb_premul color);
+  inline wuffs_base__status swizzle_planar_from(
+      const struct wuffs_base__pixel_buffer__struct* src);
 #endif  // __cplusplus
 
 } wuffs_base__pixel_buffer;
@@ -1278,8 +1397,31 @@ wuffs_base__pixel_buffer__set_from_slice(wuffs_base__pixel_buffer* pb,
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if (wuffs_base__pixel_format__is_planar(&pixcfg->private_impl.pixfmt)) {
-    // TODO: support planar pixel formats, concious of pixel subsampling.
-    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+    // Split pixbuf_memory into consecutive planes (e.g. Y, Cb and Cr, in
+    // that order, for YCBCR). Each plane is tightly packed.
+    uint64_t len = wuffs_base__pixel_config__pixbuf_len(pixcfg);
+    if (len == 0) {
+      return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+    } else if (len > pixbuf_memory.len) {
+      return wuffs_base__make_status(
+          wuffs_base__error__bad_argument_length_too_short);
+    }
+    uint8_t* ptr = pixbuf_memory.ptr;
+    uint32_t num_planes =
+        wuffs_base__pixel_format__num_planes(&pixcfg->private_impl.pixfmt);
+    uint32_t p;
+    for (p = 0; p < num_planes; p++) {
+      size_t width = wuffs_base__pixel_config__plane_width(pixcfg, p);
+      size_t height = wuffs_base__pixel_config__plane_height(pixcfg, p);
+      wuffs_base__table_u8* tab = &pb->private_impl.planes[p];
+      tab->ptr = ptr;
+      tab->width = width;
+      tab->height = height;
+      tab->stride = width;
+      ptr += width * height;
+    }
+    pb->pixcfg = *pixcfg;
+    return wuffs_base__make_status(NULL);
   }
   uint32_t bits_per_pixel =
       wuffs_base__pixel_format__bits_per_pixel(&pixcfg->private_impl.pixfmt);
@@ -1413,6 +1555,25 @@ wuffs_base__pixel_buffer__set_color_u32_fill_rect(
     wuffs_base__rect_ie_u32 rect,
     wuffs_base__color_u32_argb_premul color);
 
+// wuffs_base__pixel_buffer__swizzle_planar_from converts between planar pixel
+// buffers that have the same pixel format (e.g. YCBCR) and dimensions but
+// possibly different pixel subsampling, such as 4:2:0, 4:2:2 or 4:4:4. Each
+// plane is converted independently: copied if both subsamplings match for
+// that plane, otherwise resampled. Downsampling averages each 2 (or 2×2)
+// block of samples. Upsampling uses the same 3:1 triangle filter that the
+// JPEG decoder uses when converting to RGB.
+//
+// Every plane must have 8 bits per sample and zero bias. Along each axis, the
+// dst and src denominators must be equal or be 1 and 2 (in either order).
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_buffer__swizzle_planar_from(
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__pixel_buffer* src);
+
 #ifdef __cplusplus
 
 inline wuffs_base__status  //
@@ -1478,24 +1639,490 @@ wuffs_base__pixel_buffer::set_color_u32_fill_rect(
   return wuffs_base__pixel_buffer__set_color_u32_fill_rect(this, rect, color);
 }
 
+inline wuffs_base__status  //
+wuffs_base__pixel_buffer::swizzle_planar_from(
+    const struct wuffs_base__pixel_buffer__struct* src) {
+  return wuffs_base__pixel_buffer__swizzle_planar_from(this, src);
+}
+
 #endif  // __cplusplus
 
 // --------
 
+// wuffs_base__color_transform converts RGB pixels from a source color space
+// (described by an ICC profile or by PNG gAMA and cHRM chunks) to sRGB. A
+// zero-valued struct is the identity transform.
+//
+// It works in fixed point, via look-up tables: a per-channel table decodes
+// each 8-bit source sample to 14-bit linear light, a 3x3 matrix converts
+// between the source and sRGB primaries (and white points) and a shared table
+// re-encodes the 14-bit linear light as 8-bit sRGB.
+//
+// It is about 18 KiB in size. Pointers to it, from a decode_frame_options,
+// are borrowed: the color transform needs to outlive any decode_frame calls
+// that use it. It is not modified by those calls, so that the one color
+// transform can be shared by multiple decoders, even on multiple threads.
+typedef struct wuffs_base__color_transform__struct {
+  // Do not access the private_impl's fields directly. There is no API/ABI
+  // compatibility or safety guarantee if you do so.
+  struct {
+    bool is_active;
+    int32_t matrix[9];
+    uint16_t decode_luts[3][256];
+    // The 4 extra bytes let SIMD code look up 4 bytes at a time.
+    uint8_t encode_lut[16384 + 4];
+  } private_impl;
+
+#ifdef __cplusplus
+  inline wuffs_base__status set_from_icc_profile(wuffs_base__slice_u8 icc);
+  inline wuffs_base__status set_from_gama_chrm(uint32_t gama,
+                                               const int32_t* chrm);
+  inline bool is_identity() const;
+  inline wuffs_base__status transform_pixel_buffer(
+      wuffs_base__pixel_buffer* pb) const;
+#endif  // __cplusplus
+
+} wuffs_base__color_transform;
+
+typedef void (*wuffs_base__color_transform__func)(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len);
+
+// wuffs_base__color_transform__set_from_icc_profile sets t to convert from
+// the color space described by an ICC profile. Only RGB "matrix/TRC" profiles
+// are supported: those with rXYZ, gXYZ, bXYZ, rTRC, gTRC and bTRC tags, where
+// each TRC is a "curv" or "para" curve. It returns
+// wuffs_base__error__unsupported_option for other (e.g. grayscale, CMYK or
+// LUT-only) profiles and wuffs_base__error__bad_argument for malformed ones.
+// On error, t is set to the identity transform.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__color_transform__set_from_icc_profile(
+    wuffs_base__color_transform* t,
+    wuffs_base__slice_u8 icc);
+
+// wuffs_base__color_transform__set_from_gama_chrm sets t to convert from the
+// color space described by PNG gAMA and cHRM chunks, as returned by
+// wuffs_base__more_information__metadata_parsed__gama and
+// wuffs_base__more_information__metadata_parsed__chrm. A zero gama means the
+// sRGB transfer function. A NULL chrm means the sRGB primaries and white
+// point. Otherwise, chrm points to 8 values: white_x, white_y, red_x, ...,
+// blue_y.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__color_transform__set_from_gama_chrm(wuffs_base__color_transform* t,
+                                                uint32_t gama,
+                                                const int32_t* chrm);
+
+// wuffs_base__color_transform__is_identity returns whether t is NULL or
+// converts every 8-bit color to itself, in which case applying it can be
+// skipped.
+static inline bool  //
+wuffs_base__color_transform__is_identity(
+    const wuffs_base__color_transform* t) {
+  return !t || !t->private_impl.is_active;
+}
+
+// wuffs_base__color_transform__transform_pixel_buffer applies t, in place, to
+// every pixel of pb. It is for decoders that cannot apply it during
+// decode_frame (see wuffs_base__decode_frame_options__set_color_transform),
+// at the cost of an extra pass over the pixels. The pixel format must be one
+// of BGR, RGB, BGRX, RGBX or BGRA / RGBA (nonpremul or premul).
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__color_transform__transform_pixel_buffer(
+    const wuffs_base__color_transform* t,
+    wuffs_base__pixel_buffer* pb);
+
+#ifdef __cplusplus
+
+inline wuffs_base__status  //
+wuffs_base__color_transform::set_from_icc_profile(wuffs_base__slice_u8 icc) {
+  return wuffs_base__color_transform__set_from_icc_profile(this, icc);
+}
+
+inline wuffs_base__status  //
+wuffs_base__color_transform::set_from_gama_chrm(uint32_t gama,
+                                                const int32_t* chrm) {
+  return wuffs_base__color_transform__set_from_gama_chrm(this, gama, chrm);
+}
+
+inline bool  //
+wuffs_base__color_transform::is_identity() const {
+  return wuffs_base__color_transform__is_identity(this);
+}
+
+inline wuffs_base__status  //
+wuffs_base__color_transform::transform_pixel_buffer(
+    wuffs_base__pixel_buffer* pb) const {
+  return wuffs_base__color_transform__transform_pixel_buffer(this, pb);
+}
+
+#endif  // __cplusplus
+
+// --------
+
+// wuffs_base__pixel_quantizer holds a palette of up to 256 BGRA_NONPREMUL
+// colors, for converting non-indexed pixels to an INDEXED__BGRA_ETC pixel
+// format, and a look-up table (a cache) that maps each 15-bit (5 bits per
+// channel) opaque color to its closest palette entry. A zero-valued struct
+// has no palette.
+//
+// Its palette is either given (wuffs_base__pixel_quantizer__set_palette, such
+// as for a device's fixed palette) or built from an image's colors
+// (wuffs_base__pixel_quantizer__build_palette). Either way, the cache is then
+// precomputed, so that converting each opaque pixel costs just one look-up.
+// Non-opaque pixels fall back to wuffs_base__pixel_palette__closest_element.
+//
+// It is about 33 KiB in size. Pointers to it, from a decode_frame_options or a
+// pixel swizzler, are borrowed: the pixel quantizer needs to outlive any
+// decode_frame calls that use it. It is not modified by those calls, so that
+// the one pixel quantizer can be shared by multiple decoders, even on multiple
+// threads.
+typedef struct wuffs_base__pixel_quantizer__struct {
+  // Do not access the private_impl's fields directly. There is no API/ABI
+  // compatibility or safety guarantee if you do so.
+  struct {
+    uint32_t num_colors;
+    uint8_t palette[WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH];
+    // The 4 extra bytes let SIMD code look up 4 bytes at a time.
+    uint8_t cache[32768 + 4];
+  } private_impl;
+
+#ifdef __cplusplus
+  inline wuffs_base__status set_palette(wuffs_base__slice_u8 palette);
+  inline wuffs_base__status build_palette(const wuffs_base__pixel_buffer* src,
+                                          uint32_t max_colors,
+                                          wuffs_base__slice_u8 workbuf);
+  inline uint32_t num_colors() const;
+  inline wuffs_base__slice_u8 palette();
+#endif  // __cplusplus
+
+} wuffs_base__pixel_quantizer;
+
+// wuffs_base__pixel_quantizer__build_palette_workbuf_len returns the minimum
+// length of the workbuf passed to wuffs_base__pixel_quantizer__build_palette.
+static inline uint64_t  //
+wuffs_base__pixel_quantizer__build_palette_workbuf_len() {
+  return 32768u * 32u;
+}
+
+// wuffs_base__pixel_quantizer__set_palette sets q's palette to palette's
+// BGRA_NONPREMUL colors, whose length must be a positive multiple of 4 and at
+// most 1024, and recomputes q's cache.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_quantizer__set_palette(wuffs_base__pixel_quantizer* q,
+                                         wuffs_base__slice_u8 palette);
+
+// wuffs_base__pixel_quantizer__build_palette sets q's palette to at most
+// max_colors (which must be in [1 ..= 256]) colors that represent src's
+// pixels, and recomputes q's cache.
+//
+// It uses median cut: it builds a histogram of src's 15-bit colors and then
+// repeatedly splits (at the median, along its longest axis) the bounding box
+// that holds the most pixels times that axis' length, like building a k-d
+// tree. Each box's palette color is the average of its pixels. If src has
+// pixels whose alpha is less than 0x80 (and max_colors is at least 2), the
+// last palette entry is transparent black and all other entries are opaque.
+//
+// src can be in any pixel format that a pixel swizzler can convert to
+// BGRA_NONPREMUL. The workbuf's length must be at least what
+// wuffs_base__pixel_quantizer__build_palette_workbuf_len returns. It can be
+// uninitialized memory.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_quantizer__build_palette(
+    wuffs_base__pixel_quantizer* q,
+    const wuffs_base__pixel_buffer* src,
+    uint32_t max_colors,
+    wuffs_base__slice_u8 workbuf);
+
+static inline uint32_t  //
+wuffs_base__pixel_quantizer__num_colors(const wuffs_base__pixel_quantizer* q) {
+  return q ? q->private_impl.num_colors : 0;
+}
+
+// wuffs_base__pixel_quantizer__palette returns q's 1024 byte palette. Entries
+// at or after num_colors are transparent black.
+static inline wuffs_base__slice_u8  //
+wuffs_base__pixel_quantizer__palette(wuffs_base__pixel_quantizer* q) {
+  return q ? wuffs_base__make_slice_u8(
+                 q->private_impl.palette,
+                 WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH)
+           : wuffs_base__empty_slice_u8();
+}
+
+#ifdef __cplusplus
+
+inline wuffs_base__status  //
+wuffs_base__pixel_quantizer::set_palette(wuffs_base__slice_u8 palette) {
+  return wuffs_base__pixel_quantizer__set_palette(this, palette);
+}
+
+inline wuffs_base__status  //
+wuffs_base__pixel_quantizer::build_palette(
+    const wuffs_base__pixel_buffer* src,
+    uint32_t max_colors,
+    wuffs_base__slice_u8 workbuf) {
+  return wuffs_base__pixel_quantizer__build_palette(this, src, max_colors,
+                                                    workbuf);
+}
+
+inline uint32_t  //
+wuffs_base__pixel_quantizer::num_colors() const {
+  return wuffs_base__pixel_quantizer__num_colors(this);
+}
+
+inline wuffs_base__slice_u8  //
+wuffs_base__pixel_quantizer::palette() {
+  return wuffs_base__pixel_quantizer__palette(this);
+}
+
+#endif  // __cplusplus
+
+// --------
+
+// wuffs_base__decode_frame_options holds optional decode_frame arguments. A
+// zero-valued struct (or a NULL pointer) means the default options.
+//
+// The crop rectangle, if non-empty, is the region of interest: the part of
+// the frame (in the destination pixel buffer's coordinate space) that the
+// caller needs. Decoders may then skip work (such as entropy decoding, IDCT
+// or unfiltering, and color conversion) for pixels outside of that region.
+// Such pixels are left in an unspecified state: they may be untouched or
+// may hold partially or even fully decoded values. An empty crop rectangle
+// (the default) means the whole frame. Decoders that do not support cropping
+// simply decode the whole frame.
+//
+// The color transform, if non-NULL, is applied to each pixel as it is
+// converted to the destination pixel format, which costs no extra pass over
+// memory. The std/jpeg and std/png decoders support it, for SRC (not
+// SRC_OVER) blends and for BGR, RGB, BGRX, RGBX and BGRA / RGBA destinations,
+// returning "#base: unsupported pixel swizzler option" otherwise. Planar
+// destinations, which hold YCbCr samples, ignore it. Other decoders also
+// ignore it; see wuffs_base__color_transform__transform_pixel_buffer.
+//
+// The dither mode (and, for error diffusion, its work buffer) applies when
+// the destination pixel format has fewer bits per channel than the source,
+// which is currently only for BGR_565 destinations. The std/png decoder
+// supports it, for SRC blends. It is a quality hint, not a requirement, so
+// it is ignored where unsupported, other than an error diffusion work buffer
+// that is too short being a "#base: bad argument". Error diffusion also
+// applies to INDEXED__BGRA_ETC destinations from non-indexed sources.
+//
+// The pixel quantizer, if non-NULL, supplies the palette (copied to the
+// destination pixel buffer's palette) and the look-up table used when
+// converting non-indexed pixels to an INDEXED__BGRA_ETC destination. The
+// std/png decoder supports it, for SRC blends. Without one, such conversions
+// use the destination pixel buffer's existing palette, searching it in full
+// for every pixel.
 typedef struct wuffs_base__decode_frame_options__struct {
   // Do not access the private_impl's fields directly. There is no API/ABI
   // compatibility or safety guarantee if you do so.
   struct {
-    uint8_t TODO;
+    wuffs_base__rect_ie_u32 crop_rect;
+    const wuffs_base__color_transform* color_transform;
+    wuffs_base__pixel_dither dither;
+    wuffs_base__slice_u8 dither_workbuf;
+    const wuffs_base__pixel_quantizer* quantizer;
   } private_impl;
 
 #ifdef __cplusplus
+  inline wuffs_base__rect_ie_u32 crop_rect() const;
+  inline void set_crop_rect(wuffs_base__rect_ie_u32 r);
+  inline const wuffs_base__color_transform* color_transform() const;
+  inline void set_color_transform(const wuffs_base__color_transform* t);
+  inline wuffs_base__pixel_dither dither() const;
+  inline wuffs_base__slice_u8 dither_workbuf() const;
+  inline void set_dither(wuffs_base__pixel_dither d,
+                         wuffs_base__slice_u8 workbuf);
+  inline const wuffs_base__pixel_quantizer* quantizer() const;
+  inline void set_quantizer(const wuffs_base__pixel_quantizer* q);
 #endif  // __cplusplus
 
 } wuffs_base__decode_frame_options;
 
+static inline wuffs_base__decode_frame_options  //
+wuffs_base__null_decode_frame_options() {
+  wuffs_base__decode_frame_options ret;
+  ret.private_impl.crop_rect = wuffs_base__empty_rect_ie_u32();
+  ret.private_impl.color_transform = NULL;
+  ret.private_impl.dither = WUFFS_BASE__PIXEL_DITHER__NONE;
+  ret.private_impl.dither_workbuf = wuffs_base__empty_slice_u8();
+  ret.private_impl.quantizer = NULL;
+  return ret;
+}
+
+static inline wuffs_base__pixel_dither  //
+wuffs_base__decode_frame_options__dither(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.dither : WUFFS_BASE__PIXEL_DITHER__NONE;
+}
+
+static inline wuffs_base__slice_u8  //
+wuffs_base__decode_frame_options__dither_workbuf(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.dither_workbuf : wuffs_base__empty_slice_u8();
+}
+
+static inline void  //
+wuffs_base__decode_frame_options__set_dither(
+    wuffs_base__decode_frame_options* o,
+    wuffs_base__pixel_dither d,
+    wuffs_base__slice_u8 workbuf) {
+  if (o) {
+    o->private_impl.dither = d;
+    o->private_impl.dither_workbuf = workbuf;
+  }
+}
+
+static inline const wuffs_base__pixel_quantizer*  //
+wuffs_base__decode_frame_options__quantizer(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.quantizer : NULL;
+}
+
+static inline void  //
+wuffs_base__decode_frame_options__set_quantizer(
+    wuffs_base__decode_frame_options* o,
+    const wuffs_base__pixel_quantizer* q) {
+  if (o) {
+    o->private_impl.quantizer = q;
+  }
+}
+
+static inline const wuffs_base__color_transform*  //
+wuffs_base__decode_frame_options__color_transform(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.color_transform : NULL;
+}
+
+static inline void  //
+wuffs_base__decode_frame_options__set_color_transform(
+    wuffs_base__decode_frame_options* o,
+    const wuffs_base__color_transform* t) {
+  if (o) {
+    o->private_impl.color_transform = t;
+  }
+}
+
+static inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options__crop_rect(
+    const wuffs_base__decode_frame_options* o) {
+  return o ? o->private_impl.crop_rect : wuffs_base__empty_rect_ie_u32();
+}
+
+static inline void  //
+wuffs_base__decode_frame_options__set_crop_rect(
+    wuffs_base__decode_frame_options* o,
+    wuffs_base__rect_ie_u32 r) {
+  if (o) {
+    o->private_impl.crop_rect = r;
+  }
+}
+
+// wuffs_base__decode_frame_options__crop_etc return the crop rectangle's
+// fields, zeroing them all if that rectangle is empty.
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__crop_min_incl_x(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && !wuffs_base__rect_ie_u32__is_empty(&o->private_impl.crop_rect))
+             ? o->private_impl.crop_rect.min_incl_x
+             : 0;
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__crop_min_incl_y(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && !wuffs_base__rect_ie_u32__is_empty(&o->private_impl.crop_rect))
+             ? o->private_impl.crop_rect.min_incl_y
+             : 0;
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__crop_max_excl_x(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && !wuffs_base__rect_ie_u32__is_empty(&o->private_impl.crop_rect))
+             ? o->private_impl.crop_rect.max_excl_x
+             : 0;
+}
+
+static inline uint32_t  //
+wuffs_base__decode_frame_options__crop_max_excl_y(
+    const wuffs_base__decode_frame_options* o) {
+  return (o && !wuffs_base__rect_ie_u32__is_empty(&o->private_impl.crop_rect))
+             ? o->private_impl.crop_rect.max_excl_y
+             : 0;
+}
+
 #ifdef __cplusplus
 
+inline wuffs_base__rect_ie_u32  //
+wuffs_base__decode_frame_options::crop_rect() const {
+  return wuffs_base__decode_frame_options__crop_rect(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_crop_rect(wuffs_base__rect_ie_u32 r) {
+  wuffs_base__decode_frame_options__set_crop_rect(this, r);
+}
+
+inline const wuffs_base__color_transform*  //
+wuffs_base__decode_frame_options::color_transform() const {
+  return wuffs_base__decode_frame_options__color_transform(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_color_transform(
+    const wuffs_base__color_transform* t) {
+  wuffs_base__decode_frame_options__set_color_transform(this, t);
+}
+
+inline wuffs_base__pixel_dither  //
+wuffs_base__decode_frame_options::dither() const {
+  return wuffs_base__decode_frame_options__dither(this);
+}
+
+inline wuffs_base__slice_u8  //
+wuffs_base__decode_frame_options::dither_workbuf() const {
+  return wuffs_base__decode_frame_options__dither_workbuf(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_dither(wuffs_base__pixel_dither d,
+                                             wuffs_base__slice_u8 workbuf) {
+  wuffs_base__decode_frame_options__set_dither(this, d, workbuf);
+}
+
+inline const wuffs_base__pixel_quantizer*  //
+wuffs_base__decode_frame_options::quantizer() const {
+  return wuffs_base__decode_frame_options__quantizer(this);
+}
+
+inline void  //
+wuffs_base__decode_frame_options::set_quantizer(
+    const wuffs_base__pixel_quantizer* q) {
+  wuffs_base__decode_frame_options__set_quantizer(this, q);
+}
+
 #endif  // __cplusplus
 
 // --------
@@ -1533,6 +2160,18 @@ typedef uint64_t (*wuffs_base__pixel_swizzler__transparent_black_func)(
     uint64_t num_pixels,
     uint32_t dst_pixfmt_bytes_per_pixel);
 
+typedef void (*wuffs_base__pixel_swizzler__dither_func)(uint8_t* dst_ptr,
+                                                        const uint8_t* src_ptr,
+                                                        size_t num_pixels,
+                                                        uint32_t x,
+                                                        uint32_t y);
+
+typedef bool (*wuffs_base__pixel_swizzler__quantize_func)(
+    const wuffs_base__pixel_quantizer* q,
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels);
+
 typedef struct wuffs_base__pixel_swizzler__struct {
   // Do not access the private_impl's fields directly. There is no API/ABI
   // compatibility or safety guarantee if you do so.
@@ -1541,6 +2180,26 @@ typedef struct wuffs_base__pixel_swizzler__struct {
     wuffs_base__pixel_swizzler__transparent_black_func transparent_black_func;
     uint32_t dst_pixfmt_bytes_per_pixel;
     uint32_t src_pixfmt_bytes_per_pixel;
+    uint32_t dst_pixfmt_repr;
+    wuffs_base__pixel_blend blend;
+    wuffs_base__color_transform__func color_transform_func;
+    const wuffs_base__color_transform* color_transform;
+
+    uint32_t src_pixfmt_repr;
+    wuffs_base__pixel_dither dither;
+    wuffs_base__pixel_swizzler__func dither_wide_func;
+    wuffs_base__pixel_swizzler__dither_func dither_ordered_func;
+    uint8_t* dither_origin_ptr;
+    size_t dither_origin_stride;
+    uint32_t dither_origin_width;
+    uint32_t dither_origin_height;
+    wuffs_base__slice_u8 dither_workbuf;
+
+    wuffs_base__pixel_swizzler__func quantize_wide_func;
+    wuffs_base__pixel_swizzler__quantize_func quantize_cached_func;
+    const wuffs_base__pixel_quantizer* quantizer;
+
+    wuffs_base__pixel_swizzler__func float_wide_func;
   } private_impl;
 
 #ifdef __cplusplus
@@ -1549,10 +2208,29 @@ typedef struct wuffs_base__pixel_swizzler__struct {
                                     wuffs_base__pixel_format src_pixfmt,
                                     wuffs_base__slice_u8 src_palette,
                                     wuffs_base__pixel_blend blend);
+  inline wuffs_base__status set_dither(const wuffs_base__pixel_buffer* dst,
+                                       wuffs_base__pixel_dither dither,
+                                       wuffs_base__slice_u8 workbuf);
+  inline wuffs_base__status set_quantizer(
+      wuffs_base__pixel_buffer* dst,
+      const wuffs_base__pixel_quantizer* q);
+  inline wuffs_base__status set_decode_frame_options(
+      wuffs_base__pixel_buffer* dst,
+      const wuffs_base__decode_frame_options* opts);
   inline uint64_t swizzle_interleaved_from_slice(
       wuffs_base__slice_u8 dst,
       wuffs_base__slice_u8 dst_palette,
       wuffs_base__slice_u8 src) const;
+  inline uint64_t swizzle_interleaved_from_table(
+      wuffs_base__table_u8 dst,
+      wuffs_base__slice_u8 dst_palette,
+      wuffs_base__table_u8 src) const;
+  inline uint64_t swizzle_interleaved_tiles(wuffs_base__table_u8 dst,
+                                            size_t dst_tile_stride,
+                                            wuffs_base__slice_u8 dst_palette,
+                                            wuffs_base__table_u8 src,
+                                            size_t src_tile_stride,
+                                            size_t num_tiles) const;
 #endif  // __cplusplus
 
 } wuffs_base__pixel_swizzler;
@@ -1560,6 +2238,11 @@ typedef struct wuffs_base__pixel_swizzler__struct {
 // wuffs_base__pixel_swizzler__prepare readies the pixel swizzler so that its
 // other methods may be called.
 //
+// A prepared pixel swizzler is a plain value. Until its set_etc methods are
+// called, copying it is equivalent to preparing it again with the same
+// arguments (for non-indexed pixel formats, whose palettes do not matter). See
+// also wuffs_base__pixel_swizzler_cache.
+//
 // For modular builds that divide the base module into sub-modules, using this
 // function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
 // just WUFFS_CONFIG__MODULE__BASE__CORE.
@@ -1571,6 +2254,66 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
                                     wuffs_base__slice_u8 src_palette,
                                     wuffs_base__pixel_blend blend);
 
+// wuffs_base__pixel_swizzler__set_dither configures the prepared pixel
+// swizzler to dither when converting to dst's pixel format, which must be the
+// prepare call's destination pixel format. The swizzle_interleaved_etc
+// methods' dst slices should then point into dst's pixels, so that each
+// pixel's position is known. Other dst slices are dithered as if they started
+// a row, with no diffused error. The workbuf is only used for
+// ERROR_DIFFUSION, and must outlive the swizzler's use.
+//
+// Dithering is only implemented for non-indexed sources and the SRC blend,
+// for BGR_565 destinations and (only ERROR_DIFFUSION) for INDEXED__BGRA_ETC
+// destinations. It is otherwise a no-op, not an error. Calling prepare again
+// resets it.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_dither(wuffs_base__pixel_swizzler* p,
+                                       const wuffs_base__pixel_buffer* dst,
+                                       wuffs_base__pixel_dither dither,
+                                       wuffs_base__slice_u8 workbuf);
+
+// wuffs_base__pixel_swizzler__set_quantizer configures the prepared pixel
+// swizzler, converting from a non-indexed source pixel format to an
+// INDEXED__BGRA_ETC destination pixel format, to use q's palette and cache.
+// q's palette is copied to dst's palette, so the swizzle_interleaved_etc
+// methods' dst_palette arguments should be dst's palette. dst's pixel format
+// must be the prepare call's destination pixel format. A NULL q means to
+// search dst's palette for every pixel, which is the default after prepare.
+//
+// It is a no-op, not an error, if the prepare call did not convert from a
+// non-indexed to an indexed pixel format. Calling prepare again resets it.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_quantizer(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__pixel_quantizer* q);
+
+// wuffs_base__pixel_swizzler__set_decode_frame_options configures the
+// prepared pixel swizzler for opts' color transform (if any), applying it to
+// every converted pixel, for opts' pixel quantizer (see
+// wuffs_base__pixel_swizzler__set_quantizer) and for opts' dither mode (see
+// wuffs_base__pixel_swizzler__set_dither). It returns
+// wuffs_base__error__unsupported_pixel_swizzler_option if that color
+// transform is not the identity and the prepare call's blend or destination
+// pixel format cannot support it. Calling prepare again resets it.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_decode_frame_options(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__decode_frame_options* opts);
+
 // wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice converts pixels
 // from a source format to a destination format.
 //
@@ -1584,6 +2327,50 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src);
 
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_table converts the
+// first min(dst.height, src.height) rows of src to those of dst, like calling
+// wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice once per row but
+// with less per-row overhead. Each row converts min(dst.width / D, src.width /
+// S) pixels, where D and S are the destination and source bytes per pixel. It
+// returns the total number of pixels converted.
+//
+// When both tables' rows are contiguous (their stride equals their width) and
+// the pixel swizzler is not dithering, it converts every row in one pass.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src);
+
+// wuffs_base__pixel_swizzler__swizzle_interleaved_tiles converts num_tiles
+// same-sized tiles, such as many small images or the cells of a sprite sheet,
+// like calling wuffs_base__pixel_swizzler__swizzle_interleaved_from_table once
+// per tile. The i'th tile's tables are dst and src with (i * dst_tile_stride)
+// and (i * src_tile_stride) bytes added to their ptr fields. The caller is
+// responsible for every tile being valid memory. It returns the total number
+// of pixels converted.
+//
+// When every tile's rows, and the tiles themselves, are contiguous and the
+// pixel swizzler is not dithering, it converts every tile in one pass.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_tiles(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    size_t dst_tile_stride,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src,
+    size_t src_tile_stride,
+    size_t num_tiles);
+
 #ifdef __cplusplus
 
 inline wuffs_base__status  //
@@ -1596,6 +2383,28 @@ wuffs_base__pixel_swizzler::prepare(wuffs_base__pixel_format dst_pixfmt,
                                              src_pixfmt, src_palette, blend);
 }
 
+inline wuffs_base__status  //
+wuffs_base__pixel_swizzler::set_dither(const wuffs_base__pixel_buffer* dst,
+                                       wuffs_base__pixel_dither dither,
+                                       wuffs_base__slice_u8 workbuf) {
+  return wuffs_base__pixel_swizzler__set_dither(this, dst, dither, workbuf);
+}
+
+inline wuffs_base__status  //
+wuffs_base__pixel_swizzler::set_quantizer(
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__pixel_quantizer* q) {
+  return wuffs_base__pixel_swizzler__set_quantizer(this, dst, q);
+}
+
+inline wuffs_base__status  //
+wuffs_base__pixel_swizzler::set_decode_frame_options(
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__decode_frame_options* opts) {
+  return wuffs_base__pixel_swizzler__set_decode_frame_options(this, dst,
+                                                              opts);
+}
+
 uint64_t  //
 wuffs_base__pixel_swizzler::swizzle_interleaved_from_slice(
     wuffs_base__slice_u8 dst,
@@ -1605,4 +2414,284 @@ wuffs_base__pixel_swizzler::swizzle_interleaved_from_slice(
       this, dst, dst_palette, src);
 }
 
+uint64_t  //
+wuffs_base__pixel_swizzler::swizzle_interleaved_from_table(
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src) const {
+  return wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+      this, dst, dst_palette, src);
+}
+
+uint64_t  //
+wuffs_base__pixel_swizzler::swizzle_interleaved_tiles(
+    wuffs_base__table_u8 dst,
+    size_t dst_tile_stride,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src,
+    size_t src_tile_stride,
+    size_t num_tiles) const {
+  return wuffs_base__pixel_swizzler__swizzle_interleaved_tiles(
+      this, dst, dst_tile_stride, dst_palette, src, src_tile_stride,
+      num_tiles);
+}
+
+#endif  // __cplusplus
+
+// --------
+
+#define WUFFS_BASE__PIXEL_SWIZZLER_CACHE__NUM_ENTRIES 8
+
+// wuffs_base__pixel_swizzler_cache remembers the most recently prepared pixel
+// swizzlers, keyed by their (non-indexed) destination and source pixel
+// formats and blend. Preparing via the cache for a recently seen key, such as
+// once per image when converting many small images, copies the remembered
+// pixel swizzler instead of searching for its conversion function again. A
+// zero-valued struct is an empty cache.
+//
+// It is not safe to use the one cache from multiple threads concurrently.
+typedef struct wuffs_base__pixel_swizzler_cache__struct {
+  // Do not access the private_impl's fields directly. There is no API/ABI
+  // compatibility or safety guarantee if you do so.
+  struct {
+    uint32_t num_entries;
+    uint32_t next_entry;
+    wuffs_base__pixel_swizzler
+        entries[WUFFS_BASE__PIXEL_SWIZZLER_CACHE__NUM_ENTRIES];
+  } private_impl;
+
+#ifdef __cplusplus
+  inline wuffs_base__status prepare(wuffs_base__pixel_swizzler* p,
+                                    wuffs_base__pixel_format dst_pixfmt,
+                                    wuffs_base__slice_u8 dst_palette,
+                                    wuffs_base__pixel_format src_pixfmt,
+                                    wuffs_base__slice_u8 src_palette,
+                                    wuffs_base__pixel_blend blend);
+#endif  // __cplusplus
+
+} wuffs_base__pixel_swizzler_cache;
+
+// wuffs_base__pixel_swizzler_cache__prepare is like
+// wuffs_base__pixel_swizzler__prepare but first looks for, and afterwards
+// remembers, the prepared pixel swizzler in c. A NULL c means no caching.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler_cache__prepare(wuffs_base__pixel_swizzler_cache* c,
+                                          wuffs_base__pixel_swizzler* p,
+                                          wuffs_base__pixel_format dst_pixfmt,
+                                          wuffs_base__slice_u8 dst_palette,
+                                          wuffs_base__pixel_format src_pixfmt,
+                                          wuffs_base__slice_u8 src_palette,
+                                          wuffs_base__pixel_blend blend);
+
+#ifdef __cplusplus
+
+inline wuffs_base__status  //
+wuffs_base__pixel_swizzler_cache::prepare(wuffs_base__pixel_swizzler* p,
+                                          wuffs_base__pixel_format dst_pixfmt,
+                                          wuffs_base__slice_u8 dst_palette,
+                                          wuffs_base__pixel_format src_pixfmt,
+                                          wuffs_base__slice_u8 src_palette,
+                                          wuffs_base__pixel_blend blend) {
+  return wuffs_base__pixel_swizzler_cache__prepare(
+      this, p, dst_pixfmt, dst_palette, src_pixfmt, src_palette, blend);
+}
+
+#endif  // __cplusplus
+
+// --------
+
+typedef uint8_t wuffs_base__pixel_resampling_filter;
+
+// wuffs_base__pixel_resampling_filter is the kernel used to scale an image,
+// separably (horizontally and then vertically), to different dimensions.
+//
+// BOX averages the source pixels that each destination pixel covers. It is
+// the cheapest filter and is only suitable for downscaling.
+//
+// MITCHELL is the Mitchell-Netravali cubic with B = C = 1/3, a reasonable
+// compromise between blurring and ringing.
+//
+// LANCZOS3 is a windowed sinc with 3 lobes. It is the sharpest but slowest
+// filter and can ring (overshoot) near sharp edges.
+#define WUFFS_BASE__PIXEL_RESAMPLING_FILTER__BOX \
+  ((wuffs_base__pixel_resampling_filter)0)
+#define WUFFS_BASE__PIXEL_RESAMPLING_FILTER__MITCHELL \
+  ((wuffs_base__pixel_resampling_filter)1)
+#define WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3 \
+  ((wuffs_base__pixel_resampling_filter)2)
+
+typedef void (*wuffs_base__pixel_resampler__h_func)(int16_t* dst_ptr,
+                                                    uint32_t dst_width,
+                                                    const uint8_t* src_ptr,
+                                                    const uint32_t* starts,
+                                                    const int16_t* weights,
+                                                    uint32_t num_taps);
+
+typedef void (*wuffs_base__pixel_resampler__v_func)(uint8_t* dst_ptr,
+                                                    size_t dst_len,
+                                                    const int16_t* ring_ptr,
+                                                    size_t ring_stride,
+                                                    uint32_t ring_length,
+                                                    uint32_t ring_index,
+                                                    const int16_t* weights,
+                                                    uint32_t num_taps,
+                                                    bool clamp_to_alpha);
+
+typedef struct wuffs_base__pixel_resampler__struct {
+  // Do not access the private_impl's fields directly. There is no API/ABI
+  // compatibility or safety guarantee if you do so.
+  struct {
+    wuffs_base__pixel_resampler__h_func h_func;
+    wuffs_base__pixel_resampler__v_func v_func;
+    uint32_t pixfmt_repr;
+    uint32_t dst_width;
+    uint32_t dst_height;
+    uint32_t src_width;
+    uint32_t src_height;
+    uint32_t h_num_taps;
+    uint32_t v_num_taps;
+    uint32_t num_src_rows_pushed;
+    uint32_t num_dst_rows_written;
+    uint32_t* h_starts;
+    uint32_t* v_starts;
+    int16_t* h_weights;
+    int16_t* v_weights;
+    int16_t* ring_ptr;
+  } private_impl;
+
+#ifdef __cplusplus
+  inline wuffs_base__status prepare(wuffs_base__pixel_format pixfmt,
+                                    uint32_t dst_width,
+                                    uint32_t dst_height,
+                                    uint32_t src_width,
+                                    uint32_t src_height,
+                                    wuffs_base__pixel_resampling_filter filter,
+                                    wuffs_base__slice_u8 workbuf);
+  inline wuffs_base__status push_src_row(wuffs_base__pixel_buffer* dst,
+                                         wuffs_base__slice_u8 src_row);
+  inline wuffs_base__status resample(wuffs_base__pixel_buffer* dst,
+                                     const wuffs_base__pixel_buffer* src);
+  inline uint32_t num_dst_rows_written() const;
+#endif  // __cplusplus
+
+} wuffs_base__pixel_resampler;
+
+// wuffs_base__pixel_resampler__workbuf_len returns the minimum length of the
+// workbuf passed to wuffs_base__pixel_resampler__prepare. It returns zero if
+// any of the dimensions are zero or if the filter is unsupported.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_resampler__workbuf_len(
+    uint32_t dst_width,
+    uint32_t dst_height,
+    uint32_t src_width,
+    uint32_t src_height,
+    wuffs_base__pixel_resampling_filter filter);
+
+// wuffs_base__pixel_resampler__prepare readies the pixel resampler so that
+// its other methods may be called. Both the source and destination use the
+// same pixfmt, which must be one of:
+//  - WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL
+//  - WUFFS_BASE__PIXEL_FORMAT__BGRX
+//  - WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL
+//  - WUFFS_BASE__PIXEL_FORMAT__RGBX
+//
+// Filtering non-premultiplied alpha is incorrect (transparent pixels' colors
+// would bleed into their neighbors), so callers should swizzle to a premul
+// pixel format first.
+//
+// The workbuf is retained (as pointers into it) until the next prepare call.
+// Its length must be at least what wuffs_base__pixel_resampler__workbuf_len
+// returns. It can be uninitialized memory.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_resampler__prepare(
+    wuffs_base__pixel_resampler* r,
+    wuffs_base__pixel_format pixfmt,
+    uint32_t dst_width,
+    uint32_t dst_height,
+    uint32_t src_width,
+    uint32_t src_height,
+    wuffs_base__pixel_resampling_filter filter,
+    wuffs_base__slice_u8 workbuf);
+
+// wuffs_base__pixel_resampler__push_src_row consumes the next source row (in
+// top-to-bottom order) and writes, to dst's top-left corner, every destination
+// row that no longer depends on any unseen source rows. Only O(taps) rows are
+// buffered, so memory use is bounded by that row window if the caller's rows
+// come from a source that produces them one at a time. Wuffs' own image
+// decoders do not, so wuffs_aux::DecodeImage decodes the whole frame first.
+//
+// src_row.len must be at least (4 * src_width). Pushing more than src_height
+// rows is an error.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_resampler__push_src_row(wuffs_base__pixel_resampler* r,
+                                          wuffs_base__pixel_buffer* dst,
+                                          wuffs_base__slice_u8 src_row);
+
+// wuffs_base__pixel_resampler__resample pushes all of src's rows. src and
+// dst's pixel formats must match the prepared one, and their dimensions must
+// be at least the prepared ones.
+//
+// For modular builds that divide the base module into sub-modules, using this
+// function requires the WUFFS_CONFIG__MODULE__BASE__PIXCONV sub-module, not
+// just WUFFS_CONFIG__MODULE__BASE__CORE.
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_resampler__resample(wuffs_base__pixel_resampler* r,
+                                      wuffs_base__pixel_buffer* dst,
+                                      const wuffs_base__pixel_buffer* src);
+
+static inline uint32_t  //
+wuffs_base__pixel_resampler__num_dst_rows_written(
+    const wuffs_base__pixel_resampler* r) {
+  return r ? r->private_impl.num_dst_rows_written : 0;
+}
+
+#ifdef __cplusplus
+
+inline wuffs_base__status  //
+wuffs_base__pixel_resampler::prepare(
+    wuffs_base__pixel_format pixfmt,
+    uint32_t dst_width,
+    uint32_t dst_height,
+    uint32_t src_width,
+    uint32_t src_height,
+    wuffs_base__pixel_resampling_filter filter,
+    wuffs_base__slice_u8 workbuf) {
+  return wuffs_base__pixel_resampler__prepare(this, pixfmt, dst_width,
+                                              dst_height, src_width,
+                                              src_height, filter, workbuf);
+}
+
+inline wuffs_base__status  //
+wuffs_base__pixel_resampler::push_src_row(wuffs_base__pixel_buffer* dst,
+                                          wuffs_base__slice_u8 src_row) {
+  return wuffs_base__pixel_resampler__push_src_row(this, dst, src_row);
+}
+
+inline wuffs_base__status  //
+wuffs_base__pixel_resampler::resample(wuffs_base__pixel_buffer* dst,
+                                      const wuffs_base__pixel_buffer* src) {
+  return wuffs_base__pixel_resampler__resample(this, dst, src);
+}
+
+inline uint32_t  //
+wuffs_base__pixel_resampler::num_dst_rows_written() const {
+  return wuffs_base__pixel_resampler__num_dst_rows_written(this);
+}
+
 #endif  // __cplusplus
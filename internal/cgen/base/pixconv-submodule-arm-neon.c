@@ -0,0 +1,2054 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// --------
+
+// ‼ WUFFS MULTI-FILE SECTION +arm_neon
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+// wuffs_base__pixel_swizzler__swizzle_ycc__convert_8_arm_neon converts 8
+// pixels from YCbCr to RGB, returning (R, G, B) as the val[0 ..= 2] elements.
+//
+// Unlike the x86_avx2 code, which works in 16-bit lanes, this works in 32-bit
+// lanes and produces exactly the same output as the non-SIMD
+// wuffs_base__color_ycc__as__color_u32 function: 16.16 fixed point arithmetic
+// with a 0x8000 rounding bias, then a saturating narrow for over- and
+// underflow.
+static inline uint8x8x3_t  //
+wuffs_base__pixel_swizzler__swizzle_ycc__convert_8_arm_neon(
+    uint8x8_t yy,
+    uint8x8_t cb,
+    uint8x8_t cr) {
+  const uint8x8_t u80 = vdup_n_u8(0x80);
+  const uint32x4_t u00008000 = vdupq_n_u32(0x8000);
+
+  // yy_lo = u16x4 [yy.0 yy.1 yy.2 yy.3]
+  // cb_lo = i16x4 [cb.0-0x80 cb.1-0x80 cb.2-0x80 cb.3-0x80]
+  //
+  // Ditto for the _hi (elements 4 ..= 7) and the cr_xx Chroma-Red values.
+  uint16x8_t yy16 = vmovl_u8(yy);
+  int16x8_t cb16 = vreinterpretq_s16_u16(vsubl_u8(cb, u80));
+  int16x8_t cr16 = vreinterpretq_s16_u16(vsubl_u8(cr, u80));
+
+  // Work in 16.16 fixed point: ((yy << 16) | 0x8000).
+  int32x4_t yy_lo = vreinterpretq_s32_u32(
+      vorrq_u32(vshll_n_u16(vget_low_u16(yy16), 16), u00008000));
+  int32x4_t yy_hi = vreinterpretq_s32_u32(
+      vorrq_u32(vshll_n_u16(vget_high_u16(yy16), 16), u00008000));
+  int32x4_t cb_lo = vmovl_s16(vget_low_s16(cb16));
+  int32x4_t cb_hi = vmovl_s16(vget_high_s16(cb16));
+  int32x4_t cr_lo = vmovl_s16(vget_low_s16(cr16));
+  int32x4_t cr_hi = vmovl_s16(vget_high_s16(cr16));
+
+  // The formulae (see wuffs_base__color_ycc__as__color_u32):
+  //
+  //  R = Y                + 1.40200 * Cr
+  //  G = Y - 0.34414 * Cb - 0.71414 * Cr
+  //  B = Y + 1.77200 * Cb
+  int32x4_t rr_lo = vmlaq_n_s32(yy_lo, cr_lo, +0x166E9);
+  int32x4_t rr_hi = vmlaq_n_s32(yy_hi, cr_hi, +0x166E9);
+  int32x4_t gg_lo =
+      vmlaq_n_s32(vmlaq_n_s32(yy_lo, cb_lo, -0x0581A), cr_lo, -0x0B6D2);
+  int32x4_t gg_hi =
+      vmlaq_n_s32(vmlaq_n_s32(yy_hi, cb_hi, -0x0581A), cr_hi, -0x0B6D2);
+  int32x4_t bb_lo = vmlaq_n_s32(yy_lo, cb_lo, +0x1C5A2);
+  int32x4_t bb_hi = vmlaq_n_s32(yy_hi, cb_hi, +0x1C5A2);
+
+  // Shift right by 16, saturating (at 0 and 0xFFFF) as we narrow to u16, then
+  // saturate (at 0xFF) as we narrow to u8.
+  uint8x8x3_t ret;
+  ret.val[0] = vqmovn_u16(
+      vcombine_u16(vqshrun_n_s32(rr_lo, 16), vqshrun_n_s32(rr_hi, 16)));
+  ret.val[1] = vqmovn_u16(
+      vcombine_u16(vqshrun_n_s32(gg_lo, 16), vqshrun_n_s32(gg_hi, 16)));
+  ret.val[2] = vqmovn_u16(
+      vcombine_u16(vqshrun_n_s32(bb_lo, 16), vqshrun_n_s32(bb_hi, 16)));
+  return ret;
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  for (; (x + 16u) <= x_end; x += 16u) {
+    uint8x16_t yy = vld1q_u8(up0);
+    uint8x16_t cb = vld1q_u8(up1);
+    uint8x16_t cr = vld1q_u8(up2);
+    uint8x8x3_t lo =
+        wuffs_base__pixel_swizzler__swizzle_ycc__convert_8_arm_neon(
+            vget_low_u8(yy), vget_low_u8(cb), vget_low_u8(cr));
+    uint8x8x3_t hi =
+        wuffs_base__pixel_swizzler__swizzle_ycc__convert_8_arm_neon(
+            vget_high_u8(yy), vget_high_u8(cb), vget_high_u8(cr));
+
+    // Interleave as B, G, R, 0xFF.
+    uint8x16x4_t bgrx;
+    bgrx.val[0] = vcombine_u8(lo.val[2], hi.val[2]);
+    bgrx.val[1] = vcombine_u8(lo.val[1], hi.val[1]);
+    bgrx.val[2] = vcombine_u8(lo.val[0], hi.val[0]);
+    bgrx.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(dst_iter, bgrx);
+
+    dst_iter += 64u;
+    up0 += 16u;
+    up1 += 16u;
+    up2 += 16u;
+  }
+
+  if (x < x_end) {
+    wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx(  //
+        dst, x, x_end, y, up0, up1, up2);
+  }
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  for (; (x + 16u) <= x_end; x += 16u) {
+    uint8x16_t yy = vld1q_u8(up0);
+    uint8x16_t cb = vld1q_u8(up1);
+    uint8x16_t cr = vld1q_u8(up2);
+    uint8x8x3_t lo =
+        wuffs_base__pixel_swizzler__swizzle_ycc__convert_8_arm_neon(
+            vget_low_u8(yy), vget_low_u8(cb), vget_low_u8(cr));
+    uint8x8x3_t hi =
+        wuffs_base__pixel_swizzler__swizzle_ycc__convert_8_arm_neon(
+            vget_high_u8(yy), vget_high_u8(cb), vget_high_u8(cr));
+
+    // Interleave as R, G, B, 0xFF.
+    uint8x16x4_t rgbx;
+    rgbx.val[0] = vcombine_u8(lo.val[0], hi.val[0]);
+    rgbx.val[1] = vcombine_u8(lo.val[1], hi.val[1]);
+    rgbx.val[2] = vcombine_u8(lo.val[2], hi.val[2]);
+    rgbx.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(dst_iter, rgbx);
+
+    dst_iter += 64u;
+    up0 += 16u;
+    up1 += 16u;
+    up2 += 16u;
+  }
+
+  if (x < x_end) {
+    wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx(  //
+        dst, x, x_end, y, up0, up1, up2);
+  }
+}
+
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v2_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp_major = src_ptr_major;
+  const uint8_t* sp_minor = src_ptr_minor;
+
+  if (first_column) {
+    src_len--;
+    if ((src_len <= 0u) && last_column) {
+      uint32_t sv = (12u * ((uint32_t)(*sp_major++))) +  //
+                    (4u * ((uint32_t)(*sp_minor++)));
+      *dp++ = (uint8_t)((sv + 8u) >> 4u);
+      *dp++ = (uint8_t)((sv + 7u) >> 4u);
+      return dst_ptr;
+    }
+
+    uint32_t sv_major_m1 = sp_major[-0];  // Clamp offset to zero.
+    uint32_t sv_minor_m1 = sp_minor[-0];  // Clamp offset to zero.
+    uint32_t sv_major_p1 = sp_major[+1];
+    uint32_t sv_minor_p1 = sp_minor[+1];
+
+    uint32_t sv = (9u * ((uint32_t)(*sp_major++))) +  //
+                  (3u * ((uint32_t)(*sp_minor++)));
+    *dp++ = (uint8_t)((sv + (3u * sv_major_m1) + (sv_minor_m1) + 8u) >> 4u);
+    *dp++ = (uint8_t)((sv + (3u * sv_major_p1) + (sv_minor_p1) + 7u) >> 4u);
+    if (src_len <= 0u) {
+      return dst_ptr;
+    }
+  }
+
+  if (last_column) {
+    src_len--;
+  }
+
+  if (src_len < 16) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    for (; src_len > 0u; src_len--) {
+      uint32_t sv_major_m1 = sp_major[-1];
+      uint32_t sv_minor_m1 = sp_minor[-1];
+      uint32_t sv_major_p1 = sp_major[+1];
+      uint32_t sv_minor_p1 = sp_minor[+1];
+
+      uint32_t sv = (9u * ((uint32_t)(*sp_major++))) +  //
+                    (3u * ((uint32_t)(*sp_minor++)));
+      *dp++ = (uint8_t)((sv + (3u * sv_major_m1) + (sv_minor_m1) + 8u) >> 4u);
+      *dp++ = (uint8_t)((sv + (3u * sv_major_p1) + (sv_minor_p1) + 7u) >> 4u);
+    }
+
+  } else {
+    const uint8x8_t k3 = vdup_n_u8(3);
+    const uint8x8_t k9 = vdup_n_u8(9);
+    const uint16x8_t k7 = vdupq_n_u16(7);
+
+    while (src_len > 0u) {
+      // Load 1+16+1 samples (six u8x16 vectors) from the major (jxx) and minor
+      // (nxx) rows.
+      //
+      // major_p0 = [j00 j01 j02 j03 .. j12 j13 j14 j15]   // p0 = "plus  0"
+      // major_m1 = [jm1 j00 j01 j02 .. j11 j12 j13 j14]   // m1 = "minus 1"
+      // major_p1 = [j01 j02 j03 j04 .. j13 j14 j15 j16]   // p1 = "plus  1"
+      //
+      // Ditto for the minor_xx vectors.
+      uint8x16_t major_p0 = vld1q_u8(sp_major + 0);
+      uint8x16_t minor_p0 = vld1q_u8(sp_minor + 0);
+      uint8x16_t major_m1 = vld1q_u8(sp_major - 1);
+      uint8x16_t minor_m1 = vld1q_u8(sp_minor - 1);
+      uint8x16_t major_p1 = vld1q_u8(sp_major + 1);
+      uint8x16_t minor_p1 = vld1q_u8(sp_minor + 1);
+
+      // Widening multiply-adds, producing u16x8 vectors.
+      //
+      // sum_p0_lo = [9*j00+3*n00 9*j01+3*n01 .. 9*j07+3*n07]
+      // sum_m1_lo = [3*jm1+1*nm1 3*j00+1*n00 .. 3*j06+1*n06]
+      // sum_p1_lo = [3*j01+1*n01 3*j02+1*n02 .. 3*j08+1*n08]
+      //
+      // Ditto for the _hi (columns 8 ..= 15) vectors.
+      uint16x8_t sum_p0_lo = vmlal_u8(vmull_u8(vget_low_u8(major_p0), k9),
+                                      vget_low_u8(minor_p0), k3);
+      uint16x8_t sum_p0_hi = vmlal_u8(vmull_u8(vget_high_u8(major_p0), k9),
+                                      vget_high_u8(minor_p0), k3);
+      uint16x8_t sum_m1_lo = vmlal_u8(vmovl_u8(vget_low_u8(minor_m1)),
+                                      vget_low_u8(major_m1), k3);
+      uint16x8_t sum_m1_hi = vmlal_u8(vmovl_u8(vget_high_u8(minor_m1)),
+                                      vget_high_u8(major_m1), k3);
+      uint16x8_t sum_p1_lo = vmlal_u8(vmovl_u8(vget_low_u8(minor_p1)),
+                                      vget_low_u8(major_p1), k3);
+      uint16x8_t sum_p1_hi = vmlal_u8(vmovl_u8(vget_high_u8(minor_p1)),
+                                      vget_high_u8(major_p1), k3);
+
+      // Bias by 8 (on the left, via a rounding shift) or 7 (on the right) and
+      // then divide by 16 (which is 9+3+3+1) to get a weighted average. The
+      // even (left) and odd (right) destination samples are interleaved by
+      // the vst2q_u8 store.
+      uint8x16x2_t d;
+      d.val[0] = vcombine_u8(vrshrn_n_u16(vaddq_u16(sum_p0_lo, sum_m1_lo), 4),
+                             vrshrn_n_u16(vaddq_u16(sum_p0_hi, sum_m1_hi), 4));
+      d.val[1] = vcombine_u8(
+          vshrn_n_u16(vaddq_u16(vaddq_u16(sum_p0_lo, sum_p1_lo), k7), 4),
+          vshrn_n_u16(vaddq_u16(vaddq_u16(sum_p0_hi, sum_p1_hi), k7), 4));
+      vst2q_u8(dp, d);
+
+      // Advance by up to 16 source samples (32 destination samples). The first
+      // iteration might be smaller than 16 so that all of the remaining steps
+      // are exactly 16.
+      size_t n = 16u - (15u & (0u - src_len));
+      dp += 2u * n;
+      sp_major += n;
+      sp_minor += n;
+      src_len -= n;
+    }
+  }
+
+  if (last_column) {
+    uint32_t sv_major_m1 = sp_major[-1];
+    uint32_t sv_minor_m1 = sp_minor[-1];
+    uint32_t sv_major_p1 = sp_major[+0];  // Clamp offset to zero.
+    uint32_t sv_minor_p1 = sp_minor[+0];  // Clamp offset to zero.
+
+    uint32_t sv = (9u * ((uint32_t)(*sp_major++))) +  //
+                  (3u * ((uint32_t)(*sp_minor++)));
+    *dp++ = (uint8_t)((sv + (3u * sv_major_m1) + (sv_minor_m1) + 8u) >> 4u);
+    *dp++ = (uint8_t)((sv + (3u * sv_major_p1) + (sv_minor_p1) + 7u) >> 4u);
+  }
+
+  return dst_ptr;
+}
+
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp_major = src_ptr_major;
+  const uint8_t* sp_minor = src_ptr_minor;
+
+  if (src_len < 16) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      *dp++ = (uint8_t)(((3u * ((uint32_t)(*sp_major++))) +  //
+                         (1u * ((uint32_t)(*sp_minor++))) +  //
+                         h1v2_bias) >>
+                        2u);
+    }
+    return dst_ptr;
+  }
+
+  const uint8x8_t k3 = vdup_n_u8(3);
+  const uint16x8_t bias = vdupq_n_u16((uint16_t)h1v2_bias);
+
+  while (src_len > 0u) {
+    uint8x16_t major = vld1q_u8(sp_major);
+    uint8x16_t minor = vld1q_u8(sp_minor);
+
+    // Widening multiply-adds: (3*major + 1*minor + bias) as u16x8 vectors,
+    // then divide by 4 (which is 3+1).
+    uint16x8_t sum_lo = vmlal_u8(vaddq_u16(vmovl_u8(vget_low_u8(minor)), bias),
+                                 vget_low_u8(major), k3);
+    uint16x8_t sum_hi = vmlal_u8(vaddq_u16(vmovl_u8(vget_high_u8(minor)), bias),
+                                 vget_high_u8(major), k3);
+    vst1q_u8(dp, vcombine_u8(vshrn_n_u16(sum_lo, 2), vshrn_n_u16(sum_hi, 2)));
+
+    // Advance by up to 16 samples. The first iteration might be smaller than
+    // 16 so that all of the remaining steps are exactly 16.
+    size_t n = 16u - (15u & (0u - src_len));
+    dp += n;
+    sp_major += n;
+    sp_minor += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (first_column) {
+    src_len--;
+    if ((src_len <= 0u) && last_column) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+      return dst_ptr;
+    }
+    uint32_t svp1 = sp[+1];
+    uint8_t sv = *sp++;
+    *dp++ = sv;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svp1 + 2u) >> 2u);
+    if (src_len <= 0u) {
+      return dst_ptr;
+    }
+  }
+
+  if (last_column) {
+    src_len--;
+  }
+
+  if (src_len < 16) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    for (; src_len > 0u; src_len--) {
+      uint32_t svm1 = sp[-1];
+      uint32_t svp1 = sp[+1];
+      uint32_t sv3 = 3u * (uint32_t)(*sp++);
+      *dp++ = (uint8_t)((sv3 + svm1 + 1u) >> 2u);
+      *dp++ = (uint8_t)((sv3 + svp1 + 2u) >> 2u);
+    }
+
+  } else {
+    const uint8x8_t k3 = vdup_n_u8(3);
+    const uint16x8_t k1 = vdupq_n_u16(1);
+
+    while (src_len > 0u) {
+      // Load 1+16+1 samples (three u8x16 vectors).
+      //
+      // p0 = [s00 s01 s02 s03 .. s12 s13 s14 s15]   // p0 = "plus  0"
+      // m1 = [sm1 s00 s01 s02 .. s11 s12 s13 s14]   // m1 = "minus 1"
+      // p1 = [s01 s02 s03 s04 .. s13 s14 s15 s16]   // p1 = "plus  1"
+      uint8x16_t p0 = vld1q_u8(sp + 0);
+      uint8x16_t m1 = vld1q_u8(sp - 1);
+      uint8x16_t p1 = vld1q_u8(sp + 1);
+
+      // Widening multiply-adds, producing u16x8 vectors.
+      //
+      // sum_m1_lo = [3*s00+1*sm1 3*s01+1*s00 .. 3*s07+1*s06]
+      // sum_p1_lo = [3*s00+1*s01 3*s01+1*s02 .. 3*s07+1*s08]
+      //
+      // Ditto for the _hi (columns 8 ..= 15) vectors.
+      uint16x8_t sum_m1_lo =
+          vmlal_u8(vmovl_u8(vget_low_u8(m1)), vget_low_u8(p0), k3);
+      uint16x8_t sum_m1_hi =
+          vmlal_u8(vmovl_u8(vget_high_u8(m1)), vget_high_u8(p0), k3);
+      uint16x8_t sum_p1_lo =
+          vmlal_u8(vmovl_u8(vget_low_u8(p1)), vget_low_u8(p0), k3);
+      uint16x8_t sum_p1_hi =
+          vmlal_u8(vmovl_u8(vget_high_u8(p1)), vget_high_u8(p0), k3);
+
+      // Bias by 1 (on the left) or 2 (on the right, via a rounding shift) and
+      // then divide by 4 (which is 3+1). The even (left) and odd (right)
+      // destination samples are interleaved by the vst2q_u8 store.
+      uint8x16x2_t d;
+      d.val[0] = vcombine_u8(vshrn_n_u16(vaddq_u16(sum_m1_lo, k1), 2),
+                             vshrn_n_u16(vaddq_u16(sum_m1_hi, k1), 2));
+      d.val[1] = vcombine_u8(vrshrn_n_u16(sum_p1_lo, 2),
+                             vrshrn_n_u16(sum_p1_hi, 2));
+      vst2q_u8(dp, d);
+
+      // Advance by up to 16 source samples (32 destination samples). The first
+      // iteration might be smaller than 16 so that all of the remaining steps
+      // are exactly 16.
+      size_t n = 16u - (15u & (0u - src_len));
+      dp += 2u * n;
+      sp += n;
+      src_len -= n;
+    }
+  }
+
+  if (last_column) {
+    uint32_t svm1 = sp[-1];
+    uint8_t sv = *sp++;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svm1 + 1u) >> 2u);
+    *dp++ = sv;
+  }
+
+  return dst_ptr;
+}
+
+// wuffs_base__pixel_swizzler__swizzle_cmyk__mul_div255_arm_neon returns ((c *
+// w) + 0x7F) / 0xFF, element-wise. For every u16 product p, that's ((p + ((p +
+// 0x80) >> 8) + 0x80) >> 8): a rounding shift and a rounding add-and-narrow.
+static inline uint8x16_t  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__mul_div255_arm_neon(uint8x16_t c,
+                                                              uint8x16_t w) {
+  uint16x8_t p_lo = vmull_u8(vget_low_u8(c), vget_low_u8(w));
+  uint16x8_t p_hi = vmull_u8(vget_high_u8(c), vget_high_u8(w));
+  return vcombine_u8(vraddhn_u16(p_lo, vrshrq_n_u16(p_lo, 8)),
+                     vraddhn_u16(p_hi, vrshrq_n_u16(p_hi, 8)));
+}
+
+// wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_arm_neon is like
+// wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k but processes 16 pixels
+// (64 bytes) at a time.
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_arm_neon(uint8_t* dst_iter,
+                                                           const uint8_t* up3,
+                                                           size_t n,
+                                                           bool invert) {
+  const uint8x16_t inv = vdupq_n_u8(invert ? 0xFF : 0x00);
+  const uint8x16_t alpha = vdupq_n_u8(0xFF);
+
+  for (; n >= 16u; n -= 16u) {
+    uint8x16x4_t c = vld4q_u8(dst_iter);
+    uint8x16_t w = vld1q_u8(up3);
+    c.val[0] = wuffs_base__pixel_swizzler__swizzle_cmyk__mul_div255_arm_neon(
+        veorq_u8(c.val[0], inv), w);
+    c.val[1] = wuffs_base__pixel_swizzler__swizzle_cmyk__mul_div255_arm_neon(
+        veorq_u8(c.val[1], inv), w);
+    c.val[2] = wuffs_base__pixel_swizzler__swizzle_cmyk__mul_div255_arm_neon(
+        veorq_u8(c.val[2], inv), w);
+    c.val[3] = alpha;
+    vst4q_u8(dst_iter, c);
+
+    dst_iter += 64u;
+    up3 += 16u;
+  }
+
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k(dst_iter, up3, n, invert);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_bgrx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_arm_neon(
+      dst_iter, up3, x_end - x, false);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_rgbx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_arm_neon(
+      dst_iter, up3, x_end - x, false);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx_arm_neon(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_arm_neon(
+      dst_iter, up3, x_end - x, true);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx_arm_neon(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_arm_neon(
+      dst_iter, up3, x_end - x, true);
+}
+
+// --------
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__arm_neon(uint8_t* dst_ptr,
+                                                     size_t dst_len,
+                                                     uint8_t* dst_palette_ptr,
+                                                     size_t dst_palette_len,
+                                                     const uint8_t* src_ptr,
+                                                     size_t src_len) {
+  size_t len = (dst_len < src_len ? dst_len : src_len) / 4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x4_t x = vld4q_u8(s);
+    uint8x16_t x0 = x.val[0];
+    x.val[0] = x.val[2];
+    x.val[2] = x0;
+    vst4q_u8(d, x);
+
+    s += 16 * 4;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n--) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s2;
+    d[1] = s1;
+    d[2] = s0;
+    d[3] = s3;
+    s += 4;
+    d += 4;
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__y__arm_neon(uint8_t* dst_ptr,
+                                              size_t dst_len,
+                                              uint8_t* dst_palette_ptr,
+                                              size_t dst_palette_len,
+                                              const uint8_t* src_ptr,
+                                              size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  uint8x16x4_t x;
+  x.val[3] = vdupq_n_u8(0xFF);
+
+  while (n >= 16) {
+    uint8x16_t y = vld1q_u8(s);
+    x.val[0] = y;
+    x.val[1] = y;
+    x.val[2] = y;
+    vst4q_u8(d, x);
+
+    s += 16 * 1;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), 0xFF000000 | (0x010101 * (uint32_t)s[0]));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr__arm_neon(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  uint8x16x4_t x;
+  x.val[3] = vdupq_n_u8(0xFF);
+
+  while (n >= 16) {
+    uint8x16x3_t bgr = vld3q_u8(s);
+    x.val[0] = bgr.val[0];
+    x.val[1] = bgr.val[1];
+    x.val[2] = bgr.val[2];
+    vst4q_u8(d, x);
+
+    s += 16 * 3;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s + (0 * 3)));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgrx__arm_neon(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  const uint8x16_t or_ff = vreinterpretq_u8_u32(vdupq_n_u32(0xFF000000));
+
+  while (n >= 4) {
+    vst1q_u8(d, vorrq_u8(vld1q_u8(s), or_ff));
+
+    s += 4 * 4;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb__arm_neon(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  uint8x16x4_t x;
+  x.val[3] = vdupq_n_u8(0xFF);
+
+  while (n >= 16) {
+    uint8x16x3_t rgb = vld3q_u8(s);
+    x.val[0] = rgb.val[2];
+    x.val[1] = rgb.val[1];
+    x.val[2] = rgb.val[0];
+    vst4q_u8(d, x);
+
+    s += 16 * 3;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgbx__arm_neon(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 16) {
+    uint8x16x4_t x = vld4q_u8(s);
+    uint8x16_t x0 = x.val[0];
+    x.val[0] = x.val[2];
+    x.val[2] = x0;
+    x.val[3] = vdupq_n_u8(0xFF);
+    vst4q_u8(d, x);
+
+    s += 16 * 4;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__premul_8_arm_neon multiplies 8 color values by
+// 8 alpha values, producing exactly the same output as the non-SIMD
+// wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul function.
+//
+// That function computes ((((c * 0x101) * (a * 0x101)) / 0xFFFF) >> 8) for
+// each color channel c. For all 8-bit c and a, that equals (((c * a) *
+// 0x8101) >> 23).
+static inline uint8x8_t  //
+wuffs_base__pixel_swizzler__premul_8_arm_neon(uint8x8_t c, uint8x8_t a) {
+  uint16x8_t p = vmull_u8(c, a);
+  uint32x4_t p_lo = vmull_n_u16(vget_low_u16(p), 0x8101);
+  uint32x4_t p_hi = vmull_n_u16(vget_high_u16(p), 0x8101);
+  return vshrn_n_u16(
+      vcombine_u16(vshrn_n_u32(p_lo, 16), vshrn_n_u32(p_hi, 16)), 7);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(s);
+    x.val[0] =
+        wuffs_base__pixel_swizzler__premul_8_arm_neon(x.val[0], x.val[3]);
+    x.val[1] =
+        wuffs_base__pixel_swizzler__premul_8_arm_neon(x.val[1], x.val[3]);
+    x.val[2] =
+        wuffs_base__pixel_swizzler__premul_8_arm_neon(x.val[2], x.val[3]);
+    vst4_u8(d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(s);
+    uint8x8x4_t y;
+    y.val[0] =
+        wuffs_base__pixel_swizzler__premul_8_arm_neon(x.val[2], x.val[3]);
+    y.val[1] =
+        wuffs_base__pixel_swizzler__premul_8_arm_neon(x.val[1], x.val[3]);
+    y.val[2] =
+        wuffs_base__pixel_swizzler__premul_8_arm_neon(x.val[0], x.val[3]);
+    y.val[3] = x.val[3];
+    vst4_u8(d, y);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] = vshrn_n_u16(x.val[0], 8);
+    y.val[1] = vshrn_n_u16(x.val[1], 8);
+    y.val[2] = vshrn_n_u16(x.val[2], 8);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] = vshrn_n_u16(x.val[2], 8);
+    y.val[1] = vshrn_n_u16(x.val[1], 8);
+    y.val[2] = vshrn_n_u16(x.val[0], 8);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32__swap_u32_argb_abgr(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+  return len;
+}
+
+// wuffs_base__pixel_swizzler__premul_4x16le_arm_neon multiplies 8 16-bit
+// color values by 8 16-bit alpha values, narrowing to 8 bits, producing
+// exactly the same output as the non-SIMD
+// wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul function.
+//
+// That function computes (((c * a) / 0xFFFF) >> 8) for each color channel c.
+// For all (c * a) products p, which fit in 32 bits, dividing by 0xFFFF equals
+// ((p + (p >> 16) + 1) >> 16), which also doesn't overflow.
+static inline uint8x8_t  //
+wuffs_base__pixel_swizzler__premul_4x16le_arm_neon(uint16x8_t c,
+                                                   uint16x8_t a) {
+  const uint32x4_t ones = vdupq_n_u32(1);
+  uint32x4_t p_lo = vmull_u16(vget_low_u16(c), vget_low_u16(a));
+  uint32x4_t p_hi = vmull_u16(vget_high_u16(c), vget_high_u16(a));
+  p_lo = vaddq_u32(vsraq_n_u32(p_lo, p_lo, 16), ones);
+  p_hi = vaddq_u32(vsraq_n_u32(p_hi, p_hi, 16), ones);
+  return vshrn_n_u16(
+      vcombine_u16(vshrn_n_u32(p_lo, 16), vshrn_n_u32(p_hi, 16)), 8);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] =
+        wuffs_base__pixel_swizzler__premul_4x16le_arm_neon(x.val[0], x.val[3]);
+    y.val[1] =
+        wuffs_base__pixel_swizzler__premul_4x16le_arm_neon(x.val[1], x.val[3]);
+    y.val[2] =
+        wuffs_base__pixel_swizzler__premul_4x16le_arm_neon(x.val[2], x.val[3]);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint8x8x4_t y;
+    y.val[0] =
+        wuffs_base__pixel_swizzler__premul_4x16le_arm_neon(x.val[2], x.val[3]);
+    y.val[1] =
+        wuffs_base__pixel_swizzler__premul_4x16le_arm_neon(x.val[1], x.val[3]);
+    y.val[2] =
+        wuffs_base__pixel_swizzler__premul_4x16le_arm_neon(x.val[0], x.val[3]);
+    y.val[3] = vshrn_n_u16(x.val[3], 8);
+    vst4_u8(d, y);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+                s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// wuffs_base__pixel_swizzler__premul_16x16_arm_neon is like
+// wuffs_base__pixel_swizzler__premul_4x16le_arm_neon but without narrowing
+// to 8 bits, producing exactly the same output as the non-SIMD
+// wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul function.
+static inline uint16x8_t  //
+wuffs_base__pixel_swizzler__premul_16x16_arm_neon(uint16x8_t c,
+                                                  uint16x8_t a) {
+  const uint32x4_t ones = vdupq_n_u32(1);
+  uint32x4_t p_lo = vmull_u16(vget_low_u16(c), vget_low_u16(a));
+  uint32x4_t p_hi = vmull_u16(vget_high_u16(c), vget_high_u16(a));
+  p_lo = vaddq_u32(vsraq_n_u32(p_lo, p_lo, 16), ones);
+  p_hi = vaddq_u32(vsraq_n_u32(p_hi, p_hi, 16), ones);
+  return vcombine_u16(vshrn_n_u32(p_lo, 16), vshrn_n_u32(p_hi, 16));
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(s);
+    uint16x8_t a = vmulq_n_u16(vmovl_u8(x.val[3]), 0x101);
+    uint16x8x4_t y;
+    y.val[0] = wuffs_base__pixel_swizzler__premul_16x16_arm_neon(
+        vmulq_n_u16(vmovl_u8(x.val[0]), 0x101), a);
+    y.val[1] = wuffs_base__pixel_swizzler__premul_16x16_arm_neon(
+        vmulq_n_u16(vmovl_u8(x.val[1]), 0x101), a);
+    y.val[2] = wuffs_base__pixel_swizzler__premul_16x16_arm_neon(
+        vmulq_n_u16(vmovl_u8(x.val[2]), 0x101), a);
+    y.val[3] = a;
+    vst4q_u16((uint16_t*)(void*)d, y);
+
+    s += 8 * 4;
+    d += 8 * 8;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint16x8x4_t y;
+    y.val[0] =
+        wuffs_base__pixel_swizzler__premul_16x16_arm_neon(x.val[0], x.val[3]);
+    y.val[1] =
+        wuffs_base__pixel_swizzler__premul_16x16_arm_neon(x.val[1], x.val[3]);
+    y.val[2] =
+        wuffs_base__pixel_swizzler__premul_16x16_arm_neon(x.val[2], x.val[3]);
+    y.val[3] = x.val[3];
+    vst4q_u16((uint16_t*)(void*)d, y);
+
+    s += 8 * 8;
+    d += 8 * 8;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 8;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(s);
+    uint16x8_t a = vmulq_n_u16(vmovl_u8(x.val[3]), 0x101);
+    uint16x8x4_t y;
+    y.val[0] = wuffs_base__pixel_swizzler__premul_16x16_arm_neon(
+        vmulq_n_u16(vmovl_u8(x.val[2]), 0x101), a);
+    y.val[1] = wuffs_base__pixel_swizzler__premul_16x16_arm_neon(
+        vmulq_n_u16(vmovl_u8(x.val[1]), 0x101), a);
+    y.val[2] = wuffs_base__pixel_swizzler__premul_16x16_arm_neon(
+        vmulq_n_u16(vmovl_u8(x.val[0]), 0x101), a);
+    y.val[3] = a;
+    vst4q_u16((uint16_t*)(void*)d, y);
+
+    s += 8 * 4;
+    d += 8 * 8;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 =
+        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint16x8x4_t x = vld4q_u16((const uint16_t*)(const void*)s);
+    uint16x8x4_t y;
+    y.val[0] =
+        wuffs_base__pixel_swizzler__premul_16x16_arm_neon(x.val[2], x.val[3]);
+    y.val[1] =
+        wuffs_base__pixel_swizzler__premul_16x16_arm_neon(x.val[1], x.val[3]);
+    y.val[2] =
+        wuffs_base__pixel_swizzler__premul_16x16_arm_neon(x.val[0], x.val[3]);
+    y.val[3] = x.val[3];
+    vst4q_u16((uint16_t*)(void*)d, y);
+
+    s += 8 * 8;
+    d += 8 * 8;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__swap_u64_argb_abgr(
+        wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 8;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__src_over_premul_8_arm_neon composites 8 BGRA
+// src pixels over 8 premultiplied BGRA dst pixels, producing exactly the same
+// output as the non-SIMD wuffs_base__composite_premul_nonpremul_u32_axxx
+// function (or, if src_premul, wuffs_base__composite_premul_premul_u32_axxx).
+//
+// See wuffs_base__pixel_swizzler__src_over_premul_8_x86_avx2 for the math.
+static inline uint8x8x4_t  //
+wuffs_base__pixel_swizzler__src_over_premul_8_arm_neon(uint8x8x4_t d,
+                                                       uint8x8x4_t s,
+                                                       bool src_premul) {
+  uint8x8_t all_ff = vdup_n_u8(0xFF);
+  uint8x8_t ia = vmvn_u8(s.val[3]);
+  uint8x8_t m = src_premul ? all_ff : s.val[3];
+
+  uint8x8x4_t o;
+  int i;
+  for (i = 0; i < 4; i++) {
+    uint16x8_t x = vmlal_u8(vmull_u8(s.val[i], (i < 3) ? m : all_ff),  //
+                            d.val[i], ia);
+    uint32x4_t x_lo = vmull_n_u16(vget_low_u16(x), 0x8101);
+    uint32x4_t x_hi = vmull_n_u16(vget_high_u16(x), 0x8101);
+    o.val[i] = vshrn_n_u16(
+        vcombine_u16(vshrn_n_u32(x_lo, 16), vshrn_n_u32(x_hi, 16)), 7);
+  }
+  return o;
+}
+
+// wuffs_base__pixel_swizzler__div255_u32_arm_neon divides each 32-bit element
+// by 0xFF, rounding down. For all 32-bit x, that equals ((x * 0x80808081) >>
+// 39), where the product is computed in 64 bits.
+static inline uint32x4_t  //
+wuffs_base__pixel_swizzler__div255_u32_arm_neon(uint32x4_t x) {
+  uint32x2_t m = vdup_n_u32(0x80808081);
+  uint64x2_t x_lo = vmull_u32(vget_low_u32(x), m);
+  uint64x2_t x_hi = vmull_u32(vget_high_u32(x), m);
+  return vshrq_n_u32(
+      vcombine_u32(vshrn_n_u64(x_lo, 32), vshrn_n_u64(x_hi, 32)), 7);
+}
+
+// wuffs_base__pixel_swizzler__src_over_nonpremul_4_arm_neon composites 4 BGRA
+// nonpremul src pixels over 4 nonpremul dst pixels, apart from the (da == 0)
+// special case. Each 16-bit element holds an 8-bit channel value.
+//
+// See wuffs_base__pixel_swizzler__src_over_nonpremul_8_x86_avx2 for the math.
+// The final division uses a refined reciprocal estimate instead of a divide
+// instruction, which 32-bit ARM lacks, but is likewise corrected to be exact.
+static inline uint16x4x4_t  //
+wuffs_base__pixel_swizzler__src_over_nonpremul_4_arm_neon(uint16x4x4_t d,
+                                                          uint16x4x4_t s) {
+  uint32x4_t sa = vmovl_u16(s.val[3]);
+  uint32x4_t da = vmovl_u16(d.val[3]);
+  uint32x4_t ia = veorq_u32(sa, vdupq_n_u32(0xFF));
+  uint32x4_t sa0101 = vmulq_n_u32(sa, 0x101);
+  uint32x4_t da0101 = vmulq_n_u32(da, 0x101);
+
+  uint32x4_t a = vaddq_u32(
+      sa0101, wuffs_base__pixel_swizzler__div255_u32_arm_neon(
+                  vmulq_u32(da0101, ia)));
+  uint32x4_t a00 = vshlq_n_u32(a, 8);
+  float32x4_t af = vcvtq_f32_u32(a);
+  float32x4_t inv_a = vrecpeq_f32(af);
+  inv_a = vmulq_f32(vrecpsq_f32(af, inv_a), inv_a);
+  inv_a = vmulq_f32(vrecpsq_f32(af, inv_a), inv_a);
+  float32x4_t inv_a00 = vmulq_n_f32(inv_a, 65535.0f / 256.0f);
+
+  uint16x4x4_t o;
+  int i;
+  for (i = 0; i < 3; i++) {
+    uint32x4_t p = wuffs_base__pixel_swizzler__div255_u32_arm_neon(
+        vmulq_u32(vmovl_u16(d.val[i]), da0101));
+    uint32x4_t c = wuffs_base__pixel_swizzler__div255_u32_arm_neon(
+        vmlaq_u32(vmulq_u32(vmovl_u16(s.val[i]), sa0101), p, ia));
+
+    // q approximates ((c * 0xFFFF) / a00) to within 1. The remainder, r,
+    // tells us whether to adjust q down or up to get the exact value.
+    uint32x4_t q = vcvtq_u32_f32(vmulq_f32(vcvtq_f32_u32(c), inv_a00));
+    int32x4_t r = vreinterpretq_s32_u32(
+        vmlsq_u32(vsubq_u32(vshlq_n_u32(c, 16), c), q, a00));
+    q = vaddq_u32(q, vreinterpretq_u32_s32(vshrq_n_s32(r, 31)));
+    q = vsubq_u32(q, vcgeq_s32(r, vreinterpretq_s32_u32(a00)));
+    o.val[i] = vmovn_u32(q);
+  }
+  o.val[3] = vmovn_u32(vshrq_n_u32(a, 8));
+  return o;
+}
+
+// wuffs_base__pixel_swizzler__src_over_nonpremul_8_arm_neon composites 8 BGRA
+// nonpremul src pixels over 8 nonpremul dst pixels, producing exactly the
+// same output as the non-SIMD
+// wuffs_base__composite_nonpremul_nonpremul_u32_axxx function.
+static inline uint8x8x4_t  //
+wuffs_base__pixel_swizzler__src_over_nonpremul_8_arm_neon(uint8x8x4_t d,
+                                                          uint8x8x4_t s) {
+  uint16x4x4_t d_lo;
+  uint16x4x4_t d_hi;
+  uint16x4x4_t s_lo;
+  uint16x4x4_t s_hi;
+  int i;
+  for (i = 0; i < 4; i++) {
+    uint16x8_t d16 = vmovl_u8(d.val[i]);
+    uint16x8_t s16 = vmovl_u8(s.val[i]);
+    d_lo.val[i] = vget_low_u16(d16);
+    d_hi.val[i] = vget_high_u16(d16);
+    s_lo.val[i] = vget_low_u16(s16);
+    s_hi.val[i] = vget_high_u16(s16);
+  }
+  uint16x4x4_t o_lo =
+      wuffs_base__pixel_swizzler__src_over_nonpremul_4_arm_neon(d_lo, s_lo);
+  uint16x4x4_t o_hi =
+      wuffs_base__pixel_swizzler__src_over_nonpremul_4_arm_neon(d_hi, s_hi);
+
+  // If the dst is fully transparent then the output is the src pixel.
+  uint8x8_t transparent = vceq_u8(d.val[3], vdup_n_u8(0));
+  uint8x8x4_t o;
+  for (i = 0; i < 4; i++) {
+    o.val[i] = vbsl_u8(transparent, s.val[i],
+                       vmovn_u16(vcombine_u16(o_lo.val[i], o_hi.val[i])));
+  }
+  return o;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(d);
+    uint8x8x4_t y = vld4_u8(s);
+    x = wuffs_base__pixel_swizzler__src_over_nonpremul_8_arm_neon(x, y);
+    vst4_u8(d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8_t z[8 * 4];
+    int i;
+    for (i = 0; i < 8; i++) {
+      wuffs_base__poke_u32le__no_bounds_check(
+          z + (4 * i), wuffs_base__peek_u32le__no_bounds_check(
+                           dst_palette_ptr + ((size_t)s[i] * 4)));
+    }
+    uint8x8x4_t x = vld4_u8(d);
+    uint8x8x4_t y = vld4_u8(z);
+    x = wuffs_base__pixel_swizzler__src_over_nonpremul_8_arm_neon(x, y);
+    vst4_u8(d, x);
+
+    s += 8 * 1;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                          ((size_t)s[0] * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(d);
+    uint8x8x4_t y = vld4_u8(s);
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_arm_neon(x, y, false);
+    vst4_u8(d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(d);
+    uint8x8x4_t y = vld4_u8(s);
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_arm_neon(x, y, true);
+    vst4_u8(d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_premul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8_t z[8 * 4];
+    int i;
+    for (i = 0; i < 8; i++) {
+      wuffs_base__poke_u32le__no_bounds_check(
+          z + (4 * i), wuffs_base__peek_u32le__no_bounds_check(
+                           dst_palette_ptr + ((size_t)s[i] * 4)));
+    }
+    uint8x8x4_t x = vld4_u8(d);
+    uint8x8x4_t y = vld4_u8(z);
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_arm_neon(x, y, false);
+    vst4_u8(d, x);
+
+    s += 8 * 1;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                          ((size_t)s[0] * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    uint8x8x4_t x = vld4_u8(d);
+    uint8x8x4_t y = vld4_u8(s);
+    uint8x8_t y0 = y.val[0];
+    y.val[0] = y.val[2];
+    y.val[2] = y0;
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_arm_neon(x, y, false);
+    vst4_u8(d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+static void  //
+wuffs_base__pixel_resampler__resample_h__arm_neon(int16_t* dst_ptr,
+                                                  uint32_t dst_width,
+                                                  const uint8_t* src_ptr,
+                                                  const uint32_t* starts,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps) {
+  uint32_t x;
+  for (x = 0; x < dst_width; x++) {
+    const uint8_t* s = src_ptr + (4u * ((size_t)starts[x]));
+    int32x4_t acc = vdupq_n_s32(1 << (WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT - 1));
+    uint32_t k = 0;
+    for (; (k + 2) <= num_taps; k += 2) {
+      int16x8_t pixels = vreinterpretq_s16_u16(vmovl_u8(vld1_u8(s)));
+      acc = vmlal_n_s16(acc, vget_low_s16(pixels), weights[k + 0]);
+      acc = vmlal_n_s16(acc, vget_high_s16(pixels), weights[k + 1]);
+      s += 8;
+    }
+    if (k < num_taps) {
+      int16x8_t pixel = vreinterpretq_s16_u16(vmovl_u8(
+          vcreate_u8((uint64_t)wuffs_base__peek_u32le__no_bounds_check(s))));
+      acc = vmlal_n_s16(acc, vget_low_s16(pixel), weights[k]);
+    }
+    weights += num_taps;
+
+    vst1_s16(dst_ptr, vqmovn_s32(vshrq_n_s32(
+                          acc, WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT)));
+    dst_ptr += 4;
+  }
+}
+
+static void  //
+wuffs_base__pixel_resampler__resample_v__arm_neon(uint8_t* dst_ptr,
+                                                  size_t dst_len,
+                                                  const int16_t* ring_ptr,
+                                                  size_t ring_stride,
+                                                  uint32_t ring_length,
+                                                  uint32_t ring_index,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps,
+                                                  bool clamp_to_alpha) {
+  const int32x4_t bias =
+      vdupq_n_s32(1 << (WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT - 1));
+  const uint8x8_t alpha = vcreate_u8(0x0707070703030303);
+
+  // Process 8 samples (2 pixels) at a time.
+  size_t i = 0;
+  for (; (i + 8) <= dst_len; i += 8) {
+    int32x4_t acc_lo = bias;
+    int32x4_t acc_hi = bias;
+    uint32_t slot = ring_index;
+    uint32_t k;
+    for (k = 0; k < num_taps; k++) {
+      int16x8_t v = vld1q_s16(ring_ptr + (((size_t)slot) * ring_stride) + i);
+      acc_lo = vmlal_n_s16(acc_lo, vget_low_s16(v), weights[k]);
+      acc_hi = vmlal_n_s16(acc_hi, vget_high_s16(v), weights[k]);
+      if (++slot == ring_length) {
+        slot = 0;
+      }
+    }
+
+    uint8x8_t c = vqmovn_u16(vcombine_u16(
+        vqmovun_s32(vshrq_n_s32(acc_lo, WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT)),
+        vqmovun_s32(
+            vshrq_n_s32(acc_hi, WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT))));
+    if (clamp_to_alpha) {
+      c = vmin_u8(c, vtbl1_u8(c, alpha));
+    }
+    vst1_u8(dst_ptr + i, c);
+  }
+
+  wuffs_base__pixel_resampler__resample_v_tail(
+      dst_ptr, dst_len, i, ring_ptr, ring_stride, ring_length, ring_index,
+      weights, num_taps, clamp_to_alpha);
+}
+
+// --------
+
+static void  //
+wuffs_base__pixel_swizzler__dither_ordered__bgr_565__arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels,
+    uint32_t x,
+    uint32_t y) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  const uint32x4_t one = vdupq_n_u32(1);
+
+  while (n >= 4) {
+    uint32_t ts[4] = {
+        wuffs_base__pixel_swizzler__dither__threshold(x + 0, y),
+        wuffs_base__pixel_swizzler__dither__threshold(x + 1, y),
+        wuffs_base__pixel_swizzler__dither__threshold(x + 2, y),
+        wuffs_base__pixel_swizzler__dither__threshold(x + 3, y),
+    };
+    uint32x4_t t = vld1q_u32(ts);
+
+    // Load 4 pixels, de-interleaving the B, G, R and A channels.
+    uint16x4x4_t v = vld4_u16((const uint16_t*)(const void*)s);
+    uint32x4_t a = vmovl_u16(v.val[3]);
+
+    // Premultiply: p = ((v * a) / 0xFFFF), like
+    // wuffs_base__pixel_swizzler__dither__premul.
+    uint32x4_t b = vmulq_u32(vmovl_u16(v.val[0]), a);
+    uint32x4_t g = vmulq_u32(vmovl_u16(v.val[1]), a);
+    uint32x4_t r = vmulq_u32(vmovl_u16(v.val[2]), a);
+    b = vshrq_n_u32(vaddq_u32(vaddq_u32(b, vshrq_n_u32(b, 16)), one), 16);
+    g = vshrq_n_u32(vaddq_u32(vaddq_u32(g, vshrq_n_u32(g, 16)), one), 16);
+    r = vshrq_n_u32(vaddq_u32(vaddq_u32(r, vshrq_n_u32(r, 16)), one), 16);
+
+    b = vshrq_n_u32(
+        vaddq_u32(vmlaq_n_u32(vshrq_n_u32(b, 11), b, 31), t), 16);
+    g = vshrq_n_u32(
+        vaddq_u32(vmlaq_n_u32(vshrq_n_u32(g, 10), g, 63), t), 16);
+    r = vshrq_n_u32(
+        vaddq_u32(vmlaq_n_u32(vshrq_n_u32(r, 11), r, 31), t), 16);
+
+    uint32x4_t c = vorrq_u32(vorrq_u32(vshlq_n_u32(r, 11), vshlq_n_u32(g, 5)),
+                             b);
+    vst1_u16((uint16_t*)(void*)d, vmovn_u32(c));
+
+    s += 4 * 8;
+    d += 4 * 2;
+    n -= 4;
+    x += 4;
+  }
+
+  wuffs_base__pixel_swizzler__dither_ordered__bgr_565(d, s, n, x, y);
+}
+
+// --------
+
+static void  //
+wuffs_base__pixel_quantizer__fill_cache_row__arm_neon(
+    uint8_t* dst_ptr,
+    const int32_t* rga_scores,
+    const int32_t* premul_bs,
+    uint32_t num_colors) {
+  // Each of the 8 vectors holds 4 cells' blue values, (b << 3) | 4.
+  int32x4_t cbs[8];
+  int32x4_t bests[8];
+  uint32x4_t indexes[8];
+  int32_t cb_init[4] = {4, 12, 20, 28};
+  int k = 0;
+  for (; k < 8; k++) {
+    cbs[k] = vaddq_s32(vld1q_s32(cb_init), vdupq_n_s32(32 * k));
+    bests[k] = vdupq_n_s32(0x7FFFFFFF);
+    indexes[k] = vdupq_n_u32(0);
+  }
+
+  uint32_t i = 0;
+  for (; i < num_colors; i++) {
+    int32x4_t rga = vdupq_n_s32(rga_scores[i]);
+    int32x4_t pb = vdupq_n_s32(premul_bs[i]);
+    uint32x4_t vi = vdupq_n_u32(i);
+    for (k = 0; k < 8; k++) {
+      int32x4_t d = vsubq_s32(cbs[k], pb);
+      int32x4_t s = vmlaq_s32(rga, d, d);
+      indexes[k] = vbslq_u32(vcltq_s32(s, bests[k]), vi, indexes[k]);
+      bests[k] = vminq_s32(bests[k], s);
+    }
+  }
+
+  for (k = 0; k < 8; k += 2) {
+    uint16x8_t w = vcombine_u16(vmovn_u32(indexes[k + 0]),  //
+                                vmovn_u32(indexes[k + 1]));
+    vst1_u8(dst_ptr + (4 * k), vmovn_u16(w));
+  }
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__float__premul_4_arm_neon converts 4
+// BGRA_NONPREMUL_4X16LE pixels to premultiplied R, G, B and A floats,
+// matching wuffs_base__pixel_swizzler__float__premul exactly.
+static inline float32x4x4_t  //
+wuffs_base__pixel_swizzler__float__premul_4_arm_neon(const uint8_t* s,
+                                                      bool linear) {
+  uint16x4x4_t x = vld4_u16((const uint16_t*)(const void*)s);
+  float32x4_t a = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(x.val[3])),  //
+                              1.0f / 65535.0f);
+
+  float32x4x4_t y;
+  int i = 0;
+  for (; i < 3; i++) {
+    float32x4_t c;
+    if (linear) {
+      // NEON has no gather instruction, so look up the table one lane at a
+      // time.
+      uint16_t c16[4];
+      uint32_t l[4];
+      vst1_u16(c16, x.val[2 - i]);
+      int j = 0;
+      for (; j < 4; j++) {
+        l[j] = wuffs_base__pixel_swizzler__float__linearize(c16[j]);
+      }
+      c = vmulq_n_f32(vcvtq_f32_u32(vld1q_u32(l)), 1.0f / 1073741824.0f);
+    } else {
+      c = vmulq_n_f32(vcvtq_f32_u32(vmovl_u16(x.val[2 - i])), 1.0f / 65535.0f);
+    }
+    y.val[i] = vmulq_f32(c, a);
+  }
+  y.val[3] = a;
+  return y;
+}
+
+#if defined(WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__ARM_NEON_F16)
+static inline uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    const uint8_t* src_ptr,
+    size_t src_len,
+    bool linear) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    float32x4x4_t y =
+        wuffs_base__pixel_swizzler__float__premul_4_arm_neon(s, linear);
+    uint16x4x4_t z;
+    z.val[0] = vreinterpret_u16_f16(vcvt_f16_f32(y.val[0]));
+    z.val[1] = vreinterpret_u16_f16(vcvt_f16_f32(y.val[1]));
+    z.val[2] = vreinterpret_u16_f16(vcvt_f16_f32(y.val[2]));
+    z.val[3] = vreinterpret_u16_f16(vcvt_f16_f32(y.val[3]));
+    vst4_u16((uint16_t*)(void*)d, z);
+
+    s += 4 * 8;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      d, 8 * n, s, 8 * n, true, linear, false);
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+}
+#endif  // defined(WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__ARM_NEON_F16)
+
+static inline uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    const uint8_t* src_ptr,
+    size_t src_len,
+    bool linear) {
+  size_t dst_len16 = dst_len / 16;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len16 < src_len8) ? dst_len16 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    vst4q_f32((float*)(void*)d,
+              wuffs_base__pixel_swizzler__float__premul_4_arm_neon(s, linear));
+
+    s += 4 * 8;
+    d += 4 * 16;
+    n -= 4;
+  }
+
+  wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      d, 16 * n, s, 8 * n, false, linear, false);
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__arm_neon(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+}
+
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+// ‼ WUFFS MULTI-FILE SECTION -arm_neon
@@ -0,0 +1,897 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// --------
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_bgrx__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_rgbx__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_bgra_premul__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_rgba_premul__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// --------
+
+// The color transform works in fixed point. The decode look-up tables map
+// 8-bit source samples to linear light, where 1.0 is 0x3FFF. The matrix
+// coefficients are 4.12 (so that 1.0 is 0x1000). Each output channel sums
+// three (linear light times coefficient) products, rounds (shifting right by
+// 12), clamps to [0 ..= 0x3FFF] and indexes the encode look-up table.
+//
+// Coefficients are limited to ±8.0, which (with 14-bit linear light) keeps
+// that sum within int32_t range.
+
+#define WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX 0x3FFF
+#define WUFFS_BASE__COLOR_TRANSFORM__MATRIX_ONE 0x1000
+#define WUFFS_BASE__COLOR_TRANSFORM__MATRIX_SHIFT 12
+
+// wuffs_base__color_transform__log2 returns log2(x), for positive x. Like
+// wuffs_base__pixel_resampler__sin_pi, it avoids depending on <math.h> (and
+// libm). It is accurate to about 1e-13.
+static double  //
+wuffs_base__color_transform__log2(double x) {
+  int64_t e = 0;
+  uint64_t u = wuffs_base__ieee_754_bit_representation__from_f64_to_u64(x);
+  if ((u >> 52) == 0) {  // Subnormal.
+    x *= 18446744073709551616.0;  // 2**64.
+    e = -64;
+    u = wuffs_base__ieee_754_bit_representation__from_f64_to_u64(x);
+  }
+  e += ((int64_t)((u >> 52) & 0x7FF)) - 1023;
+
+  // Split x as (m * 2**e), with m in the range [√½, √2].
+  double m = wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
+      (u & 0x000FFFFFFFFFFFFF) | 0x3FF0000000000000);
+  if (m > 1.4142135623730951) {
+    m *= 0.5;
+    e++;
+  }
+
+  // ln(m) = 2 * atanh(s) = 2 * (s + s**3/3 + s**5/5 + ...), for s = (m - 1)
+  // / (m + 1), where |s| <= 0.1716.
+  double s = (m - 1.0) / (m + 1.0);
+  double ss = s * s;
+  double term = s;
+  double ln_m = 0.0;
+  int i;
+  for (i = 1; i <= 15; i += 2) {
+    ln_m += term / ((double)i);
+    term *= ss;
+  }
+  ln_m *= 2.0;
+  return ((double)e) + (ln_m * 1.4426950408889634);  // 1.44 is 1/ln(2).
+}
+
+// wuffs_base__color_transform__exp2 returns 2**x. Like
+// wuffs_base__color_transform__log2, it is accurate to about 1e-13.
+static double  //
+wuffs_base__color_transform__exp2(double x) {
+  if (x < -1000.0) {
+    return 0.0;
+  } else if (x > 1000.0) {
+    x = 1000.0;
+  }
+
+  // Split x as (n + f), with integral n and f in the range [0, 1).
+  int64_t n = (int64_t)x;
+  if (x < ((double)n)) {
+    n--;
+  }
+  double f = (x - ((double)n)) * 0.6931471805599453;  // 0.69 is ln(2).
+
+  // Taylor series for exp(f), good enough for f < ln(2).
+  double term = 1.0;
+  double exp_f = 1.0;
+  int i;
+  for (i = 1; i <= 13; i++) {
+    term *= f / ((double)i);
+    exp_f += term;
+  }
+
+  if (n < -1022) {
+    return 0.0;
+  }
+  return exp_f * wuffs_base__ieee_754_bit_representation__from_u64_to_f64(
+                     ((uint64_t)(n + 1023)) << 52);
+}
+
+// wuffs_base__color_transform__pow returns x**y, or zero if x is not
+// positive.
+static double  //
+wuffs_base__color_transform__pow(double x, double y) {
+  if (!(x > 0.0)) {
+    return 0.0;
+  }
+  return wuffs_base__color_transform__exp2(
+      y * wuffs_base__color_transform__log2(x));
+}
+
+// --------
+
+// wuffs_base__color_transform__curve is a transfer function, mapping encoded
+// values in [0, 1] to linear light.
+typedef struct {
+  // If table_len is zero then y = ((a * x) + b)**g + e when x >= d, otherwise
+  // y = (c * x) + f. This is the ICC "para" curve's function type 4, which
+  // generalizes the other function types (and the "curv" gamma curve).
+  double g;
+  double a;
+  double b;
+  double c;
+  double d;
+  double e;
+  double f;
+  // If table_len is non-zero then table_ptr points to table_len big-endian
+  // uint16_t values, linearly interpolated.
+  const uint8_t* table_ptr;
+  uint32_t table_len;
+} wuffs_base__color_transform__curve;
+
+static void  //
+wuffs_base__color_transform__curve__set_gamma(
+    wuffs_base__color_transform__curve* c,
+    double g) {
+  c->g = g;
+  c->a = 1.0;
+  c->b = 0.0;
+  c->c = 0.0;
+  c->d = 0.0;
+  c->e = 0.0;
+  c->f = 0.0;
+  c->table_ptr = NULL;
+  c->table_len = 0;
+}
+
+static void  //
+wuffs_base__color_transform__curve__set_srgb(
+    wuffs_base__color_transform__curve* c) {
+  c->g = 2.4;
+  c->a = 1.0 / 1.055;
+  c->b = 0.055 / 1.055;
+  c->c = 1.0 / 12.92;
+  c->d = 0.04045;
+  c->e = 0.0;
+  c->f = 0.0;
+  c->table_ptr = NULL;
+  c->table_len = 0;
+}
+
+static double  //
+wuffs_base__color_transform__curve__eval(
+    const wuffs_base__color_transform__curve* c,
+    double x) {
+  if (c->table_len > 0) {
+    uint32_t last = c->table_len - 1;
+    double pos = x * ((double)last);
+    uint32_t i = (pos > 0.0) ? ((uint32_t)pos) : 0;
+    if (i >= last) {
+      return ((double)wuffs_base__peek_u16be__no_bounds_check(
+                 c->table_ptr + (2 * ((size_t)last)))) /
+             65535.0;
+    }
+    double v0 = (double)wuffs_base__peek_u16be__no_bounds_check(
+        c->table_ptr + (2 * ((size_t)i)));
+    double v1 = (double)wuffs_base__peek_u16be__no_bounds_check(
+        c->table_ptr + (2 * ((size_t)i)) + 2);
+    return (v0 + ((pos - ((double)i)) * (v1 - v0))) / 65535.0;
+  }
+  if (x >= c->d) {
+    return wuffs_base__color_transform__pow((c->a * x) + c->b, c->g) + c->e;
+  }
+  return (c->c * x) + c->f;
+}
+
+// --------
+
+// 3x3 matrices are row major.
+
+static void  //
+wuffs_base__color_transform__mat3_mul(double* dst,
+                                      const double* a,
+                                      const double* b) {
+  int i;
+  int j;
+  for (i = 0; i < 3; i++) {
+    for (j = 0; j < 3; j++) {
+      dst[(3 * i) + j] = (a[(3 * i) + 0] * b[(3 * 0) + j]) +  //
+                         (a[(3 * i) + 1] * b[(3 * 1) + j]) +  //
+                         (a[(3 * i) + 2] * b[(3 * 2) + j]);
+    }
+  }
+}
+
+static bool  //
+wuffs_base__color_transform__mat3_inv(double* dst, const double* m) {
+  double c0 = (m[4] * m[8]) - (m[5] * m[7]);
+  double c1 = (m[5] * m[6]) - (m[3] * m[8]);
+  double c2 = (m[3] * m[7]) - (m[4] * m[6]);
+  double det = (m[0] * c0) + (m[1] * c1) + (m[2] * c2);
+  if (!((det > 1e-12) || (det < -1e-12))) {
+    return false;
+  }
+  double inv_det = 1.0 / det;
+  dst[0] = c0 * inv_det;
+  dst[1] = ((m[2] * m[7]) - (m[1] * m[8])) * inv_det;
+  dst[2] = ((m[1] * m[5]) - (m[2] * m[4])) * inv_det;
+  dst[3] = c1 * inv_det;
+  dst[4] = ((m[0] * m[8]) - (m[2] * m[6])) * inv_det;
+  dst[5] = ((m[2] * m[3]) - (m[0] * m[5])) * inv_det;
+  dst[6] = c2 * inv_det;
+  dst[7] = ((m[1] * m[6]) - (m[0] * m[7])) * inv_det;
+  dst[8] = ((m[0] * m[4]) - (m[1] * m[3])) * inv_det;
+  return true;
+}
+
+// wuffs_base__color_transform__rgb_to_xyz sets dst to the matrix that maps
+// linear RGB to CIE XYZ, given chromaticities (white_x, white_y, red_x,
+// red_y, green_x, green_y, blue_x, blue_y) such as a PNG cHRM chunk's. It
+// also sets white_xyz to the white point's XYZ (with Y = 1).
+static bool  //
+wuffs_base__color_transform__rgb_to_xyz(double* dst,
+                                        double* white_xyz,
+                                        const double* xy) {
+  int i;
+  for (i = 1; i < 8; i += 2) {
+    if (!(xy[i] > 0.0)) {
+      return false;
+    }
+  }
+  white_xyz[0] = xy[0] / xy[1];
+  white_xyz[1] = 1.0;
+  white_xyz[2] = (1.0 - xy[0] - xy[1]) / xy[1];
+
+  // The columns of p are the primaries' XYZ (with Y = 1). Scale each column
+  // so that RGB = (1, 1, 1) maps to the white point.
+  double p[9];
+  double p_inv[9];
+  for (i = 0; i < 3; i++) {
+    double x = xy[2 + (2 * i)];
+    double y = xy[3 + (2 * i)];
+    p[0 + i] = x / y;
+    p[3 + i] = 1.0;
+    p[6 + i] = (1.0 - x - y) / y;
+  }
+  if (!wuffs_base__color_transform__mat3_inv(p_inv, p)) {
+    return false;
+  }
+  for (i = 0; i < 3; i++) {
+    double s = (p_inv[(3 * i) + 0] * white_xyz[0]) +  //
+               (p_inv[(3 * i) + 1] * white_xyz[1]) +  //
+               (p_inv[(3 * i) + 2] * white_xyz[2]);
+    dst[0 + i] = p[0 + i] * s;
+    dst[3 + i] = p[3 + i] * s;
+    dst[6 + i] = p[6 + i] * s;
+  }
+  return true;
+}
+
+// wuffs_base__color_transform__adapt sets dst to the Bradford chromatic
+// adaptation matrix (in XYZ space) from the src white point to the dst one.
+static bool  //
+wuffs_base__color_transform__adapt(double* dst,
+                                   const double* dst_white_xyz,
+                                   const double* src_white_xyz) {
+  static const double bradford[9] = {
+      +0.8951, +0.2664, -0.1614,  //
+      -0.7502, +1.7135, +0.0367,  //
+      +0.0389, -0.0685, +1.0296,  //
+  };
+  double bradford_inv[9];
+  if (!wuffs_base__color_transform__mat3_inv(bradford_inv, bradford)) {
+    return false;
+  }
+  double scale[9] = {0};
+  int i;
+  for (i = 0; i < 3; i++) {
+    double d = (bradford[(3 * i) + 0] * dst_white_xyz[0]) +  //
+               (bradford[(3 * i) + 1] * dst_white_xyz[1]) +  //
+               (bradford[(3 * i) + 2] * dst_white_xyz[2]);
+    double s = (bradford[(3 * i) + 0] * src_white_xyz[0]) +  //
+               (bradford[(3 * i) + 1] * src_white_xyz[1]) +  //
+               (bradford[(3 * i) + 2] * src_white_xyz[2]);
+    if (!(s > 0.0)) {
+      return false;
+    }
+    scale[(3 * i) + i] = d / s;
+  }
+  double tmp[9];
+  wuffs_base__color_transform__mat3_mul(tmp, scale, bradford);
+  wuffs_base__color_transform__mat3_mul(dst, bradford_inv, tmp);
+  return true;
+}
+
+// --------
+
+static const double wuffs_base__color_transform__srgb_chromaticities[8] = {
+    0.3127, 0.3290,  // White (D65).
+    0.6400, 0.3300,  // Red.
+    0.3000, 0.6000,  // Green.
+    0.1500, 0.0600,  // Blue.
+};
+
+// wuffs_base__color_transform__build sets t to convert from the source color
+// space, given by its per-channel transfer functions and its linear RGB to
+// XYZ matrix (relative to the white_xyz white point), to sRGB.
+static wuffs_base__status  //
+wuffs_base__color_transform__build(
+    wuffs_base__color_transform* t,
+    const wuffs_base__color_transform__curve* curves,
+    const double* src_rgb_to_xyz,
+    const double* white_xyz) {
+  // Map sRGB's D65 white point to the source's, so that white stays white.
+  double srgb_rgb_to_xyz[9];
+  double srgb_white_xyz[3];
+  double adapt[9];
+  double dst_rgb_to_xyz[9];
+  double dst_xyz_to_rgb[9];
+  double m[9];
+  if (!wuffs_base__color_transform__rgb_to_xyz(
+          srgb_rgb_to_xyz, srgb_white_xyz,
+          wuffs_base__color_transform__srgb_chromaticities) ||
+      !wuffs_base__color_transform__adapt(adapt, white_xyz, srgb_white_xyz)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  wuffs_base__color_transform__mat3_mul(dst_rgb_to_xyz, adapt,
+                                        srgb_rgb_to_xyz);
+  if (!wuffs_base__color_transform__mat3_inv(dst_xyz_to_rgb,
+                                             dst_rgb_to_xyz)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  wuffs_base__color_transform__mat3_mul(m, dst_xyz_to_rgb, src_rgb_to_xyz);
+
+  bool is_identity = true;
+  int i;
+  for (i = 0; i < 9; i++) {
+    if (!((-8.0 <= m[i]) && (m[i] <= +8.0))) {
+      return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+    }
+    double v = m[i] * WUFFS_BASE__COLOR_TRANSFORM__MATRIX_ONE;
+    t->private_impl.matrix[i] =
+        (int32_t)((v >= 0.0) ? (v + 0.5) : (v - 0.5));
+    is_identity =
+        is_identity && (t->private_impl.matrix[i] ==
+                        (((i % 4) == 0) ? WUFFS_BASE__COLOR_TRANSFORM__MATRIX_ONE
+                                        : 0));
+  }
+
+  // The sRGB encoding is monotonic, so instead of evaluating it for all
+  // 16384 linear values, find the 255 thresholds between 8-bit outputs: the
+  // linear values that encode to (k + 0.5) / 255.
+  wuffs_base__color_transform__curve srgb;
+  wuffs_base__color_transform__curve__set_srgb(&srgb);
+  uint32_t j = 0;
+  uint32_t k;
+  for (k = 0; k < 255; k++) {
+    double threshold = WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX *
+                       wuffs_base__color_transform__curve__eval(
+                           &srgb, (((double)k) + 0.5) / 255.0);
+    for (; (j <= WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX) &&
+           (((double)j) < threshold);
+         j++) {
+      t->private_impl.encode_lut[j] = (uint8_t)k;
+    }
+  }
+  for (; j < sizeof(t->private_impl.encode_lut); j++) {
+    t->private_impl.encode_lut[j] = 0xFF;
+  }
+
+  int c;
+  for (c = 0; c < 3; c++) {
+    for (k = 0; k < 256; k++) {
+      double y = wuffs_base__color_transform__curve__eval(&curves[c],
+                                                          ((double)k) / 255.0);
+      uint16_t v = 0;
+      if (y >= 1.0) {
+        v = WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX;
+      } else if (y > 0.0) {
+        v = (uint16_t)((y * WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX) + 0.5);
+      }
+      t->private_impl.decode_luts[c][k] = v;
+      is_identity = is_identity && (t->private_impl.encode_lut[v] == k);
+    }
+  }
+
+  t->private_impl.is_active = !is_identity;
+  return wuffs_base__make_status(NULL);
+}
+
+static wuffs_base__status  //
+wuffs_base__color_transform__parse_icc_curve(
+    wuffs_base__color_transform__curve* c,
+    const uint8_t* ptr,
+    uint32_t len) {
+  wuffs_base__color_transform__curve__set_gamma(c, 1.0);
+  if (len < 12) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  uint32_t type = wuffs_base__peek_u32be__no_bounds_check(ptr);
+
+  if (type == 0x63757276) {  // "curv".
+    uint32_t count = wuffs_base__peek_u32be__no_bounds_check(ptr + 8);
+    if (count > ((len - 12) / 2)) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    } else if (count == 1) {
+      // A u8.8 fixed point gamma.
+      c->g = ((double)wuffs_base__peek_u16be__no_bounds_check(ptr + 12)) /
+             256.0;
+    } else if (count > 1) {
+      c->table_ptr = ptr + 12;
+      c->table_len = count;
+    }
+    return wuffs_base__make_status(NULL);
+
+  } else if (type == 0x70617261) {  // "para".
+    static const uint8_t num_params[5] = {1, 3, 4, 5, 7};
+    uint32_t function_type = wuffs_base__peek_u16be__no_bounds_check(ptr + 8);
+    if (function_type >= 5) {
+      return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+    }
+    uint32_t n = num_params[function_type];
+    if (len < (12 + (4 * n))) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+    // The parameters are s15.16 fixed point: g, a, b, c, d, e, f.
+    double p[7] = {0};
+    uint32_t i;
+    for (i = 0; i < n; i++) {
+      p[i] = ((double)((int32_t)wuffs_base__peek_u32be__no_bounds_check(
+                 ptr + 12 + (4 * i)))) /
+             65536.0;
+    }
+    c->g = p[0];
+    if (function_type == 0) {
+      return wuffs_base__make_status(NULL);
+    }
+    c->a = p[1];
+    c->b = p[2];
+    if (function_type <= 2) {
+      // Y = ((a * X) + b)**g (+ c) when X >= -b/a, otherwise Y = 0 (+ c).
+      if (!((p[1] > 0.0) || (p[1] < 0.0))) {
+        return wuffs_base__make_status(wuffs_base__error__bad_argument);
+      }
+      c->d = -p[2] / p[1];
+      c->e = (function_type == 2) ? p[3] : 0.0;
+      c->f = c->e;
+    } else {
+      c->c = p[3];
+      c->d = p[4];
+      c->e = p[5];
+      c->f = p[6];
+    }
+    return wuffs_base__make_status(NULL);
+  }
+
+  return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__color_transform__set_from_icc_profile(
+    wuffs_base__color_transform* t,
+    wuffs_base__slice_u8 icc) {
+  if (!t) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  t->private_impl.is_active = false;
+
+  // The 128 byte header is followed by the tag count and then 12 bytes (tag
+  // signature, offset and length) per tag.
+  if (icc.len < 132) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  uint32_t size = wuffs_base__peek_u32be__no_bounds_check(icc.ptr);
+  if ((size < 132) || (size > icc.len)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  } else if ((wuffs_base__peek_u32be__no_bounds_check(icc.ptr + 16) !=
+              0x52474220) ||  // "RGB ".
+             (wuffs_base__peek_u32be__no_bounds_check(icc.ptr + 20) !=
+              0x58595A20)) {  // "XYZ ".
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+  uint32_t num_tags = wuffs_base__peek_u32be__no_bounds_check(icc.ptr + 128);
+  if (num_tags > ((size - 132) / 12)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+
+  const uint8_t* xyz_ptrs[3] = {NULL, NULL, NULL};
+  const uint8_t* trc_ptrs[3] = {NULL, NULL, NULL};
+  uint32_t trc_lens[3] = {0, 0, 0};
+  uint32_t i;
+  for (i = 0; i < num_tags; i++) {
+    const uint8_t* p = icc.ptr + 132 + (12 * i);
+    uint32_t sig = wuffs_base__peek_u32be__no_bounds_check(p + 0);
+    uint32_t off = wuffs_base__peek_u32be__no_bounds_check(p + 4);
+    uint32_t len = wuffs_base__peek_u32be__no_bounds_check(p + 8);
+    if ((off > size) || (len > (size - off))) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+    int c = -1;
+    switch (sig) {
+      case 0x7258595A:  // "rXYZ".
+      case 0x72545243:  // "rTRC".
+        c = 0;
+        break;
+      case 0x6758595A:  // "gXYZ".
+      case 0x67545243:  // "gTRC".
+        c = 1;
+        break;
+      case 0x6258595A:  // "bXYZ".
+      case 0x62545243:  // "bTRC".
+        c = 2;
+        break;
+      default:
+        continue;
+    }
+    if ((sig & 0xFFFF) == 0x595A) {
+      // An "XYZ " type: the type signature, 4 reserved bytes and then three
+      // s15.16 fixed point numbers.
+      if ((len < 20) || (wuffs_base__peek_u32be__no_bounds_check(
+                             icc.ptr + off) != 0x58595A20)) {
+        return wuffs_base__make_status(wuffs_base__error__bad_argument);
+      }
+      xyz_ptrs[c] = icc.ptr + off + 8;
+    } else {
+      trc_ptrs[c] = icc.ptr + off;
+      trc_lens[c] = len;
+    }
+  }
+
+  double src_rgb_to_xyz[9];
+  wuffs_base__color_transform__curve curves[3];
+  int c;
+  for (c = 0; c < 3; c++) {
+    if (!xyz_ptrs[c] || !trc_ptrs[c]) {
+      return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+    }
+    int j;
+    for (j = 0; j < 3; j++) {
+      src_rgb_to_xyz[(3 * j) + c] =
+          ((double)((int32_t)wuffs_base__peek_u32be__no_bounds_check(
+              xyz_ptrs[c] + (4 * j)))) /
+          65536.0;
+    }
+    wuffs_base__status status = wuffs_base__color_transform__parse_icc_curve(
+        &curves[c], trc_ptrs[c], trc_lens[c]);
+    if (status.repr) {
+      return status;
+    }
+  }
+
+  // The ICC Profile Connection Space's white point is D50.
+  static const double d50_xyz[3] = {0.9642, 1.0, 0.8249};
+  return wuffs_base__color_transform__build(t, curves, src_rgb_to_xyz,
+                                            d50_xyz);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__color_transform__set_from_gama_chrm(wuffs_base__color_transform* t,
+                                                uint32_t gama,
+                                                const int32_t* chrm) {
+  if (!t) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  t->private_impl.is_active = false;
+
+  wuffs_base__color_transform__curve curves[3];
+  if (gama == 0) {
+    wuffs_base__color_transform__curve__set_srgb(&curves[0]);
+  } else {
+    // The gAMA chunk holds the encoding exponent, scaled by 100000. Decoding
+    // uses its reciprocal.
+    wuffs_base__color_transform__curve__set_gamma(&curves[0],
+                                                  100000.0 / ((double)gama));
+  }
+  curves[1] = curves[0];
+  curves[2] = curves[0];
+
+  double xy[8];
+  int i;
+  for (i = 0; i < 8; i++) {
+    xy[i] = chrm ? (((double)chrm[i]) / 100000.0)
+                 : wuffs_base__color_transform__srgb_chromaticities[i];
+  }
+  double src_rgb_to_xyz[9];
+  double white_xyz[3];
+  if (!wuffs_base__color_transform__rgb_to_xyz(src_rgb_to_xyz, white_xyz,
+                                               xy)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  return wuffs_base__color_transform__build(t, curves, src_rgb_to_xyz,
+                                            white_xyz);
+}
+
+// --------
+
+// wuffs_base__color_transform__convert transforms one pixel's 8-bit red,
+// green and blue values, in place.
+static inline void  //
+wuffs_base__color_transform__convert(const wuffs_base__color_transform* t,
+                                     uint32_t* r,
+                                     uint32_t* g,
+                                     uint32_t* b) {
+  const int32_t* m = t->private_impl.matrix;
+  int32_t lr = (int32_t)(t->private_impl.decode_luts[0][*r]);
+  int32_t lg = (int32_t)(t->private_impl.decode_luts[1][*g]);
+  int32_t lb = (int32_t)(t->private_impl.decode_luts[2][*b]);
+  uint32_t* outs[3] = {r, g, b};
+  int i;
+  for (i = 0; i < 3; i++) {
+    int32_t v = (m[(3 * i) + 0] * lr) + (m[(3 * i) + 1] * lg) +
+                (m[(3 * i) + 2] * lb) +
+                (1 << (WUFFS_BASE__COLOR_TRANSFORM__MATRIX_SHIFT - 1));
+    uint32_t u = (v > 0) ? (((uint32_t)v) >>
+                            WUFFS_BASE__COLOR_TRANSFORM__MATRIX_SHIFT)
+                         : 0;
+    if (u > WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX) {
+      u = WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX;
+    }
+    *outs[i] = t->private_impl.encode_lut[u];
+  }
+}
+
+// wuffs_base__color_transform__transform_3 and
+// wuffs_base__color_transform__transform_4 transform (len / 3) or (len / 4)
+// pixels, in place. The bgr argument is whether blue (instead of red) is the
+// first byte of each pixel. For 4 byte pixels, the premul argument is
+// whether the color channels are premultiplied by the fourth (alpha) byte.
+// They return the number of bytes processed.
+
+static inline size_t  //
+wuffs_base__color_transform__transform_3(const wuffs_base__color_transform* t,
+                                         uint8_t* ptr,
+                                         size_t len,
+                                         bool bgr) {
+  size_t n = len / 3;
+  size_t ir = bgr ? 2 : 0;
+  size_t ib = bgr ? 0 : 2;
+  for (; n > 0; n--) {
+    uint32_t r = ptr[ir];
+    uint32_t g = ptr[1];
+    uint32_t b = ptr[ib];
+    wuffs_base__color_transform__convert(t, &r, &g, &b);
+    ptr[ir] = (uint8_t)r;
+    ptr[1] = (uint8_t)g;
+    ptr[ib] = (uint8_t)b;
+    ptr += 3;
+  }
+  return len - (len % 3);
+}
+
+static inline size_t  //
+wuffs_base__color_transform__transform_4(const wuffs_base__color_transform* t,
+                                         uint8_t* ptr,
+                                         size_t len,
+                                         bool bgr,
+                                         bool premul) {
+  size_t n = len / 4;
+  size_t ir = bgr ? 2 : 0;
+  size_t ib = bgr ? 0 : 2;
+  for (; n > 0; n--) {
+    uint32_t a = ptr[3];
+    if (!premul || (a == 0xFF)) {
+      uint32_t r = ptr[ir];
+      uint32_t g = ptr[1];
+      uint32_t b = ptr[ib];
+      wuffs_base__color_transform__convert(t, &r, &g, &b);
+      ptr[ir] = (uint8_t)r;
+      ptr[1] = (uint8_t)g;
+      ptr[ib] = (uint8_t)b;
+    } else if (a != 0) {
+      uint32_t c = wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(
+          (a << 24) | (((uint32_t)ptr[ir]) << 16) | (((uint32_t)ptr[1]) << 8) |
+          (((uint32_t)ptr[ib]) << 0));
+      uint32_t r = 0xFF & (c >> 16);
+      uint32_t g = 0xFF & (c >> 8);
+      uint32_t b = 0xFF & (c >> 0);
+      wuffs_base__color_transform__convert(t, &r, &g, &b);
+      c = wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
+          (a << 24) | (r << 16) | (g << 8) | (b << 0));
+      ptr[ir] = (uint8_t)(c >> 16);
+      ptr[1] = (uint8_t)(c >> 8);
+      ptr[ib] = (uint8_t)(c >> 0);
+    }
+    ptr += 4;
+  }
+  return len & ~((size_t)3);
+}
+
+static void  //
+wuffs_base__color_transform__transform_bgr(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_3(t, ptr, len, true);
+}
+
+static void  //
+wuffs_base__color_transform__transform_rgb(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_3(t, ptr, len, false);
+}
+
+static void  //
+wuffs_base__color_transform__transform_bgrx(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4(t, ptr, len, true, false);
+}
+
+static void  //
+wuffs_base__color_transform__transform_rgbx(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4(t, ptr, len, false, false);
+}
+
+static void  //
+wuffs_base__color_transform__transform_bgra_premul(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4(t, ptr, len, true, true);
+}
+
+static void  //
+wuffs_base__color_transform__transform_rgba_premul(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4(t, ptr, len, false, true);
+}
+
+// wuffs_base__color_transform__func_for returns the (possibly SIMD)
+// function that transforms pixels of the given pixel format, or NULL if that
+// pixel format is unsupported. Non-premultiplied alpha, like BGRX's X, is
+// simply left as is.
+static wuffs_base__color_transform__func  //
+wuffs_base__color_transform__func_for(uint32_t pixfmt_repr) {
+  switch (pixfmt_repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGR:
+      return &wuffs_base__color_transform__transform_bgr;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGB:
+      return &wuffs_base__color_transform__transform_rgb;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return &wuffs_base__color_transform__transform_bgrx__x86_avx2;
+      }
+#endif
+      return &wuffs_base__color_transform__transform_bgrx;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return &wuffs_base__color_transform__transform_rgbx__x86_avx2;
+      }
+#endif
+      return &wuffs_base__color_transform__transform_rgbx;
+
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return &wuffs_base__color_transform__transform_bgra_premul__x86_avx2;
+      }
+#endif
+      return &wuffs_base__color_transform__transform_bgra_premul;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return &wuffs_base__color_transform__transform_rgba_premul__x86_avx2;
+      }
+#endif
+      return &wuffs_base__color_transform__transform_rgba_premul;
+  }
+  return NULL;
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__color_transform__transform_pixel_buffer(
+    const wuffs_base__color_transform* t,
+    wuffs_base__pixel_buffer* pb) {
+  if (!pb) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  } else if (wuffs_base__color_transform__is_identity(t)) {
+    return wuffs_base__make_status(NULL);
+  }
+  wuffs_base__color_transform__func func =
+      wuffs_base__color_transform__func_for(pb->pixcfg.private_impl.pixfmt.repr);
+  if (!func) {
+    return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+
+  size_t len = ((size_t)wuffs_base__pixel_config__width(&pb->pixcfg)) *
+               (wuffs_base__pixel_format__bits_per_pixel(
+                    &pb->pixcfg.private_impl.pixfmt) /
+                8);
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(pb, 0);
+  if (len > tab.width) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  size_t y;
+  for (y = 0; y < tab.height; y++) {
+    (*func)(t, tab.ptr + (y * tab.stride), len);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_decode_frame_options(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__decode_frame_options* opts) {
+  if (!p) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  p->private_impl.color_transform_func = NULL;
+  p->private_impl.color_transform = NULL;
+
+  wuffs_base__status status = wuffs_base__pixel_swizzler__set_quantizer(
+      p, dst, wuffs_base__decode_frame_options__quantizer(opts));
+  if (!wuffs_base__status__is_ok(&status)) {
+    return status;
+  }
+  status = wuffs_base__pixel_swizzler__set_dither(
+      p, dst, wuffs_base__decode_frame_options__dither(opts),
+      wuffs_base__decode_frame_options__dither_workbuf(opts));
+  if (!wuffs_base__status__is_ok(&status)) {
+    return status;
+  }
+
+  const wuffs_base__color_transform* t =
+      wuffs_base__decode_frame_options__color_transform(opts);
+  if (wuffs_base__color_transform__is_identity(t)) {
+    return wuffs_base__make_status(NULL);
+  }
+  wuffs_base__color_transform__func func =
+      wuffs_base__color_transform__func_for(p->private_impl.dst_pixfmt_repr);
+  if (!func || !p->private_impl.func ||
+      (p->private_impl.blend != WUFFS_BASE__PIXEL_BLEND__SRC)) {
+    return wuffs_base__make_status(
+        wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  p->private_impl.color_transform_func = func;
+  p->private_impl.color_transform = t;
+  return wuffs_base__make_status(NULL);
+}
@@ -0,0 +1,374 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// --------
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static void  //
+wuffs_base__pixel_swizzler__dither_ordered__bgr_565__arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels,
+    uint32_t x,
+    uint32_t y);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels,
+    uint32_t x,
+    uint32_t y);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// --------
+
+// Dithering is a second stage after a regular swizzler func. That first stage
+// converts up to WUFFS_BASE__PIXEL_SWIZZLER__DITHER__CHUNK source pixels at a
+// time to BGRA_NONPREMUL_4X16LE, the widest pixel format, in a buffer on the
+// stack. The second stage then premultiplies by alpha (BGR_565 is opaque, so
+// this is SRC blending over black) and narrows each channel, adding ordered
+// thresholds or diffused errors.
+//
+// Each 16-bit channel value v (a premultiplied color, in [0 ..= 0xFFFF]) maps
+// to a 5-bit value (((v * 31) + (v >> 11) + t) >> 16) and likewise for 6 bits
+// ((v * 63) + (v >> 10) etc). The (v >> 11) term approximates (v * 31 /
+// 0xFFFF), so that 0xFFFF maps to 31 for any threshold t in [0 .. 0x10000).
+
+#define WUFFS_BASE__PIXEL_SWIZZLER__DITHER__CHUNK 64
+
+// wuffs_base__pixel_swizzler__dither__bayer8 is the 8x8 Bayer (ordered
+// dither) matrix.
+static const uint8_t wuffs_base__pixel_swizzler__dither__bayer8[8][8] = {
+    {0x00, 0x20, 0x08, 0x28, 0x02, 0x22, 0x0A, 0x2A},  //
+    {0x30, 0x10, 0x38, 0x18, 0x32, 0x12, 0x3A, 0x1A},  //
+    {0x0C, 0x2C, 0x04, 0x24, 0x0E, 0x2E, 0x06, 0x26},  //
+    {0x3C, 0x1C, 0x34, 0x14, 0x3E, 0x1E, 0x36, 0x16},  //
+    {0x03, 0x23, 0x0B, 0x2B, 0x01, 0x21, 0x09, 0x29},  //
+    {0x33, 0x13, 0x3B, 0x1B, 0x31, 0x11, 0x39, 0x19},  //
+    {0x0F, 0x2F, 0x07, 0x27, 0x0D, 0x2D, 0x05, 0x25},  //
+    {0x3F, 0x1F, 0x37, 0x17, 0x3D, 0x1D, 0x35, 0x15},  //
+};
+
+// wuffs_base__pixel_swizzler__dither__threshold returns the ordered dither
+// threshold, in [0 .. 0x10000), for the pixel at (x, y).
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__dither__threshold(uint32_t x, uint32_t y) {
+  return (((uint32_t)(wuffs_base__pixel_swizzler__dither__bayer8[y & 7][x & 7]))
+          << 10) |
+         0x200u;
+}
+
+// wuffs_base__pixel_swizzler__dither__premul returns ((v * a) / 0xFFFF),
+// computed without a division. It is exact for all 16-bit v and a.
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__dither__premul(uint32_t v, uint32_t a) {
+  uint32_t p = v * a;
+  return (p + (p >> 16) + 1u) >> 16;
+}
+
+static void  //
+wuffs_base__pixel_swizzler__dither_ordered__bgr_565(uint8_t* dst_ptr,
+                                                    const uint8_t* src_ptr,
+                                                    size_t num_pixels,
+                                                    uint32_t x,
+                                                    uint32_t y) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  while (n >= 1) {
+    uint32_t t = wuffs_base__pixel_swizzler__dither__threshold(x, y);
+    uint32_t a = wuffs_base__peek_u16le__no_bounds_check(s + 6);
+    uint32_t b = wuffs_base__pixel_swizzler__dither__premul(
+        wuffs_base__peek_u16le__no_bounds_check(s + 0), a);
+    uint32_t g = wuffs_base__pixel_swizzler__dither__premul(
+        wuffs_base__peek_u16le__no_bounds_check(s + 2), a);
+    uint32_t r = wuffs_base__pixel_swizzler__dither__premul(
+        wuffs_base__peek_u16le__no_bounds_check(s + 4), a);
+    b = ((b * 31u) + (b >> 11) + t) >> 16;
+    g = ((g * 63u) + (g >> 10) + t) >> 16;
+    r = ((r * 31u) + (r >> 11) + t) >> 16;
+    wuffs_base__poke_u16le__no_bounds_check(
+        d, (uint16_t)((r << 11) | (g << 5) | (b << 0)));
+
+    s += 1 * 8;
+    d += 1 * 2;
+    n -= 1;
+    x += 1;
+  }
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__dither__error_diffusion_state is the start of
+// the ERROR_DIFFUSION work buffer, so that a row can be converted over
+// multiple swizzle calls. The rest of the work buffer holds, for each x and
+// each of the B, G and R channels, the error diffused from the row above (for
+// x at or after next_x) or to the row below (for x before it). All errors are
+// int32_t, in 1/16ths of a 16-bit channel value, as per Floyd-Steinberg's
+// 7/16, 3/16, 5/16 and 1/16 weights.
+typedef struct {
+  uint32_t next_x;
+  uint32_t next_y;
+  int32_t right[3];
+  int32_t below_left[3];
+  int32_t below[3];
+} wuffs_base__pixel_swizzler__dither__error_diffusion_state;
+
+static void  //
+wuffs_base__pixel_swizzler__dither_error_diffusion__bgr_565(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels,
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint8_t* workbuf_ptr) {
+  static const uint32_t muls[3] = {31u, 63u, 31u};
+  static const uint32_t shifts[3] = {11u, 10u, 11u};
+
+  wuffs_base__pixel_swizzler__dither__error_diffusion_state st;
+  memcpy(&st, workbuf_ptr, sizeof st);
+  uint8_t* errs = workbuf_ptr + 64;
+  if ((st.next_x != x) || (st.next_y != y)) {
+    memset(&st, 0, sizeof st);
+    memset(errs, 0, 12u * ((size_t)width));
+  }
+
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  while (n >= 1) {
+    uint32_t a = wuffs_base__peek_u16le__no_bounds_check(s + 6);
+    uint8_t* e = errs + (12u * ((size_t)x));
+    uint32_t q[3];
+    int c = 0;
+    for (; c < 3; c++) {
+      uint32_t v = wuffs_base__pixel_swizzler__dither__premul(
+          wuffs_base__peek_u16le__no_bounds_check(s + (2 * c)), a);
+      int32_t v16 = ((int32_t)(v << 4)) + st.right[c] +
+                    ((int32_t)(wuffs_base__peek_u32le__no_bounds_check(
+                        e + (4 * c))));
+      v = (v16 <= 0)
+              ? 0u
+              : wuffs_base__u32__min(((uint32_t)v16 + 8u) >> 4, 0xFFFFu);
+      uint32_t m = muls[c];
+      q[c] = ((v * m) + (v >> shifts[c]) + 0x8000u) >> 16;
+      int32_t err =
+          ((int32_t)v) - ((int32_t)(((q[c] * 0xFFFFu) + (m / 2)) / m));
+
+      st.right[c] = 7 * err;
+      if (x > 0) {
+        wuffs_base__poke_u32le__no_bounds_check(
+            e - 12 + (4 * c), (uint32_t)(st.below_left[c] + (3 * err)));
+      }
+      st.below_left[c] = st.below[c] + (5 * err);
+      st.below[c] = err;
+    }
+    wuffs_base__poke_u16le__no_bounds_check(
+        d, (uint16_t)((q[2] << 11) | (q[1] << 5) | (q[0] << 0)));
+
+    s += 1 * 8;
+    d += 1 * 2;
+    n -= 1;
+    x += 1;
+  }
+
+  if (x < width) {
+    st.next_x = x;
+    st.next_y = y;
+  } else {
+    uint8_t* e = errs + (12u * ((size_t)(width - 1)));
+    int c = 0;
+    for (; c < 3; c++) {
+      wuffs_base__poke_u32le__no_bounds_check(e + (4 * c),
+                                              (uint32_t)st.below_left[c]);
+    }
+    memset(&st, 0, sizeof st);
+    st.next_y = y + 1;
+  }
+  memcpy(workbuf_ptr, &st, sizeof st);
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__swizzle_dithered is like the prepared swizzler
+// func, for a BGR_565 destination, but dithers. Pixels outside of the
+// set_dither call's pixel buffer are converted without dithering.
+static uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_dithered(
+    const wuffs_base__pixel_swizzler* p,
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t stride = p->private_impl.dither_origin_stride;
+  uintptr_t offset =
+      ((uintptr_t)dst_ptr) - ((uintptr_t)p->private_impl.dither_origin_ptr);
+  if ((((uintptr_t)dst_ptr) < ((uintptr_t)p->private_impl.dither_origin_ptr)) ||
+      (stride < 2) ||
+      ((offset / stride) >= p->private_impl.dither_origin_height)) {
+    return (*p->private_impl.func)(dst_ptr, dst_len, dst_palette_ptr,
+                                   dst_palette_len, src_ptr, src_len);
+  }
+
+  size_t src_bytes_per_pixel = p->private_impl.src_pixfmt_bytes_per_pixel;
+  size_t dst_len2 = dst_len / 2;
+  size_t src_len_n = src_len / src_bytes_per_pixel;
+  size_t len = (dst_len2 < src_len_n) ? dst_len2 : src_len_n;
+  uint32_t width = p->private_impl.dither_origin_width;
+
+  uint8_t wide[8 * WUFFS_BASE__PIXEL_SWIZZLER__DITHER__CHUNK];
+  size_t n = len;
+  while (n > 0) {
+    uint32_t y = (uint32_t)(offset / stride);
+    uint32_t x = (uint32_t)((offset % stride) / 2);
+    size_t run = (size_t)wuffs_base__u64__min(
+        n, WUFFS_BASE__PIXEL_SWIZZLER__DITHER__CHUNK);
+    if (x < width) {
+      run = (size_t)wuffs_base__u64__min(run, width - x);
+    } else if (((stride / 2) - x) > 0) {
+      run = (size_t)wuffs_base__u64__min(run, (stride / 2) - x);
+    }
+
+    (*p->private_impl.dither_wide_func)(wide, sizeof wide, NULL, 0, src_ptr,
+                                        run * src_bytes_per_pixel);
+    if ((x < width) && (y < p->private_impl.dither_origin_height) &&
+        (p->private_impl.dither ==
+         WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION)) {
+      wuffs_base__pixel_swizzler__dither_error_diffusion__bgr_565(
+          dst_ptr, wide, run, x, y, width,
+          p->private_impl.dither_workbuf.ptr);
+    } else {
+      (*p->private_impl.dither_ordered_func)(dst_ptr, wide, run, x, y);
+    }
+
+    dst_ptr += 2 * run;
+    src_ptr += src_bytes_per_pixel * run;
+    offset += 2 * run;
+    n -= run;
+  }
+  return len;
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_dither(wuffs_base__pixel_swizzler* p,
+                                       const wuffs_base__pixel_buffer* dst,
+                                       wuffs_base__pixel_dither dither,
+                                       wuffs_base__slice_u8 workbuf) {
+  if (!p) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  p->private_impl.dither = WUFFS_BASE__PIXEL_DITHER__NONE;
+  p->private_impl.dither_wide_func = NULL;
+  p->private_impl.dither_ordered_func = NULL;
+  p->private_impl.dither_origin_ptr = NULL;
+  p->private_impl.dither_origin_stride = 0;
+  p->private_impl.dither_origin_width = 0;
+  p->private_impl.dither_origin_height = 0;
+  p->private_impl.dither_workbuf = wuffs_base__empty_slice_u8();
+
+  // Quantizing swizzlers (with indexed destinations) only support error
+  // diffusion, as ordered dithering needs to know the palette's spacing.
+  bool quantizing = (p->private_impl.quantize_wide_func != NULL) &&
+                    (dither == WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION);
+
+  if (dither == WUFFS_BASE__PIXEL_DITHER__NONE) {
+    return wuffs_base__make_status(NULL);
+  } else if ((dither > WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION) || !dst) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  } else if (!p->private_impl.func ||
+             (p->private_impl.blend != WUFFS_BASE__PIXEL_BLEND__SRC) ||
+             ((p->private_impl.dst_pixfmt_repr !=
+               WUFFS_BASE__PIXEL_FORMAT__BGR_565) &&
+              !quantizing) ||
+             (dst->pixcfg.private_impl.pixfmt.repr !=
+              p->private_impl.dst_pixfmt_repr)) {
+    return wuffs_base__make_status(NULL);
+  }
+
+  uint32_t width = dst->pixcfg.private_impl.width;
+  if (dither == WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION) {
+    if (workbuf.len <
+        wuffs_base__pixel_dither__error_diffusion_workbuf_len(width)) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+    wuffs_base__pixel_swizzler__dither__error_diffusion_state st;
+    memset(&st, 0, sizeof st);
+    st.next_y = 0xFFFFFFFFu;
+    memcpy(workbuf.ptr, &st, sizeof st);
+  }
+
+  if (!quantizing) {
+    // No-op.
+  } else {
+    p->private_impl.dither = dither;
+    p->private_impl.dither_origin_ptr = dst->private_impl.planes[0].ptr;
+    p->private_impl.dither_origin_stride = dst->private_impl.planes[0].stride;
+    p->private_impl.dither_origin_width = width;
+    p->private_impl.dither_origin_height = dst->pixcfg.private_impl.height;
+    p->private_impl.dither_workbuf = workbuf;
+    return wuffs_base__make_status(NULL);
+  }
+
+  // Indexed source pixel formats' swizzler funcs use the (prepared for
+  // BGR_565) dst_palette, so they cannot be re-purposed for dithering.
+  wuffs_base__pixel_format src_pixfmt =
+      wuffs_base__make_pixel_format(p->private_impl.src_pixfmt_repr);
+  if (wuffs_base__pixel_format__is_indexed(&src_pixfmt)) {
+    return wuffs_base__make_status(NULL);
+  }
+  wuffs_base__pixel_swizzler wide;
+  wuffs_base__status status = wuffs_base__pixel_swizzler__prepare(
+      &wide,
+      wuffs_base__make_pixel_format(
+          WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE),
+      wuffs_base__empty_slice_u8(), src_pixfmt, wuffs_base__empty_slice_u8(),
+      WUFFS_BASE__PIXEL_BLEND__SRC);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return wuffs_base__make_status(NULL);
+  }
+
+  wuffs_base__pixel_swizzler__dither_func ordered_func =
+      &wuffs_base__pixel_swizzler__dither_ordered__bgr_565;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    ordered_func =
+        &wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2;
+  }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    ordered_func =
+        &wuffs_base__pixel_swizzler__dither_ordered__bgr_565__arm_neon;
+  }
+#endif
+
+  p->private_impl.dither = dither;
+  p->private_impl.dither_wide_func = wide.private_impl.func;
+  p->private_impl.dither_ordered_func = ordered_func;
+  p->private_impl.dither_origin_ptr = dst->private_impl.planes[0].ptr;
+  p->private_impl.dither_origin_stride = dst->private_impl.planes[0].stride;
+  p->private_impl.dither_origin_width = width;
+  p->private_impl.dither_origin_height = dst->pixcfg.private_impl.height;
+  p->private_impl.dither_workbuf = workbuf;
+  return wuffs_base__make_status(NULL);
+}
@@ -0,0 +1,662 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// --------
+
+// Converting from f32 to f16 with NEON needs the half precision conversion
+// instructions, which are optional for 32-bit ARM.
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON) && defined(__ARM_FP) && \
+    ((__ARM_FP & 0x02) != 0)
+#define WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__ARM_NEON_F16
+#endif
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+#if defined(WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__ARM_NEON_F16)
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__ARM_NEON_F16)
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2,f16c")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2,f16c")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// --------
+
+// Like dithering and quantizing, converting to floating point pixel formats
+// is a second stage after a regular swizzler func. That first stage converts
+// up to WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__CHUNK source pixels at a time to
+// BGRA_NONPREMUL_4X16LE, the widest integer pixel format, in a buffer on the
+// stack. The second stage then converts each 16-bit channel to a float in [0,
+// 1] (optionally decoding the sRGB transfer function), premultiplies by alpha
+// and reorders to RGBA. There is no first stage if the source pixel format is
+// already BGRA_NONPREMUL_4X16LE.
+//
+// The second stage only multiplies (and, for _LINEAR formats, does integer
+// arithmetic), with no floating point additions, so that its SIMD
+// implementations produce exactly the same output as the non-SIMD ones, even
+// if the C compiler fuses multiplies and adds.
+
+#define WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__CHUNK 64
+
+// wuffs_base__pixel_swizzler__float__srgb_to_linear is the sRGB transfer
+// function (decoding, from encoded values to linear light) sampled at (i /
+// 256) for i in [0 ..= 256], where 1.0 is 0x40000000. The final element is
+// repeated so that interpolating at 1.0 does not read out of bounds.
+static const uint32_t wuffs_base__pixel_swizzler__float__srgb_to_linear[258] = {
+    0x00000000, 0x0004F41D, 0x0009E839, 0x000EDC56, 0x0013D072, 0x0018C48F,
+    0x001DB8AB, 0x0022ACC8, 0x0027A0E4, 0x002C9501, 0x0031891D, 0x00369A9E,
+    0x003BF9D1, 0x0041A4DC, 0x00479CE6, 0x004DE30F, 0x00547871, 0x005B5E20,
+    0x0062952A, 0x006A1E9A, 0x0071FB73, 0x007A2CB6, 0x0082B35F, 0x008B9063,
+    0x0094C4B8, 0x009E514B, 0x00A83708, 0x00B276D7, 0x00BD119D, 0x00C8083A,
+    0x00D35B8D, 0x00DF0C71, 0x00EB1BBD, 0x00F78A46, 0x010458DF, 0x01118857,
+    0x011F197B, 0x012D0D16, 0x013B63F1, 0x014A1ED0, 0x01593E78, 0x0168C3A9,
+    0x0178AF24, 0x018901A4, 0x0199BBE6, 0x01AADEA2, 0x01BC6A90, 0x01CE6065,
+    0x01E0C0D4, 0x01F38C90, 0x0206C449, 0x021A68AD, 0x022E7A69, 0x0242FA29,
+    0x0257E895, 0x026D4657, 0x02831414, 0x02995273, 0x02B00217, 0x02C723A2,
+    0x02DEB7B6, 0x02F6BEF3, 0x030F39F7, 0x0328295F, 0x03418DC8, 0x035B67CC,
+    0x0375B805, 0x03907F0B, 0x03ABBD76, 0x03C773DD, 0x03E3A2D3, 0x04004AEE,
+    0x041D6CC0, 0x043B08DB, 0x04591FD0, 0x0477B230, 0x0496C089, 0x04B64B69,
+    0x04D6535D, 0x04F6D8F2, 0x0517DCB2, 0x05395F29, 0x055B60DF, 0x057DE25D,
+    0x05A0E42C, 0x05C466D1, 0x05E86AD3, 0x060CF0B7, 0x0631F903, 0x06578438,
+    0x067D92DC, 0x06A4256E, 0x06CB3C72, 0x06F2D868, 0x071AF9CF, 0x0743A128,
+    0x076CCEF0, 0x079683A5, 0x07C0BFC5, 0x07EB83CC, 0x0816D036, 0x0842A57E,
+    0x086F041E, 0x089BEC91, 0x08C95F50, 0x08F75CD4, 0x0925E593, 0x0954FA07,
+    0x09849AA6, 0x09B4C7E5, 0x09E5823B, 0x0A16CA1D, 0x0A489FFF, 0x0A7B0456,
+    0x0AADF794, 0x0AE17A2D, 0x0B158C93, 0x0B4A2F37, 0x0B7F628C, 0x0BB52701,
+    0x0BEB7D07, 0x0C22650F, 0x0C59DF86, 0x0C91ECDC, 0x0CCA8D7F, 0x0D03C1DE,
+    0x0D3D8A64, 0x0D77E780, 0x0DB2D99D, 0x0DEE6127, 0x0E2A7E8A, 0x0E673232,
+    0x0EA47C87, 0x0EE25DF5, 0x0F20D6E6, 0x0F5FE7C2, 0x0F9F90F3, 0x0FDFD2E0,
+    0x1020ADF2, 0x10622291, 0x10A43123, 0x10E6DA10, 0x112A1DBE, 0x116DFC92,
+    0x11B276F2, 0x11F78D45, 0x123D3FED, 0x12838F51, 0x12CA7BD3, 0x131205D8,
+    0x135A2DC3, 0x13A2F3F7, 0x13EC58D7, 0x14365CC4, 0x14810021, 0x14CC434F,
+    0x151826AF, 0x1564AAA3, 0x15B1CF8A, 0x15FF95C6, 0x164DFDB5, 0x169D07B7,
+    0x16ECB42C, 0x173D0372, 0x178DF5E8, 0x17DF8BEC, 0x1831C5DC, 0x1884A415,
+    0x18D826F5, 0x192C4ED9, 0x19811C1D, 0x19D68F1D, 0x1A2CA837, 0x1A8367C5,
+    0x1ADACE23, 0x1B32DBAC, 0x1B8B90BB, 0x1BE4EDAB, 0x1C3EF2D5, 0x1C99A095,
+    0x1CF4F742, 0x1D50F738, 0x1DADA0D0, 0x1E0AF461, 0x1E68F245, 0x1EC79AD5,
+    0x1F26EE67, 0x1F86ED55, 0x1FE797F5, 0x2048EE9F, 0x20AAF1AA, 0x210DA16D,
+    0x2170FE3E, 0x21D50874, 0x2239C065, 0x229F2666, 0x23053ACD, 0x236BFDEF,
+    0x23D37021, 0x243B91B9, 0x24A4630A, 0x250DE469, 0x2578162A, 0x25E2F8A2,
+    0x264E8C22, 0x26BAD100, 0x2727C78E, 0x2795701F, 0x2803CB06, 0x2872D895,
+    0x28E2991F, 0x29530CF5, 0x29C4346A, 0x2A360FCF, 0x2AA89F75, 0x2B1BE3AE,
+    0x2B8FDCCA, 0x2C048B1B, 0x2C79EEF0, 0x2CF0089B, 0x2D66D86B, 0x2DDE5EB0,
+    0x2E569BBB, 0x2ECF8FDA, 0x2F493B5C, 0x2FC39E92, 0x303EB9C9, 0x30BA8D51,
+    0x31371978, 0x31B45E8C, 0x32325CDB, 0x32B114B5, 0x33308665, 0x33B0B23A,
+    0x34319881, 0x34B33987, 0x3535959A, 0x35B8AD06, 0x363C8017, 0x36C10F1B,
+    0x37465A5C, 0x37CC6229, 0x385326CB, 0x38DAA890, 0x3962E7C2, 0x39EBE4AE,
+    0x3A759F9D, 0x3B0018DC, 0x3B8B50B5, 0x3C174772, 0x3CA3FD5F, 0x3D3172C5,
+    0x3DBFA7EE, 0x3E4E9D26, 0x3EDE52B5, 0x3F6EC8E5, 0x40000000, 0x40000000,
+};
+
+// wuffs_base__pixel_swizzler__float__linearize returns the linear light value
+// (where 1.0 is 0x40000000) of the 16-bit sRGB encoded value c, linearly
+// interpolating the look-up table. The interpolation position p is c scaled
+// from [0 ..= 0xFFFF] to [0 ..= 0x10000], rounded to nearest. The result is
+// within 2e-5 of the exact sRGB curve, comparable to 16-bit precision.
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__float__linearize(uint32_t c) {
+  uint32_t p = c + ((c + 0x8000u) >> 16);
+  uint32_t lo = wuffs_base__pixel_swizzler__float__srgb_to_linear[p >> 8];
+  uint32_t hi = wuffs_base__pixel_swizzler__float__srgb_to_linear[(p >> 8) + 1];
+  return lo + (((hi - lo) * (p & 0xFFu)) >> 8);
+}
+
+// wuffs_base__pixel_swizzler__float__delinearize is the approximate inverse
+// of wuffs_base__pixel_swizzler__float__linearize, for v in [0, 1].
+static uint32_t  //
+wuffs_base__pixel_swizzler__float__delinearize(float v) {
+  const uint32_t* t = wuffs_base__pixel_swizzler__float__srgb_to_linear;
+  if (!(v > 0.0f)) {
+    return 0;
+  } else if (!(v < 1.0f)) {
+    return 0xFFFF;
+  }
+  uint32_t l = (uint32_t)(v * 1073741824.0f);
+
+  // Binary search for the largest i such that (t[i] <= l).
+  uint32_t i = 0;
+  uint32_t j = 256;
+  while (i < j) {
+    uint32_t m = (i + j + 1) / 2;
+    if (t[m] <= l) {
+      i = m;
+    } else {
+      j = m - 1;
+    }
+  }
+
+  uint32_t p = i << 8;
+  uint32_t range = t[i + 1] - t[i];
+  if (range > 0) {
+    p += (uint32_t)(((((uint64_t)(l - t[i])) << 8) + (range / 2)) / range);
+  }
+  if (p >= 0x8001u) {
+    p -= 1;
+  }
+  return (p < 0xFFFFu) ? p : 0xFFFFu;
+}
+
+static inline uint32_t  //
+wuffs_base__pixel_swizzler__float__f32_bits(float f) {
+  uint32_t u = 0;
+  if (sizeof(uint32_t) == sizeof(float)) {
+    memcpy(&u, &f, sizeof(uint32_t));
+  }
+  return u;
+}
+
+// wuffs_base__pixel_swizzler__float__f16_bits converts from f32 to f16,
+// rounding to nearest even, like the F16C and NEON instructions do (for
+// non-NaN values). Unlike
+// wuffs_base__ieee_754_bit_representation__from_f64_to_u16_truncate, it does
+// not truncate and does not need the FLOATCONV sub-module.
+static inline uint16_t  //
+wuffs_base__pixel_swizzler__float__f16_bits(float f) {
+  uint32_t u = wuffs_base__pixel_swizzler__float__f32_bits(f);
+  uint16_t sign = (uint16_t)((u >> 16) & 0x8000u);
+  u &= 0x7FFFFFFFu;
+
+  if (u >= 0x47800000u) {  // Too large (or infinity or NaN) for a finite f16.
+    return sign | ((u > 0x7F800000u) ? 0x7E00u : 0x7C00u);
+
+  } else if (u < 0x38800000u) {  // Subnormal f16 (or zero).
+    // Adding 0.5 aligns the f16's 10 mantissa bits with the bottom of the
+    // f32's 23 mantissa bits, rounding to nearest even.
+    float g =
+        ((float)wuffs_base__ieee_754_bit_representation__from_u32_to_f64(u)) +
+        0.5f;
+    return sign |
+           ((uint16_t)(wuffs_base__pixel_swizzler__float__f32_bits(g) -
+                       0x3F000000u));
+  }
+
+  // Normal f16. Re-bias the exponent from 127 to 15, adding 0xC8000000 (which
+  // is ((15 - 127) << 23) modulo 1<<32), and round to nearest even.
+  u += 0xC8000FFFu + ((u >> 13) & 1u);
+  return sign | ((uint16_t)(u >> 13));
+}
+
+// wuffs_base__pixel_swizzler__float__peek returns the f16 or f32 at ptr.
+static inline float  //
+wuffs_base__pixel_swizzler__float__peek(const uint8_t* ptr, bool f16) {
+  if (f16) {
+    return (float)wuffs_base__ieee_754_bit_representation__from_u16_to_f64(
+        wuffs_base__peek_u16le__no_bounds_check(ptr));
+  }
+  return (float)wuffs_base__ieee_754_bit_representation__from_u32_to_f64(
+      wuffs_base__peek_u32le__no_bounds_check(ptr));
+}
+
+// wuffs_base__pixel_swizzler__float__poke writes v to ptr as an f16 or f32.
+static inline void  //
+wuffs_base__pixel_swizzler__float__poke(uint8_t* ptr, float v, bool f16) {
+  if (f16) {
+    wuffs_base__poke_u16le__no_bounds_check(
+        ptr, wuffs_base__pixel_swizzler__float__f16_bits(v));
+  } else {
+    wuffs_base__poke_u32le__no_bounds_check(
+        ptr, wuffs_base__pixel_swizzler__float__f32_bits(v));
+  }
+}
+
+// wuffs_base__pixel_swizzler__float__premul converts the
+// BGRA_NONPREMUL_4X16LE pixel at src_ptr to premultiplied RGBA floats.
+static inline void  //
+wuffs_base__pixel_swizzler__float__premul(float* dst_rgba,
+                                          const uint8_t* src_ptr,
+                                          bool linear) {
+  float a = ((float)wuffs_base__peek_u16le__no_bounds_check(src_ptr + 6)) *
+            (1.0f / 65535.0f);
+  int i;
+  for (i = 0; i < 3; i++) {
+    uint32_t c = wuffs_base__peek_u16le__no_bounds_check(src_ptr + 4 - (2 * i));
+    float v = 0;
+    if (linear) {
+      v = ((float)wuffs_base__pixel_swizzler__float__linearize(c)) *
+          (1.0f / 1073741824.0f);
+    } else {
+      v = ((float)c) * (1.0f / 65535.0f);
+    }
+    dst_rgba[i] = v * a;
+  }
+  dst_rgba[3] = a;
+}
+
+// --------
+
+static inline uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    const uint8_t* src_ptr,
+    size_t src_len,
+    bool f16,
+    bool linear,
+    bool src_over) {
+  size_t dst_bytes_per_channel = f16 ? 2 : 4;
+  size_t dst_len_n = dst_len / (4 * dst_bytes_per_channel);
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len_n < src_len8) ? dst_len_n : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    float c[4];
+    wuffs_base__pixel_swizzler__float__premul(c, s, linear);
+    size_t i;
+    if (src_over) {
+      // Composite premultiplied s over premultiplied d: s + (d * (1 - sa)).
+      float ia = 1.0f - c[3];
+      for (i = 0; i < 4; i++) {
+        c[i] += ia * wuffs_base__pixel_swizzler__float__peek(
+                         d + (i * dst_bytes_per_channel), f16);
+      }
+    }
+    for (i = 0; i < 4; i++) {
+      wuffs_base__pixel_swizzler__float__poke(d + (i * dst_bytes_per_channel),
+                                              c[i], f16);
+    }
+
+    s += 1 * 8;
+    d += 4 * dst_bytes_per_channel;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, true, false, false);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, true, false, true);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, true, true, false);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, true, true, true);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, false, false, false);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, false, false, true);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, false, true, false);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      dst_ptr, dst_len, src_ptr, src_len, false, true, true);
+}
+
+// --------
+
+static wuffs_base__color_u32_argb_premul  //
+wuffs_base__pixel_swizzler__float__peek_color_u32(uint32_t pixfmt_repr,
+                                                  const uint8_t* ptr) {
+  bool f16 = (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16) ||
+             (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR);
+  bool linear =
+      (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR) ||
+      (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR);
+  size_t dst_bytes_per_channel = f16 ? 2 : 4;
+
+  float a = wuffs_base__pixel_swizzler__float__peek(
+      ptr + (3 * dst_bytes_per_channel), f16);
+  if (!(a > 0.0f)) {
+    return 0;
+  } else if (a > 1.0f) {
+    a = 1.0f;
+  }
+
+  uint64_t c = ((uint64_t)((a * 65535.0f) + 0.5f)) << 48;
+  size_t i;
+  for (i = 0; i < 3; i++) {
+    float v = wuffs_base__pixel_swizzler__float__peek(
+                  ptr + (i * dst_bytes_per_channel), f16) /
+              a;
+    uint32_t v16 = 0;
+    if (linear) {
+      v16 = wuffs_base__pixel_swizzler__float__delinearize(v);
+    } else if (!(v > 0.0f)) {
+      v16 = 0;
+    } else if (!(v < 1.0f)) {
+      v16 = 0xFFFF;
+    } else {
+      v16 = (uint32_t)((v * 65535.0f) + 0.5f);
+    }
+    c |= ((uint64_t)v16) << (32 - (16 * i));
+  }
+  return wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(c);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__float__poke_color_u32(
+    uint32_t pixfmt_repr,
+    uint8_t* ptr,
+    wuffs_base__color_u32_argb_premul color) {
+  bool f16 = (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16) ||
+             (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR);
+  bool linear =
+      (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR) ||
+      (pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR);
+
+  uint8_t src[8];
+  wuffs_base__poke_u64le__no_bounds_check(
+      src,
+      wuffs_base__color_u32_argb_premul__as__color_u64_argb_nonpremul(color));
+  wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      ptr, f16 ? 8 : 16, src, 8, f16, linear, false);
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__swizzle_float is the two stage swizzler func
+// for floating point destinations.
+static uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_float(const wuffs_base__pixel_swizzler* p,
+                                          uint8_t* dst_ptr,
+                                          size_t dst_len,
+                                          uint8_t* dst_palette_ptr,
+                                          size_t dst_palette_len,
+                                          const uint8_t* src_ptr,
+                                          size_t src_len) {
+  size_t dst_bytes_per_pixel = p->private_impl.dst_pixfmt_bytes_per_pixel;
+  size_t src_bytes_per_pixel = p->private_impl.src_pixfmt_bytes_per_pixel;
+  size_t dst_len_n = dst_len / dst_bytes_per_pixel;
+  size_t src_len_n = src_len / src_bytes_per_pixel;
+  size_t len = (dst_len_n < src_len_n) ? dst_len_n : src_len_n;
+
+  uint8_t wide[8 * WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__CHUNK];
+  size_t n = len;
+  while (n > 0) {
+    size_t run = (size_t)wuffs_base__u64__min(
+        n, WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__CHUNK);
+    (*p->private_impl.float_wide_func)(wide, sizeof wide, dst_palette_ptr,
+                                       dst_palette_len, src_ptr,
+                                       run * src_bytes_per_pixel);
+    (*p->private_impl.func)(dst_ptr, run * dst_bytes_per_pixel, NULL, 0, wide,
+                            8 * run);
+
+    dst_ptr += dst_bytes_per_pixel * run;
+    src_ptr += src_bytes_per_pixel * run;
+    n -= run;
+  }
+  return len;
+}
+
+// wuffs_base__pixel_swizzler__prepare__float__second_stage returns the func
+// that converts from BGRA_NONPREMUL_4X16LE to the floating point dst_pixfmt.
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__float__second_stage(
+    wuffs_base__pixel_format dst_pixfmt,
+    wuffs_base__pixel_blend blend) {
+  switch (dst_pixfmt.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2() &&
+              wuffs_base__cpu_arch__have_x86_f16c()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__ARM_NEON_F16)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src_over;
+      }
+      return NULL;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2() &&
+              wuffs_base__cpu_arch__have_x86_f16c()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__PIXEL_SWIZZLER__FLOAT__ARM_NEON_F16)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src_over;
+      }
+      return NULL;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src_over;
+      }
+      return NULL;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src_over;
+      }
+      return NULL;
+  }
+  return NULL;
+}
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__float(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_pixfmt,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__pixel_format src_pixfmt,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend) {
+  wuffs_base__pixel_swizzler__func func =
+      wuffs_base__pixel_swizzler__prepare__float__second_stage(dst_pixfmt,
+                                                               blend);
+  if (!func || (src_pixfmt.repr ==
+                WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE)) {
+    return func;
+  }
+
+  // For indexed sources, the first stage (like other swizzlers from indexed
+  // sources) writes the converted src_palette to dst_palette and reads it back
+  // when swizzling.
+  wuffs_base__pixel_swizzler wide;
+  wuffs_base__status status = wuffs_base__pixel_swizzler__prepare(
+      &wide,
+      wuffs_base__make_pixel_format(
+          WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE),
+      dst_palette, src_pixfmt, src_palette, WUFFS_BASE__PIXEL_BLEND__SRC);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return NULL;
+  }
+  p->private_impl.float_wide_func = wide.private_impl.func;
+  return func;
+}
@@ -0,0 +1,775 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// --------
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static void  //
+wuffs_base__pixel_quantizer__fill_cache_row__arm_neon(
+    uint8_t* dst_ptr,
+    const int32_t* rga_scores,
+    const int32_t* premul_bs,
+    uint32_t num_colors);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_quantizer__fill_cache_row__x86_avx2(
+    uint8_t* dst_ptr,
+    const int32_t* rga_scores,
+    const int32_t* premul_bs,
+    uint32_t num_colors);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static bool  //
+wuffs_base__pixel_swizzler__quantize_cached__x86_avx2(
+    const wuffs_base__pixel_quantizer* q,
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+// --------
+
+// Quantizing (converting non-indexed pixels to an indexed pixel format) is,
+// like dithering, a second stage after a regular swizzler func. That first
+// stage converts up to WUFFS_BASE__PIXEL_SWIZZLER__QUANTIZE__CHUNK source
+// pixels at a time to BGRA_PREMUL, in a buffer on the stack. The second stage
+// then maps each color to a palette index.
+//
+// Opaque colors are looked up in the pixel quantizer's cache, keyed by each
+// channel's high 5 bits. Each cache entry is the palette index closest (with
+// the same squared-difference metric as
+// wuffs_base__pixel_palette__closest_element) to the center of that 8x8x8
+// cell of 24-bit colors. Non-opaque colors, and all colors when there is no
+// pixel quantizer, are searched for directly.
+
+#define WUFFS_BASE__PIXEL_SWIZZLER__QUANTIZE__CHUNK 64
+
+// wuffs_base__pixel_quantizer__cache_index maps a BGRA_PREMUL color (as a
+// little-endian uint32_t, so that blue is the low byte) to its cache index.
+static inline uint32_t  //
+wuffs_base__pixel_quantizer__cache_index(uint32_t c) {
+  return ((c >> 9) & 0x7C00u) | ((c >> 6) & 0x03E0u) | ((c >> 3) & 0x001Fu);
+}
+
+// wuffs_base__pixel_quantizer__premul returns ((v * a) / 0xFF), rounded to
+// nearest, for 8-bit v and a.
+static inline int32_t  //
+wuffs_base__pixel_quantizer__premul(uint32_t v, uint32_t a) {
+  return (int32_t)(((v * a) + 127u) / 255u);
+}
+
+// wuffs_base__pixel_quantizer__fill_cache_row sets the 32 cache entries for
+// the cells with the given red and green (whose contributions to each palette
+// entry's score are in rga_scores, along with alpha's) and every blue.
+static void  //
+wuffs_base__pixel_quantizer__fill_cache_row(uint8_t* dst_ptr,
+                                            const int32_t* rga_scores,
+                                            const int32_t* premul_bs,
+                                            uint32_t num_colors) {
+  uint32_t b = 0;
+  for (; b < 32; b++) {
+    int32_t cb = (int32_t)((b << 3) | 4u);
+    int32_t best_score = 0x7FFFFFFF;
+    uint32_t best_index = 0;
+    uint32_t i = 0;
+    for (; i < num_colors; i++) {
+      int32_t db = cb - premul_bs[i];
+      int32_t score = rga_scores[i] + (db * db);
+      if (best_score > score) {
+        best_score = score;
+        best_index = i;
+      }
+    }
+    dst_ptr[b] = (uint8_t)best_index;
+  }
+}
+
+static void  //
+wuffs_base__pixel_quantizer__fill_cache(wuffs_base__pixel_quantizer* q) {
+  void (*fill_row)(uint8_t* dst_ptr, const int32_t* rga_scores,
+                   const int32_t* premul_bs, uint32_t num_colors) =
+      &wuffs_base__pixel_quantizer__fill_cache_row;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    fill_row = &wuffs_base__pixel_quantizer__fill_cache_row__x86_avx2;
+  }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    fill_row = &wuffs_base__pixel_quantizer__fill_cache_row__arm_neon;
+  }
+#endif
+
+  // The premul arrays hold each palette entry's premultiplied blue, green
+  // and red and its alpha's difference from opaque.
+  uint32_t n = q->private_impl.num_colors;
+  int32_t premul[4][256];
+  uint32_t i = 0;
+  for (; i < n; i++) {
+    const uint8_t* e = q->private_impl.palette + (4 * i);
+    uint32_t a = e[3];
+    premul[0][i] = wuffs_base__pixel_quantizer__premul(e[0], a);
+    premul[1][i] = wuffs_base__pixel_quantizer__premul(e[1], a);
+    premul[2][i] = wuffs_base__pixel_quantizer__premul(e[2], a);
+    premul[3][i] = (int32_t)(255u - a);
+  }
+
+  int32_t rga_scores[256];
+  uint32_t r = 0;
+  for (; r < 32; r++) {
+    int32_t cr = (int32_t)((r << 3) | 4u);
+    uint32_t g = 0;
+    for (; g < 32; g++) {
+      int32_t cg = (int32_t)((g << 3) | 4u);
+      for (i = 0; i < n; i++) {
+        int32_t dr = cr - premul[2][i];
+        int32_t dg = cg - premul[1][i];
+        int32_t da = premul[3][i];
+        rga_scores[i] = (dr * dr) + (dg * dg) + (da * da);
+      }
+      (*fill_row)(q->private_impl.cache + ((r << 10) | (g << 5)), rga_scores,
+                  premul[0], n);
+    }
+  }
+  memset(q->private_impl.cache + 32768, 0, 4);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_quantizer__set_palette(wuffs_base__pixel_quantizer* q,
+                                         wuffs_base__slice_u8 palette) {
+  if (!q) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  } else if ((palette.len == 0) || ((palette.len & 3) != 0) ||
+             (palette.len >
+              WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  memset(q->private_impl.palette, 0, sizeof q->private_impl.palette);
+  memcpy(q->private_impl.palette, palette.ptr, palette.len);
+  q->private_impl.num_colors = (uint32_t)(palette.len / 4);
+  wuffs_base__pixel_quantizer__fill_cache(q);
+  return wuffs_base__make_status(NULL);
+}
+
+// --------
+
+// The build_palette workbuf is a histogram, with 32768 bins (one per 15-bit
+// color). Each bin is four uint64_t values: the number of pixels and the sums
+// of their blue, green and red values.
+
+typedef struct {
+  // The min and max (inclusive) bin coordinates, indexed by 0, 1 or 2 for
+  // blue, green or red.
+  uint32_t min[3];
+  uint32_t max[3];
+  uint64_t count;
+} wuffs_base__pixel_quantizer__box;
+
+static inline uint64_t  //
+wuffs_base__pixel_quantizer__bin_count(const uint8_t* hist,
+                                       uint32_t b,
+                                       uint32_t g,
+                                       uint32_t r) {
+  return wuffs_base__peek_u64le__no_bounds_check(
+      hist + (32u * ((r << 10) | (g << 5) | b)));
+}
+
+// wuffs_base__pixel_quantizer__shrink_box shrinks the box to the bounds of
+// its non-empty bins and recalculates its count. If marginal is non-NULL, it
+// also accumulates the per-axis counts along that axis.
+static void  //
+wuffs_base__pixel_quantizer__shrink_box(const uint8_t* hist,
+                                        wuffs_base__pixel_quantizer__box* box,
+                                        uint32_t axis,
+                                        uint64_t* marginal) {
+  uint32_t new_min[3] = {31, 31, 31};
+  uint32_t new_max[3] = {0, 0, 0};
+  uint64_t count = 0;
+  uint32_t c[3];
+  for (c[2] = box->min[2]; c[2] <= box->max[2]; c[2]++) {
+    for (c[1] = box->min[1]; c[1] <= box->max[1]; c[1]++) {
+      for (c[0] = box->min[0]; c[0] <= box->max[0]; c[0]++) {
+        uint64_t n =
+            wuffs_base__pixel_quantizer__bin_count(hist, c[0], c[1], c[2]);
+        if (n == 0) {
+          continue;
+        }
+        count += n;
+        if (marginal) {
+          marginal[c[axis]] += n;
+        }
+        int j = 0;
+        for (; j < 3; j++) {
+          new_min[j] = wuffs_base__u32__min(new_min[j], c[j]);
+          new_max[j] = wuffs_base__u32__max(new_max[j], c[j]);
+        }
+      }
+    }
+  }
+  if (count > 0) {
+    memcpy(box->min, new_min, sizeof new_min);
+    memcpy(box->max, new_max, sizeof new_max);
+  }
+  box->count = count;
+}
+
+// wuffs_base__pixel_quantizer__longest_axis returns the box's longest axis,
+// favoring green and then red for ties, as the eye is more sensitive to them.
+static inline uint32_t  //
+wuffs_base__pixel_quantizer__longest_axis(
+    const wuffs_base__pixel_quantizer__box* box) {
+  uint32_t axis = 1;
+  if ((box->max[2] - box->min[2]) > (box->max[axis] - box->min[axis])) {
+    axis = 2;
+  }
+  if ((box->max[0] - box->min[0]) > (box->max[axis] - box->min[axis])) {
+    axis = 0;
+  }
+  return axis;
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_quantizer__build_palette(
+    wuffs_base__pixel_quantizer* q,
+    const wuffs_base__pixel_buffer* src,
+    uint32_t max_colors,
+    wuffs_base__slice_u8 workbuf) {
+  if (!q) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  } else if (!src || (max_colors < 1) || (max_colors > 256) ||
+             (workbuf.len <
+              wuffs_base__pixel_quantizer__build_palette_workbuf_len())) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+
+  // Indexed sources' swizzler funcs read the (converted) palette from their
+  // dst_palette argument.
+  wuffs_base__pixel_format src_pixfmt = src->pixcfg.private_impl.pixfmt;
+  uint8_t dst_palette[WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH];
+  wuffs_base__slice_u8 src_palette = wuffs_base__empty_slice_u8();
+  if (wuffs_base__pixel_format__is_indexed(&src_pixfmt)) {
+    const wuffs_base__table_u8* tab =
+        &src->private_impl
+             .planes[WUFFS_BASE__PIXEL_FORMAT__INDEXED__COLOR_PLANE];
+    src_palette = wuffs_base__make_slice_u8(tab->ptr, tab->width);
+  }
+  wuffs_base__pixel_swizzler wide;
+  wuffs_base__status status = wuffs_base__pixel_swizzler__prepare(
+      &wide,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      wuffs_base__make_slice_u8(dst_palette, sizeof dst_palette), src_pixfmt,
+      src_palette, WUFFS_BASE__PIXEL_BLEND__SRC);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return status;
+  }
+
+  // Build the histogram.
+  uint8_t* hist = workbuf.ptr;
+  memset(hist, 0, 32768u * 32u);
+  uint64_t num_transparent = 0;
+  uint32_t width = src->pixcfg.private_impl.width;
+  uint32_t height = src->pixcfg.private_impl.height;
+  size_t src_bytes_per_pixel = wide.private_impl.src_pixfmt_bytes_per_pixel;
+  const wuffs_base__table_u8* src_tab = &src->private_impl.planes[0];
+  uint8_t chunk[4 * WUFFS_BASE__PIXEL_SWIZZLER__QUANTIZE__CHUNK];
+  uint32_t y = 0;
+  for (; y < height; y++) {
+    const uint8_t* s = src_tab->ptr + (((size_t)y) * src_tab->stride);
+    size_t n = wuffs_base__u64__min(
+        width, src_tab->width / wuffs_base__u64__max(src_bytes_per_pixel, 1));
+    while (n > 0) {
+      size_t run = (size_t)wuffs_base__u64__min(
+          n, WUFFS_BASE__PIXEL_SWIZZLER__QUANTIZE__CHUNK);
+      (*wide.private_impl.func)(chunk, 4 * run, dst_palette,
+                                sizeof dst_palette, s,
+                                src_bytes_per_pixel * run);
+      const uint8_t* c = chunk;
+      size_t i = 0;
+      for (; i < run; i++, c += 4) {
+        if (c[3] < 0x80) {
+          num_transparent++;
+          continue;
+        }
+        uint8_t* bin = hist + (32u * ((((uint32_t)(c[2] >> 3)) << 10) |
+                                      (((uint32_t)(c[1] >> 3)) << 5) |
+                                      (((uint32_t)(c[0] >> 3)) << 0)));
+        int j = 0;
+        for (; j < 4; j++) {
+          uint64_t v = wuffs_base__peek_u64le__no_bounds_check(bin + (8 * j));
+          v += (j == 0) ? 1u : c[j - 1];
+          wuffs_base__poke_u64le__no_bounds_check(bin + (8 * j), v);
+        }
+      }
+      s += src_bytes_per_pixel * run;
+      n -= run;
+    }
+  }
+
+  // Reserve a transparent palette entry, if needed and if there's room.
+  wuffs_base__pixel_quantizer__box boxes[256];
+  uint32_t num_boxes = 0;
+  boxes[0].min[0] = boxes[0].min[1] = boxes[0].min[2] = 0;
+  boxes[0].max[0] = boxes[0].max[1] = boxes[0].max[2] = 31;
+  wuffs_base__pixel_quantizer__shrink_box(hist, &boxes[0], 0, NULL);
+  uint32_t max_boxes = max_colors;
+  bool transparent = false;
+  if ((num_transparent > 0) && ((max_colors > 1) || (boxes[0].count == 0))) {
+    transparent = true;
+    max_boxes--;
+  }
+  if ((boxes[0].count > 0) && (max_boxes > 0)) {
+    num_boxes = 1;
+  }
+
+  // Median cut: split the box with the highest (count * longest axis length)
+  // until there are enough boxes or no box can be split.
+  while (num_boxes < max_boxes) {
+    uint32_t best_box = 0;
+    uint64_t best_score = 0;
+    uint32_t i = 0;
+    for (; i < num_boxes; i++) {
+      uint32_t axis = wuffs_base__pixel_quantizer__longest_axis(&boxes[i]);
+      uint64_t score =
+          boxes[i].count * (boxes[i].max[axis] - boxes[i].min[axis]);
+      if (best_score < score) {
+        best_score = score;
+        best_box = i;
+      }
+    }
+    if (best_score == 0) {
+      break;
+    }
+
+    wuffs_base__pixel_quantizer__box* lo = &boxes[best_box];
+    wuffs_base__pixel_quantizer__box* hi = &boxes[num_boxes++];
+    uint32_t axis = wuffs_base__pixel_quantizer__longest_axis(lo);
+    uint64_t marginal[32] = {0};
+    wuffs_base__pixel_quantizer__shrink_box(hist, lo, axis, marginal);
+
+    // Cut after the median. A shrunk box has non-empty bins at both its min
+    // and max, so cutting in [min .. max) leaves both halves non-empty.
+    uint32_t cut = lo->min[axis];
+    uint64_t sum = marginal[cut];
+    while (((2 * sum) < lo->count) && ((cut + 1) < lo->max[axis])) {
+      cut++;
+      sum += marginal[cut];
+    }
+
+    *hi = *lo;
+    lo->max[axis] = cut;
+    hi->min[axis] = cut + 1;
+    wuffs_base__pixel_quantizer__shrink_box(hist, lo, 0, NULL);
+    wuffs_base__pixel_quantizer__shrink_box(hist, hi, 0, NULL);
+  }
+
+  // Each box's palette entry is the average of its pixels.
+  memset(q->private_impl.palette, 0, sizeof q->private_impl.palette);
+  uint32_t i = 0;
+  for (; i < num_boxes; i++) {
+    uint64_t sums[4] = {0};
+    uint32_t c[3];
+    for (c[2] = boxes[i].min[2]; c[2] <= boxes[i].max[2]; c[2]++) {
+      for (c[1] = boxes[i].min[1]; c[1] <= boxes[i].max[1]; c[1]++) {
+        for (c[0] = boxes[i].min[0]; c[0] <= boxes[i].max[0]; c[0]++) {
+          const uint8_t* bin =
+              hist + (32u * ((c[2] << 10) | (c[1] << 5) | c[0]));
+          int j = 0;
+          for (; j < 4; j++) {
+            sums[j] += wuffs_base__peek_u64le__no_bounds_check(bin + (8 * j));
+          }
+        }
+      }
+    }
+    uint8_t* e = q->private_impl.palette + (4 * i);
+    int j = 0;
+    for (; j < 3; j++) {
+      e[j] = (uint8_t)((sums[j + 1] + (sums[0] / 2)) / sums[0]);
+    }
+    e[3] = 0xFF;
+  }
+  q->private_impl.num_colors =
+      wuffs_base__u32__max(num_boxes + (transparent ? 1u : 0u), 1u);
+  wuffs_base__pixel_quantizer__fill_cache(q);
+  return wuffs_base__make_status(NULL);
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__quantize__closest converts BGRA_PREMUL pixels
+// by searching the palette, re-using the previous search's result for runs
+// of the same color.
+static uint64_t  //
+wuffs_base__pixel_swizzler__quantize__closest(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    wuffs_base__slice_u8 dst_palette,
+    uint32_t dst_palette_pixfmt_repr,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  wuffs_base__pixel_format palette_format =
+      wuffs_base__make_pixel_format(dst_palette_pixfmt_repr);
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len < src_len4) ? dst_len : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  uint32_t prev_color = 0;
+  uint8_t prev_index = 0;
+  bool have_prev = false;
+  while (n >= 1) {
+    uint32_t c = wuffs_base__peek_u32le__no_bounds_check(s);
+    if (!have_prev || (prev_color != c)) {
+      prev_color = c;
+      prev_index = wuffs_base__pixel_palette__closest_element(
+          dst_palette, palette_format, c);
+      have_prev = true;
+    }
+    *d = prev_index;
+
+    s += 1 * 4;
+    d += 1 * 1;
+    n -= 1;
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__index__bgra_premul__src(uint8_t* dst_ptr,
+                                                    size_t dst_len,
+                                                    uint8_t* dst_palette_ptr,
+                                                    size_t dst_palette_len,
+                                                    const uint8_t* src_ptr,
+                                                    size_t src_len) {
+  return wuffs_base__pixel_swizzler__quantize__closest(
+      dst_ptr, dst_len,
+      wuffs_base__make_slice_u8(dst_palette_ptr, dst_palette_len),
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL, src_ptr, src_len);
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__index_nonpremul__bgra_premul__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__quantize__closest(
+      dst_ptr, dst_len,
+      wuffs_base__make_slice_u8(dst_palette_ptr, dst_palette_len),
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL, src_ptr, src_len);
+}
+
+// wuffs_base__pixel_swizzler__quantize_cached converts BGRA_PREMUL pixels via
+// q's cache. It returns whether they were all opaque. If not, the non-opaque
+// pixels' indexes need to be re-calculated.
+static bool  //
+wuffs_base__pixel_swizzler__quantize_cached(
+    const wuffs_base__pixel_quantizer* q,
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels) {
+  uint32_t all_alpha = 0xFFu;
+  size_t i = 0;
+  for (; i < num_pixels; i++) {
+    uint32_t c = wuffs_base__peek_u32le__no_bounds_check(src_ptr + (4 * i));
+    all_alpha &= c >> 24;
+    dst_ptr[i] =
+        q->private_impl.cache[wuffs_base__pixel_quantizer__cache_index(c)];
+  }
+  return all_alpha == 0xFFu;
+}
+
+// wuffs_base__pixel_swizzler__quantize_error_diffusion is like
+// wuffs_base__pixel_swizzler__dither_error_diffusion__bgr_565 but for an
+// indexed destination. Its errors are in 1/16ths of an 8-bit channel value.
+// Non-opaque pixels are not dithered.
+static void  //
+wuffs_base__pixel_swizzler__quantize_error_diffusion(
+    const wuffs_base__pixel_swizzler* p,
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels,
+    uint32_t x,
+    uint32_t y,
+    wuffs_base__slice_u8 dst_palette) {
+  const wuffs_base__pixel_quantizer* q = p->private_impl.quantizer;
+  wuffs_base__pixel_format palette_format =
+      wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);
+  bool nonpremul = p->private_impl.dst_pixfmt_repr ==
+                   WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL;
+  uint32_t width = p->private_impl.dither_origin_width;
+  uint8_t* workbuf_ptr = p->private_impl.dither_workbuf.ptr;
+
+  wuffs_base__pixel_swizzler__dither__error_diffusion_state st;
+  memcpy(&st, workbuf_ptr, sizeof st);
+  uint8_t* errs = workbuf_ptr + 64;
+  if ((st.next_x != x) || (st.next_y != y)) {
+    memset(&st, 0, sizeof st);
+    memset(errs, 0, 12u * ((size_t)width));
+  }
+
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  while (n >= 1) {
+    uint32_t c = wuffs_base__peek_u32le__no_bounds_check(s);
+    uint8_t* e = errs + (12u * ((size_t)x));
+    int32_t errs3[3] = {0};
+    uint8_t index = 0;
+    if ((c >> 24) != 0xFF) {
+      index = wuffs_base__pixel_palette__closest_element(dst_palette,
+                                                         palette_format, c);
+    } else {
+      uint32_t v[3];
+      int ch = 0;
+      for (; ch < 3; ch++) {
+        int32_t v16 = ((int32_t)(((c >> (8 * ch)) & 0xFFu) << 4)) +
+                      st.right[ch] +
+                      ((int32_t)(wuffs_base__peek_u32le__no_bounds_check(
+                          e + (4 * ch))));
+        v[ch] = (v16 <= 0)
+                    ? 0u
+                    : wuffs_base__u32__min(((uint32_t)v16 + 8u) >> 4, 0xFFu);
+      }
+      uint32_t adjusted = 0xFF000000u | (v[2] << 16) | (v[1] << 8) | v[0];
+      if (q) {
+        index = q->private_impl
+                    .cache[wuffs_base__pixel_quantizer__cache_index(adjusted)];
+      } else {
+        index = wuffs_base__pixel_palette__closest_element(
+            dst_palette, palette_format, adjusted);
+      }
+      if ((4u * ((size_t)index)) < dst_palette.len) {
+        const uint8_t* pe = dst_palette.ptr + (4u * ((size_t)index));
+        uint32_t pa = nonpremul ? pe[3] : 0xFFu;
+        for (ch = 0; ch < 3; ch++) {
+          errs3[ch] = ((int32_t)v[ch]) -
+                      wuffs_base__pixel_quantizer__premul(pe[ch], pa);
+        }
+      }
+    }
+    *d = index;
+
+    int ch = 0;
+    for (; ch < 3; ch++) {
+      int32_t err = errs3[ch];
+      st.right[ch] = 7 * err;
+      if (x > 0) {
+        wuffs_base__poke_u32le__no_bounds_check(
+            e - 12 + (4 * ch), (uint32_t)(st.below_left[ch] + (3 * err)));
+      }
+      st.below_left[ch] = st.below[ch] + (5 * err);
+      st.below[ch] = err;
+    }
+
+    s += 1 * 4;
+    d += 1 * 1;
+    n -= 1;
+    x += 1;
+  }
+
+  if (x < width) {
+    st.next_x = x;
+    st.next_y = y;
+  } else {
+    uint8_t* e = errs + (12u * ((size_t)(width - 1)));
+    int ch = 0;
+    for (; ch < 3; ch++) {
+      wuffs_base__poke_u32le__no_bounds_check(e + (4 * ch),
+                                              (uint32_t)st.below_left[ch]);
+    }
+    memset(&st, 0, sizeof st);
+    st.next_y = y + 1;
+  }
+  memcpy(workbuf_ptr, &st, sizeof st);
+}
+
+// wuffs_base__pixel_swizzler__swizzle_quantized is the two stage swizzler
+// func for non-indexed sources and indexed destinations.
+static uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_quantized(
+    const wuffs_base__pixel_swizzler* p,
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  const wuffs_base__pixel_quantizer* q = p->private_impl.quantizer;
+  wuffs_base__slice_u8 palette =
+      wuffs_base__make_slice_u8(dst_palette_ptr, dst_palette_len);
+  if (q) {
+    palette.len = (size_t)wuffs_base__u64__min(
+        palette.len, 4u * ((uint64_t)q->private_impl.num_colors));
+  }
+
+  size_t src_bytes_per_pixel = p->private_impl.src_pixfmt_bytes_per_pixel;
+  size_t src_len_n = src_len / src_bytes_per_pixel;
+  size_t len = (dst_len < src_len_n) ? dst_len : src_len_n;
+
+  // As for wuffs_base__pixel_swizzler__swizzle_dithered, error diffusion
+  // needs each pixel's position.
+  size_t stride = p->private_impl.dither_origin_stride;
+  uintptr_t offset =
+      ((uintptr_t)dst_ptr) - ((uintptr_t)p->private_impl.dither_origin_ptr);
+  bool diffuse =
+      (p->private_impl.dither == WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION) &&
+      (((uintptr_t)dst_ptr) >=
+       ((uintptr_t)p->private_impl.dither_origin_ptr)) &&
+      (stride > 0);
+  uint32_t width = p->private_impl.dither_origin_width;
+
+  uint8_t wide[4 * WUFFS_BASE__PIXEL_SWIZZLER__QUANTIZE__CHUNK];
+  size_t n = len;
+  while (n > 0) {
+    size_t run = (size_t)wuffs_base__u64__min(
+        n, WUFFS_BASE__PIXEL_SWIZZLER__QUANTIZE__CHUNK);
+    uint32_t x = 0;
+    uint32_t y = 0;
+    if (diffuse) {
+      y = (uint32_t)wuffs_base__u64__min(offset / stride, 0xFFFFFFFFu);
+      x = (uint32_t)wuffs_base__u64__min(offset % stride, 0xFFFFFFFFu);
+      if (x < width) {
+        run = (size_t)wuffs_base__u64__min(run, width - x);
+      } else {
+        run = (size_t)wuffs_base__u64__min(run, stride - x);
+      }
+    }
+
+    (*p->private_impl.quantize_wide_func)(wide, sizeof wide, NULL, 0, src_ptr,
+                                          run * src_bytes_per_pixel);
+    if (diffuse && (x < width) && (y < p->private_impl.dither_origin_height)) {
+      wuffs_base__pixel_swizzler__quantize_error_diffusion(p, dst_ptr, wide,
+                                                           run, x, y, palette);
+    } else if (!q) {
+      (*p->private_impl.func)(dst_ptr, run, palette.ptr, palette.len, wide,
+                              4 * run);
+    } else if (!(*p->private_impl.quantize_cached_func)(q, dst_ptr, wide,
+                                                          run)) {
+      wuffs_base__pixel_format palette_format =
+          wuffs_base__make_pixel_format(p->private_impl.dst_pixfmt_repr);
+      size_t i = 0;
+      for (; i < run; i++) {
+        uint32_t c = wuffs_base__peek_u32le__no_bounds_check(wide + (4 * i));
+        if ((c >> 24) != 0xFF) {
+          dst_ptr[i] = wuffs_base__pixel_palette__closest_element(
+              palette, palette_format, c);
+        }
+      }
+    }
+
+    dst_ptr += run;
+    src_ptr += src_bytes_per_pixel * run;
+    offset += run;
+    n -= run;
+  }
+  return len;
+}
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__quantize(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_pixfmt,
+    wuffs_base__pixel_format src_pixfmt,
+    wuffs_base__pixel_blend blend) {
+  switch (dst_pixfmt.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_BINARY:
+      break;
+    default:
+      return NULL;
+  }
+  if ((blend != WUFFS_BASE__PIXEL_BLEND__SRC) ||
+      wuffs_base__pixel_format__is_indexed(&src_pixfmt)) {
+    return NULL;
+  }
+
+  wuffs_base__pixel_swizzler wide;
+  wuffs_base__status status = wuffs_base__pixel_swizzler__prepare(
+      &wide,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL),
+      wuffs_base__empty_slice_u8(), src_pixfmt, wuffs_base__empty_slice_u8(),
+      WUFFS_BASE__PIXEL_BLEND__SRC);
+  if (!wuffs_base__status__is_ok(&status)) {
+    return NULL;
+  }
+  p->private_impl.quantize_wide_func = wide.private_impl.func;
+
+  // The returned func is only the second stage, converting from
+  // BGRA_PREMUL. See wuffs_base__pixel_swizzler__call_func.
+  return (dst_pixfmt.repr == WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL)
+             ? wuffs_base__pixel_swizzler__index_nonpremul__bgra_premul__src
+             : wuffs_base__pixel_swizzler__index__bgra_premul__src;
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler__set_quantizer(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__pixel_quantizer* q) {
+  if (!p) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  p->private_impl.quantize_cached_func = NULL;
+  p->private_impl.quantizer = NULL;
+  if (!q || !p->private_impl.quantize_wide_func) {
+    return wuffs_base__make_status(NULL);
+  }
+
+  wuffs_base__slice_u8 dst_palette = wuffs_base__pixel_buffer__palette(dst);
+  if ((q->private_impl.num_colors == 0) ||
+      (dst_palette.len !=
+       WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) ||
+      (dst->pixcfg.private_impl.pixfmt.repr !=
+       p->private_impl.dst_pixfmt_repr)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+
+  if (p->private_impl.dst_pixfmt_repr ==
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL) {
+    memcpy(dst_palette.ptr, q->private_impl.palette, dst_palette.len);
+  } else {
+    size_t i = 0;
+    for (; i < dst_palette.len; i += 4) {
+      const uint8_t* e = q->private_impl.palette + i;
+      uint32_t a = e[3];
+      dst_palette.ptr[i + 0] =
+          (uint8_t)wuffs_base__pixel_quantizer__premul(e[0], a);
+      dst_palette.ptr[i + 1] =
+          (uint8_t)wuffs_base__pixel_quantizer__premul(e[1], a);
+      dst_palette.ptr[i + 2] =
+          (uint8_t)wuffs_base__pixel_quantizer__premul(e[2], a);
+      dst_palette.ptr[i + 3] = (uint8_t)a;
+    }
+  }
+
+  wuffs_base__pixel_swizzler__quantize_func cached_func =
+      &wuffs_base__pixel_swizzler__quantize_cached;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    cached_func = &wuffs_base__pixel_swizzler__quantize_cached__x86_avx2;
+  }
+#endif
+
+  p->private_impl.quantize_cached_func = cached_func;
+  p->private_impl.quantizer = q;
+  return wuffs_base__make_status(NULL);
+}
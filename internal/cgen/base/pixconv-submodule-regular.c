@@ -14,6 +14,61 @@
 
 // ---------------- Pixel Swizzler
 
+static uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_dithered(
+    const wuffs_base__pixel_swizzler* p,
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_quantized(
+    const wuffs_base__pixel_swizzler* p,
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__quantize(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_pixfmt,
+    wuffs_base__pixel_format src_pixfmt,
+    wuffs_base__pixel_blend blend);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_float(const wuffs_base__pixel_swizzler* p,
+                                          uint8_t* dst_ptr,
+                                          size_t dst_len,
+                                          uint8_t* dst_palette_ptr,
+                                          size_t dst_palette_len,
+                                          const uint8_t* src_ptr,
+                                          size_t src_len);
+
+static wuffs_base__pixel_swizzler__func  //
+wuffs_base__pixel_swizzler__prepare__float(
+    wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_format dst_pixfmt,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__pixel_format src_pixfmt,
+    wuffs_base__slice_u8 src_palette,
+    wuffs_base__pixel_blend blend);
+
+static wuffs_base__color_u32_argb_premul  //
+wuffs_base__pixel_swizzler__float__peek_color_u32(uint32_t pixfmt_repr,
+                                                  const uint8_t* ptr);
+
+static void  //
+wuffs_base__pixel_swizzler__float__poke_color_u32(
+    uint32_t pixfmt_repr,
+    uint8_t* ptr,
+    wuffs_base__color_u32_argb_premul color);
+
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
 WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2")
 static uint64_t  //
@@ -43,6 +98,416 @@ wuffs_base__pixel_swizzler__xxxx__y__x86_sse42(uint8_t* dst_ptr,
                                                size_t src_len);
 #endif  // defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
 
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_avx2(uint8_t* dst_ptr,
+                                                     size_t dst_len,
+                                                     uint8_t* dst_palette_ptr,
+                                                     size_t dst_palette_len,
+                                                     const uint8_t* src_ptr,
+                                                     size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__y__x86_avx2(uint8_t* dst_ptr,
+                                              size_t dst_len,
+                                              uint8_t* dst_palette_ptr,
+                                              size_t dst_palette_len,
+                                              const uint8_t* src_ptr,
+                                              size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr__x86_avx2(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgrx__x86_avx2(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb__x86_avx2(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgbx__x86_avx2(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__arm_neon(uint8_t* dst_ptr,
+                                                     size_t dst_len,
+                                                     uint8_t* dst_palette_ptr,
+                                                     size_t dst_palette_len,
+                                                     const uint8_t* src_ptr,
+                                                     size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__y__arm_neon(uint8_t* dst_ptr,
+                                              size_t dst_len,
+                                              uint8_t* dst_palette_ptr,
+                                              size_t dst_palette_len,
+                                              const uint8_t* src_ptr,
+                                              size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr__arm_neon(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgrx__arm_neon(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb__arm_neon(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgbx__arm_neon(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__arm_neon(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
 // --------
 
 static inline uint32_t  //
@@ -129,6 +594,9 @@ wuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_buffer* pb,
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
       return wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
           wuffs_base__peek_u64le__no_bounds_check(row + (8 * ((size_t)x))));
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      return wuffs_base__color_u64__as__color_u32(
+          wuffs_base__peek_u64le__no_bounds_check(row + (8 * ((size_t)x))));
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
       return 0xFF000000 |
              wuffs_base__peek_u32le__no_bounds_check(row + (4 * ((size_t)x)));
@@ -146,11 +614,23 @@ wuffs_base__pixel_buffer__color_u32_at(const wuffs_base__pixel_buffer* pb,
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
       return wuffs_base__swap_u32_argb_abgr(
           wuffs_base__peek_u32le__no_bounds_check(row + (4 * ((size_t)x))));
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      return wuffs_base__color_u64__as__color_u32__swap_u32_argb_abgr(
+          wuffs_base__peek_u64le__no_bounds_check(row + (8 * ((size_t)x))));
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       return wuffs_base__swap_u32_argb_abgr(
           0xFF000000 |
           wuffs_base__peek_u32le__no_bounds_check(row + (4 * ((size_t)x))));
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR:
+      return wuffs_base__pixel_swizzler__float__peek_color_u32(
+          pb->pixcfg.private_impl.pixfmt.repr, row + (8 * ((size_t)x)));
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR:
+      return wuffs_base__pixel_swizzler__float__peek_color_u32(
+          pb->pixcfg.private_impl.pixfmt.repr, row + (16 * ((size_t)x)));
+
     default:
       // TODO: support more formats.
       break;
@@ -236,6 +716,10 @@ wuffs_base__pixel_buffer__set_color_u32_at(
           wuffs_base__color_u32_argb_premul__as__color_u64_argb_nonpremul(
               color));
       break;
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      wuffs_base__poke_u64le__no_bounds_check(
+          row + (8 * ((size_t)x)), wuffs_base__color_u32__as__color_u64(color));
+      break;
 
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
       wuffs_base__poke_u24le__no_bounds_check(
@@ -252,6 +736,23 @@ wuffs_base__pixel_buffer__set_color_u32_at(
       wuffs_base__poke_u32le__no_bounds_check(
           row + (4 * ((size_t)x)), wuffs_base__swap_u32_argb_abgr(color));
       break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      wuffs_base__poke_u64le__no_bounds_check(
+          row + (8 * ((size_t)x)), wuffs_base__color_u32__as__color_u64(
+                                       wuffs_base__swap_u32_argb_abgr(color)));
+      break;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR:
+      wuffs_base__pixel_swizzler__float__poke_color_u32(
+          pb->pixcfg.private_impl.pixfmt.repr, row + (8 * ((size_t)x)), color);
+      break;
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR:
+      wuffs_base__pixel_swizzler__float__poke_color_u32(
+          pb->pixcfg.private_impl.pixfmt.repr, row + (16 * ((size_t)x)),
+          color);
+      break;
 
     default:
       // TODO: support more formats.
@@ -440,6 +941,11 @@ wuffs_base__pixel_buffer__set_color_u32_fill_rect(
               color));
       return wuffs_base__make_status(NULL);
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      wuffs_base__pixel_buffer__set_color_u32_fill_rect__xxxxxxxx(
+          pb, rect, wuffs_base__color_u32__as__color_u64(color));
+      return wuffs_base__make_status(NULL);
+
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       wuffs_base__pixel_buffer__set_color_u32_fill_rect__xxxx(
           pb, rect,
@@ -452,6 +958,23 @@ wuffs_base__pixel_buffer__set_color_u32_fill_rect(
       wuffs_base__pixel_buffer__set_color_u32_fill_rect__xxxx(
           pb, rect, wuffs_base__swap_u32_argb_abgr(color));
       return wuffs_base__make_status(NULL);
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      wuffs_base__pixel_buffer__set_color_u32_fill_rect__xxxxxxxx(
+          pb, rect,
+          wuffs_base__color_u32__as__color_u64(
+              wuffs_base__swap_u32_argb_abgr(color)));
+      return wuffs_base__make_status(NULL);
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR: {
+      uint8_t f16[8];
+      wuffs_base__pixel_swizzler__float__poke_color_u32(
+          pb->pixcfg.private_impl.pixfmt.repr, f16, color);
+      wuffs_base__pixel_buffer__set_color_u32_fill_rect__xxxxxxxx(
+          pb, rect, wuffs_base__peek_u64le__no_bounds_check(f16));
+      return wuffs_base__make_status(NULL);
+    }
   }
 
   uint32_t y;
@@ -800,6 +1323,32 @@ wuffs_base__composite_premul_premul_u32_axxx(uint32_t dst_premul,
   return (db << 0) | (dg << 8) | (dr << 16) | (da << 24);
 }
 
+static inline uint64_t  //
+wuffs_base__composite_premul_premul_u64_axxx(uint64_t dst_premul,
+                                             uint64_t src_premul) {
+  // Extract components.
+  uint64_t da = 0xFFFF & (dst_premul >> 48);
+  uint64_t dr = 0xFFFF & (dst_premul >> 32);
+  uint64_t dg = 0xFFFF & (dst_premul >> 16);
+  uint64_t db = 0xFFFF & (dst_premul >> 0);
+  uint64_t sa = 0xFFFF & (src_premul >> 48);
+  uint64_t sr = 0xFFFF & (src_premul >> 32);
+  uint64_t sg = 0xFFFF & (src_premul >> 16);
+  uint64_t sb = 0xFFFF & (src_premul >> 0);
+
+  // Calculate the inverse of the src-alpha: how much of the dst to keep.
+  uint64_t ia = 0xFFFF - sa;
+
+  // Composite src (premul) over dst (premul).
+  da = sa + ((da * ia) / 0xFFFF);
+  dr = sr + ((dr * ia) / 0xFFFF);
+  dg = sg + ((dg * ia) / 0xFFFF);
+  db = sb + ((db * ia) / 0xFFFF);
+
+  // Combine components.
+  return (db << 0) | (dg << 16) | (dr << 32) | (da << 48);
+}
+
 // --------
 
 static uint64_t  //
@@ -1685,8 +2234,231 @@ wuffs_base__pixel_swizzler__bgr_565__index_bgra_nonpremul__src_over(
         wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(
             wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0)));
 
-    s += 1 * 1;
-    d += 1 * 2;
+    s += 1 * 1;
+    d += 1 * 2;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr_565__index_binary_alpha__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len2 = dst_len / 2;
+  size_t len = (dst_len2 < src_len) ? dst_len2 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                          ((size_t)s[0] * 4));
+    if (s0) {
+      wuffs_base__poke_u16le__no_bounds_check(d + (0 * 2), (uint16_t)s0);
+    }
+
+    s += 1 * 1;
+    d += 1 * 2;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr__bgr_565(uint8_t* dst_ptr,
+                                         size_t dst_len,
+                                         uint8_t* dst_palette_ptr,
+                                         size_t dst_palette_len,
+                                         const uint8_t* src_ptr,
+                                         size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len2 = src_len / 2;
+  size_t len = (dst_len3 < src_len2) ? dst_len3 : src_len2;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
+        wuffs_base__peek_u16le__no_bounds_check(s + (0 * 2)));
+    wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
+
+    s += 1 * 2;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src(uint8_t* dst_ptr,
+                                                     size_t dst_len,
+                                                     uint8_t* dst_palette_ptr,
+                                                     size_t dst_palette_len,
+                                                     const uint8_t* src_ptr,
+                                                     size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint32_t s0 =
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
+
+    s += 1 * 4;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len3 < src_len8) ? dst_len3 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint32_t s0 =
+        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+            wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
+    wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
+
+    s += 1 * 8;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    // Extract 16-bit color components.
+    uint32_t dr = 0x101 * ((uint32_t)d[2]);
+    uint32_t dg = 0x101 * ((uint32_t)d[1]);
+    uint32_t db = 0x101 * ((uint32_t)d[0]);
+    uint32_t sa = 0x101 * ((uint32_t)s[3]);
+    uint32_t sr = 0x101 * ((uint32_t)s[2]);
+    uint32_t sg = 0x101 * ((uint32_t)s[1]);
+    uint32_t sb = 0x101 * ((uint32_t)s[0]);
+
+    // Calculate the inverse of the src-alpha: how much of the dst to keep.
+    uint32_t ia = 0xFFFF - sa;
+
+    // Composite src (nonpremul) over dst (premul).
+    dr = ((sr * sa) + (dr * ia)) / 0xFFFF;
+    dg = ((sg * sa) + (dg * ia)) / 0xFFFF;
+    db = ((sb * sa) + (db * ia)) / 0xFFFF;
+
+    // Convert from 16-bit color to 8-bit color.
+    d[0] = (uint8_t)(db >> 8);
+    d[1] = (uint8_t)(dg >> 8);
+    d[2] = (uint8_t)(dr >> 8);
+
+    s += 1 * 4;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len3 < src_len8) ? dst_len3 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    // Extract 16-bit color components.
+    uint32_t dr = 0x101 * ((uint32_t)d[2]);
+    uint32_t dg = 0x101 * ((uint32_t)d[1]);
+    uint32_t db = 0x101 * ((uint32_t)d[0]);
+    uint32_t sa = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 6));
+    uint32_t sr = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 4));
+    uint32_t sg = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 2));
+    uint32_t sb = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 0));
+
+    // Calculate the inverse of the src-alpha: how much of the dst to keep.
+    uint32_t ia = 0xFFFF - sa;
+
+    // Composite src (nonpremul) over dst (premul).
+    dr = ((sr * sa) + (dr * ia)) / 0xFFFF;
+    dg = ((sg * sa) + (dg * ia)) / 0xFFFF;
+    db = ((sb * sa) + (db * ia)) / 0xFFFF;
+
+    // Convert from 16-bit color to 8-bit color.
+    d[0] = (uint8_t)(db >> 8);
+    d[1] = (uint8_t)(dg >> 8);
+    d[2] = (uint8_t)(dr >> 8);
+
+    s += 1 * 8;
+    d += 1 * 3;
     n -= 1;
   }
 
@@ -1694,64 +2466,73 @@ wuffs_base__pixel_swizzler__bgr_565__index_bgra_nonpremul__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr_565__index_binary_alpha__src_over(
-    uint8_t* dst_ptr,
-    size_t dst_len,
-    uint8_t* dst_palette_ptr,
-    size_t dst_palette_len,
-    const uint8_t* src_ptr,
-    size_t src_len) {
-  if (dst_palette_len !=
-      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
-    return 0;
-  }
-  size_t dst_len2 = dst_len / 2;
-  size_t len = (dst_len2 < src_len) ? dst_len2 : src_len;
+wuffs_base__pixel_swizzler__bgr__bgra_premul__src(uint8_t* dst_ptr,
+                                                  size_t dst_len,
+                                                  uint8_t* dst_palette_ptr,
+                                                  size_t dst_palette_len,
+                                                  const uint8_t* src_ptr,
+                                                  size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
-
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
-                                                          ((size_t)s[0] * 4));
-    if (s0) {
-      wuffs_base__poke_u16le__no_bounds_check(d + (0 * 2), (uint16_t)s0);
-    }
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    d[0] = s0;
+    d[1] = s1;
+    d[2] = s2;
 
-    s += 1 * 1;
-    d += 1 * 2;
+    s += 1 * 4;
+    d += 1 * 3;
     n -= 1;
   }
 
   return len;
 }
 
-// --------
-
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__bgr_565(uint8_t* dst_ptr,
-                                         size_t dst_len,
-                                         uint8_t* dst_palette_ptr,
-                                         size_t dst_palette_len,
-                                         const uint8_t* src_ptr,
-                                         size_t src_len) {
+wuffs_base__pixel_swizzler__bgr__bgra_premul__src_over(uint8_t* dst_ptr,
+                                                       size_t dst_len,
+                                                       uint8_t* dst_palette_ptr,
+                                                       size_t dst_palette_len,
+                                                       const uint8_t* src_ptr,
+                                                       size_t src_len) {
   size_t dst_len3 = dst_len / 3;
-  size_t src_len2 = src_len / 2;
-  size_t len = (dst_len3 < src_len2) ? dst_len3 : src_len2;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
-
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
-        wuffs_base__peek_u16le__no_bounds_check(s + (0 * 2)));
-    wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
+    // Extract 16-bit color components.
+    uint32_t dr = 0x101 * ((uint32_t)d[2]);
+    uint32_t dg = 0x101 * ((uint32_t)d[1]);
+    uint32_t db = 0x101 * ((uint32_t)d[0]);
+    uint32_t sa = 0x101 * ((uint32_t)s[3]);
+    uint32_t sr = 0x101 * ((uint32_t)s[2]);
+    uint32_t sg = 0x101 * ((uint32_t)s[1]);
+    uint32_t sb = 0x101 * ((uint32_t)s[0]);
 
-    s += 1 * 2;
+    // Calculate the inverse of the src-alpha: how much of the dst to keep.
+    uint32_t ia = 0xFFFF - sa;
+
+    // Composite src (premul) over dst (premul).
+    dr = sr + ((dr * ia) / 0xFFFF);
+    dg = sg + ((dg * ia) / 0xFFFF);
+    db = sb + ((db * ia) / 0xFFFF);
+
+    // Convert from 16-bit color to 8-bit color.
+    d[0] = (uint8_t)(db >> 8);
+    d[1] = (uint8_t)(dg >> 8);
+    d[2] = (uint8_t)(dr >> 8);
+
+    s += 1 * 4;
     d += 1 * 3;
     n -= 1;
   }
@@ -1760,7 +2541,7 @@ wuffs_base__pixel_swizzler__bgr__bgr_565(uint8_t* dst_ptr,
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src(uint8_t* dst_ptr,
+wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src(uint8_t* dst_ptr,
                                                      size_t dst_len,
                                                      uint8_t* dst_palette_ptr,
                                                      size_t dst_palette_len,
@@ -1776,9 +2557,9 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src(uint8_t* dst_ptr,
   // TODO: unroll.
 
   while (n >= 1) {
-    uint32_t s0 =
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
         wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
-            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
     wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
 
     s += 1 * 4;
@@ -1790,7 +2571,7 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src(uint8_t* dst_ptr,
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src(
+wuffs_base__pixel_swizzler__bgr__rgba_nonpremul_4x16le__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -1807,9 +2588,9 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src(
   // TODO: unroll.
 
   while (n >= 1) {
-    uint32_t s0 =
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
         wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
-            wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
+            wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
     wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
 
     s += 1 * 8;
@@ -1821,7 +2602,7 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -1843,9 +2624,9 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src_over(
     uint32_t dg = 0x101 * ((uint32_t)d[1]);
     uint32_t db = 0x101 * ((uint32_t)d[0]);
     uint32_t sa = 0x101 * ((uint32_t)s[3]);
-    uint32_t sr = 0x101 * ((uint32_t)s[2]);
+    uint32_t sb = 0x101 * ((uint32_t)s[2]);
     uint32_t sg = 0x101 * ((uint32_t)s[1]);
-    uint32_t sb = 0x101 * ((uint32_t)s[0]);
+    uint32_t sr = 0x101 * ((uint32_t)s[0]);
 
     // Calculate the inverse of the src-alpha: how much of the dst to keep.
     uint32_t ia = 0xFFFF - sa;
@@ -1869,7 +2650,7 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src_over(
+wuffs_base__pixel_swizzler__bgr__rgba_nonpremul_4x16le__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -1891,9 +2672,9 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src_over(
     uint32_t dg = 0x101 * ((uint32_t)d[1]);
     uint32_t db = 0x101 * ((uint32_t)d[0]);
     uint32_t sa = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 6));
-    uint32_t sr = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 4));
+    uint32_t sb = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 4));
     uint32_t sg = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 2));
-    uint32_t sb = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 0));
+    uint32_t sr = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 0));
 
     // Calculate the inverse of the src-alpha: how much of the dst to keep.
     uint32_t ia = 0xFFFF - sa;
@@ -1917,7 +2698,7 @@ wuffs_base__pixel_swizzler__bgr__bgra_nonpremul_4x16le__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__bgra_premul__src(uint8_t* dst_ptr,
+wuffs_base__pixel_swizzler__bgr__rgba_premul__src(uint8_t* dst_ptr,
                                                   size_t dst_len,
                                                   uint8_t* dst_palette_ptr,
                                                   size_t dst_palette_len,
@@ -1934,9 +2715,9 @@ wuffs_base__pixel_swizzler__bgr__bgra_premul__src(uint8_t* dst_ptr,
     uint8_t s0 = s[0];
     uint8_t s1 = s[1];
     uint8_t s2 = s[2];
-    d[0] = s0;
+    d[0] = s2;
     d[1] = s1;
-    d[2] = s2;
+    d[2] = s0;
 
     s += 1 * 4;
     d += 1 * 3;
@@ -1947,7 +2728,7 @@ wuffs_base__pixel_swizzler__bgr__bgra_premul__src(uint8_t* dst_ptr,
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__bgra_premul__src_over(uint8_t* dst_ptr,
+wuffs_base__pixel_swizzler__bgr__rgba_premul__src_over(uint8_t* dst_ptr,
                                                        size_t dst_len,
                                                        uint8_t* dst_palette_ptr,
                                                        size_t dst_palette_len,
@@ -1966,9 +2747,9 @@ wuffs_base__pixel_swizzler__bgr__bgra_premul__src_over(uint8_t* dst_ptr,
     uint32_t dg = 0x101 * ((uint32_t)d[1]);
     uint32_t db = 0x101 * ((uint32_t)d[0]);
     uint32_t sa = 0x101 * ((uint32_t)s[3]);
-    uint32_t sr = 0x101 * ((uint32_t)s[2]);
+    uint32_t sb = 0x101 * ((uint32_t)s[2]);
     uint32_t sg = 0x101 * ((uint32_t)s[1]);
-    uint32_t sb = 0x101 * ((uint32_t)s[0]);
+    uint32_t sr = 0x101 * ((uint32_t)s[0]);
 
     // Calculate the inverse of the src-alpha: how much of the dst to keep.
     uint32_t ia = 0xFFFF - sa;
@@ -1983,8 +2764,131 @@ wuffs_base__pixel_swizzler__bgr__bgra_premul__src_over(uint8_t* dst_ptr,
     d[1] = (uint8_t)(dg >> 8);
     d[2] = (uint8_t)(dr >> 8);
 
-    s += 1 * 4;
-    d += 1 * 3;
+    s += 1 * 4;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgr__rgbx(uint8_t* dst_ptr,
+                                      size_t dst_len,
+                                      uint8_t* dst_palette_ptr,
+                                      size_t dst_palette_len,
+                                      const uint8_t* src_ptr,
+                                      size_t src_len) {
+  size_t dst_len3 = dst_len / 3;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // TODO: unroll.
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+
+    s += 1 * 4;
+    d += 1 * 3;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+
+  size_t n = len;
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u64__as__color_u32(
+            wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
     n -= 1;
   }
 
@@ -1992,29 +2896,28 @@ wuffs_base__pixel_swizzler__bgr__bgra_premul__src_over(uint8_t* dst_ptr,
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src(uint8_t* dst_ptr,
-                                                     size_t dst_len,
-                                                     uint8_t* dst_palette_ptr,
-                                                     size_t dst_palette_len,
-                                                     const uint8_t* src_ptr,
-                                                     size_t src_len) {
-  size_t dst_len3 = dst_len / 3;
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
-
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
-        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
-            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
-    wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(s0));
 
     s += 1 * 4;
-    d += 1 * 3;
+    d += 1 * 4;
     n -= 1;
   }
 
@@ -2022,30 +2925,28 @@ wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src(uint8_t* dst_ptr,
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__rgba_nonpremul_4x16le__src(
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len3 = dst_len / 3;
-  size_t src_len8 = src_len / 8;
-  size_t len = (dst_len3 < src_len8) ? dst_len3 : src_len8;
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
-
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
-        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
-            wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
-    wuffs_base__poke_u24le__no_bounds_check(d + (0 * 3), s0);
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_nonpremul_premul_u32_axxx(d0, s0));
 
-    s += 1 * 8;
-    d += 1 * 3;
+    s += 1 * 4;
+    d += 1 * 4;
     n -= 1;
   }
 
@@ -2053,16 +2954,19 @@ wuffs_base__pixel_swizzler__bgr__rgba_nonpremul_4x16le__src(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len3 = dst_len / 3;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
@@ -2070,30 +2974,15 @@ wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src_over(
   // TODO: unroll.
 
   while (n >= 1) {
-    // Extract 16-bit color components.
-    uint32_t dr = 0x101 * ((uint32_t)d[2]);
-    uint32_t dg = 0x101 * ((uint32_t)d[1]);
-    uint32_t db = 0x101 * ((uint32_t)d[0]);
-    uint32_t sa = 0x101 * ((uint32_t)s[3]);
-    uint32_t sb = 0x101 * ((uint32_t)s[2]);
-    uint32_t sg = 0x101 * ((uint32_t)s[1]);
-    uint32_t sr = 0x101 * ((uint32_t)s[0]);
-
-    // Calculate the inverse of the src-alpha: how much of the dst to keep.
-    uint32_t ia = 0xFFFF - sa;
-
-    // Composite src (nonpremul) over dst (premul).
-    dr = ((sr * sa) + (dr * ia)) / 0xFFFF;
-    dg = ((sg * sa) + (dg * ia)) / 0xFFFF;
-    db = ((sb * sa) + (db * ia)) / 0xFFFF;
-
-    // Convert from 16-bit color to 8-bit color.
-    d[0] = (uint8_t)(db >> 8);
-    d[1] = (uint8_t)(dg >> 8);
-    d[2] = (uint8_t)(dr >> 8);
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                          ((size_t)s[0] * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
 
-    s += 1 * 4;
-    d += 1 * 3;
+    s += 1 * 1;
+    d += 1 * 4;
     n -= 1;
   }
 
@@ -2101,47 +2990,30 @@ wuffs_base__pixel_swizzler__bgr__rgba_nonpremul__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__rgba_nonpremul_4x16le__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len3 = dst_len / 3;
-  size_t src_len8 = src_len / 8;
-  size_t len = (dst_len3 < src_len8) ? dst_len3 : src_len8;
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
-  // TODO: unroll.
-
   while (n >= 1) {
-    // Extract 16-bit color components.
-    uint32_t dr = 0x101 * ((uint32_t)d[2]);
-    uint32_t dg = 0x101 * ((uint32_t)d[1]);
-    uint32_t db = 0x101 * ((uint32_t)d[0]);
-    uint32_t sa = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 6));
-    uint32_t sb = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 4));
-    uint32_t sg = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 2));
-    uint32_t sr = ((uint32_t)wuffs_base__peek_u16le__no_bounds_check(s + 0));
-
-    // Calculate the inverse of the src-alpha: how much of the dst to keep.
-    uint32_t ia = 0xFFFF - sa;
-
-    // Composite src (nonpremul) over dst (premul).
-    dr = ((sr * sa) + (dr * ia)) / 0xFFFF;
-    dg = ((sg * sa) + (dg * ia)) / 0xFFFF;
-    db = ((sb * sa) + (db * ia)) / 0xFFFF;
-
-    // Convert from 16-bit color to 8-bit color.
-    d[0] = (uint8_t)(db >> 8);
-    d[1] = (uint8_t)(dg >> 8);
-    d[2] = (uint8_t)(dr >> 8);
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
 
-    s += 1 * 8;
-    d += 1 * 3;
+    s += 1 * 4;
+    d += 1 * 4;
     n -= 1;
   }
 
@@ -2149,29 +3021,29 @@ wuffs_base__pixel_swizzler__bgr__rgba_nonpremul_4x16le__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__rgba_premul__src(uint8_t* dst_ptr,
-                                                  size_t dst_len,
-                                                  uint8_t* dst_palette_ptr,
-                                                  size_t dst_palette_len,
-                                                  const uint8_t* src_ptr,
-                                                  size_t src_len) {
-  size_t dst_len3 = dst_len / 3;
+wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_premul__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
   while (n >= 1) {
-    uint8_t s0 = s[0];
-    uint8_t s1 = s[1];
-    uint8_t s2 = s[2];
-    d[0] = s2;
-    d[1] = s1;
-    d[2] = s0;
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(s0));
 
     s += 1 * 4;
-    d += 1 * 3;
+    d += 1 * 4;
     n -= 1;
   }
 
@@ -2179,225 +3051,218 @@ wuffs_base__pixel_swizzler__bgr__rgba_premul__src(uint8_t* dst_ptr,
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__rgba_premul__src_over(uint8_t* dst_ptr,
-                                                       size_t dst_len,
-                                                       uint8_t* dst_palette_ptr,
-                                                       size_t dst_palette_len,
-                                                       const uint8_t* src_ptr,
-                                                       size_t src_len) {
-  size_t dst_len3 = dst_len / 3;
+wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_premul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
   while (n >= 1) {
-    // Extract 16-bit color components.
-    uint32_t dr = 0x101 * ((uint32_t)d[2]);
-    uint32_t dg = 0x101 * ((uint32_t)d[1]);
-    uint32_t db = 0x101 * ((uint32_t)d[0]);
-    uint32_t sa = 0x101 * ((uint32_t)s[3]);
-    uint32_t sb = 0x101 * ((uint32_t)s[2]);
-    uint32_t sg = 0x101 * ((uint32_t)s[1]);
-    uint32_t sr = 0x101 * ((uint32_t)s[0]);
-
-    // Calculate the inverse of the src-alpha: how much of the dst to keep.
-    uint32_t ia = 0xFFFF - sa;
-
-    // Composite src (premul) over dst (premul).
-    dr = sr + ((dr * ia) / 0xFFFF);
-    dg = sg + ((dg * ia) / 0xFFFF);
-    db = sb + ((db * ia) / 0xFFFF);
-
-    // Convert from 16-bit color to 8-bit color.
-    d[0] = (uint8_t)(db >> 8);
-    d[1] = (uint8_t)(dg >> 8);
-    d[2] = (uint8_t)(dr >> 8);
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_nonpremul_premul_u32_axxx(d0, s0));
 
     s += 1 * 4;
-    d += 1 * 3;
+    d += 1 * 4;
     n -= 1;
   }
 
   return len;
 }
 
+// --------
+
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgr__rgbx(uint8_t* dst_ptr,
-                                      size_t dst_len,
-                                      uint8_t* dst_palette_ptr,
-                                      size_t dst_palette_len,
-                                      const uint8_t* src_ptr,
-                                      size_t src_len) {
-  size_t dst_len3 = dst_len / 3;
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len3 < src_len4) ? dst_len3 : src_len4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
-
-  // TODO: unroll.
 
+  size_t n = len;
   while (n >= 1) {
-    uint8_t b0 = s[0];
-    uint8_t b1 = s[1];
-    uint8_t b2 = s[2];
-    d[0] = b2;
-    d[1] = b1;
-    d[2] = b0;
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s0;
+    d[1] = s0;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s2;
+    d[5] = s2;
+    d[6] = s3;
+    d[7] = s3;
 
     s += 1 * 4;
-    d += 1 * 3;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
-// --------
-
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
+  size_t dst_len8 = dst_len / 8;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
 
+  size_t n = len;
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
 
     s += 1 * 4;
-    d += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul_4x16le__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
+  size_t dst_len8 = dst_len / 8;
   size_t src_len8 = src_len / 8;
-  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
 
   size_t n = len;
   while (n >= 1) {
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__color_u64__as__color_u32(
-                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
 
     s += 1 * 8;
-    d += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
   return len;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_premul__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
-  size_t src_len8 = src_len / 8;
-  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
 
+  size_t n = len;
   while (n >= 1) {
-    uint64_t d0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4)));
-    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__color_u64__as__color_u32(
-            wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0)));
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    wuffs_base__poke_u64le__no_bounds_check(d + (0 * 8), s0);
 
-    s += 1 * 8;
-    d += 1 * 4;
+    s += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_premul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
+  size_t dst_len8 = dst_len / 8;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
 
+  size_t n = len;
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(s0));
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8), wuffs_base__composite_nonpremul_premul_u64_axxx(d0, s0));
 
     s += 1 * 4;
-    d += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__index_bgra_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len8 = dst_len / 8;
+  size_t len = (dst_len8 < src_len) ? dst_len8 : src_len;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
   size_t n = len;
 
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__composite_nonpremul_premul_u32_axxx(d0, s0));
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                ((size_t)s[0] * 4)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
 
-    s += 1 * 4;
-    d += 1 * 4;
+    s += 1 * 1;
+    d += 1 * 8;
     n -= 1;
   }
 
@@ -2405,136 +3270,164 @@ wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_premul__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  if (dst_palette_len !=
-      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
-    return 0;
-  }
-  size_t dst_len4 = dst_len / 4;
-  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
+
   size_t n = len;
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s2;
+    d[1] = s2;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s0;
+    d[5] = s0;
+    d[6] = s3;
+    d[7] = s3;
 
-  // TODO: unroll.
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
 
+  size_t n = len;
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
-                                                          ((size_t)s[0] * 4));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 =
+        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
 
-    s += 1 * 1;
-    d += 1 * 4;
+    s += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
+  size_t dst_len8 = dst_len / 8;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
 
+  size_t n = len;
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
-        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(
+            wuffs_base__swap_u32_argb_abgr(
+                wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)))));
+    wuffs_base__poke_u64le__no_bounds_check(d + (0 * 8), s0);
 
     s += 1 * 4;
-    d += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_premul__src(
+wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
+  size_t dst_len8 = dst_len / 8;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
 
+  size_t n = len;
   while (n >= 1) {
-    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
-        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4),
-        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(s0));
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 =
+        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8), wuffs_base__composite_nonpremul_premul_u64_axxx(d0, s0));
 
     s += 1 * 4;
-    d += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
+// --------
+
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul__rgba_premul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
-  size_t dst_len4 = dst_len / 4;
+  size_t dst_len8 = dst_len / 8;
   size_t src_len4 = src_len / 4;
-  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-  size_t n = len;
 
+  size_t n = len;
   while (n >= 1) {
-    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
-    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
         wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
-    wuffs_base__poke_u32le__no_bounds_check(
-        d + (0 * 4), wuffs_base__composite_nonpremul_premul_u32_axxx(d0, s0));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
 
     s += 1 * 4;
-    d += 1 * 4;
+    d += 1 * 8;
     n -= 1;
   }
-
   return len;
 }
 
-// --------
-
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2549,18 +3442,11 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src(
 
   size_t n = len;
   while (n >= 1) {
-    uint8_t s0 = s[0];
-    uint8_t s1 = s[1];
-    uint8_t s2 = s[2];
-    uint8_t s3 = s[3];
-    d[0] = s0;
-    d[1] = s0;
-    d[2] = s1;
-    d[3] = s1;
-    d[4] = s2;
-    d[5] = s2;
-    d[6] = s3;
-    d[7] = s3;
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8), wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0));
 
     s += 1 * 4;
     d += 1 * 8;
@@ -2570,7 +3456,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2578,21 +3464,19 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src_over(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len8 = dst_len / 8;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
 
   size_t n = len;
   while (n >= 1) {
-    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
-    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
     wuffs_base__poke_u64le__no_bounds_check(
         d + (0 * 8),
-        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
 
-    s += 1 * 4;
+    s += 1 * 8;
     d += 1 * 8;
     n -= 1;
   }
@@ -2600,7 +3484,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul_4x16le__src_over(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2618,8 +3502,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul_4x16le__src_ov
     uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
     uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
     wuffs_base__poke_u64le__no_bounds_check(
-        d + (0 * 8),
-        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
+        d + (0 * 8), wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0));
 
     s += 1 * 8;
     d += 1 * 8;
@@ -2629,7 +3512,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul_4x16le__src_ov
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_premul__src(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_premul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2644,10 +3527,11 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_premul__src(
 
   size_t n = len;
   while (n >= 1) {
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
     uint64_t s0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(
-            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
-    wuffs_base__poke_u64le__no_bounds_check(d + (0 * 8), s0);
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8), wuffs_base__composite_premul_premul_u64_axxx(d0, s0));
 
     s += 1 * 4;
     d += 1 * 8;
@@ -2657,36 +3541,41 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_premul__src(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_premul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__index_bgra_nonpremul__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
     size_t dst_palette_len,
     const uint8_t* src_ptr,
     size_t src_len) {
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
   size_t dst_len8 = dst_len / 8;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  size_t len = (dst_len8 < src_len) ? dst_len8 : src_len;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
-
   size_t n = len;
+
   while (n >= 1) {
-    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
     uint64_t s0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+        wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                ((size_t)s[0] * 4)));
     wuffs_base__poke_u64le__no_bounds_check(
-        d + (0 * 8), wuffs_base__composite_nonpremul_premul_u64_axxx(d0, s0));
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
 
-    s += 1 * 4;
+    s += 1 * 1;
     d += 1 * 8;
     n -= 1;
   }
+
   return len;
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__index_bgra_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__index_bgra_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2709,8 +3598,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__index_bgra_nonpremul__src_ove
         wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
                                                 ((size_t)s[0] * 4)));
     wuffs_base__poke_u64le__no_bounds_check(
-        d + (0 * 8),
-        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
+        d + (0 * 8), wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0));
 
     s += 1 * 1;
     d += 1 * 8;
@@ -2721,7 +3609,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__index_bgra_nonpremul__src_ove
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2736,18 +3624,12 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src(
 
   size_t n = len;
   while (n >= 1) {
-    uint8_t s0 = s[0];
-    uint8_t s1 = s[1];
-    uint8_t s2 = s[2];
-    uint8_t s3 = s[3];
-    d[0] = s2;
-    d[1] = s2;
-    d[2] = s1;
-    d[3] = s1;
-    d[4] = s0;
-    d[5] = s0;
-    d[6] = s3;
-    d[7] = s3;
+    uint64_t s0 =
+        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
 
     s += 1 * 4;
     d += 1 * 8;
@@ -2757,7 +3639,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src_over(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2777,8 +3659,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src_over(
         wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
             wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
     wuffs_base__poke_u64le__no_bounds_check(
-        d + (0 * 8),
-        wuffs_base__composite_nonpremul_nonpremul_u64_axxx(d0, s0));
+        d + (0 * 8), wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0));
 
     s += 1 * 4;
     d += 1 * 8;
@@ -2788,7 +3669,7 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src_over(
 }
 
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src(
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_premul__src_over(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2803,11 +3684,12 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src(
 
   size_t n = len;
   while (n >= 1) {
-    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
-        wuffs_base__color_u32_argb_premul__as__color_u32_argb_nonpremul(
-            wuffs_base__swap_u32_argb_abgr(
-                wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)))));
-    wuffs_base__poke_u64le__no_bounds_check(d + (0 * 8), s0);
+    uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
+    uint64_t s0 =
+        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8), wuffs_base__composite_premul_premul_u64_axxx(d0, s0));
 
     s += 1 * 4;
     d += 1 * 8;
@@ -2816,8 +3698,10 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src(
   return len;
 }
 
+// --------
+
 static uint64_t  //
-wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src_over(
+wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src(
     uint8_t* dst_ptr,
     size_t dst_len,
     uint8_t* dst_palette_ptr,
@@ -2825,21 +3709,49 @@ wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_premul__src_over(
     const uint8_t* src_ptr,
     size_t src_len) {
   size_t dst_len8 = dst_len / 8;
-  size_t src_len4 = src_len / 4;
-  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+
+  size_t n = len;
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__swap_u64_argb_abgr(
+        wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 8;
+    d += 1 * 8;
+    n -= 1;
+  }
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src_over(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
   uint8_t* d = dst_ptr;
   const uint8_t* s = src_ptr;
 
   size_t n = len;
   while (n >= 1) {
     uint64_t d0 = wuffs_base__peek_u64le__no_bounds_check(d + (0 * 8));
-    uint64_t s0 =
-        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
-            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    uint64_t s0 = wuffs_base__swap_u64_argb_abgr(
+        wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
     wuffs_base__poke_u64le__no_bounds_check(
-        d + (0 * 8), wuffs_base__composite_nonpremul_premul_u64_axxx(d0, s0));
+        d + (0 * 8), wuffs_base__composite_premul_nonpremul_u64_axxx(d0, s0));
 
-    s += 1 * 4;
+    s += 1 * 8;
     d += 1 * 8;
     n -= 1;
   }
@@ -3677,6 +4589,70 @@ wuffs_base__pixel_swizzler__rgbw__bgr_565(uint8_t* dst_ptr,
   return len;
 }
 
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgbw_4x16le__bgr_565(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len2 = src_len / 2;
+  size_t len = (dst_len8 < src_len2) ? dst_len8 : src_len2;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_u16_rgb_565__as__color_u32_argb_premul(
+                wuffs_base__peek_u16le__no_bounds_check(s + (0 * 2))))));
+
+    s += 1 * 2;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgbw_4x16le__bgrx(uint8_t* dst_ptr,
+                                              size_t dst_len,
+                                              uint8_t* dst_palette_ptr,
+                                              size_t dst_palette_len,
+                                              const uint8_t* src_ptr,
+                                              size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 1) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    d[0] = s2;
+    d[1] = s2;
+    d[2] = s1;
+    d[3] = s1;
+    d[4] = s0;
+    d[5] = s0;
+    d[6] = 0xFF;
+    d[7] = 0xFF;
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
 // --------
 
 static uint64_t  //
@@ -4327,7 +5303,9 @@ wuffs_base__pixel_swizzler__transparent_black_src(
   if (n > num_pixels) {
     n = num_pixels;
   }
-  memset(dst_ptr, 0, ((size_t)(n * dst_pixfmt_bytes_per_pixel)));
+  if (n > 0) {  // dst_ptr may be NULL when dst_len is zero.
+    memset(dst_ptr, 0, ((size_t)(n * dst_pixfmt_bytes_per_pixel)));
+  }
   return n;
 }
 
@@ -4373,10 +5351,20 @@ wuffs_base__pixel_swizzler__prepare__y(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_base__pixel_swizzler__xxxx__y__x86_avx2;
+      }
+#endif
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_base__pixel_swizzler__xxxx__y__x86_sse42;
       }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_base__pixel_swizzler__xxxx__y__arm_neon;
+      }
 #endif
       return wuffs_base__pixel_swizzler__xxxx__y;
 
@@ -4497,6 +5485,16 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__xxxx__index__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over;
       }
       return NULL;
@@ -4514,6 +5512,19 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      if (wuffs_base__slice_u8__copy_from_slice(dst_palette, src_palette) !=
+          WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+        return NULL;
+      }
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__index_bgra_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__index_bgra_nonpremul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
@@ -4529,6 +5540,16 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
               WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
             return NULL;
           }
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over;
       }
       return NULL;
@@ -4565,6 +5586,16 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__xxxx__index__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over;
       }
       return NULL;
@@ -4586,10 +5617,35 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_nonpremul(
               (WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH / 4)) {
             return NULL;
           }
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(
+              dst_palette.ptr, dst_palette.len, NULL, 0, src_palette.ptr,
+              src_palette.len) !=
+          (WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH / 4)) {
+        return NULL;
+      }
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__index_bgra_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__index_bgra_nonpremul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
       break;
@@ -4706,6 +5762,21 @@ wuffs_base__pixel_swizzler__prepare__indexed__bgra_binary(
           return wuffs_base__pixel_swizzler__xxxx__index_binary_alpha__src_over;
       }
       return NULL;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      if (wuffs_base__pixel_swizzler__swap_rgbx_bgrx(
+              dst_palette.ptr, dst_palette.len, NULL, 0, src_palette.ptr,
+              src_palette.len) !=
+          (WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH / 4)) {
+        return NULL;
+      }
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__xxxxxxxx__index__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__xxxxxxxx__index_binary_alpha__src_over;
+      }
+      return NULL;
   }
   return NULL;
 }
@@ -4742,6 +5813,9 @@ wuffs_base__pixel_swizzler__prepare__bgr_565(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       return wuffs_base__pixel_swizzler__rgbw__bgr_565;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      return wuffs_base__pixel_swizzler__rgbw_4x16le__bgr_565;
   }
   return NULL;
 }
@@ -4763,6 +5837,16 @@ wuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_base__pixel_swizzler__bgrw__bgr__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_base__pixel_swizzler__bgrw__bgr__arm_neon;
+      }
+#endif
       return wuffs_base__pixel_swizzler__bgrw__bgr;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
@@ -4776,12 +5860,25 @@ wuffs_base__pixel_swizzler__prepare__bgr(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_base__pixel_swizzler__bgrw__rgb__x86_avx2;
+      }
+#endif
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_base__pixel_swizzler__bgrw__rgb__x86_sse42;
       }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_base__pixel_swizzler__bgrw__rgb__arm_neon;
+      }
 #endif
       return wuffs_base__pixel_swizzler__bgrw__rgb;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      return wuffs_base__pixel_swizzler__bgrw_4x16le__rgb;
   }
   return NULL;
 }
@@ -4817,6 +5914,16 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__copy_4_4;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over;
       }
       return NULL;
@@ -4830,11 +5937,50 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;
       }
       return NULL;
@@ -4856,10 +6002,20 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_avx2;
+          }
+#endif
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
           }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__arm_neon;
+          }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
@@ -4870,12 +6026,51 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
@@ -4913,6 +6108,16 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src_over;
@@ -4928,9 +6133,38 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src_over;
@@ -4954,6 +6188,16 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src_over;
@@ -4963,12 +6207,41 @@ wuffs_base__pixel_swizzler__prepare__bgra_nonpremul_4x16le(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src_over;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
@@ -5021,11 +6294,30 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_premul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__copy_4_4;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over;
       }
       return NULL;
@@ -5051,16 +6343,35 @@ wuffs_base__pixel_swizzler__prepare__bgra_premul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_avx2;
+          }
+#endif
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
           }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__arm_neon;
+          }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_premul__src_over;
       }
       return NULL;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_premul__src_over;
+      }
+      return NULL;
   }
   return NULL;
 }
@@ -5081,9 +6392,20 @@ wuffs_base__pixel_swizzler__prepare__bgrx(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_base__pixel_swizzler__bgrw__bgrx__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_base__pixel_swizzler__bgrw__bgrx__arm_neon;
+      }
+#endif
       return wuffs_base__pixel_swizzler__bgrw__bgrx;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
       return wuffs_base__pixel_swizzler__bgrw_4x16le__bgrx;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
@@ -5096,7 +6418,20 @@ wuffs_base__pixel_swizzler__prepare__bgrx(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_base__pixel_swizzler__bgrw__rgbx__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_base__pixel_swizzler__bgrw__rgbx__arm_neon;
+      }
+#endif
       return wuffs_base__pixel_swizzler__bgrw__rgbx;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      return wuffs_base__pixel_swizzler__rgbw_4x16le__bgrx;
   }
   return NULL;
 }
@@ -5118,14 +6453,25 @@ wuffs_base__pixel_swizzler__prepare__rgb(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_base__pixel_swizzler__bgrw__rgb__x86_avx2;
+      }
+#endif
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
       if (wuffs_base__cpu_arch__have_x86_sse42()) {
         return wuffs_base__pixel_swizzler__bgrw__rgb__x86_sse42;
       }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_base__pixel_swizzler__bgrw__rgb__arm_neon;
+      }
 #endif
       return wuffs_base__pixel_swizzler__bgrw__rgb;
 
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
       return wuffs_base__pixel_swizzler__bgrw_4x16le__rgb;
 
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
@@ -5135,7 +6481,20 @@ wuffs_base__pixel_swizzler__prepare__rgb(wuffs_base__pixel_swizzler* p,
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+      if (wuffs_base__cpu_arch__have_x86_avx2()) {
+        return wuffs_base__pixel_swizzler__bgrw__bgr__x86_avx2;
+      }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+      if (wuffs_base__cpu_arch__have_arm_neon()) {
+        return wuffs_base__pixel_swizzler__bgrw__bgr__arm_neon;
+      }
+#endif
       return wuffs_base__pixel_swizzler__bgrw__bgr;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      return wuffs_base__pixel_swizzler__bgrw_4x16le__bgr;
   }
   return NULL;
 }
@@ -5169,10 +6528,20 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_avx2;
+          }
+#endif
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
           }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__arm_neon;
+          }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
@@ -5189,11 +6558,50 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over;
       }
       return NULL;
@@ -5217,6 +6625,16 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__copy_4_4;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over;
       }
       return NULL;
@@ -5224,12 +6642,51 @@ wuffs_base__pixel_swizzler__prepare__rgba_nonpremul(
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over;
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__arm_neon;
+          }
+#endif
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_BINARY:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       // TODO.
@@ -5282,13 +6739,32 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
       }
       return NULL;
 
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__rgba_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_premul__src_over;
+      }
+      return NULL;
+
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
       switch (blend) {
         case WUFFS_BASE__PIXEL_BLEND__SRC:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_avx2;
+          }
+#endif
 #if defined(WUFFS_BASE__CPU_ARCH__X86_FAMILY)
           if (wuffs_base__cpu_arch__have_x86_sse42()) {
             return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_sse42;
           }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__swap_rgbx_bgrx__arm_neon;
+          }
 #endif
           return wuffs_base__pixel_swizzler__swap_rgbx_bgrx;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
@@ -5319,9 +6795,28 @@ wuffs_base__pixel_swizzler__prepare__rgba_premul(
         case WUFFS_BASE__PIXEL_BLEND__SRC:
           return wuffs_base__pixel_swizzler__copy_4_4;
         case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+          if (wuffs_base__cpu_arch__have_x86_avx2()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__x86_avx2;
+          }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+          if (wuffs_base__cpu_arch__have_arm_neon()) {
+            return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__arm_neon;
+          }
+#endif
           return wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over;
       }
       return NULL;
+
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+      switch (blend) {
+        case WUFFS_BASE__PIXEL_BLEND__SRC:
+          return wuffs_base__pixel_swizzler__bgra_nonpremul_4x16le__bgra_nonpremul__src;
+        case WUFFS_BASE__PIXEL_BLEND__SRC_OVER:
+          return wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_premul__src_over;
+      }
+      return NULL;
   }
   return NULL;
 }
@@ -5342,6 +6837,23 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
   p->private_impl.transparent_black_func = NULL;
   p->private_impl.dst_pixfmt_bytes_per_pixel = 0;
   p->private_impl.src_pixfmt_bytes_per_pixel = 0;
+  p->private_impl.dst_pixfmt_repr = 0;
+  p->private_impl.blend = 0;
+  p->private_impl.color_transform_func = NULL;
+  p->private_impl.color_transform = NULL;
+  p->private_impl.src_pixfmt_repr = 0;
+  p->private_impl.dither = WUFFS_BASE__PIXEL_DITHER__NONE;
+  p->private_impl.dither_wide_func = NULL;
+  p->private_impl.dither_ordered_func = NULL;
+  p->private_impl.dither_origin_ptr = NULL;
+  p->private_impl.dither_origin_stride = 0;
+  p->private_impl.dither_origin_width = 0;
+  p->private_impl.dither_origin_height = 0;
+  p->private_impl.dither_workbuf = wuffs_base__empty_slice_u8();
+  p->private_impl.quantize_wide_func = NULL;
+  p->private_impl.quantize_cached_func = NULL;
+  p->private_impl.quantizer = NULL;
+  p->private_impl.float_wide_func = NULL;
 
   wuffs_base__pixel_swizzler__func func = NULL;
   wuffs_base__pixel_swizzler__transparent_black_func transparent_black_func =
@@ -5444,14 +6956,53 @@ wuffs_base__pixel_swizzler__prepare(wuffs_base__pixel_swizzler* p,
       break;
   }
 
+  if (!func) {
+    func = wuffs_base__pixel_swizzler__prepare__quantize(p, dst_pixfmt,
+                                                         src_pixfmt, blend);
+  }
+  if (!func) {
+    func = wuffs_base__pixel_swizzler__prepare__float(
+        p, dst_pixfmt, dst_palette, src_pixfmt, src_palette, blend);
+  }
+
   p->private_impl.func = func;
   p->private_impl.transparent_black_func = transparent_black_func;
   p->private_impl.dst_pixfmt_bytes_per_pixel = dst_pixfmt_bits_per_pixel / 8;
   p->private_impl.src_pixfmt_bytes_per_pixel = src_pixfmt_bits_per_pixel / 8;
+  p->private_impl.dst_pixfmt_repr = dst_pixfmt.repr;
+  p->private_impl.blend = blend;
+  p->private_impl.src_pixfmt_repr = src_pixfmt.repr;
   return wuffs_base__make_status(
       func ? NULL : wuffs_base__error__unsupported_pixel_swizzler_option);
 }
 
+// wuffs_base__pixel_swizzler__call_func calls the prepared func, or the
+// dithering, quantizing or floating point (two stage) equivalent.
+static inline uint64_t  //
+wuffs_base__pixel_swizzler__call_func(const wuffs_base__pixel_swizzler* p,
+                                      uint8_t* dst_ptr,
+                                      size_t dst_len,
+                                      uint8_t* dst_palette_ptr,
+                                      size_t dst_palette_len,
+                                      const uint8_t* src_ptr,
+                                      size_t src_len) {
+  if (p->private_impl.quantize_wide_func) {
+    return wuffs_base__pixel_swizzler__swizzle_quantized(
+        p, dst_ptr, dst_len, dst_palette_ptr, dst_palette_len, src_ptr,
+        src_len);
+  } else if (p->private_impl.dither_wide_func) {
+    return wuffs_base__pixel_swizzler__swizzle_dithered(
+        p, dst_ptr, dst_len, dst_palette_ptr, dst_palette_len, src_ptr,
+        src_len);
+  } else if (p->private_impl.float_wide_func) {
+    return wuffs_base__pixel_swizzler__swizzle_float(
+        p, dst_ptr, dst_len, dst_palette_ptr, dst_palette_len, src_ptr,
+        src_len);
+  }
+  return (*p->private_impl.func)(dst_ptr, dst_len, dst_palette_ptr,
+                                 dst_palette_len, src_ptr, src_len);
+}
+
 WUFFS_BASE__MAYBE_STATIC uint64_t  //
 wuffs_base__pixel_swizzler__limited_swizzle_u32_interleaved_from_reader(
     const wuffs_base__pixel_swizzler* p,
@@ -5466,9 +7017,14 @@ wuffs_base__pixel_swizzler__limited_swizzle_u32_interleaved_from_reader(
         ((uint64_t)up_to_num_pixels) *
             ((uint64_t)p->private_impl.src_pixfmt_bytes_per_pixel),
         ((uint64_t)(io2_r - iop_r)));
-    uint64_t n =
-        (*p->private_impl.func)(dst.ptr, dst.len, dst_palette.ptr,
-                                dst_palette.len, iop_r, (size_t)src_len);
+    uint64_t n = wuffs_base__pixel_swizzler__call_func(
+        p, dst.ptr, dst.len, dst_palette.ptr, dst_palette.len, iop_r,
+        (size_t)src_len);
+    if (p->private_impl.color_transform_func) {
+      (*p->private_impl.color_transform_func)(
+          p->private_impl.color_transform, dst.ptr,
+          (size_t)(n * p->private_impl.dst_pixfmt_bytes_per_pixel));
+    }
     *ptr_iop_r += n * p->private_impl.src_pixfmt_bytes_per_pixel;
     return n;
   }
@@ -5485,9 +7041,14 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_reader(
   if (p && p->private_impl.func) {
     const uint8_t* iop_r = *ptr_iop_r;
     uint64_t src_len = ((uint64_t)(io2_r - iop_r));
-    uint64_t n =
-        (*p->private_impl.func)(dst.ptr, dst.len, dst_palette.ptr,
-                                dst_palette.len, iop_r, (size_t)src_len);
+    uint64_t n = wuffs_base__pixel_swizzler__call_func(
+        p, dst.ptr, dst.len, dst_palette.ptr, dst_palette.len, iop_r,
+        (size_t)src_len);
+    if (p->private_impl.color_transform_func) {
+      (*p->private_impl.color_transform_func)(
+          p->private_impl.color_transform, dst.ptr,
+          (size_t)(n * p->private_impl.dst_pixfmt_bytes_per_pixel));
+    }
     *ptr_iop_r += n * p->private_impl.src_pixfmt_bytes_per_pixel;
     return n;
   }
@@ -5501,12 +7062,154 @@ wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
     wuffs_base__slice_u8 dst_palette,
     wuffs_base__slice_u8 src) {
   if (p && p->private_impl.func) {
-    return (*p->private_impl.func)(dst.ptr, dst.len, dst_palette.ptr,
-                                   dst_palette.len, src.ptr, src.len);
+    uint64_t n = wuffs_base__pixel_swizzler__call_func(
+        p, dst.ptr, dst.len, dst_palette.ptr, dst_palette.len, src.ptr,
+        src.len);
+    if (p->private_impl.color_transform_func) {
+      (*p->private_impl.color_transform_func)(
+          p->private_impl.color_transform, dst.ptr,
+          (size_t)(n * p->private_impl.dst_pixfmt_bytes_per_pixel));
+    }
+    return n;
   }
   return 0;
 }
 
+// wuffs_base__pixel_swizzler__swizzle_rows converts width pixels per row, for
+// height rows, merging them into one call when both sides' rows are
+// contiguous and no dithering depends on each pixel's position.
+static uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_rows(const wuffs_base__pixel_swizzler* p,
+                                         uint8_t* dst_ptr,
+                                         size_t dst_stride,
+                                         wuffs_base__slice_u8 dst_palette,
+                                         const uint8_t* src_ptr,
+                                         size_t src_stride,
+                                         size_t width,
+                                         size_t height) {
+  size_t dst_row_len = width * p->private_impl.dst_pixfmt_bytes_per_pixel;
+  size_t src_row_len = width * p->private_impl.src_pixfmt_bytes_per_pixel;
+  if ((dst_stride == dst_row_len) && (src_stride == src_row_len) &&
+      (p->private_impl.dither == WUFFS_BASE__PIXEL_DITHER__NONE)) {
+    dst_row_len *= height;
+    src_row_len *= height;
+    height = 1;
+  }
+
+  uint64_t total = 0;
+  size_t y = 0;
+  for (; y < height; y++) {
+    uint8_t* d = dst_ptr + (y * dst_stride);
+    uint64_t n = wuffs_base__pixel_swizzler__call_func(
+        p, d, dst_row_len, dst_palette.ptr, dst_palette.len,
+        src_ptr + (y * src_stride), src_row_len);
+    if (p->private_impl.color_transform_func) {
+      (*p->private_impl.color_transform_func)(
+          p->private_impl.color_transform, d,
+          (size_t)(n * p->private_impl.dst_pixfmt_bytes_per_pixel));
+    }
+    total += n;
+  }
+  return total;
+}
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src) {
+  return wuffs_base__pixel_swizzler__swizzle_interleaved_tiles(
+      p, dst, 0, dst_palette, src, 0, 1);
+}
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_swizzler__swizzle_interleaved_tiles(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__table_u8 dst,
+    size_t dst_tile_stride,
+    wuffs_base__slice_u8 dst_palette,
+    wuffs_base__table_u8 src,
+    size_t src_tile_stride,
+    size_t num_tiles) {
+  if (!p || !p->private_impl.func) {
+    return 0;
+  }
+  size_t width = (size_t)wuffs_base__u64__min(
+      dst.width / p->private_impl.dst_pixfmt_bytes_per_pixel,
+      src.width / p->private_impl.src_pixfmt_bytes_per_pixel);
+  size_t height = (size_t)wuffs_base__u64__min(dst.height, src.height);
+  if ((width == 0) || (height == 0) || (num_tiles == 0)) {
+    return 0;
+  }
+
+  // If the tiles are contiguous (and so are their rows), treat all of them as
+  // one taller tile.
+  size_t dst_tile_len = dst.stride * height;
+  size_t src_tile_len = src.stride * height;
+  if ((dst_tile_stride == dst_tile_len) && (src_tile_stride == src_tile_len) &&
+      (dst.stride == (width * p->private_impl.dst_pixfmt_bytes_per_pixel)) &&
+      (src.stride == (width * p->private_impl.src_pixfmt_bytes_per_pixel))) {
+    height *= num_tiles;
+    num_tiles = 1;
+  }
+
+  uint64_t total = 0;
+  size_t i = 0;
+  for (; i < num_tiles; i++) {
+    total += wuffs_base__pixel_swizzler__swizzle_rows(
+        p, dst.ptr + (i * dst_tile_stride), dst.stride, dst_palette,
+        src.ptr + (i * src_tile_stride), src.stride, width, height);
+  }
+  return total;
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_swizzler_cache__prepare(wuffs_base__pixel_swizzler_cache* c,
+                                          wuffs_base__pixel_swizzler* p,
+                                          wuffs_base__pixel_format dst_pixfmt,
+                                          wuffs_base__slice_u8 dst_palette,
+                                          wuffs_base__pixel_format src_pixfmt,
+                                          wuffs_base__slice_u8 src_palette,
+                                          wuffs_base__pixel_blend blend) {
+  if (!p) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  } else if (!c || wuffs_base__pixel_format__is_indexed(&dst_pixfmt) ||
+             wuffs_base__pixel_format__is_indexed(&src_pixfmt)) {
+    return wuffs_base__pixel_swizzler__prepare(p, dst_pixfmt, dst_palette,
+                                               src_pixfmt, src_palette, blend);
+  }
+
+  uint32_t n = wuffs_base__u32__min(
+      c->private_impl.num_entries,
+      WUFFS_BASE__PIXEL_SWIZZLER_CACHE__NUM_ENTRIES);
+  uint32_t i = 0;
+  for (; i < n; i++) {
+    const wuffs_base__pixel_swizzler* e = &c->private_impl.entries[i];
+    if ((e->private_impl.dst_pixfmt_repr == dst_pixfmt.repr) &&
+        (e->private_impl.src_pixfmt_repr == src_pixfmt.repr) &&
+        (e->private_impl.blend == blend)) {
+      *p = *e;
+      return wuffs_base__make_status(NULL);
+    }
+  }
+
+  wuffs_base__status status = wuffs_base__pixel_swizzler__prepare(
+      p, dst_pixfmt, dst_palette, src_pixfmt, src_palette, blend);
+  if (status.repr || !p->private_impl.func) {
+    return status;
+  }
+  i = c->private_impl.next_entry %
+      WUFFS_BASE__PIXEL_SWIZZLER_CACHE__NUM_ENTRIES;
+  c->private_impl.entries[i] = *p;
+  c->private_impl.next_entry =
+      (i + 1) % WUFFS_BASE__PIXEL_SWIZZLER_CACHE__NUM_ENTRIES;
+  if (n < WUFFS_BASE__PIXEL_SWIZZLER_CACHE__NUM_ENTRIES) {
+    c->private_impl.num_entries = n + 1;
+  }
+  return status;
+}
+
 WUFFS_BASE__MAYBE_STATIC uint64_t  //
 wuffs_base__pixel_swizzler__swizzle_interleaved_transparent_black(
     const wuffs_base__pixel_swizzler* p,
@@ -0,0 +1,593 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// --------
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_resampler__resample_h__x86_avx2(int16_t* dst_ptr,
+                                                  uint32_t dst_width,
+                                                  const uint8_t* src_ptr,
+                                                  const uint32_t* starts,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_resampler__resample_v__x86_avx2(uint8_t* dst_ptr,
+                                                  size_t dst_len,
+                                                  const int16_t* ring_ptr,
+                                                  size_t ring_stride,
+                                                  uint32_t ring_length,
+                                                  uint32_t ring_index,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps,
+                                                  bool clamp_to_alpha);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
+
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static void  //
+wuffs_base__pixel_resampler__resample_h__arm_neon(int16_t* dst_ptr,
+                                                  uint32_t dst_width,
+                                                  const uint8_t* src_ptr,
+                                                  const uint32_t* starts,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps);
+
+static void  //
+wuffs_base__pixel_resampler__resample_v__arm_neon(uint8_t* dst_ptr,
+                                                  size_t dst_len,
+                                                  const int16_t* ring_ptr,
+                                                  size_t ring_stride,
+                                                  uint32_t ring_length,
+                                                  uint32_t ring_index,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps,
+                                                  bool clamp_to_alpha);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
+// --------
+
+// The resampler works in fixed point. Filter weights are 2.14 (so that 1.0
+// is 0x4000) and sum to exactly 0x4000 for every destination pixel, so that
+// flat regions stay flat. The horizontal pass turns 8-bit source samples into
+// signed 16-bit intermediate samples with 6 fractional bits, keeping both
+// precision and any negative-lobe overshoot for the vertical pass, which
+// rounds (shifting right by 20 = 14 + 6) and clamps back to 8 bits.
+//
+// Each destination pixel reads exactly num_taps contiguous source pixels
+// (padding the filter with zero weights near the edges), which keeps the
+// inner loops simple and bounds-check free.
+
+#define WUFFS_BASE__PIXEL_RESAMPLER__WEIGHT_ONE 0x4000
+#define WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT 8
+#define WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT 20
+
+// wuffs_base__pixel_resampler__sin_pi returns sin(π * t). It avoids depending
+// on <math.h> (and libm), and is accurate to about 1e-9, far finer than the
+// 14 bit weights that it feeds.
+static double  //
+wuffs_base__pixel_resampler__sin_pi(double t) {
+  // Reduce t to the range [-0.5, +0.5], using sin(π * (1 - t)) = sin(π * t).
+  t -= 2.0 * ((double)((int64_t)(t * 0.5)));
+  if (t > 1.0) {
+    t -= 2.0;
+  } else if (t < -1.0) {
+    t += 2.0;
+  }
+  if (t > 0.5) {
+    t = 1.0 - t;
+  } else if (t < -0.5) {
+    t = -1.0 - t;
+  }
+
+  // Taylor series (in Horner form), good enough for |u| <= π/2.
+  double u = 3.14159265358979323846 * t;
+  double uu = u * u;
+  return u * (1.0 +
+              uu * ((-1.0 / 6.0) +
+                    uu * ((1.0 / 120.0) +
+                          uu * ((-1.0 / 5040.0) +
+                                uu * ((1.0 / 362880.0) +
+                                      uu * ((-1.0 / 39916800.0) +
+                                            uu * (1.0 / 6227020800.0)))))));
+}
+
+static double  //
+wuffs_base__pixel_resampler__support(
+    wuffs_base__pixel_resampling_filter filter) {
+  switch (filter) {
+    case WUFFS_BASE__PIXEL_RESAMPLING_FILTER__BOX:
+      return 0.5;
+    case WUFFS_BASE__PIXEL_RESAMPLING_FILTER__MITCHELL:
+      return 2.0;
+    case WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3:
+      return 3.0;
+  }
+  return 0.0;
+}
+
+static double  //
+wuffs_base__pixel_resampler__kernel(wuffs_base__pixel_resampling_filter filter,
+                                    double x) {
+  switch (filter) {
+    case WUFFS_BASE__PIXEL_RESAMPLING_FILTER__BOX:
+      return ((-0.5 < x) && (x <= 0.5)) ? 1.0 : 0.0;
+
+    case WUFFS_BASE__PIXEL_RESAMPLING_FILTER__MITCHELL:
+      // B = C = 1/3, pre-multiplied by 6 and then divided back out.
+      if (x < 0.0) {
+        x = -x;
+      }
+      if (x < 1.0) {
+        return ((7.0 * x * x * x) - (12.0 * x * x) + (16.0 / 3.0)) / 6.0;
+      } else if (x < 2.0) {
+        return (((-7.0 / 3.0) * x * x * x) + (12.0 * x * x) - (20.0 * x) +
+                (32.0 / 3.0)) /
+               6.0;
+      }
+      return 0.0;
+
+    case WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3:
+      if ((-1e-9 < x) && (x < 1e-9)) {
+        return 1.0;
+      } else if ((-3.0 < x) && (x < 3.0)) {
+        return (3.0 * wuffs_base__pixel_resampler__sin_pi(x) *
+                wuffs_base__pixel_resampler__sin_pi(x * (1.0 / 3.0))) /
+               (3.14159265358979323846 * 3.14159265358979323846 * x * x);
+      }
+      return 0.0;
+  }
+  return 0.0;
+}
+
+// wuffs_base__pixel_resampler__num_taps returns the number of source samples
+// that each destination sample reads (along one dimension), or zero if the
+// arguments are invalid.
+static uint32_t  //
+wuffs_base__pixel_resampler__num_taps(
+    uint32_t dst_n,
+    uint32_t src_n,
+    wuffs_base__pixel_resampling_filter filter) {
+  double support = wuffs_base__pixel_resampler__support(filter);
+  if ((dst_n == 0) || (src_n == 0) || !(support > 0.0)) {
+    return 0;
+  }
+  double scale = ((double)src_n) / ((double)dst_n);
+  if (scale > 1.0) {
+    support *= scale;
+  }
+  uint64_t n = (uint64_t)support;
+  if (((double)n) < support) {
+    n++;
+  }
+  n = (2 * n) + 1;
+  return (n < src_n) ? ((uint32_t)n) : src_n;
+}
+
+// wuffs_base__pixel_resampler__make_weights fills in the starts (dst_n
+// elements) and weights (dst_n * num_taps elements) for one dimension. The
+// scratch (num_taps elements) holds the unnormalized kernel values.
+static void  //
+wuffs_base__pixel_resampler__make_weights(
+    uint32_t* starts,
+    int16_t* weights,
+    double* scratch,
+    uint32_t num_taps,
+    uint32_t dst_n,
+    uint32_t src_n,
+    wuffs_base__pixel_resampling_filter filter) {
+  double scale = ((double)src_n) / ((double)dst_n);
+  double filter_scale = (scale > 1.0) ? scale : 1.0;
+  double inv_filter_scale = 1.0 / filter_scale;
+  double support =
+      wuffs_base__pixel_resampler__support(filter) * filter_scale;
+
+  uint32_t d;
+  for (d = 0; d < dst_n; d++) {
+    double center = (((double)d) + 0.5) * scale;
+    double lo = center - support + 0.5;
+    double hi = center + support + 0.5;
+    uint32_t x_min = (lo > 0.0) ? ((uint32_t)lo) : 0;
+    uint32_t x_max = (hi < ((double)src_n)) ? ((uint32_t)hi) : src_n;
+    if (x_min >= src_n) {
+      x_min = src_n - 1;
+    }
+    if (x_max <= x_min) {
+      x_max = x_min + 1;
+    } else if ((x_max - x_min) > num_taps) {
+      x_max = x_min + num_taps;
+    }
+
+    uint32_t start = x_min;
+    if (start > (src_n - num_taps)) {
+      start = src_n - num_taps;
+    }
+    starts[d] = start;
+
+    int16_t* w = weights + (((size_t)d) * num_taps);
+    uint32_t i;
+    for (i = 0; i < num_taps; i++) {
+      w[i] = 0;
+    }
+
+    double sum = 0.0;
+    uint32_t x;
+    for (x = x_min; x < x_max; x++) {
+      double k = wuffs_base__pixel_resampler__kernel(
+          filter, (((double)x) - center + 0.5) * inv_filter_scale);
+      scratch[x - x_min] = k;
+      sum += k;
+    }
+
+    int32_t total = 0;
+    int32_t biggest_w = 0;
+    uint32_t biggest_i = x_min - start;
+    if ((sum > 1e-9) || (sum < -1e-9)) {
+      double scale_to_one = WUFFS_BASE__PIXEL_RESAMPLER__WEIGHT_ONE / sum;
+      for (x = x_min; x < x_max; x++) {
+        double v = scratch[x - x_min] * scale_to_one;
+        int32_t q = (int32_t)((v >= 0.0) ? (v + 0.5) : (v - 0.5));
+        if (q > 0x7FFF) {
+          q = 0x7FFF;
+        } else if (q < -0x8000) {
+          q = -0x8000;
+        }
+        w[x - start] = (int16_t)q;
+        total += q;
+        if (biggest_w < q) {
+          biggest_w = q;
+          biggest_i = x - start;
+        }
+      }
+    }
+
+    // Give any rounding error to the biggest weight, so that the weights sum
+    // to exactly 1.0. If every kernel value was zero, this degrades to
+    // nearest neighbor.
+    w[biggest_i] = (int16_t)(w[biggest_i] +
+                             (WUFFS_BASE__PIXEL_RESAMPLER__WEIGHT_ONE - total));
+  }
+}
+
+static inline int16_t  //
+wuffs_base__pixel_resampler__clamp_i16(int32_t x) {
+  return (int16_t)((x > 0x7FFF) ? 0x7FFF : ((x < -0x8000) ? -0x8000 : x));
+}
+
+static inline uint8_t  //
+wuffs_base__pixel_resampler__clamp_u8(int32_t x) {
+  return (uint8_t)((x > 0xFF) ? 0xFF : ((x < 0) ? 0 : x));
+}
+
+static void  //
+wuffs_base__pixel_resampler__resample_h(int16_t* dst_ptr,
+                                        uint32_t dst_width,
+                                        const uint8_t* src_ptr,
+                                        const uint32_t* starts,
+                                        const int16_t* weights,
+                                        uint32_t num_taps) {
+  const int32_t bias = 1 << (WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT - 1);
+
+  uint32_t x;
+  for (x = 0; x < dst_width; x++) {
+    const uint8_t* s = src_ptr + (4u * ((size_t)starts[x]));
+    int32_t s0 = bias;
+    int32_t s1 = bias;
+    int32_t s2 = bias;
+    int32_t s3 = bias;
+    uint32_t k;
+    for (k = 0; k < num_taps; k++) {
+      int32_t w = weights[k];
+      s0 += w * ((int32_t)s[0]);
+      s1 += w * ((int32_t)s[1]);
+      s2 += w * ((int32_t)s[2]);
+      s3 += w * ((int32_t)s[3]);
+      s += 4;
+    }
+    weights += num_taps;
+
+    dst_ptr[0] = wuffs_base__pixel_resampler__clamp_i16(
+        s0 >> WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT);
+    dst_ptr[1] = wuffs_base__pixel_resampler__clamp_i16(
+        s1 >> WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT);
+    dst_ptr[2] = wuffs_base__pixel_resampler__clamp_i16(
+        s2 >> WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT);
+    dst_ptr[3] = wuffs_base__pixel_resampler__clamp_i16(
+        s3 >> WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT);
+    dst_ptr += 4;
+  }
+}
+
+// wuffs_base__pixel_resampler__resample_v_tail is the non-SIMD vertical pass,
+// for the samples from offset i onwards. It is also the SIMD implementations'
+// tail loop.
+static void  //
+wuffs_base__pixel_resampler__resample_v_tail(uint8_t* dst_ptr,
+                                             size_t dst_len,
+                                             size_t i,
+                                             const int16_t* ring_ptr,
+                                             size_t ring_stride,
+                                             uint32_t ring_length,
+                                             uint32_t ring_index,
+                                             const int16_t* weights,
+                                             uint32_t num_taps,
+                                             bool clamp_to_alpha) {
+  const int32_t bias = 1 << (WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT - 1);
+
+  for (; (i + 4) <= dst_len; i += 4) {
+    int32_t s0 = bias;
+    int32_t s1 = bias;
+    int32_t s2 = bias;
+    int32_t s3 = bias;
+    uint32_t slot = ring_index;
+    uint32_t k;
+    for (k = 0; k < num_taps; k++) {
+      const int16_t* r = ring_ptr + (((size_t)slot) * ring_stride) + i;
+      int32_t w = weights[k];
+      s0 += w * ((int32_t)r[0]);
+      s1 += w * ((int32_t)r[1]);
+      s2 += w * ((int32_t)r[2]);
+      s3 += w * ((int32_t)r[3]);
+      if (++slot == ring_length) {
+        slot = 0;
+      }
+    }
+
+    uint8_t c0 = wuffs_base__pixel_resampler__clamp_u8(
+        s0 >> WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT);
+    uint8_t c1 = wuffs_base__pixel_resampler__clamp_u8(
+        s1 >> WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT);
+    uint8_t c2 = wuffs_base__pixel_resampler__clamp_u8(
+        s2 >> WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT);
+    uint8_t c3 = wuffs_base__pixel_resampler__clamp_u8(
+        s3 >> WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT);
+    if (clamp_to_alpha) {
+      // Ringing can push a premultiplied color above its alpha.
+      c0 = (c0 < c3) ? c0 : c3;
+      c1 = (c1 < c3) ? c1 : c3;
+      c2 = (c2 < c3) ? c2 : c3;
+    }
+    dst_ptr[i + 0] = c0;
+    dst_ptr[i + 1] = c1;
+    dst_ptr[i + 2] = c2;
+    dst_ptr[i + 3] = c3;
+  }
+}
+
+static void  //
+wuffs_base__pixel_resampler__resample_v(uint8_t* dst_ptr,
+                                        size_t dst_len,
+                                        const int16_t* ring_ptr,
+                                        size_t ring_stride,
+                                        uint32_t ring_length,
+                                        uint32_t ring_index,
+                                        const int16_t* weights,
+                                        uint32_t num_taps,
+                                        bool clamp_to_alpha) {
+  wuffs_base__pixel_resampler__resample_v_tail(
+      dst_ptr, dst_len, 0, ring_ptr, ring_stride, ring_length, ring_index,
+      weights, num_taps, clamp_to_alpha);
+}
+
+// --------
+
+WUFFS_BASE__MAYBE_STATIC uint64_t  //
+wuffs_base__pixel_resampler__workbuf_len(
+    uint32_t dst_width,
+    uint32_t dst_height,
+    uint32_t src_width,
+    uint32_t src_height,
+    wuffs_base__pixel_resampling_filter filter) {
+  uint64_t h_num_taps =
+      wuffs_base__pixel_resampler__num_taps(dst_width, src_width, filter);
+  uint64_t v_num_taps =
+      wuffs_base__pixel_resampler__num_taps(dst_height, src_height, filter);
+  if ((h_num_taps == 0) || (v_num_taps == 0)) {
+    return 0;
+  }
+  uint64_t h_weights_len = ((uint64_t)dst_width) * h_num_taps;
+  uint64_t v_weights_len = ((uint64_t)dst_height) * v_num_taps;
+  uint64_t ring_len = ((uint64_t)dst_width) * v_num_taps;
+  if ((h_weights_len > 0x0FFFFFFFFFFFFFFF) ||
+      (v_weights_len > 0x0FFFFFFFFFFFFFFF) ||
+      (ring_len > 0x0FFFFFFFFFFFFFFF)) {
+    return 0;
+  }
+
+  // The 8 is slack for aligning the workbuf's start.
+  uint64_t n = 8;
+  n = wuffs_base__u64__sat_add(
+      n, 8 * ((h_num_taps > v_num_taps) ? h_num_taps : v_num_taps));
+  n = wuffs_base__u64__sat_add(n, 4 * ((uint64_t)dst_width));
+  n = wuffs_base__u64__sat_add(n, 4 * ((uint64_t)dst_height));
+  n = wuffs_base__u64__sat_add(n, 2 * h_weights_len);
+  n = wuffs_base__u64__sat_add(n, 2 * v_weights_len);
+  n = wuffs_base__u64__sat_add(n, 8 * ring_len);
+  return n;
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_resampler__prepare(
+    wuffs_base__pixel_resampler* r,
+    wuffs_base__pixel_format pixfmt,
+    uint32_t dst_width,
+    uint32_t dst_height,
+    uint32_t src_width,
+    uint32_t src_height,
+    wuffs_base__pixel_resampling_filter filter,
+    wuffs_base__slice_u8 workbuf) {
+  if (!r) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  }
+  memset(&r->private_impl, 0, sizeof(r->private_impl));
+
+  switch (pixfmt.repr) {
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+      break;
+    default:
+      return wuffs_base__make_status(wuffs_base__error__unsupported_option);
+  }
+
+  uint64_t workbuf_len = wuffs_base__pixel_resampler__workbuf_len(
+      dst_width, dst_height, src_width, src_height, filter);
+  if (workbuf_len == 0) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  } else if (workbuf_len > ((uint64_t)workbuf.len)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_workbuf_length);
+  }
+
+  uint32_t h_num_taps =
+      wuffs_base__pixel_resampler__num_taps(dst_width, src_width, filter);
+  uint32_t v_num_taps =
+      wuffs_base__pixel_resampler__num_taps(dst_height, src_height, filter);
+
+  uint8_t* p = workbuf.ptr + ((8 - (((uintptr_t)workbuf.ptr) & 7)) & 7);
+  double* scratch = (double*)(void*)p;
+  p += 8 * ((size_t)((h_num_taps > v_num_taps) ? h_num_taps : v_num_taps));
+  uint32_t* h_starts = (uint32_t*)(void*)p;
+  p += 4 * ((size_t)dst_width);
+  uint32_t* v_starts = (uint32_t*)(void*)p;
+  p += 4 * ((size_t)dst_height);
+  int16_t* h_weights = (int16_t*)(void*)p;
+  p += 2 * ((size_t)dst_width) * h_num_taps;
+  int16_t* v_weights = (int16_t*)(void*)p;
+  p += 2 * ((size_t)dst_height) * v_num_taps;
+  int16_t* ring_ptr = (int16_t*)(void*)p;
+
+  wuffs_base__pixel_resampler__make_weights(h_starts, h_weights, scratch,
+                                            h_num_taps, dst_width, src_width,
+                                            filter);
+  wuffs_base__pixel_resampler__make_weights(v_starts, v_weights, scratch,
+                                            v_num_taps, dst_height, src_height,
+                                            filter);
+
+  wuffs_base__pixel_resampler__h_func h_func =
+      &wuffs_base__pixel_resampler__resample_h;
+  wuffs_base__pixel_resampler__v_func v_func =
+      &wuffs_base__pixel_resampler__resample_v;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    h_func = &wuffs_base__pixel_resampler__resample_h__x86_avx2;
+    v_func = &wuffs_base__pixel_resampler__resample_v__x86_avx2;
+  }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    h_func = &wuffs_base__pixel_resampler__resample_h__arm_neon;
+    v_func = &wuffs_base__pixel_resampler__resample_v__arm_neon;
+  }
+#endif
+
+  r->private_impl.h_func = h_func;
+  r->private_impl.v_func = v_func;
+  r->private_impl.pixfmt_repr = pixfmt.repr;
+  r->private_impl.dst_width = dst_width;
+  r->private_impl.dst_height = dst_height;
+  r->private_impl.src_width = src_width;
+  r->private_impl.src_height = src_height;
+  r->private_impl.h_num_taps = h_num_taps;
+  r->private_impl.v_num_taps = v_num_taps;
+  r->private_impl.h_starts = h_starts;
+  r->private_impl.v_starts = v_starts;
+  r->private_impl.h_weights = h_weights;
+  r->private_impl.v_weights = v_weights;
+  r->private_impl.ring_ptr = ring_ptr;
+  return wuffs_base__make_status(NULL);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_resampler__push_src_row(wuffs_base__pixel_resampler* r,
+                                          wuffs_base__pixel_buffer* dst,
+                                          wuffs_base__slice_u8 src_row) {
+  if (!r || !r->private_impl.h_func) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  } else if (!dst ||
+             (dst->pixcfg.private_impl.pixfmt.repr !=
+              r->private_impl.pixfmt_repr) ||
+             (dst->pixcfg.private_impl.width < r->private_impl.dst_width) ||
+             (dst->pixcfg.private_impl.height < r->private_impl.dst_height)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  } else if (src_row.len < (4 * ((size_t)r->private_impl.src_width))) {
+    return wuffs_base__make_status(
+        wuffs_base__error__bad_argument_length_too_short);
+  } else if (r->private_impl.num_src_rows_pushed >=
+             r->private_impl.src_height) {
+    return wuffs_base__make_status(wuffs_base__error__bad_call_sequence);
+  }
+
+  uint32_t dst_width = r->private_impl.dst_width;
+  uint32_t v_num_taps = r->private_impl.v_num_taps;
+  size_t ring_stride = 4 * ((size_t)dst_width);
+  uint32_t src_y = r->private_impl.num_src_rows_pushed++;
+
+  // The ring buffer holds the last v_num_taps horizontally resampled rows.
+  // Each destination row reads v_num_taps consecutive rows and those starts
+  // never decrease, so the row being overwritten is no longer needed.
+  (*r->private_impl.h_func)(
+      r->private_impl.ring_ptr + (((size_t)(src_y % v_num_taps)) * ring_stride),
+      dst_width, src_row.ptr, r->private_impl.h_starts,
+      r->private_impl.h_weights, r->private_impl.h_num_taps);
+
+  bool clamp_to_alpha =
+      (r->private_impl.pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL) ||
+      (r->private_impl.pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL);
+  wuffs_base__table_u8 dst_table = wuffs_base__pixel_buffer__plane(dst, 0);
+  while (r->private_impl.num_dst_rows_written < r->private_impl.dst_height) {
+    uint32_t dst_y = r->private_impl.num_dst_rows_written;
+    uint32_t start = r->private_impl.v_starts[dst_y];
+    if ((start + v_num_taps) > r->private_impl.num_src_rows_pushed) {
+      break;
+    }
+    (*r->private_impl.v_func)(
+        wuffs_base__table_u8__row_u32(dst_table, dst_y).ptr,
+        4 * ((size_t)dst_width), r->private_impl.ring_ptr, ring_stride,
+        v_num_taps, start % v_num_taps,
+        r->private_impl.v_weights + (((size_t)dst_y) * v_num_taps), v_num_taps,
+        clamp_to_alpha);
+    r->private_impl.num_dst_rows_written++;
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_resampler__resample(wuffs_base__pixel_resampler* r,
+                                      wuffs_base__pixel_buffer* dst,
+                                      const wuffs_base__pixel_buffer* src) {
+  if (!r || !r->private_impl.h_func) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  } else if (!src ||
+             (src->pixcfg.private_impl.pixfmt.repr !=
+              r->private_impl.pixfmt_repr) ||
+             (src->pixcfg.private_impl.width < r->private_impl.src_width) ||
+             (src->pixcfg.private_impl.height < r->private_impl.src_height)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+
+  const wuffs_base__table_u8* src_table = &src->private_impl.planes[0];
+  while (r->private_impl.num_src_rows_pushed < r->private_impl.src_height) {
+    wuffs_base__status status = wuffs_base__pixel_resampler__push_src_row(
+        r, dst,
+        wuffs_base__table_u8__row_u32(*src_table,
+                                      r->private_impl.num_src_rows_pushed));
+    if (status.repr) {
+      return status;
+    }
+  }
+  return wuffs_base__make_status(NULL);
+}
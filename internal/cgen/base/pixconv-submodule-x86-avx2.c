@@ -300,7 +300,7 @@ wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx_x86_avx2(
     const uint8_t* up1,
     const uint8_t* up2) {
   if ((x + 32u) > x_end) {
-    wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx(  //
+    wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx(  //
         dst, x, x_end, y, up0, up1, up2);
     return;
   }
@@ -640,5 +640,2281 @@ wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2(
   return dst_ptr;
 }
 #endif
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp_major = src_ptr_major;
+  const uint8_t* sp_minor = src_ptr_minor;
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    while (src_len--) {
+      *dp++ = (uint8_t)(((3u * ((uint32_t)(*sp_major++))) +  //
+                         (1u * ((uint32_t)(*sp_minor++))) +  //
+                         h1v2_bias) >>
+                        2u);
+    }
+    return dst_ptr;
+  }
+
+  const __m256i k0103 = _mm256_set1_epi16(0x0103);
+  const __m256i bias = _mm256_set1_epi16((int16_t)h1v2_bias);
+
+  while (src_len > 0u) {
+    // Load 32 samples from the major (jxx) and minor (nxx) rows.
+    //
+    // major = [j00 j01 j02 j03 .. j28 j29 j30 j31]
+    // minor = [n00 n01 n02 n03 .. n28 n29 n30 n31]
+    __m256i major = _mm256_lddqu_si256((const __m256i*)(const void*)sp_major);
+    __m256i minor = _mm256_lddqu_si256((const __m256i*)(const void*)sp_minor);
+
+    // Unpack and multiply-add to get u16x16 vectors.
+    //
+    // sum_lo = [3*j00+1*n00 3*j01+1*n01 .. 3*j07+1*n07  3*j16+1*n16 .. ]
+    // sum_hi = [3*j08+1*n08 3*j09+1*n09 .. 3*j15+1*n15  3*j24+1*n24 .. ]
+    __m256i sum_lo =
+        _mm256_maddubs_epi16(_mm256_unpacklo_epi8(major, minor), k0103);
+    __m256i sum_hi =
+        _mm256_maddubs_epi16(_mm256_unpackhi_epi8(major, minor), k0103);
+
+    // Bias by 1 or 2 (alternating per row) and then divide by 4 (which is
+    // 3+1). The within-lane pack undoes the within-lane unpack, so no
+    // permute is needed.
+    __m256i d = _mm256_packus_epi16(
+        _mm256_srli_epi16(_mm256_add_epi16(sum_lo, bias), 2),
+        _mm256_srli_epi16(_mm256_add_epi16(sum_hi, bias), 2));
+    _mm256_storeu_si256((__m256i*)(void*)dp, d);
+
+    // Advance by up to 32 samples. The first iteration might be smaller than
+    // 32 so that all of the remaining steps are exactly 32.
+    size_t n = 32u - (31u & (0u - src_len));
+    dp += n;
+    sp_major += n;
+    sp_minor += n;
+    src_len -= n;
+  }
+
+  return dst_ptr;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column) {
+  uint8_t* dp = dst_ptr;
+  const uint8_t* sp = src_ptr_major;
+
+  if (first_column) {
+    src_len--;
+    if ((src_len <= 0u) && last_column) {
+      uint8_t sv = *sp++;
+      *dp++ = sv;
+      *dp++ = sv;
+      return dst_ptr;
+    }
+    uint32_t svp1 = sp[+1];
+    uint8_t sv = *sp++;
+    *dp++ = sv;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svp1 + 2u) >> 2u);
+    if (src_len <= 0u) {
+      return dst_ptr;
+    }
+  }
+
+  if (last_column) {
+    src_len--;
+  }
+
+  if (src_len < 32) {
+    // This fallback is the same as the non-SIMD-capable code path.
+    for (; src_len > 0u; src_len--) {
+      uint32_t svm1 = sp[-1];
+      uint32_t svp1 = sp[+1];
+      uint32_t sv3 = 3u * (uint32_t)(*sp++);
+      *dp++ = (uint8_t)((sv3 + svm1 + 1u) >> 2u);
+      *dp++ = (uint8_t)((sv3 + svp1 + 2u) >> 2u);
+    }
+
+  } else {
+    const __m256i k0103 = _mm256_set1_epi16(0x0103);
+    const __m256i k0001 = _mm256_set1_epi16(0x0001);
+    const __m256i k0002 = _mm256_set1_epi16(0x0002);
+
+    while (src_len > 0u) {
+      // Load 1+32+1 samples (three u8x32 vectors).
+      //
+      // p0 = [s00 s01 s02 s03 .. s28 s29 s30 s31]   // p0 = "plus  0"
+      // m1 = [sm1 s00 s01 s02 .. s27 s28 s29 s30]   // m1 = "minus 1"
+      // p1 = [s01 s02 s03 s04 .. s29 s30 s31 s32]   // p1 = "plus  1"
+      __m256i p0 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp + 0));
+      __m256i m1 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp - 1));
+      __m256i p1 = _mm256_lddqu_si256((const __m256i*)(const void*)(sp + 1));
+
+      // Unpack and multiply-add to get u16x16 vectors.
+      //
+      // sum_m1_lo = [3*s00+1*sm1 3*s01+1*s00 .. 3*s23+1*s22]
+      // sum_p1_hi = [3*s08+1*s09 3*s09+1*s10 .. 3*s31+1*s32]
+      __m256i sum_m1_lo =
+          _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p0, m1), k0103);
+      __m256i sum_m1_hi =
+          _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p0, m1), k0103);
+      __m256i sum_p1_lo =
+          _mm256_maddubs_epi16(_mm256_unpacklo_epi8(p0, p1), k0103);
+      __m256i sum_p1_hi =
+          _mm256_maddubs_epi16(_mm256_unpackhi_epi8(p0, p1), k0103);
+
+      // Bias by 1 (on the left) or 2 (on the right) and then divide by 4
+      // (which is 3+1). As for the h2v2 flavor, shift the right (p1) values
+      // up by 8 bits and bitwise-or to interleave the even and odd
+      // destination samples.
+      //
+      // d_lo = [d00 d01 .. d14 d15  d32 d33 .. d46 d47]
+      // d_hi = [d16 d17 .. d30 d31  d48 d49 .. d62 d63]
+      __m256i d_lo = _mm256_or_si256(
+          _mm256_srli_epi16(_mm256_add_epi16(sum_m1_lo, k0001), 2),
+          _mm256_slli_epi16(
+              _mm256_srli_epi16(_mm256_add_epi16(sum_p1_lo, k0002), 2), 8));
+      __m256i d_hi = _mm256_or_si256(
+          _mm256_srli_epi16(_mm256_add_epi16(sum_m1_hi, k0001), 2),
+          _mm256_slli_epi16(
+              _mm256_srli_epi16(_mm256_add_epi16(sum_p1_hi, k0002), 2), 8));
+
+      // Permute and store.
+      _mm256_storeu_si256((__m256i*)(void*)(dp + 0x00),
+                          _mm256_permute2x128_si256(d_lo, d_hi, 0x20));
+      _mm256_storeu_si256((__m256i*)(void*)(dp + 0x20),
+                          _mm256_permute2x128_si256(d_lo, d_hi, 0x31));
+
+      // Advance by up to 32 source samples (64 destination samples). The first
+      // iteration might be smaller than 32 so that all of the remaining steps
+      // are exactly 32.
+      size_t n = 32u - (31u & (0u - src_len));
+      dp += 2u * n;
+      sp += n;
+      src_len -= n;
+    }
+  }
+
+  if (last_column) {
+    uint32_t svm1 = sp[-1];
+    uint8_t sv = *sp++;
+    *dp++ = (uint8_t)(((3u * (uint32_t)sv) + svm1 + 1u) >> 2u);
+    *dp++ = sv;
+  }
+
+  return dst_ptr;
+}
+
+// wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_x86_avx2 is like
+// wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k but processes 8 pixels
+// (32 bytes) at a time.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_x86_avx2(
+    uint8_t* dst_iter,
+    const uint8_t* up3,
+    size_t n,
+    bool invert) {
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i k0080 = _mm256_set1_epi16(0x0080);
+  const __m256i alpha = _mm256_set1_epi32(-0x01000000);
+  const __m256i inv = _mm256_set1_epi32(invert ? 0x00FFFFFF : 0x00000000);
+
+  for (; n >= 8u; n -= 8u) {
+    // Load 8 pixels (as u8x32) and their 8 w values (as u32x8). Spread each
+    // w value to all four u8 elements of its u32 element.
+    //
+    // c = [b0 g0 r0 a0  b1 g1 r1 a1  ..  b7 g7 r7 a7]
+    // w = [w0 w0 w0 w0  w1 w1 w1 w1  ..  w7 w7 w7 w7]
+    __m256i c = _mm256_xor_si256(
+        inv, _mm256_lddqu_si256((const __m256i*)(const void*)dst_iter));
+    __m256i w = _mm256_cvtepu8_epi32(
+        _mm_loadl_epi64((const __m128i*)(const void*)up3));
+    w = _mm256_or_si256(w, _mm256_slli_epi32(w, 16));
+
+    // Widen to u16 and multiply. Element-wise, the products are at most
+    // (0xFF * 0xFF) = 0xFE01, which fits in a u16.
+    __m256i prod_lo = _mm256_mullo_epi16(_mm256_unpacklo_epi8(c, zero),
+                                         _mm256_unpacklo_epi32(w, w));
+    __m256i prod_hi = _mm256_mullo_epi16(_mm256_unpackhi_epi8(c, zero),
+                                         _mm256_unpackhi_epi32(w, w));
+
+    // Divide by 0xFF, rounding to nearest. For every u16 product p, that's
+    // ((p + 0x7F) / 0xFF) == ((t + (t >> 8)) >> 8) where t = (p + 0x80).
+    __m256i t_lo = _mm256_add_epi16(prod_lo, k0080);
+    __m256i t_hi = _mm256_add_epi16(prod_hi, k0080);
+    __m256i q_lo = _mm256_srli_epi16(
+        _mm256_add_epi16(t_lo, _mm256_srli_epi16(t_lo, 8)), 8);
+    __m256i q_hi = _mm256_srli_epi16(
+        _mm256_add_epi16(t_hi, _mm256_srli_epi16(t_hi, 8)), 8);
+
+    // Pack (undoing the within-lane unpack), set the alpha and store.
+    _mm256_storeu_si256(
+        (__m256i*)(void*)dst_iter,
+        _mm256_or_si256(alpha, _mm256_packus_epi16(q_lo, q_hi)));
+
+    dst_iter += 32u;
+    up3 += 8u;
+  }
+
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k(dst_iter, up3, n, invert);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_bgrx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_x86_avx2(
+      dst_iter, up3, x_end - x, false);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_rgbx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_x86_avx2(
+      dst_iter, up3, x_end - x, false);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx_x86_avx2(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_x86_avx2(
+      dst_iter, up3, x_end - x, true);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx_x86_avx2(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k_x86_avx2(
+      dst_iter, up3, x_end - x, true);
+}
+
+// --------
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__swap_rgbx_bgrx__x86_avx2(uint8_t* dst_ptr,
+                                                     size_t dst_len,
+                                                     uint8_t* dst_palette_ptr,
+                                                     size_t dst_palette_len,
+                                                     const uint8_t* src_ptr,
+                                                     size_t src_len) {
+  size_t len = (dst_len < src_len ? dst_len : src_len) / 4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  __m256i shuffle = _mm256_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02,  //
+                                    +0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02);
+
+  while (n >= 8) {
+    __m256i x;
+    x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n--) {
+    uint8_t s0 = s[0];
+    uint8_t s1 = s[1];
+    uint8_t s2 = s[2];
+    uint8_t s3 = s[3];
+    d[0] = s2;
+    d[1] = s1;
+    d[2] = s0;
+    d[3] = s3;
+    s += 4;
+    d += 4;
+  }
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__xxxx__y__x86_avx2(uint8_t* dst_ptr,
+                                              size_t dst_len,
+                                              uint8_t* dst_palette_ptr,
+                                              size_t dst_palette_len,
+                                              const uint8_t* src_ptr,
+                                              size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // After _mm256_cvtepu8_epi32, each u32 lane holds one Y value in its low
+  // byte. Spread that to the B, G and R bytes and set the A byte to 0xFF.
+  __m256i shuffle = _mm256_set_epi8(-0x80, +0x0C, +0x0C, +0x0C,  //
+                                    -0x80, +0x08, +0x08, +0x08,  //
+                                    -0x80, +0x04, +0x04, +0x04,  //
+                                    -0x80, +0x00, +0x00, +0x00,  //
+                                    -0x80, +0x0C, +0x0C, +0x0C,  //
+                                    -0x80, +0x08, +0x08, +0x08,  //
+                                    -0x80, +0x04, +0x04, +0x04,  //
+                                    -0x80, +0x00, +0x00, +0x00);
+  __m256i or_ff = _mm256_set1_epi32(-0x01000000);
+
+  while (n >= 16) {
+    __m128i y = _mm_lddqu_si128((const __m128i*)(const void*)s);
+    __m256i x0 = _mm256_cvtepu8_epi32(y);
+    __m256i x1 = _mm256_cvtepu8_epi32(_mm_srli_si128(y, 8));
+    x0 = _mm256_or_si256(_mm256_shuffle_epi8(x0, shuffle), or_ff);
+    x1 = _mm256_or_si256(_mm256_shuffle_epi8(x1, shuffle), or_ff);
+    _mm256_storeu_si256((__m256i*)(void*)(d + 0x00), x0);
+    _mm256_storeu_si256((__m256i*)(void*)(d + 0x20), x1);
+
+    s += 16 * 1;
+    d += 16 * 4;
+    n -= 16;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), 0xFF000000 | (0x010101 * (uint32_t)s[0]));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgr__x86_avx2(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // AVX2 byte shuffles don't cross 128-bit lanes, so load the first four
+  // pixels (12 bytes) into the low lane and the next four into the high lane.
+  __m256i shuffle = _mm256_set_epi8(-0x80, +0x0B, +0x0A, +0x09,  //
+                                    -0x80, +0x08, +0x07, +0x06,  //
+                                    -0x80, +0x05, +0x04, +0x03,  //
+                                    -0x80, +0x02, +0x01, +0x00,  //
+                                    -0x80, +0x0B, +0x0A, +0x09,  //
+                                    -0x80, +0x08, +0x07, +0x06,  //
+                                    -0x80, +0x05, +0x04, +0x03,  //
+                                    -0x80, +0x02, +0x01, +0x00);
+  __m256i or_ff = _mm256_set1_epi32(-0x01000000);
+
+  // Each iteration reads 28 bytes, which is more than (8 * 3).
+  while (n >= 10) {
+    __m256i x = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_lddqu_si128((const __m128i*)(const void*)(s + 0))),
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 12)), 1);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = _mm256_or_si256(x, or_ff);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 3;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u24le__no_bounds_check(s + (0 * 3)));
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__bgrx__x86_avx2(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  __m256i or_ff = _mm256_set1_epi32(-0x01000000);
+
+  while (n >= 8) {
+    __m256i x;
+    x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = _mm256_or_si256(x, or_ff);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        0xFF000000 | wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgb__x86_avx2(uint8_t* dst_ptr,
+                                                size_t dst_len,
+                                                uint8_t* dst_palette_ptr,
+                                                size_t dst_palette_len,
+                                                const uint8_t* src_ptr,
+                                                size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len3 = src_len / 3;
+  size_t len = (dst_len4 < src_len3) ? dst_len4 : src_len3;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  // See wuffs_base__pixel_swizzler__bgrw__bgr__x86_avx2 for why each 128-bit
+  // lane is loaded separately.
+  __m256i shuffle = _mm256_set_epi8(-0x80, +0x09, +0x0A, +0x0B,  //
+                                    -0x80, +0x06, +0x07, +0x08,  //
+                                    -0x80, +0x03, +0x04, +0x05,  //
+                                    -0x80, +0x00, +0x01, +0x02,  //
+                                    -0x80, +0x09, +0x0A, +0x0B,  //
+                                    -0x80, +0x06, +0x07, +0x08,  //
+                                    -0x80, +0x03, +0x04, +0x05,  //
+                                    -0x80, +0x00, +0x01, +0x02);
+  __m256i or_ff = _mm256_set1_epi32(-0x01000000);
+
+  // Each iteration reads 28 bytes, which is more than (8 * 3).
+  while (n >= 10) {
+    __m256i x = _mm256_inserti128_si256(
+        _mm256_castsi128_si256(
+            _mm_lddqu_si128((const __m128i*)(const void*)(s + 0))),
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 12)), 1);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = _mm256_or_si256(x, or_ff);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 3;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 3;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgrw__rgbx__x86_avx2(uint8_t* dst_ptr,
+                                                 size_t dst_len,
+                                                 uint8_t* dst_palette_ptr,
+                                                 size_t dst_palette_len,
+                                                 const uint8_t* src_ptr,
+                                                 size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  __m256i shuffle = _mm256_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02,  //
+                                    +0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02);
+  __m256i or_ff = _mm256_set1_epi32(-0x01000000);
+
+  while (n >= 8) {
+    __m256i x;
+    x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = _mm256_or_si256(x, or_ff);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint8_t b0 = s[0];
+    uint8_t b1 = s[1];
+    uint8_t b2 = s[2];
+    d[0] = b2;
+    d[1] = b1;
+    d[2] = b0;
+    d[3] = 0xFF;
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__premul_8_x86_avx2 converts 8 non-premultiplied
+// BGRA (or RGBA) pixels to premultiplied alpha, producing exactly the same
+// output as the non-SIMD
+// wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul function.
+//
+// That function computes ((((c * 0x101) * (a * 0x101)) / 0xFFFF) >> 8) for
+// each color channel c. For all 8-bit c and a, that equals (((c * a) *
+// 0x8101) >> 23), where (c * a) fits in 16 bits. Multiplying the alpha
+// channel by 0xFF leaves it unchanged.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__pixel_swizzler__premul_8_x86_avx2(__m256i x) {
+  __m256i shuffle_aaa = _mm256_set_epi8(-0x80, +0x0F, +0x0F, +0x0F,  //
+                                        -0x80, +0x0B, +0x0B, +0x0B,  //
+                                        -0x80, +0x07, +0x07, +0x07,  //
+                                        -0x80, +0x03, +0x03, +0x03,  //
+                                        -0x80, +0x0F, +0x0F, +0x0F,  //
+                                        -0x80, +0x0B, +0x0B, +0x0B,  //
+                                        -0x80, +0x07, +0x07, +0x07,  //
+                                        -0x80, +0x03, +0x03, +0x03);
+  __m256i or_ff = _mm256_set1_epi32(-0x01000000);
+  __m256i u8101 = _mm256_set1_epi16(-0x7EFF);
+  __m256i zero = _mm256_setzero_si256();
+
+  // a = [a0 a0 a0 ff a1 a1 a1 ff ...], with 8 bits per element.
+  __m256i a = _mm256_or_si256(_mm256_shuffle_epi8(x, shuffle_aaa), or_ff);
+
+  // Unpack to 16 bits per element. Unpacking the low and high halves within
+  // each 128-bit lane, then packing them again, preserves the pixel order.
+  __m256i x_lo = _mm256_unpacklo_epi8(x, zero);
+  __m256i x_hi = _mm256_unpackhi_epi8(x, zero);
+  __m256i a_lo = _mm256_unpacklo_epi8(a, zero);
+  __m256i a_hi = _mm256_unpackhi_epi8(a, zero);
+
+  __m256i p_lo = _mm256_mullo_epi16(x_lo, a_lo);
+  __m256i p_hi = _mm256_mullo_epi16(x_hi, a_hi);
+  p_lo = _mm256_srli_epi16(_mm256_mulhi_epu16(p_lo, u8101), 7);
+  p_hi = _mm256_srli_epi16(_mm256_mulhi_epu16(p_hi, u8101), 7);
+  return _mm256_packus_epi16(p_lo, p_hi);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    __m256i x;
+    x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = wuffs_base__pixel_swizzler__premul_8_x86_avx2(x);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  __m256i shuffle = _mm256_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02,  //
+                                    +0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02);
+
+  while (n >= 8) {
+    __m256i x;
+    x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    x = wuffs_base__pixel_swizzler__premul_8_x86_avx2(x);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    // Keep the high byte of each 16-bit channel. _mm256_packus_epi16 works
+    // within 128-bit lanes, so _mm256_permute4x64_epi64 restores the order.
+    __m256i x0 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x00));
+    __m256i x1 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x20));
+    __m256i x = _mm256_packus_epi16(_mm256_srli_epi16(x0, 8),
+                                    _mm256_srli_epi16(x1, 8));
+    x = _mm256_permute4x64_epi64(x, 0xD8);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  __m256i shuffle = _mm256_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02,  //
+                                    +0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02);
+
+  while (n >= 8) {
+    __m256i x0 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x00));
+    __m256i x1 = _mm256_lddqu_si256((const __m256i*)(const void*)(s + 0x20));
+    __m256i x = _mm256_packus_epi16(_mm256_srli_epi16(x0, 8),
+                                    _mm256_srli_epi16(x1, 8));
+    x = _mm256_permute4x64_epi64(x, 0xD8);
+    x = _mm256_shuffle_epi8(x, shuffle);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 8;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__color_u64__as__color_u32__swap_u32_argb_abgr(
+                         wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8))));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+  return len;
+}
+
+// wuffs_base__pixel_swizzler__premul_4x16le_x86_avx2 converts 4
+// non-premultiplied 4x16LE pixels to 4x8 premultiplied alpha (in the low
+// 128 bits of the result), producing exactly the same output as the non-SIMD
+// wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul function.
+//
+// That function computes (((c * a) / 0xFFFF) >> 8) for each 16-bit color
+// channel c. For all (c * a) products, which fit in 32 bits, dividing by
+// 0xFFFF equals ((p + (p >> 16) + 1) >> 16), which also doesn't overflow.
+//
+// If swap_rgbx_bgrx is true, the output's R and B channels are swapped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m128i  //
+wuffs_base__pixel_swizzler__premul_4x16le_x86_avx2(__m256i x,
+                                                   bool swap_rgbx_bgrx) {
+  __m256i ones = _mm256_set1_epi32(1);
+  __m256i order = _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0);
+
+  // Each 128-bit lane of x0 and x1 holds one pixel, 32 bits per channel.
+  __m256i x0 = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(x));
+  __m256i x1 = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(x, 1));
+  if (swap_rgbx_bgrx) {
+    x0 = _mm256_shuffle_epi32(x0, 0xC6);
+    x1 = _mm256_shuffle_epi32(x1, 0xC6);
+  }
+
+  __m256i p0 = _mm256_mullo_epi32(x0, _mm256_shuffle_epi32(x0, 0xFF));
+  __m256i p1 = _mm256_mullo_epi32(x1, _mm256_shuffle_epi32(x1, 0xFF));
+  p0 = _mm256_add_epi32(_mm256_add_epi32(p0, _mm256_srli_epi32(p0, 16)), ones);
+  p1 = _mm256_add_epi32(_mm256_add_epi32(p1, _mm256_srli_epi32(p1, 16)), ones);
+  p0 = _mm256_srli_epi32(p0, 24);
+  p1 = _mm256_srli_epi32(p1, 24);
+
+  // The alpha channel is just narrowed from 16 to 8 bits.
+  p0 = _mm256_blend_epi32(p0, _mm256_srli_epi32(x0, 8), 0x88);
+  p1 = _mm256_blend_epi32(p1, _mm256_srli_epi32(x1, 8), 0x88);
+
+  // Packing works within 128-bit lanes, so the packed pixels are in the order
+  // [0, 2, 0, 2; 1, 3, 1, 3]. The permute gives [0, 1, 2, 3; etc].
+  __m256i p = _mm256_packus_epi32(p0, p1);
+  p = _mm256_packus_epi16(p, p);
+  p = _mm256_permutevar8x32_epi32(p, order);
+  return _mm256_castsi256_si128(p);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)d,
+                     wuffs_base__pixel_swizzler__premul_4x16le_x86_avx2(
+                         x, false));
+
+    s += 4 * 8;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(s0));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len4 < src_len8) ? dst_len4 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    _mm_storeu_si128((__m128i*)(void*)d,
+                     wuffs_base__pixel_swizzler__premul_4x16le_x86_avx2(
+                         x, true));
+
+    s += 4 * 8;
+    d += 4 * 4;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+                s0)));
+
+    s += 1 * 8;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// wuffs_base__pixel_swizzler__premul_16x16_x86_avx2 converts 4
+// non-premultiplied 4x16LE pixels to 4x16LE premultiplied alpha, producing
+// exactly the same output as the non-SIMD
+// wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul function.
+//
+// Split each (c * a) product p into 16-bit halves hi and lo. Dividing p by
+// 0xFFFF, computed as ((p + (p >> 16) + 1) >> 16) like the
+// wuffs_base__pixel_swizzler__premul_4x16le_x86_avx2 function, then equals
+// hi plus the carry out of (lo + hi + 1). That carry is set exactly when (lo
+// >= ~hi), which needs only 16-bit lanes.
+//
+// If swap_rgbx_bgrx is true, the output's R and B channels are swapped.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__pixel_swizzler__premul_16x16_x86_avx2(__m256i x,
+                                                  bool swap_rgbx_bgrx) {
+  if (swap_rgbx_bgrx) {
+    x = _mm256_shuffle_epi8(
+        x, _mm256_set_epi8(15, 14, 9, 8, 11, 10, 13, 12,  //
+                           7, 6, 1, 0, 3, 2, 5, 4,        //
+                           15, 14, 9, 8, 11, 10, 13, 12,  //
+                           7, 6, 1, 0, 3, 2, 5, 4));
+  }
+  __m256i a = _mm256_shuffle_epi8(
+      x, _mm256_set_epi8(15, 14, 15, 14, 15, 14, 15, 14,  //
+                         7, 6, 7, 6, 7, 6, 7, 6,          //
+                         15, 14, 15, 14, 15, 14, 15, 14,  //
+                         7, 6, 7, 6, 7, 6, 7, 6));
+
+  __m256i hi = _mm256_mulhi_epu16(x, a);
+  __m256i lo = _mm256_mullo_epi16(x, a);
+  __m256i not_hi = _mm256_xor_si256(hi, _mm256_set1_epi16(-1));
+  __m256i carry = _mm256_cmpeq_epi16(_mm256_max_epu16(lo, not_hi), lo);
+  __m256i p = _mm256_sub_epi16(hi, carry);
+
+  // The alpha channel is unchanged.
+  return _mm256_blend_epi16(p, x, 0x88);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    __m256i x = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)s));
+    x = _mm256_or_si256(x, _mm256_slli_epi16(x, 8));
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        wuffs_base__pixel_swizzler__premul_16x16_x86_avx2(x, false));
+
+    s += 4 * 4;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__color_u32__as__color_u64(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        wuffs_base__pixel_swizzler__premul_16x16_x86_avx2(x, false));
+
+    s += 4 * 8;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 8;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len8 < src_len4) ? dst_len8 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    __m256i x = _mm256_cvtepu8_epi16(
+        _mm_lddqu_si128((const __m128i*)(const void*)s));
+    x = _mm256_or_si256(x, _mm256_slli_epi16(x, 8));
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        wuffs_base__pixel_swizzler__premul_16x16_x86_avx2(x, true));
+
+    s += 4 * 4;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 =
+        wuffs_base__color_u32__as__color_u64(wuffs_base__swap_u32_argb_abgr(
+            wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4))));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 4;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 4) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    _mm256_storeu_si256(
+        (__m256i*)(void*)d,
+        wuffs_base__pixel_swizzler__premul_16x16_x86_avx2(x, true));
+
+    s += 4 * 8;
+    d += 4 * 8;
+    n -= 4;
+  }
+
+  while (n >= 1) {
+    uint64_t s0 = wuffs_base__swap_u64_argb_abgr(
+        wuffs_base__peek_u64le__no_bounds_check(s + (0 * 8)));
+    wuffs_base__poke_u64le__no_bounds_check(
+        d + (0 * 8),
+        wuffs_base__color_u64_argb_nonpremul__as__color_u64_argb_premul(s0));
+
+    s += 1 * 8;
+    d += 1 * 8;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__src_over_premul_8_x86_avx2 composites 8 BGRA
+// (or RGBA) src pixels over 8 premultiplied dst pixels, producing exactly the
+// same output as the non-SIMD wuffs_base__composite_premul_nonpremul_u32_axxx
+// function (or, if src_premul, wuffs_base__composite_premul_premul_u32_axxx).
+//
+// Those functions work in 16-bit color but, for 8-bit inputs, each output
+// channel equals ((x * 0x8101) >> 23), where x is ((s * m) + (d * (0xFF -
+// sa))), m is sa for a nonpremul src's color channels and m is 0xFF for a
+// premul src or for the alpha channel. x fits in 16 bits provided that, for
+// premul src, no color channel exceeds sa. Valid premultiplied alpha colors
+// always satisfy that constraint.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__pixel_swizzler__src_over_premul_8_x86_avx2(__m256i d,
+                                                       __m256i s,
+                                                       bool src_premul) {
+  __m256i shuffle_aaaa = _mm256_set_epi8(+0x0F, +0x0F, +0x0F, +0x0F,  //
+                                         +0x0B, +0x0B, +0x0B, +0x0B,  //
+                                         +0x07, +0x07, +0x07, +0x07,  //
+                                         +0x03, +0x03, +0x03, +0x03,  //
+                                         +0x0F, +0x0F, +0x0F, +0x0F,  //
+                                         +0x0B, +0x0B, +0x0B, +0x0B,  //
+                                         +0x07, +0x07, +0x07, +0x07,  //
+                                         +0x03, +0x03, +0x03, +0x03);
+  __m256i or_ff = _mm256_set1_epi32(-0x01000000);
+  __m256i all_ff = _mm256_set1_epi8(-0x01);
+  __m256i u8101 = _mm256_set1_epi16(-0x7EFF);
+  __m256i zero = _mm256_setzero_si256();
+
+  // a = [a0 a0 a0 a0 a1 a1 a1 a1 ...], with 8 bits per element, ia = (0xFF -
+  // a) and m = [a0 a0 a0 ff a1 a1 a1 ff ...] or all 0xFF.
+  __m256i a = _mm256_shuffle_epi8(s, shuffle_aaaa);
+  __m256i ia = _mm256_xor_si256(a, all_ff);
+  __m256i m = src_premul ? all_ff : _mm256_or_si256(a, or_ff);
+
+  // Unpack to 16 bits per element. Unpacking the low and high halves within
+  // each 128-bit lane, then packing them again, preserves the pixel order.
+  __m256i x_lo = _mm256_add_epi16(
+      _mm256_mullo_epi16(_mm256_unpacklo_epi8(s, zero),
+                         _mm256_unpacklo_epi8(m, zero)),
+      _mm256_mullo_epi16(_mm256_unpacklo_epi8(d, zero),
+                         _mm256_unpacklo_epi8(ia, zero)));
+  __m256i x_hi = _mm256_add_epi16(
+      _mm256_mullo_epi16(_mm256_unpackhi_epi8(s, zero),
+                         _mm256_unpackhi_epi8(m, zero)),
+      _mm256_mullo_epi16(_mm256_unpackhi_epi8(d, zero),
+                         _mm256_unpackhi_epi8(ia, zero)));
+  x_lo = _mm256_srli_epi16(_mm256_mulhi_epu16(x_lo, u8101), 7);
+  x_hi = _mm256_srli_epi16(_mm256_mulhi_epu16(x_hi, u8101), 7);
+  return _mm256_packus_epi16(x_lo, x_hi);
+}
+
+// wuffs_base__pixel_swizzler__div255_u32_x86_avx2 divides each 32-bit element
+// by 0xFF, rounding down. For all 32-bit x, that equals ((x * 0x80808081) >>
+// 39), where the product is computed in 64 bits.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__pixel_swizzler__div255_u32_x86_avx2(__m256i x) {
+  __m256i m = _mm256_set1_epi32(-0x7F7F7F7F);
+  __m256i even = _mm256_mul_epu32(x, m);
+  __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+  return _mm256_blend_epi32(_mm256_srli_epi64(even, 39),
+                            _mm256_slli_epi64(_mm256_srli_epi64(odd, 39), 32),
+                            0xAA);
+}
+
+// wuffs_base__pixel_swizzler__src_over_nonpremul_channel_x86_avx2 computes one
+// output color channel of wuffs_base__pixel_swizzler__src_over_nonpremul_8.
+// Each 32-bit element of sc and dc holds an 8-bit color value. The other
+// arguments are shared by all three color channels.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__pixel_swizzler__src_over_nonpremul_channel_x86_avx2(
+    __m256i sc,
+    __m256i dc,
+    __m256i sa0101,
+    __m256i da0101,
+    __m256i ia,
+    __m256i a00,
+    __m256 inv_a00) {
+  __m256i ones = _mm256_set1_epi32(1);
+  __m256i zero = _mm256_setzero_si256();
+
+  __m256i p = wuffs_base__pixel_swizzler__div255_u32_x86_avx2(
+      _mm256_mullo_epi32(dc, da0101));
+  __m256i c = wuffs_base__pixel_swizzler__div255_u32_x86_avx2(_mm256_add_epi32(
+      _mm256_mullo_epi32(sc, sa0101), _mm256_mullo_epi32(p, ia)));
+
+  // q approximates ((c * 0xFFFF) / a00) to within 1. The remainder, r, tells
+  // us whether to adjust q down or up to get the exact (rounded down) value.
+  __m256i q = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(c),  //
+                                                inv_a00));
+  __m256i r = _mm256_sub_epi32(_mm256_sub_epi32(_mm256_slli_epi32(c, 16), c),
+                               _mm256_mullo_epi32(q, a00));
+  q = _mm256_add_epi32(q, _mm256_cmpgt_epi32(zero, r));
+  q = _mm256_sub_epi32(q, _mm256_cmpgt_epi32(_mm256_add_epi32(r, ones), a00));
+  return q;
+}
+
+// wuffs_base__pixel_swizzler__src_over_nonpremul_8_x86_avx2 composites 8 BGRA
+// (or RGBA) nonpremul src pixels over 8 nonpremul dst pixels, producing
+// exactly the same output as the non-SIMD
+// wuffs_base__composite_nonpremul_nonpremul_u32_axxx function.
+//
+// For 8-bit inputs and ia = (0xFF - sa), that function's 16-bit arithmetic is
+// equivalent to the following, where "/" rounds down:
+//  - a  = (sa * 0x101) + ((da * 0x101 * ia) / 0xFF)
+//  - p  = (dc * 0x101 * da) / 0xFF
+//  - c  = ((sc * 0x101 * sa) + (p * ia)) / 0xFF
+//  - output alpha = (a >> 8)
+//  - output color = (c * 0xFFFF) / (a << 8)
+//
+// All of the intermediate values fit in 32 bits, and c <= a. The final
+// division uses single-precision floating point, corrected to be exact.
+//
+// If da is zero then the output is the src pixel, unchanged.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__pixel_swizzler__src_over_nonpremul_8_x86_avx2(__m256i d,
+                                                          __m256i s) {
+  __m256i u00ff = _mm256_set1_epi32(0xFF);
+  __m256i u0101 = _mm256_set1_epi32(0x101);
+  __m256 f00ff = _mm256_set1_ps(65535.0f / 256.0f);
+
+  __m256i sa = _mm256_srli_epi32(s, 24);
+  __m256i da = _mm256_srli_epi32(d, 24);
+  __m256i ia = _mm256_xor_si256(sa, u00ff);
+  __m256i sa0101 = _mm256_mullo_epi32(sa, u0101);
+  __m256i da0101 = _mm256_mullo_epi32(da, u0101);
+
+  __m256i a = _mm256_add_epi32(
+      sa0101, wuffs_base__pixel_swizzler__div255_u32_x86_avx2(
+                  _mm256_mullo_epi32(da0101, ia)));
+  __m256i a00 = _mm256_slli_epi32(a, 8);
+  __m256 inv_a00 = _mm256_div_ps(f00ff, _mm256_cvtepi32_ps(a));
+
+  __m256i b = wuffs_base__pixel_swizzler__src_over_nonpremul_channel_x86_avx2(
+      _mm256_and_si256(s, u00ff), _mm256_and_si256(d, u00ff),  //
+      sa0101, da0101, ia, a00, inv_a00);
+  __m256i g = wuffs_base__pixel_swizzler__src_over_nonpremul_channel_x86_avx2(
+      _mm256_and_si256(_mm256_srli_epi32(s, 8), u00ff),
+      _mm256_and_si256(_mm256_srli_epi32(d, 8), u00ff),  //
+      sa0101, da0101, ia, a00, inv_a00);
+  __m256i r = wuffs_base__pixel_swizzler__src_over_nonpremul_channel_x86_avx2(
+      _mm256_and_si256(_mm256_srli_epi32(s, 16), u00ff),
+      _mm256_and_si256(_mm256_srli_epi32(d, 16), u00ff),  //
+      sa0101, da0101, ia, a00, inv_a00);
+
+  __m256i x = _mm256_or_si256(
+      _mm256_or_si256(b, _mm256_slli_epi32(g, 8)),
+      _mm256_or_si256(_mm256_slli_epi32(r, 16),
+                      _mm256_slli_epi32(_mm256_srli_epi32(a, 8), 24)));
+  return _mm256_blendv_epi8(
+      x, s, _mm256_cmpeq_epi32(da, _mm256_setzero_si256()));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    __m256i y = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = wuffs_base__pixel_swizzler__src_over_nonpremul_8_x86_avx2(x, y);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    __m256i y = _mm256_i32gather_epi32(
+        (const int*)(const void*)dst_palette_ptr,
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(const void*)s)),
+        4);
+    x = wuffs_base__pixel_swizzler__src_over_nonpremul_8_x86_avx2(x, y);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 1;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                          ((size_t)s[0] * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4),
+        wuffs_base__composite_nonpremul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    __m256i y = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_x86_avx2(x, y, false);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    __m256i y = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_x86_avx2(x, y, true);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_premul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  if (dst_palette_len !=
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH) {
+    return 0;
+  }
+  size_t dst_len4 = dst_len / 4;
+  size_t len = (dst_len4 < src_len) ? dst_len4 : src_len;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    __m256i y = _mm256_i32gather_epi32(
+        (const int*)(const void*)dst_palette_ptr,
+        _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(const void*)s)),
+        4);
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_x86_avx2(x, y, false);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 1;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__peek_u32le__no_bounds_check(dst_palette_ptr +
+                                                          ((size_t)s[0] * 4));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 1;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  size_t dst_len4 = dst_len / 4;
+  size_t src_len4 = src_len / 4;
+  size_t len = (dst_len4 < src_len4) ? dst_len4 : src_len4;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  __m256i shuffle = _mm256_set_epi8(+0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02,  //
+                                    +0x0F, +0x0C, +0x0D, +0x0E,  //
+                                    +0x0B, +0x08, +0x09, +0x0A,  //
+                                    +0x07, +0x04, +0x05, +0x06,  //
+                                    +0x03, +0x00, +0x01, +0x02);
+
+  while (n >= 8) {
+    __m256i x = _mm256_lddqu_si256((const __m256i*)(const void*)d);
+    __m256i y = _mm256_shuffle_epi8(
+        _mm256_lddqu_si256((const __m256i*)(const void*)s), shuffle);
+    x = wuffs_base__pixel_swizzler__src_over_premul_8_x86_avx2(x, y, false);
+    _mm256_storeu_si256((__m256i*)(void*)d, x);
+
+    s += 8 * 4;
+    d += 8 * 4;
+    n -= 8;
+  }
+
+  while (n >= 1) {
+    uint32_t d0 = wuffs_base__peek_u32le__no_bounds_check(d + (0 * 4));
+    uint32_t s0 = wuffs_base__swap_u32_argb_abgr(
+        wuffs_base__peek_u32le__no_bounds_check(s + (0 * 4)));
+    wuffs_base__poke_u32le__no_bounds_check(
+        d + (0 * 4), wuffs_base__composite_premul_nonpremul_u32_axxx(d0, s0));
+
+    s += 1 * 4;
+    d += 1 * 4;
+    n -= 1;
+  }
+
+  return len;
+}
+
+// --------
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_resampler__resample_h__x86_avx2(int16_t* dst_ptr,
+                                                  uint32_t dst_width,
+                                                  const uint8_t* src_ptr,
+                                                  const uint32_t* starts,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps) {
+  // Widen two adjacent source pixels to u16 and interleave their channels,
+  // so that one madd call applies both taps' weights and sums them per
+  // channel. Two adjacent weights are loaded as one u32 (little-endian puts
+  // weights[k] in the low half). Each 128-bit lane holds a different
+  // destination pixel.
+  const __m256i interleave = _mm256_set_epi8(  //
+      -128, 7, -128, 3, -128, 6, -128, 2,      //
+      -128, 5, -128, 1, -128, 4, -128, 0,      //
+      -128, 7, -128, 3, -128, 6, -128, 2,      //
+      -128, 5, -128, 1, -128, 4, -128, 0);
+  const __m256i bias =
+      _mm256_set1_epi32(1 << (WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT - 1));
+  const bool odd = (num_taps & 1) != 0;
+
+  uint32_t x = 0;
+  for (; (x + 2) <= dst_width; x += 2) {
+    const uint8_t* s0 = src_ptr + (4u * ((size_t)starts[x + 0]));
+    const uint8_t* s1 = src_ptr + (4u * ((size_t)starts[x + 1]));
+    const uint8_t* w0 = (const uint8_t*)(const void*)(weights);
+    const uint8_t* w1 = (const uint8_t*)(const void*)(weights + num_taps);
+    __m256i acc = bias;
+    uint32_t k = 0;
+    for (; (k + 2) <= num_taps; k += 2) {
+      __m256i pixels = _mm256_shuffle_epi8(
+          _mm256_inserti128_si256(
+              _mm256_castsi128_si256(
+                  _mm_loadl_epi64((const __m128i*)(const void*)s0)),
+              _mm_loadl_epi64((const __m128i*)(const void*)s1), 1),
+          interleave);
+      __m256i w = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_set1_epi32(
+              (int32_t)wuffs_base__peek_u32le__no_bounds_check(w0))),
+          _mm_set1_epi32((int32_t)wuffs_base__peek_u32le__no_bounds_check(w1)),
+          1);
+      acc = _mm256_add_epi32(acc, _mm256_madd_epi16(pixels, w));
+      s0 += 8;
+      s1 += 8;
+      w0 += 4;
+      w1 += 4;
+    }
+    if (odd) {
+      __m256i pixels = _mm256_cvtepu8_epi32(_mm_set_epi32(
+          0, 0, (int32_t)wuffs_base__peek_u32le__no_bounds_check(s1),
+          (int32_t)wuffs_base__peek_u32le__no_bounds_check(s0)));
+      __m256i w = _mm256_inserti128_si256(
+          _mm256_castsi128_si256(_mm_set1_epi32(weights[k])),
+          _mm_set1_epi32(weights[num_taps + k]), 1);
+      acc = _mm256_add_epi32(acc, _mm256_mullo_epi32(pixels, w));
+    }
+    weights += 2 * num_taps;
+
+    acc = _mm256_srai_epi32(acc, WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT);
+    __m256i c = _mm256_permute4x64_epi64(_mm256_packs_epi32(acc, acc), 0x08);
+    _mm_storeu_si128((__m128i*)(void*)dst_ptr, _mm256_castsi256_si128(c));
+    dst_ptr += 8;
+  }
+
+  if (x < dst_width) {
+    const uint8_t* s0 = src_ptr + (4u * ((size_t)starts[x]));
+    __m128i acc = _mm256_castsi256_si128(bias);
+    uint32_t k = 0;
+    for (; (k + 2) <= num_taps; k += 2) {
+      __m128i pixels = _mm_shuffle_epi8(
+          _mm_loadl_epi64((const __m128i*)(const void*)s0),
+          _mm256_castsi256_si128(interleave));
+      __m128i w = _mm_set1_epi32((int32_t)wuffs_base__peek_u32le__no_bounds_check(
+          (const uint8_t*)(const void*)(weights + k)));
+      acc = _mm_add_epi32(acc, _mm_madd_epi16(pixels, w));
+      s0 += 8;
+    }
+    if (odd) {
+      __m128i pixel = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(
+          (int)(wuffs_base__peek_u32le__no_bounds_check(s0))));
+      acc = _mm_add_epi32(acc,
+                          _mm_mullo_epi32(pixel, _mm_set1_epi32(weights[k])));
+    }
+
+    acc = _mm_srai_epi32(acc, WUFFS_BASE__PIXEL_RESAMPLER__H_SHIFT);
+    _mm_storel_epi64((__m128i*)(void*)dst_ptr, _mm_packs_epi32(acc, acc));
+  }
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_resampler__resample_v__x86_avx2(uint8_t* dst_ptr,
+                                                  size_t dst_len,
+                                                  const int16_t* ring_ptr,
+                                                  size_t ring_stride,
+                                                  uint32_t ring_length,
+                                                  uint32_t ring_index,
+                                                  const int16_t* weights,
+                                                  uint32_t num_taps,
+                                                  bool clamp_to_alpha) {
+  const __m256i bias =
+      _mm256_set1_epi32(1 << (WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT - 1));
+  const __m256i zero = _mm256_setzero_si256();
+  const __m128i alpha = _mm_set_epi8(  //
+      15, 15, 15, 15, 11, 11, 11, 11,  //
+      7, 7, 7, 7, 3, 3, 3, 3);
+
+  // Process 16 samples (4 pixels) at a time, two source rows per
+  // _mm256_madd_epi16 call. Unpacking and packing both work within 128-bit
+  // lanes, so the packed result is back in the original order.
+  size_t i = 0;
+  for (; (i + 16) <= dst_len; i += 16) {
+    __m256i acc_lo = bias;
+    __m256i acc_hi = bias;
+    uint32_t slot = ring_index;
+    uint32_t k = 0;
+    for (; (k + 2) <= num_taps; k += 2) {
+      const int16_t* r0 = ring_ptr + (((size_t)slot) * ring_stride) + i;
+      if (++slot == ring_length) {
+        slot = 0;
+      }
+      const int16_t* r1 = ring_ptr + (((size_t)slot) * ring_stride) + i;
+      if (++slot == ring_length) {
+        slot = 0;
+      }
+      __m256i v0 = _mm256_lddqu_si256((const __m256i*)(const void*)r0);
+      __m256i v1 = _mm256_lddqu_si256((const __m256i*)(const void*)r1);
+      uint32_t w01 = ((uint32_t)((uint16_t)weights[k + 0])) |
+                     (((uint32_t)((uint16_t)weights[k + 1])) << 16);
+      __m256i w = _mm256_set1_epi32((int32_t)w01);
+      acc_lo = _mm256_add_epi32(
+          acc_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(v0, v1), w));
+      acc_hi = _mm256_add_epi32(
+          acc_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(v0, v1), w));
+    }
+    if (k < num_taps) {
+      const int16_t* r0 = ring_ptr + (((size_t)slot) * ring_stride) + i;
+      __m256i v0 = _mm256_lddqu_si256((const __m256i*)(const void*)r0);
+      __m256i w = _mm256_set1_epi32((int32_t)((uint16_t)weights[k]));
+      acc_lo = _mm256_add_epi32(
+          acc_lo, _mm256_madd_epi16(_mm256_unpacklo_epi16(v0, zero), w));
+      acc_hi = _mm256_add_epi32(
+          acc_hi, _mm256_madd_epi16(_mm256_unpackhi_epi16(v0, zero), w));
+    }
+
+    __m256i c16 = _mm256_packs_epi32(
+        _mm256_srai_epi32(acc_lo, WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT),
+        _mm256_srai_epi32(acc_hi, WUFFS_BASE__PIXEL_RESAMPLER__V_SHIFT));
+    __m256i c8 = _mm256_permute4x64_epi64(_mm256_packus_epi16(c16, c16), 0x08);
+    __m128i c = _mm256_castsi256_si128(c8);
+    if (clamp_to_alpha) {
+      c = _mm_min_epu8(c, _mm_shuffle_epi8(c, alpha));
+    }
+    _mm_storeu_si128((__m128i*)(void*)(dst_ptr + i), c);
+  }
+
+  wuffs_base__pixel_resampler__resample_v_tail(
+      dst_ptr, dst_len, i, ring_ptr, ring_stride, ring_length, ring_index,
+      weights, num_taps, clamp_to_alpha);
+}
+
+// --------
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__color_transform__channel__x86_avx2(
+    const wuffs_base__color_transform* t,
+    __m256i lr,
+    __m256i lg,
+    __m256i lb,
+    int32_t i) {
+  const int32_t* m = &t->private_impl.matrix[3 * i];
+  __m256i v = _mm256_add_epi32(
+      _mm256_add_epi32(_mm256_mullo_epi32(lr, _mm256_set1_epi32(m[0])),
+                       _mm256_mullo_epi32(lg, _mm256_set1_epi32(m[1]))),
+      _mm256_add_epi32(
+          _mm256_mullo_epi32(lb, _mm256_set1_epi32(m[2])),
+          _mm256_set1_epi32(
+              1 << (WUFFS_BASE__COLOR_TRANSFORM__MATRIX_SHIFT - 1))));
+  v = _mm256_min_epi32(
+      _mm256_max_epi32(
+          _mm256_srai_epi32(v, WUFFS_BASE__COLOR_TRANSFORM__MATRIX_SHIFT),
+          _mm256_setzero_si256()),
+      _mm256_set1_epi32(WUFFS_BASE__COLOR_TRANSFORM__LINEAR_MAX));
+  return _mm256_and_si256(
+      _mm256_i32gather_epi32(
+          (const int*)(const void*)(&t->private_impl.encode_lut[0]), v, 1),
+      _mm256_set1_epi32(0xFF));
+}
+
+// wuffs_base__color_transform__transform_4__x86_avx2 is the AVX2 version of
+// wuffs_base__color_transform__transform_4, 8 pixels at a time. Its table
+// look-ups are gathers, loading 4 bytes per pixel and masking off the excess.
+// For premultiplied alpha, only fully opaque groups of 8 pixels take the
+// SIMD path.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline void  //
+wuffs_base__color_transform__transform_4__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len,
+    bool bgr,
+    bool premul) {
+  const __m256i u8_mask = _mm256_set1_epi32(0xFF);
+  const __m256i u16_mask = _mm256_set1_epi32(0xFFFF);
+  const __m256i alpha_mask = _mm256_set1_epi32((int32_t)0xFF000000u);
+  const int* lut0 =
+      (const int*)(const void*)(&t->private_impl.decode_luts[0][0]);
+  const int* lut1 =
+      (const int*)(const void*)(&t->private_impl.decode_luts[1][0]);
+  const int* lut2 =
+      (const int*)(const void*)(&t->private_impl.decode_luts[2][0]);
+
+  size_t n = len / 4;
+  while (n >= 8) {
+    __m256i v = _mm256_lddqu_si256((const __m256i*)(const void*)ptr);
+    __m256i a = _mm256_and_si256(v, alpha_mask);
+    if (premul &&
+        (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, alpha_mask)) != -1)) {
+      wuffs_base__color_transform__transform_4(t, ptr, 8 * 4, bgr, true);
+      ptr += 8 * 4;
+      n -= 8;
+      continue;
+    }
+
+    __m256i c0 = _mm256_and_si256(v, u8_mask);
+    __m256i c1 = _mm256_and_si256(_mm256_srli_epi32(v, 8), u8_mask);
+    __m256i c2 = _mm256_and_si256(_mm256_srli_epi32(v, 16), u8_mask);
+    __m256i lr = _mm256_and_si256(
+        _mm256_i32gather_epi32(lut0, bgr ? c2 : c0, 2), u16_mask);
+    __m256i lg =
+        _mm256_and_si256(_mm256_i32gather_epi32(lut1, c1, 2), u16_mask);
+    __m256i lb = _mm256_and_si256(
+        _mm256_i32gather_epi32(lut2, bgr ? c0 : c2, 2), u16_mask);
+
+    __m256i r =
+        wuffs_base__color_transform__channel__x86_avx2(t, lr, lg, lb, 0);
+    __m256i g =
+        wuffs_base__color_transform__channel__x86_avx2(t, lr, lg, lb, 1);
+    __m256i b =
+        wuffs_base__color_transform__channel__x86_avx2(t, lr, lg, lb, 2);
+    v = _mm256_or_si256(
+        _mm256_or_si256(a, _mm256_slli_epi32(g, 8)),
+        _mm256_or_si256(_mm256_slli_epi32(bgr ? r : b, 16), bgr ? b : r));
+    _mm256_storeu_si256((__m256i*)(void*)ptr, v);
+
+    ptr += 8 * 4;
+    n -= 8;
+  }
+
+  wuffs_base__color_transform__transform_4(t, ptr, n * 4, bgr, premul);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_bgrx__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4__x86_avx2(t, ptr, len, true, false);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_rgbx__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4__x86_avx2(t, ptr, len, false,
+                                                     false);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_bgra_premul__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4__x86_avx2(t, ptr, len, true, true);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__color_transform__transform_rgba_premul__x86_avx2(
+    const wuffs_base__color_transform* t,
+    uint8_t* ptr,
+    size_t len) {
+  wuffs_base__color_transform__transform_4__x86_avx2(t, ptr, len, false,
+                                                     true);
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2__quantize
+// takes two BGRA_NONPREMUL_4X16LE pixels, widened to 32 bits per channel, and
+// returns their BGR_565 values, repeated across each 128-bit lane. The t
+// argument holds each pixel's threshold in its B, G and R lanes.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256i  //
+wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2__quantize(
+    __m256i v,
+    __m256i t) {
+  // The alpha lanes multiply by 0 and shift right by 32, so that they
+  // quantize to 0.
+  const __m256i mul = _mm256_set_epi32(0, 31, 63, 31, 0, 31, 63, 31);
+  const __m256i shr = _mm256_set_epi32(32, 11, 10, 11, 32, 11, 10, 11);
+  const __m256i shl = _mm256_set_epi32(0, 11, 5, 0, 0, 11, 5, 0);
+
+  // Premultiply: p = ((v * a) / 0xFFFF), computed as ((p + (p >> 16) + 1) >>
+  // 16), like wuffs_base__pixel_swizzler__dither__premul.
+  __m256i p = _mm256_mullo_epi32(v, _mm256_shuffle_epi32(v, 0xFF));
+  p = _mm256_srli_epi32(
+      _mm256_add_epi32(_mm256_add_epi32(p, _mm256_srli_epi32(p, 16)),
+                       _mm256_set1_epi32(1)),
+      16);
+
+  __m256i q = _mm256_add_epi32(
+      _mm256_add_epi32(_mm256_mullo_epi32(p, mul), _mm256_srlv_epi32(p, shr)),
+      t);
+  q = _mm256_sllv_epi32(_mm256_srli_epi32(q, 16), shl);
+  q = _mm256_or_si256(q, _mm256_shuffle_epi32(q, 0xB1));
+  return _mm256_or_si256(q, _mm256_shuffle_epi32(q, 0x4E));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels,
+    uint32_t x,
+    uint32_t y) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  // After _mm256_packus_epi32, the four pixels' 16-bit values are at u16
+  // offsets 0, 8, 4 and 12. This permutes (32-bit granularity) and shuffles
+  // (8-bit granularity) them to the low 64 bits.
+  const __m256i perm = _mm256_set_epi32(0, 0, 0, 0, 6, 2, 4, 0);
+  const __m128i shuf = _mm_set_epi8(-128, -128, -128, -128,  //
+                                    -128, -128, -128, -128,  //
+                                    +13, +12, +9, +8,        //
+                                    +5, +4, +1, +0);
+
+  while (n >= 4) {
+    uint32_t t0 = wuffs_base__pixel_swizzler__dither__threshold(x + 0, y);
+    uint32_t t1 = wuffs_base__pixel_swizzler__dither__threshold(x + 1, y);
+    uint32_t t2 = wuffs_base__pixel_swizzler__dither__threshold(x + 2, y);
+    uint32_t t3 = wuffs_base__pixel_swizzler__dither__threshold(x + 3, y);
+
+    __m256i v01 = _mm256_cvtepu16_epi32(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 0)));
+    __m256i v23 = _mm256_cvtepu16_epi32(
+        _mm_lddqu_si128((const __m128i*)(const void*)(s + 16)));
+    __m256i q01 =
+        wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2__quantize(
+            v01, _mm256_set_epi32(0, (int32_t)t1, (int32_t)t1, (int32_t)t1,  //
+                                  0, (int32_t)t0, (int32_t)t0, (int32_t)t0));
+    __m256i q23 =
+        wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2__quantize(
+            v23, _mm256_set_epi32(0, (int32_t)t3, (int32_t)t3, (int32_t)t3,  //
+                                  0, (int32_t)t2, (int32_t)t2, (int32_t)t2));
+
+    __m256i packed = _mm256_permutevar8x32_epi32(
+        _mm256_packus_epi32(q01, q23), perm);
+    _mm_storel_epi64((__m128i*)(void*)d,
+                     _mm_shuffle_epi8(_mm256_castsi256_si128(packed), shuf));
+
+    s += 4 * 8;
+    d += 4 * 2;
+    n -= 4;
+    x += 4;
+  }
+
+  wuffs_base__pixel_swizzler__dither_ordered__bgr_565(d, s, n, x, y);
+}
+
+// --------
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_quantizer__fill_cache_row__x86_avx2(
+    uint8_t* dst_ptr,
+    const int32_t* rga_scores,
+    const int32_t* premul_bs,
+    uint32_t num_colors) {
+  // Each of the 4 vectors holds 8 cells' blue values, (b << 3) | 4.
+  const __m256i cb0 = _mm256_set_epi32(60, 52, 44, 36, 28, 20, 12, 4);
+  const __m256i cb1 = _mm256_add_epi32(cb0, _mm256_set1_epi32(64));
+  const __m256i cb2 = _mm256_add_epi32(cb1, _mm256_set1_epi32(64));
+  const __m256i cb3 = _mm256_add_epi32(cb2, _mm256_set1_epi32(64));
+
+  __m256i best0 = _mm256_set1_epi32(0x7FFFFFFF);
+  __m256i best1 = best0;
+  __m256i best2 = best0;
+  __m256i best3 = best0;
+  __m256i index0 = _mm256_setzero_si256();
+  __m256i index1 = index0;
+  __m256i index2 = index0;
+  __m256i index3 = index0;
+
+  uint32_t i = 0;
+  for (; i < num_colors; i++) {
+    __m256i rga = _mm256_set1_epi32(rga_scores[i]);
+    __m256i pb = _mm256_set1_epi32(premul_bs[i]);
+    __m256i vi = _mm256_set1_epi32((int32_t)i);
+
+    // Strictly-less-than comparisons, like the non-SIMD code, favor the
+    // smaller index for ties.
+    __m256i d0 = _mm256_sub_epi32(cb0, pb);
+    __m256i d1 = _mm256_sub_epi32(cb1, pb);
+    __m256i d2 = _mm256_sub_epi32(cb2, pb);
+    __m256i d3 = _mm256_sub_epi32(cb3, pb);
+    __m256i s0 = _mm256_add_epi32(rga, _mm256_mullo_epi32(d0, d0));
+    __m256i s1 = _mm256_add_epi32(rga, _mm256_mullo_epi32(d1, d1));
+    __m256i s2 = _mm256_add_epi32(rga, _mm256_mullo_epi32(d2, d2));
+    __m256i s3 = _mm256_add_epi32(rga, _mm256_mullo_epi32(d3, d3));
+    index0 = _mm256_blendv_epi8(index0, vi, _mm256_cmpgt_epi32(best0, s0));
+    index1 = _mm256_blendv_epi8(index1, vi, _mm256_cmpgt_epi32(best1, s1));
+    index2 = _mm256_blendv_epi8(index2, vi, _mm256_cmpgt_epi32(best2, s2));
+    index3 = _mm256_blendv_epi8(index3, vi, _mm256_cmpgt_epi32(best3, s3));
+    best0 = _mm256_min_epi32(best0, s0);
+    best1 = _mm256_min_epi32(best1, s1);
+    best2 = _mm256_min_epi32(best2, s2);
+    best3 = _mm256_min_epi32(best3, s3);
+  }
+
+  // Narrow from 32 to 8 bits. The packs interleave 128-bit lanes, which the
+  // permute undoes.
+  __m256i packed = _mm256_packus_epi16(_mm256_packus_epi32(index0, index1),
+                                       _mm256_packus_epi32(index2, index3));
+  _mm256_storeu_si256(
+      (__m256i*)(void*)dst_ptr,
+      _mm256_permutevar8x32_epi32(packed,
+                                  _mm256_set_epi32(7, 3, 6, 2, 5, 1, 4, 0)));
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static bool  //
+wuffs_base__pixel_swizzler__quantize_cached__x86_avx2(
+    const wuffs_base__pixel_quantizer* q,
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr,
+    size_t num_pixels) {
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = num_pixels;
+
+  const int* cache = (const int*)(const void*)q->private_impl.cache;
+  const __m256i mask_b = _mm256_set1_epi32(0x001F);
+  const __m256i mask_g = _mm256_set1_epi32(0x03E0);
+  const __m256i mask_r = _mm256_set1_epi32(0x7C00);
+  const __m256i mask_lo = _mm256_set1_epi32(0xFF);
+  __m256i all_alpha = _mm256_set1_epi32(-1);
+
+  while (n >= 8) {
+    __m256i c = _mm256_lddqu_si256((const __m256i*)(const void*)s);
+    all_alpha = _mm256_and_si256(all_alpha, c);
+
+    // Gather 4 bytes (the cache has 4 bytes of slack at its end) at each
+    // wuffs_base__pixel_quantizer__cache_index and keep the low byte.
+    __m256i idx = _mm256_or_si256(
+        _mm256_or_si256(_mm256_and_si256(_mm256_srli_epi32(c, 9), mask_r),
+                        _mm256_and_si256(_mm256_srli_epi32(c, 6), mask_g)),
+        _mm256_and_si256(_mm256_srli_epi32(c, 3), mask_b));
+    __m256i g =
+        _mm256_and_si256(_mm256_i32gather_epi32(cache, idx, 1), mask_lo);
+
+    __m128i w = _mm_packus_epi32(_mm256_castsi256_si128(g),
+                                 _mm256_extracti128_si256(g, 1));
+    _mm_storel_epi64((__m128i*)(void*)d, _mm_packus_epi16(w, w));
+
+    s += 8 * 4;
+    d += 8 * 1;
+    n -= 8;
+  }
+
+  __m256i alphas = _mm256_srli_epi32(all_alpha, 24);
+  bool all_opaque = _mm256_movemask_epi8(_mm256_cmpeq_epi32(
+                        alphas, _mm256_set1_epi32(0xFF))) == -1;
+  bool tail_all_opaque =
+      wuffs_base__pixel_swizzler__quantize_cached(q, d, s, n);
+  return all_opaque && tail_all_opaque;
+}
+
+// --------
+
+// wuffs_base__pixel_swizzler__float__premul_2_x86_avx2 converts 2
+// BGRA_NONPREMUL_4X16LE pixels to premultiplied RGBA floats, matching
+// wuffs_base__pixel_swizzler__float__premul exactly.
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline __m256  //
+wuffs_base__pixel_swizzler__float__premul_2_x86_avx2(const uint8_t* s,
+                                                      bool linear) {
+  // Widen from u16 to u32 and reorder from BGRA to RGBA.
+  __m256i x = _mm256_shuffle_epi32(
+      _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(const void*)s)),
+      0xC6);
+  __m256 a = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_shuffle_epi32(x, 0xFF)),
+                           _mm256_set1_ps(1.0f / 65535.0f));
+
+  __m256 c;
+  if (linear) {
+    // This is wuffs_base__pixel_swizzler__float__linearize, 8 lanes at a time
+    // (including the alpha lanes, whose results are discarded).
+    const int* lut = (const int*)(const void*)
+        wuffs_base__pixel_swizzler__float__srgb_to_linear;
+    __m256i p = _mm256_add_epi32(
+        x, _mm256_srli_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(0x8000)),
+                             16));
+    __m256i i = _mm256_srli_epi32(p, 8);
+    __m256i lo = _mm256_i32gather_epi32(lut, i, 4);
+    __m256i hi = _mm256_i32gather_epi32(lut + 1, i, 4);
+    __m256i f = _mm256_and_si256(p, _mm256_set1_epi32(0xFF));
+    __m256i l = _mm256_add_epi32(
+        lo, _mm256_srli_epi32(
+                _mm256_mullo_epi32(_mm256_sub_epi32(hi, lo), f), 8));
+    c = _mm256_mul_ps(_mm256_cvtepi32_ps(l),
+                      _mm256_set1_ps(1.0f / 1073741824.0f));
+  } else {
+    c = _mm256_mul_ps(_mm256_cvtepi32_ps(x), _mm256_set1_ps(1.0f / 65535.0f));
+  }
+
+  // Premultiply the RGB lanes and keep the alpha lanes.
+  return _mm256_blend_ps(_mm256_mul_ps(c, a), a, 0x88);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2,f16c")
+static inline uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    const uint8_t* src_ptr,
+    size_t src_len,
+    bool linear) {
+  size_t dst_len8 = dst_len / 8;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len8 < src_len8) ? dst_len8 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 2) {
+    _mm_storeu_si128(
+        (__m128i*)(void*)d,
+        _mm256_cvtps_ph(
+            wuffs_base__pixel_swizzler__float__premul_2_x86_avx2(s, linear),
+            _MM_FROUND_TO_NEAREST_INT));
+
+    s += 2 * 8;
+    d += 2 * 8;
+    n -= 2;
+  }
+
+  wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      d, 8 * n, s, 8 * n, true, linear, false);
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static inline uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    const uint8_t* src_ptr,
+    size_t src_len,
+    bool linear) {
+  size_t dst_len16 = dst_len / 16;
+  size_t src_len8 = src_len / 8;
+  size_t len = (dst_len16 < src_len8) ? dst_len16 : src_len8;
+  uint8_t* d = dst_ptr;
+  const uint8_t* s = src_ptr;
+  size_t n = len;
+
+  while (n >= 2) {
+    _mm256_storeu_ps(
+        (float*)(void*)d,
+        wuffs_base__pixel_swizzler__float__premul_2_x86_avx2(s, linear));
+
+    s += 2 * 8;
+    d += 2 * 16;
+    n -= 2;
+  }
+
+  wuffs_base__pixel_swizzler__rgba_premul_fxx__bgra_nonpremul_4x16le(
+      d, 16 * n, s, 8 * n, false, linear, false);
+  return len;
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2,f16c")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2,f16c")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, false);
+}
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static uint64_t  //
+wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src__x86_avx2(
+    uint8_t* dst_ptr,
+    size_t dst_len,
+    uint8_t* dst_palette_ptr,
+    size_t dst_palette_len,
+    const uint8_t* src_ptr,
+    size_t src_len) {
+  return wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__x86_avx2(
+      dst_ptr, dst_len, src_ptr, src_len, true);
+}
 #endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
 // ‼ WUFFS MULTI-FILE SECTION -x86_avx2
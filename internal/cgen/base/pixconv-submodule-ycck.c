@@ -51,8 +51,174 @@ wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2(
     bool first_column,
     bool last_column);
 #endif
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+WUFFS_BASE__MAYBE_ATTRIBUTE_TARGET("pclmul,popcnt,sse4.2,avx2")
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_x86_avx2(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
 #endif  // defined(WUFFS_BASE__CPU_ARCH__X86_64)
 
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2);
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2);
+
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v2_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column);
+
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias,
+    bool first_column,
+    bool last_column);
+
+static const uint8_t*  //
+wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_arm_neon(
+    uint8_t* dst_ptr,
+    const uint8_t* src_ptr_major,
+    const uint8_t* src_ptr_minor,
+    size_t src_len,
+    uint32_t h1v2_bias_ignored,
+    bool first_column,
+    bool last_column);
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_arm_neon(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3);
+#endif  // defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+
 // --------
 
 static inline uint32_t  //
@@ -169,6 +335,52 @@ wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_general(
   }
 }
 
+static void  //
+wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_bgrx(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  for (; x < x_end; x++) {
+    uint32_t color = 0xFF000000u |                    //
+                     (((uint32_t)(*up0++)) << 16u) |  //
+                     (((uint32_t)(*up1++)) << 8u) |   //
+                     (((uint32_t)(*up2++)) << 0u);
+    wuffs_base__poke_u32le__no_bounds_check(dst_iter, color);
+    dst_iter += 4u;
+  }
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_rgbx(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  for (; x < x_end; x++) {
+    uint32_t color = 0xFF000000u |                    //
+                     (((uint32_t)(*up0++)) << 0u) |   //
+                     (((uint32_t)(*up1++)) << 8u) |   //
+                     (((uint32_t)(*up2++)) << 16u);
+    wuffs_base__poke_u32le__no_bounds_check(dst_iter, color);
+    dst_iter += 4u;
+  }
+}
+
 static void  //
 wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_general(
     wuffs_base__pixel_buffer* dst,
@@ -232,6 +444,112 @@ wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx(
 
 // --------
 
+// wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k multiplies the color
+// channels of n 4-byte BGRX or RGBX pixels (already converted from the first
+// three of four components) by the fourth component, the w in RGBW (see
+// wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_general). If invert is
+// true, the color channels are first inverted, as for YCCK. The alpha channel
+// is left as 0xFF.
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k(uint8_t* dst_iter,
+                                                  const uint8_t* up3,
+                                                  size_t n,
+                                                  bool invert) {
+  uint32_t inv = invert ? 0xFFu : 0x00u;
+  for (; n > 0u; n--) {
+    uint32_t w = ((uint32_t)(*up3++));
+    uint32_t c0 = inv ^ ((uint32_t)(dst_iter[0u]));
+    uint32_t c1 = inv ^ ((uint32_t)(dst_iter[1u]));
+    uint32_t c2 = inv ^ ((uint32_t)(dst_iter[2u]));
+    dst_iter[0u] = (uint8_t)(((c0 * w) + 0x7Fu) / 0xFFu);
+    dst_iter[1u] = (uint8_t)(((c1 * w) + 0x7Fu) / 0xFFu);
+    dst_iter[2u] = (uint8_t)(((c2 * w) + 0x7Fu) / 0xFFu);
+    dst_iter += 4u;
+  }
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_bgrx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k(dst_iter, up3, x_end - x,
+                                                    false);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_rgbx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k(dst_iter, up3, x_end - x,
+                                                    false);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k(dst_iter, up3, x_end - x,
+                                                    true);
+}
+
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx(
+    wuffs_base__pixel_buffer* dst,
+    uint32_t x,
+    uint32_t x_end,
+    uint32_t y,
+    const uint8_t* up0,
+    const uint8_t* up1,
+    const uint8_t* up2,
+    const uint8_t* up3) {
+  size_t dst_stride = dst->private_impl.planes[0].stride;
+  uint8_t* dst_iter = dst->private_impl.planes[0].ptr +
+                      (dst_stride * ((size_t)y)) + (4u * ((size_t)x));
+
+  wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx(  //
+      dst, x, x_end, y, up0, up1, up2);
+  wuffs_base__pixel_swizzler__swizzle_cmyk__apply_k(dst_iter, up3, x_end - x,
+                                                    true);
+}
+
+// --------
+
 // wuffs_base__pixel_swizzler__swizzle_ycc__upsample_func upsamples to a
 // destination slice at least 480 (YCCK) or 672 (YCC) bytes long and whose
 // src_len (multiplied by 1, 2, 3 or 4) is positive but no more than that. This
@@ -631,6 +949,8 @@ wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter(
     wuffs_base__pixel_buffer* dst,
     uint32_t width,
     uint32_t height,
+    uint32_t y_min_incl,
+    uint32_t y_max_excl,
     const uint8_t* src_ptr0,
     const uint8_t* src_ptr1,
     const uint8_t* src_ptr2,
@@ -661,25 +981,32 @@ wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter(
   wuffs_base__pixel_swizzler__swizzle_ycc__upsample_func upfunc3 =
       (*upfuncs)[(inv_h3 - 1u) & 3u][(inv_v3 - 1u) & 3u];
 
+  uint32_t y = y_min_incl;
+  uint32_t h1v2_bias = 1u + (y & 1u);
+
   // First row.
-  uint32_t h1v2_bias = 1u;
-  wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter_edge_row(
-      dst, width, 0u,                          //
-      src_ptr0, src_ptr1, src_ptr2, src_ptr3,  //
-      stride0, stride1, stride2, stride3,      //
-      inv_h0, inv_h1, inv_h2, inv_h3,          //
-      inv_v0, inv_v1, inv_v2, inv_v3,          //
-      half_width_for_2to1,                     //
-      h1v2_bias,                               //
-      scratch_buffer_2k_ptr,                   //
-      upfunc0, upfunc1, upfunc2, upfunc3, conv4func);
-  h1v2_bias = 2u;
+  if (y == 0u) {
+    wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter_edge_row(
+        dst, width, 0u,                          //
+        src_ptr0, src_ptr1, src_ptr2, src_ptr3,  //
+        stride0, stride1, stride2, stride3,      //
+        inv_h0, inv_h1, inv_h2, inv_h3,          //
+        inv_v0, inv_v1, inv_v2, inv_v3,          //
+        half_width_for_2to1,                     //
+        h1v2_bias,                               //
+        scratch_buffer_2k_ptr,                   //
+        upfunc0, upfunc1, upfunc2, upfunc3, conv4func);
+    y = 1u;
+    h1v2_bias = 2u;
+  }
 
   // Middle rows.
   bool last_row = height == 2u * half_height_for_2to1;
-  uint32_t y_max_excl = last_row ? (height - 1u) : height;
-  uint32_t y;
-  for (y = 1u; y < y_max_excl; y++) {
+  uint32_t y_middle_max_excl = last_row ? (height - 1u) : height;
+  if (y_middle_max_excl > y_max_excl) {
+    y_middle_max_excl = y_max_excl;
+  }
+  for (; y < y_middle_max_excl; y++) {
     const uint8_t* src0_major = src_ptr0 + ((y / inv_v0) * (size_t)stride0);
     const uint8_t* src0_minor =
         (inv_v0 != 2u)
@@ -766,7 +1093,7 @@ wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter(
   }
 
   // Last row.
-  if (y_max_excl != height) {
+  if (last_row && (y_max_excl == height)) {
     wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter_edge_row(
         dst, width, height - 1u,                 //
         src_ptr0, src_ptr1, src_ptr2, src_ptr3,  //
@@ -866,6 +1193,8 @@ wuffs_base__pixel_swizzler__swizzle_ycc__general__triangle_filter(
     wuffs_base__pixel_buffer* dst,
     uint32_t width,
     uint32_t height,
+    uint32_t y_min_incl,
+    uint32_t y_max_excl,
     const uint8_t* src_ptr0,
     const uint8_t* src_ptr1,
     const uint8_t* src_ptr2,
@@ -890,25 +1219,32 @@ wuffs_base__pixel_swizzler__swizzle_ycc__general__triangle_filter(
   wuffs_base__pixel_swizzler__swizzle_ycc__upsample_func upfunc2 =
       (*upfuncs)[(inv_h2 - 1u) & 3u][(inv_v2 - 1u) & 3u];
 
+  uint32_t y = y_min_incl;
+  uint32_t h1v2_bias = 1u + (y & 1u);
+
   // First row.
-  uint32_t h1v2_bias = 1u;
-  wuffs_base__pixel_swizzler__swizzle_ycc__general__triangle_filter_edge_row(
-      dst, width, 0u,                //
-      src_ptr0, src_ptr1, src_ptr2,  //
-      stride0, stride1, stride2,     //
-      inv_h0, inv_h1, inv_h2,        //
-      inv_v0, inv_v1, inv_v2,        //
-      half_width_for_2to1,           //
-      h1v2_bias,                     //
-      scratch_buffer_2k_ptr,         //
-      upfunc0, upfunc1, upfunc2, conv3func);
-  h1v2_bias = 2u;
+  if (y == 0u) {
+    wuffs_base__pixel_swizzler__swizzle_ycc__general__triangle_filter_edge_row(
+        dst, width, 0u,                //
+        src_ptr0, src_ptr1, src_ptr2,  //
+        stride0, stride1, stride2,     //
+        inv_h0, inv_h1, inv_h2,        //
+        inv_v0, inv_v1, inv_v2,        //
+        half_width_for_2to1,           //
+        h1v2_bias,                     //
+        scratch_buffer_2k_ptr,         //
+        upfunc0, upfunc1, upfunc2, conv3func);
+    y = 1u;
+    h1v2_bias = 2u;
+  }
 
   // Middle rows.
   bool last_row = height == 2u * half_height_for_2to1;
-  uint32_t y_max_excl = last_row ? (height - 1u) : height;
-  uint32_t y;
-  for (y = 1u; y < y_max_excl; y++) {
+  uint32_t y_middle_max_excl = last_row ? (height - 1u) : height;
+  if (y_middle_max_excl > y_max_excl) {
+    y_middle_max_excl = y_max_excl;
+  }
+  for (; y < y_middle_max_excl; y++) {
     const uint8_t* src0_major = src_ptr0 + ((y / inv_v0) * (size_t)stride0);
     const uint8_t* src0_minor =
         (inv_v0 != 2u)
@@ -978,7 +1314,7 @@ wuffs_base__pixel_swizzler__swizzle_ycc__general__triangle_filter(
   }
 
   // Last row.
-  if (y_max_excl != height) {
+  if (last_row && (y_max_excl == height)) {
     wuffs_base__pixel_swizzler__swizzle_ycc__general__triangle_filter_edge_row(
         dst, width, height - 1u,       //
         src_ptr0, src_ptr1, src_ptr2,  //
@@ -997,6 +1333,8 @@ wuffs_base__pixel_swizzler__swizzle_ycc__general__box_filter(
     wuffs_base__pixel_buffer* dst,
     uint32_t width,
     uint32_t height,
+    uint32_t y_min_incl,
+    uint32_t y_max_excl,
     const uint8_t* src_ptr0,
     const uint8_t* src_ptr1,
     const uint8_t* src_ptr2,
@@ -1022,7 +1360,7 @@ wuffs_base__pixel_swizzler__swizzle_ycc__general__box_filter(
       (*upfuncs)[(inv_h2 - 1u) & 3u][(inv_v2 - 1u) & 3u];
 
   uint32_t y;
-  for (y = 0u; y < height; y++) {
+  for (y = y_min_incl; y < y_max_excl; y++) {
     const uint8_t* src0_major = src_ptr0 + ((y / inv_v0) * (size_t)stride0);
     const uint8_t* src1_major = src_ptr1 + ((y / inv_v1) * (size_t)stride1);
     const uint8_t* src2_major = src_ptr2 + ((y / inv_v2) * (size_t)stride2);
@@ -1084,6 +1422,265 @@ wuffs_base__pixel_swizzler__flattened_length(uint32_t width,
   return ((scaled_height - 1u) * stride) + scaled_width;
 }
 
+// --------
+
+// wuffs_base__pixel_swizzler__swizzle_planar__plane converts the sample rows,
+// of one plane, that cover the pixel rows in [y_min_incl .. y_max_excl). The
+// src_ptr's first row holds sample row src_j_offset.
+//
+// Along each axis, the src and dst inverse ratios (what the pixel subsampling
+// calls denominators) are either equal or are 1 and 2. The sum below weighs
+// each src sample by 16ths: 4 × 4 for the same ratio, 2 × 2 (averaging two
+// src samples) for downsampling and 3 × 1 (the triangle filter) for
+// upsampling.
+//
+// Other preconditions (checked by the callers) are that width and height are
+// positive, that (y_min_incl < y_max_excl <= height) and that dst is large
+// enough. Src rows or columns outside of what src_len covers are clamped.
+static void  //
+wuffs_base__pixel_swizzler__swizzle_planar__plane(wuffs_base__table_u8 dst,
+                                                  uint32_t dst_inv_h,
+                                                  uint32_t dst_inv_v,
+                                                  const uint8_t* src_ptr,
+                                                  size_t src_len,
+                                                  size_t src_stride,
+                                                  uint32_t src_inv_h,
+                                                  uint32_t src_inv_v,
+                                                  uint32_t src_j_offset,
+                                                  uint32_t width,
+                                                  uint32_t height,
+                                                  uint32_t y_min_incl,
+                                                  uint32_t y_max_excl) {
+  uint32_t sw = (width + src_inv_h - 1u) / src_inv_h;
+  uint32_t sh = (height + src_inv_v - 1u) / src_inv_v;
+  uint32_t dw = (width + dst_inv_h - 1u) / dst_inv_h;
+  if ((src_len < sw) || (src_stride < sw)) {
+    return;
+  }
+  uint64_t r_max = ((uint64_t)src_j_offset) + ((src_len - sw) / src_stride);
+  uint32_t r_min = src_j_offset;
+  if (r_max > (sh - 1u)) {
+    r_max = sh - 1u;
+  }
+  if (r_max < r_min) {
+    return;
+  }
+
+  uint32_t j = y_min_incl / dst_inv_v;
+  uint32_t j_end = ((y_max_excl - 1u) / dst_inv_v) + 1u;
+  for (; j < j_end; j++) {
+    uint8_t* d = dst.ptr + (dst.stride * ((size_t)j));
+
+    uint32_t ra = j;
+    uint32_t rb = j;
+    uint32_t va = 2u;
+    uint32_t vb = 2u;
+    if (dst_inv_v > src_inv_v) {
+      ra = 2u * j;
+      rb = ra + 1u;
+    } else if (dst_inv_v < src_inv_v) {
+      ra = j / 2u;
+      rb = (j & 1u) ? (ra + 1u) : (ra ? (ra - 1u) : 0u);
+      va = 3u;
+      vb = 1u;
+    }
+    ra = (uint32_t)wuffs_base__u64__min(wuffs_base__u32__max(ra, r_min), r_max);
+    rb = (uint32_t)wuffs_base__u64__min(wuffs_base__u32__max(rb, r_min), r_max);
+    const uint8_t* sa = src_ptr + (src_stride * ((size_t)(ra - r_min)));
+    const uint8_t* sb = src_ptr + (src_stride * ((size_t)(rb - r_min)));
+
+    uint32_t i = 0u;
+    if (dst_inv_h > src_inv_h) {
+      for (; i < dw; i++) {
+        uint32_t ia = 2u * i;
+        uint32_t ib = wuffs_base__u32__min(ia + 1u, sw - 1u);
+        uint32_t t = (2u * ((va * sa[ia]) + (vb * sb[ia]))) +  //
+                     (2u * ((va * sa[ib]) + (vb * sb[ib])));
+        d[i] = (uint8_t)((t + 8u) >> 4u);
+      }
+    } else if (dst_inv_h < src_inv_h) {
+      for (; i < dw; i++) {
+        uint32_t ia = i / 2u;
+        uint32_t ib = (i & 1u) ? wuffs_base__u32__min(ia + 1u, sw - 1u)
+                               : (ia ? (ia - 1u) : 0u);
+        uint32_t t = (3u * ((va * sa[ia]) + (vb * sb[ia]))) +  //
+                     (1u * ((va * sa[ib]) + (vb * sb[ib])));
+        d[i] = (uint8_t)((t + 8u) >> 4u);
+      }
+    } else if ((dst_inv_v == src_inv_v) || (ra == rb)) {
+      memmove(d, sa, dw);
+    } else {
+      for (; i < dw; i++) {
+        uint32_t t = 4u * ((va * sa[i]) + (vb * sb[i]));
+        d[i] = (uint8_t)((t + 8u) >> 4u);
+      }
+    }
+  }
+}
+
+// wuffs_base__pixel_swizzler__swizzle_planar checks that the dst pixel
+// buffer's planes are compatible with the num_planes src planes, which have
+// the given (inverse) subsampling ratios, and then converts each plane. The
+// srcs[p] slice's first row holds the samples for image row src_y_offset,
+// which must be a multiple of every src_inv_vs[p].
+static wuffs_base__status  //
+wuffs_base__pixel_swizzler__swizzle_planar(wuffs_base__pixel_buffer* dst,
+                                           uint32_t width,
+                                           uint32_t height,
+                                           uint32_t y_min_incl,
+                                           uint32_t y_max_excl,
+                                           uint32_t src_y_offset,
+                                           uint32_t num_planes,
+                                           const wuffs_base__slice_u8* srcs,
+                                           const uint32_t* src_strides,
+                                           const uint32_t* src_inv_hs,
+                                           const uint32_t* src_inv_vs) {
+  const wuffs_base__pixel_subsampling* dst_pixsub =
+      &dst->pixcfg.private_impl.pixsub;
+  uint32_t dst_inv_hs[WUFFS_BASE__PIXEL_FORMAT__NUM_PLANES_MAX_INCL];
+  uint32_t dst_inv_vs[WUFFS_BASE__PIXEL_FORMAT__NUM_PLANES_MAX_INCL];
+  uint32_t p;
+  for (p = 0u; p < num_planes; p++) {
+    if ((wuffs_base__pixel_format__bits_per_channel
+             [0x0Fu & (dst->pixcfg.private_impl.pixfmt.repr >> (4u * p))] !=
+         8u) ||
+        (wuffs_base__pixel_subsampling__bias_x(dst_pixsub, p) != 0u) ||
+        (wuffs_base__pixel_subsampling__bias_y(dst_pixsub, p) != 0u)) {
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    uint32_t dh = wuffs_base__pixel_subsampling__denominator_x(dst_pixsub, p);
+    uint32_t dv = wuffs_base__pixel_subsampling__denominator_y(dst_pixsub, p);
+    uint32_t sh = src_inv_hs[p];
+    uint32_t sv = src_inv_vs[p];
+    if (((dh != sh) && ((dh * sh) != 2u)) ||  //
+        ((dv != sv) && ((dv * sv) != 2u))) {
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    dst_inv_hs[p] = dh;
+    dst_inv_vs[p] = dv;
+  }
+
+  if (y_max_excl > height) {
+    y_max_excl = height;
+  }
+  if ((width <= 0u) || (height <= 0u) || (y_min_incl >= y_max_excl)) {
+    return wuffs_base__make_status(NULL);
+  }
+
+  for (p = 0u; p < num_planes; p++) {
+    wuffs_base__table_u8 tab = dst->private_impl.planes[p];
+    uint32_t dw = (width + dst_inv_hs[p] - 1u) / dst_inv_hs[p];
+    uint32_t dj_end = ((y_max_excl - 1u) / dst_inv_vs[p]) + 1u;
+    if ((tab.width < dw) || (tab.height < dj_end)) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+  }
+
+  for (p = 0u; p < num_planes; p++) {
+    wuffs_base__pixel_swizzler__swizzle_planar__plane(
+        dst->private_impl.planes[p], dst_inv_hs[p], dst_inv_vs[p],  //
+        srcs[p].ptr, srcs[p].len, src_strides[p],                   //
+        src_inv_hs[p], src_inv_vs[p], src_y_offset / src_inv_vs[p],  //
+        width, height, y_min_incl, y_max_excl);
+  }
+  return wuffs_base__make_status(NULL);
+}
+
+WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
+wuffs_base__pixel_buffer__swizzle_planar_from(
+    wuffs_base__pixel_buffer* dst,
+    const wuffs_base__pixel_buffer* src) {
+  if (!dst) {
+    return wuffs_base__make_status(wuffs_base__error__bad_receiver);
+  } else if (!src ||
+             (dst->pixcfg.private_impl.width !=
+              src->pixcfg.private_impl.width) ||
+             (dst->pixcfg.private_impl.height !=
+              src->pixcfg.private_impl.height)) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  } else if (!wuffs_base__pixel_format__is_planar(
+                 &dst->pixcfg.private_impl.pixfmt) ||
+             (dst->pixcfg.private_impl.pixfmt.repr !=
+              src->pixcfg.private_impl.pixfmt.repr)) {
+    return wuffs_base__make_status(
+        wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+
+  uint32_t width = src->pixcfg.private_impl.width;
+  uint32_t height = src->pixcfg.private_impl.height;
+  const wuffs_base__pixel_subsampling* src_pixsub =
+      &src->pixcfg.private_impl.pixsub;
+  uint32_t num_planes =
+      wuffs_base__pixel_format__num_planes(&src->pixcfg.private_impl.pixfmt);
+  wuffs_base__slice_u8 srcs[WUFFS_BASE__PIXEL_FORMAT__NUM_PLANES_MAX_INCL];
+  uint32_t src_strides[WUFFS_BASE__PIXEL_FORMAT__NUM_PLANES_MAX_INCL];
+  uint32_t src_inv_hs[WUFFS_BASE__PIXEL_FORMAT__NUM_PLANES_MAX_INCL];
+  uint32_t src_inv_vs[WUFFS_BASE__PIXEL_FORMAT__NUM_PLANES_MAX_INCL];
+  uint32_t p;
+  for (p = 0u; p < num_planes; p++) {
+    const wuffs_base__table_u8* tab = &src->private_impl.planes[p];
+    if ((wuffs_base__pixel_subsampling__bias_x(src_pixsub, p) != 0u) ||
+        (wuffs_base__pixel_subsampling__bias_y(src_pixsub, p) != 0u)) {
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    src_inv_hs[p] = wuffs_base__pixel_subsampling__denominator_x(src_pixsub, p);
+    src_inv_vs[p] = wuffs_base__pixel_subsampling__denominator_y(src_pixsub, p);
+    if ((tab->stride > 0xFFFFFFFFu) ||
+        (tab->width < ((width + src_inv_hs[p] - 1u) / src_inv_hs[p])) ||
+        (tab->height < ((height + src_inv_vs[p] - 1u) / src_inv_vs[p]))) {
+      return wuffs_base__make_status(wuffs_base__error__bad_argument);
+    }
+    src_strides[p] = (uint32_t)(tab->stride);
+    size_t len = 0u;
+    if (tab->height > 0u) {
+      len = ((tab->height - 1u) * tab->stride) + tab->width;
+    }
+    srcs[p] = wuffs_base__make_slice_u8(tab->ptr, len);
+  }
+
+  return wuffs_base__pixel_swizzler__swizzle_planar(
+      dst, width, height, 0u, height, 0u, num_planes, srcs, src_strides,
+      src_inv_hs, src_inv_vs);
+}
+
+// wuffs_base__pixel_swizzler__swizzle_ycck__color_transform_row applies the
+// swizzler's color transform, if any, to the first width pixels of dst's row
+// y. The transform was set up for the prepared dst pixel format, so it is
+// skipped if dst has some other pixel format.
+static void  //
+wuffs_base__pixel_swizzler__swizzle_ycck__color_transform_row(
+    const wuffs_base__pixel_swizzler* p,
+    wuffs_base__pixel_buffer* dst,
+    uint32_t width,
+    uint32_t y) {
+  if (!p->private_impl.color_transform_func ||
+      (dst->pixcfg.private_impl.pixfmt.repr !=
+       p->private_impl.dst_pixfmt_repr)) {
+    return;
+  }
+  size_t bytes_per_pixel = p->private_impl.dst_pixfmt_bytes_per_pixel;
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(dst, 0);
+  size_t len = ((size_t)width) * bytes_per_pixel;
+  if ((y >= tab.height) || (len > tab.width)) {
+    return;
+  }
+  (*p->private_impl.color_transform_func)(
+      p->private_impl.color_transform, tab.ptr + (((size_t)y) * tab.stride),
+      len);
+}
+
+// wuffs_base__pixel_swizzler__swizzle_ycck writes the dst rows in [y_min_incl
+// .. y_max_excl), clamped to the (width, height) image. Each srcN slice's
+// first row holds the samples for image row src_y_offset, which must be a
+// multiple of the maximum v. It is typically zero, with every srcN slice
+// holding a whole plane, but a non-zero value lets the caller convert a band
+// of rows at a time, re-using a smaller buffer. In that case, the srcN slices
+// must also hold the one row of context above y_min_incl (so that
+// src_y_offset is less than y_min_incl) and below y_max_excl, if any, that the
+// triangle filter needs.
 WUFFS_BASE__MAYBE_STATIC wuffs_base__status  //
 wuffs_base__pixel_swizzler__swizzle_ycck(
     const wuffs_base__pixel_swizzler* p,
@@ -1091,6 +1688,9 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     wuffs_base__slice_u8 dst_palette,
     uint32_t width,
     uint32_t height,
+    uint32_t y_min_incl,
+    uint32_t y_max_excl,
+    uint32_t src_y_offset,
     wuffs_base__slice_u8 src0,
     wuffs_base__slice_u8 src1,
     wuffs_base__slice_u8 src2,
@@ -1169,6 +1769,21 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
       height2 * inv_v2,                //
       wuffs_base__pixel_config__height(&dst->pixcfg));
 
+  if (y_max_excl > height) {
+    y_max_excl = height;
+  }
+  if ((src_y_offset != 0u) &&
+      ((src_y_offset >= y_min_incl) || ((src_y_offset % max_incl_v) != 0u))) {
+    return wuffs_base__make_status(wuffs_base__error__bad_argument);
+  }
+  // The srcN slices need to cover the rows up to (and including one row of
+  // vertical context beyond) y_max_excl, relative to src_y_offset.
+  uint32_t src_y_max_excl =
+      wuffs_base__u32__min(y_max_excl + max_incl_v, height);
+  uint32_t src_height = (src_y_max_excl > src_y_offset)
+                            ? (src_y_max_excl - src_y_offset)
+                            : 0u;
+
   if (((h0 * inv_h0) != max_incl_h) ||  //
       ((h1 * inv_h1) != max_incl_h) ||  //
       ((h2 * inv_h2) != max_incl_h) ||  //
@@ -1176,26 +1791,39 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
       ((v1 * inv_v1) != max_incl_v) ||  //
       ((v2 * inv_v2) != max_incl_v) ||  //
       (src0.len < wuffs_base__pixel_swizzler__flattened_length(
-                      width, height, stride0, inv_h0, inv_v0)) ||
+                      width, src_height, stride0, inv_h0, inv_v0)) ||
       (src1.len < wuffs_base__pixel_swizzler__flattened_length(
-                      width, height, stride1, inv_h1, inv_v1)) ||
+                      width, src_height, stride1, inv_h1, inv_v1)) ||
       (src2.len < wuffs_base__pixel_swizzler__flattened_length(
-                      width, height, stride2, inv_h2, inv_v2))) {
+                      width, src_height, stride2, inv_h2, inv_v2))) {
     return wuffs_base__make_status(wuffs_base__error__bad_argument);
   }
   if ((h3 != 0u) || (v3 != 0u)) {
     if (((h3 * inv_h3) != max_incl_h) ||  //
         ((v3 * inv_v3) != max_incl_v) ||  //
         (src3.len < wuffs_base__pixel_swizzler__flattened_length(
-                        width, height, stride3, inv_h3, inv_v3))) {
+                        width, src_height, stride3, inv_h3, inv_v3))) {
       return wuffs_base__make_status(wuffs_base__error__bad_argument);
     }
   }
 
   if (wuffs_base__pixel_format__is_planar(&dst->pixcfg.private_impl.pixfmt)) {
-    // TODO: see wuffs_base__pixel_buffer__set_color_u32_at's TODO.
-    return wuffs_base__make_status(
-        wuffs_base__error__unsupported_pixel_swizzler_option);
+    // Planar YCbCr destinations skip the upsampling and color conversion.
+    // Each src plane is copied as is, unless the dst pixel subsampling
+    // differs from the (h, v) sampling factors.
+    if (is_rgb_or_cmyk || (h3 != 0u) || (v3 != 0u) ||
+        (dst->pixcfg.private_impl.pixfmt.repr !=
+         WUFFS_BASE__PIXEL_FORMAT__YCBCR)) {
+      return wuffs_base__make_status(
+          wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+    wuffs_base__slice_u8 srcs[3] = {src0, src1, src2};
+    uint32_t strides[3] = {stride0, stride1, stride2};
+    uint32_t inv_hs[3] = {inv_h0, inv_h1, inv_h2};
+    uint32_t inv_vs[3] = {inv_v0, inv_v1, inv_v2};
+    return wuffs_base__pixel_swizzler__swizzle_planar(
+        dst, width, height, y_min_incl, y_max_excl, src_y_offset, 3u, srcs,
+        strides, inv_hs, inv_vs);
   }
 
   switch (dst->pixcfg.private_impl.pixfmt.repr) {
@@ -1210,10 +1838,16 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE:
     case WUFFS_BASE__PIXEL_FORMAT__BGRX:
     case WUFFS_BASE__PIXEL_FORMAT__RGB:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
     case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32:
+    case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR:
     case WUFFS_BASE__PIXEL_FORMAT__RGBX:
       break;
 
@@ -1223,14 +1857,43 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
           wuffs_base__error__unsupported_pixel_swizzler_option);
   }
 
-  if ((width <= 0u) || (height <= 0u)) {
+  if ((width <= 0u) || (height <= 0u) || (y_min_incl >= y_max_excl)) {
     return wuffs_base__make_status(NULL);
   }
 
+  // Convert relative to src_y_offset: offset the dst pixel buffer (a copy of
+  // it) so that its row 0 is the image's row src_y_offset. As src_y_offset is
+  // a multiple of the maximum v, this preserves every row's (y % inv_v).
+  wuffs_base__pixel_buffer band_dst = *dst;
+  if (src_y_offset > 0u) {
+    band_dst.private_impl.planes[0].ptr +=
+        ((size_t)src_y_offset) * band_dst.private_impl.planes[0].stride;
+    band_dst.private_impl.planes[0].height -= src_y_offset;
+    band_dst.pixcfg.private_impl.height -= src_y_offset;
+    height -= src_y_offset;
+    y_min_incl -= src_y_offset;
+    y_max_excl -= src_y_offset;
+    half_height_for_2to1 -= src_y_offset / 2u;
+  }
+
   wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_func conv3func = NULL;
 
   if (is_rgb_or_cmyk) {
-    conv3func = &wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_general;
+    switch (dst->pixcfg.private_impl.pixfmt.repr) {
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+        conv3func = &wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_bgrx;
+        break;
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+        conv3func = &wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_rgbx;
+        break;
+      default:
+        conv3func = &wuffs_base__pixel_swizzler__swizzle_rgb__convert_3_general;
+        break;
+    }
   } else {
     switch (dst->pixcfg.private_impl.pixfmt.repr) {
       case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
@@ -1242,6 +1905,13 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
               &wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx_x86_avx2;
           break;
         }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        if (wuffs_base__cpu_arch__have_arm_neon()) {
+          conv3func =
+              &wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx_arm_neon;
+          break;
+        }
 #endif
         conv3func = &wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_bgrx;
         break;
@@ -1254,6 +1924,13 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
               &wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx_x86_avx2;
           break;
         }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        if (wuffs_base__cpu_arch__have_arm_neon()) {
+          conv3func =
+              &wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx_arm_neon;
+          break;
+        }
 #endif
         conv3func = &wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_rgbx;
         break;
@@ -1267,6 +1944,8 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
       wuffs_base__pixel_buffer * dst,  //
       uint32_t width,                  //
       uint32_t height,                 //
+      uint32_t y_min_incl,             //
+      uint32_t y_max_excl,             //
       const uint8_t* src_ptr0,         //
       const uint8_t* src_ptr1,         //
       const uint8_t* src_ptr2,         //
@@ -1286,6 +1965,13 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
       wuffs_base__pixel_swizzler__swizzle_ycc__convert_3_func conv3func) =
       &wuffs_base__pixel_swizzler__swizzle_ycc__general__box_filter;
 
+  // With a color transform, convert one row at a time, so that the transform
+  // runs while that row is still hot in the cache.
+  uint32_t y = 0u;
+  uint32_t y_step = p->private_impl.color_transform_func
+                        ? 1u
+                        : (y_max_excl - y_min_incl);
+
   wuffs_base__pixel_swizzler__swizzle_ycc__upsample_func upfuncs[4][4];
   memcpy(&upfuncs, &wuffs_base__pixel_swizzler__swizzle_ycc__upsample_funcs,
          sizeof upfuncs);
@@ -1322,6 +2008,22 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
           wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v2_triangle_x86_avx2;
     }
 #endif
+    if (wuffs_base__cpu_arch__have_x86_avx2()) {
+      upfuncs[0][1] =
+          wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2;
+      upfuncs[1][0] =
+          wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2;
+    }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+    if (wuffs_base__cpu_arch__have_arm_neon()) {
+      upfuncs[0][1] =
+          wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_arm_neon;
+      upfuncs[1][0] =
+          wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_arm_neon;
+      upfuncs[1][1] =
+          wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v2_triangle_arm_neon;
+    }
 #endif
   }
 
@@ -1330,24 +2032,87 @@ wuffs_base__pixel_swizzler__swizzle_ycck(
         is_rgb_or_cmyk
             ? &wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_general
             : &wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_general;
-    wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter(  //
-        dst, width, height,                                              //
-        src0.ptr, src1.ptr, src2.ptr, src3.ptr,                          //
-        stride0, stride1, stride2, stride3,                              //
-        inv_h0, inv_h1, inv_h2, inv_h3,                                  //
-        inv_v0, inv_v1, inv_v2, inv_v3,                                  //
-        half_width_for_2to1, half_height_for_2to1,                       //
-        scratch_buffer_2k.ptr, &upfuncs, conv4func);
+    switch (dst->pixcfg.private_impl.pixfmt.repr) {
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__BGRX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+        if (wuffs_base__cpu_arch__have_x86_avx2()) {
+          conv4func =
+              is_rgb_or_cmyk
+                  ? &wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_x86_avx2
+                  : &wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_x86_avx2;
+          break;
+        }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        if (wuffs_base__cpu_arch__have_arm_neon()) {
+          conv4func =
+              is_rgb_or_cmyk
+                  ? &wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_arm_neon
+                  : &wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_arm_neon;
+          break;
+        }
+#endif
+        conv4func =
+            is_rgb_or_cmyk
+                ? &wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx
+                : &wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx;
+        break;
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL:
+      case WUFFS_BASE__PIXEL_FORMAT__RGBX:
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+        if (wuffs_base__cpu_arch__have_x86_avx2()) {
+          conv4func =
+              is_rgb_or_cmyk
+                  ? &wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_x86_avx2
+                  : &wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_x86_avx2;
+          break;
+        }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+        if (wuffs_base__cpu_arch__have_arm_neon()) {
+          conv4func =
+              is_rgb_or_cmyk
+                  ? &wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_arm_neon
+                  : &wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_arm_neon;
+          break;
+        }
+#endif
+        conv4func =
+            is_rgb_or_cmyk
+                ? &wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx
+                : &wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx;
+        break;
+    }
+    for (y = y_min_incl; y < y_max_excl; y += y_step) {
+      wuffs_base__pixel_swizzler__swizzle_ycck__general__triangle_filter(  //
+          &band_dst, width, height, y, y + y_step,                         //
+          src0.ptr, src1.ptr, src2.ptr, src3.ptr,                          //
+          stride0, stride1, stride2, stride3,                              //
+          inv_h0, inv_h1, inv_h2, inv_h3,                                  //
+          inv_v0, inv_v1, inv_v2, inv_v3,                                  //
+          half_width_for_2to1, half_height_for_2to1,                       //
+          scratch_buffer_2k.ptr, &upfuncs, conv4func);
+      wuffs_base__pixel_swizzler__swizzle_ycck__color_transform_row(
+          p, &band_dst, width, y);
+    }
 
   } else {
-    (*func)(                                        //
-        dst, width, height,                         //
-        src0.ptr, src1.ptr, src2.ptr,               //
-        stride0, stride1, stride2,                  //
-        inv_h0, inv_h1, inv_h2,                     //
-        inv_v0, inv_v1, inv_v2,                     //
-        half_width_for_2to1, half_height_for_2to1,  //
-        scratch_buffer_2k.ptr, &upfuncs, conv3func);
+    for (y = y_min_incl; y < y_max_excl; y += y_step) {
+      (*func)(                                        //
+          &band_dst, width, height,                   //
+          y, y + y_step,                              //
+          src0.ptr, src1.ptr, src2.ptr,               //
+          stride0, stride1, stride2,                  //
+          inv_h0, inv_h1, inv_h2,                     //
+          inv_v0, inv_v1, inv_v2,                     //
+          half_width_for_2to1, half_height_for_2to1,  //
+          scratch_buffer_2k.ptr, &upfuncs, conv3func);
+      wuffs_base__pixel_swizzler__swizzle_ycck__color_transform_row(
+          p, &band_dst, width, y);
+    }
   }
 
   return wuffs_base__make_status(NULL);
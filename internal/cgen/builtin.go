@@ -534,6 +534,8 @@ func (g *gen) writeBuiltinCPUArchARMNeon(b *buffer, recv *a.Expr, method t.ID, a
 				before, ptr = "vld1_u8(", true
 			case "make_u8x16_slice128":
 				before, ptr = "vld1q_u8(", true
+			case "make_u16x8_slice_u16lex8":
+				before, ptr = "vld1q_u16(", true
 			default:
 				return fmt.Errorf("internal error: unsupported cpu_arch method %q", methodStr)
 			}
@@ -133,7 +133,13 @@ func Do(args []string) error {
 				"// ¡ INSERT base/floatconv-submodule.c.\n":        insertBaseFloatConvSubmoduleC,
 				"// ¡ INSERT base/intconv-submodule.c.\n":          insertBaseIntConvSubmoduleC,
 				"// ¡ INSERT base/magic-submodule.c.\n":            insertBaseMagicSubmoduleC,
+				"// ¡ INSERT base/pixconv-submodule-arm-neon.c.\n": insertBasePixConvSubmoduleARMNeonC,
+				"// ¡ INSERT base/pixconv-submodule-color.c.\n":    insertBasePixConvSubmoduleColorC,
+				"// ¡ INSERT base/pixconv-submodule-dither.c.\n":   insertBasePixConvSubmoduleDitherC,
+				"// ¡ INSERT base/pixconv-submodule-float.c.\n":    insertBasePixConvSubmoduleFloatC,
+				"// ¡ INSERT base/pixconv-submodule-quantize.c.\n": insertBasePixConvSubmoduleQuantizeC,
 				"// ¡ INSERT base/pixconv-submodule-regular.c.\n":  insertBasePixConvSubmoduleRegularC,
+				"// ¡ INSERT base/pixconv-submodule-resample.c.\n": insertBasePixConvSubmoduleResampleC,
 				"// ¡ INSERT base/pixconv-submodule-x86-avx2.c.\n": insertBasePixConvSubmoduleX86Avx2C,
 				"// ¡ INSERT base/pixconv-submodule-ycck.c.\n":     insertBasePixConvSubmoduleYcckC,
 				"// ¡ INSERT base/utf8-submodule.c.\n":             insertBaseUTF8SubmoduleC,
@@ -383,11 +389,41 @@ func insertBaseMagicSubmoduleC(buf *buffer) error {
 	return nil
 }
 
+func insertBasePixConvSubmoduleARMNeonC(buf *buffer) error {
+	buf.writes(embedBasePixConvSubmoduleARMNeonC.Trim())
+	return nil
+}
+
+func insertBasePixConvSubmoduleColorC(buf *buffer) error {
+	buf.writes(embedBasePixConvSubmoduleColorC.Trim())
+	return nil
+}
+
+func insertBasePixConvSubmoduleDitherC(buf *buffer) error {
+	buf.writes(embedBasePixConvSubmoduleDitherC.Trim())
+	return nil
+}
+
+func insertBasePixConvSubmoduleFloatC(buf *buffer) error {
+	buf.writes(embedBasePixConvSubmoduleFloatC.Trim())
+	return nil
+}
+
+func insertBasePixConvSubmoduleQuantizeC(buf *buffer) error {
+	buf.writes(embedBasePixConvSubmoduleQuantizeC.Trim())
+	return nil
+}
+
 func insertBasePixConvSubmoduleRegularC(buf *buffer) error {
 	buf.writes(embedBasePixConvSubmoduleRegularC.Trim())
 	return nil
 }
 
+func insertBasePixConvSubmoduleResampleC(buf *buffer) error {
+	buf.writes(embedBasePixConvSubmoduleResampleC.Trim())
+	return nil
+}
+
 func insertBasePixConvSubmoduleX86Avx2C(buf *buffer) error {
 	buf.writes(embedBasePixConvSubmoduleX86Avx2C.Trim())
 	return nil
@@ -97,9 +97,27 @@ var embedBaseIntConvSubmoduleC EmbeddedString
 //go:embed base/magic-submodule.c
 var embedBaseMagicSubmoduleC EmbeddedString
 
+//go:embed base/pixconv-submodule-arm-neon.c
+var embedBasePixConvSubmoduleARMNeonC EmbeddedString
+
+//go:embed base/pixconv-submodule-color.c
+var embedBasePixConvSubmoduleColorC EmbeddedString
+
+//go:embed base/pixconv-submodule-dither.c
+var embedBasePixConvSubmoduleDitherC EmbeddedString
+
+//go:embed base/pixconv-submodule-float.c
+var embedBasePixConvSubmoduleFloatC EmbeddedString
+
+//go:embed base/pixconv-submodule-quantize.c
+var embedBasePixConvSubmoduleQuantizeC EmbeddedString
+
 //go:embed base/pixconv-submodule-regular.c
 var embedBasePixConvSubmoduleRegularC EmbeddedString
 
+//go:embed base/pixconv-submodule-resample.c
+var embedBasePixConvSubmoduleResampleC EmbeddedString
+
 //go:embed base/pixconv-submodule-x86-avx2.c
 var embedBasePixConvSubmoduleX86Avx2C EmbeddedString
 
@@ -251,7 +251,9 @@ func (g *gen) couldHaveDerivedVar(n *a.Expr) bool {
 }
 
 func (g *gen) writeLoadExprDerivedVars(b *buffer, n *a.Expr) error {
-	if (g.currFunk.derivedVars != nil) && (n.Operator() == a.ExprOperatorCall) {
+	// Local io_bind variables (not just args) can have derived variables, so
+	// don't short-circuit on g.currFunk.derivedVars being nil.
+	if n.Operator() == a.ExprOperatorCall {
 		for _, o := range n.Args() {
 			if v := o.AsArg().Value(); g.couldHaveDerivedVar(v) {
 				if err := g.writeLoadDerivedVar(b, v); err != nil {
@@ -264,7 +266,9 @@ func (g *gen) writeLoadExprDerivedVars(b *buffer, n *a.Expr) error {
 }
 
 func (g *gen) writeSaveExprDerivedVars(b *buffer, n *a.Expr) error {
-	if (g.currFunk.derivedVars != nil) && (n.Operator() == a.ExprOperatorCall) {
+	// Local io_bind variables (not just args) can have derived variables, so
+	// don't short-circuit on g.currFunk.derivedVars being nil.
+	if n.Operator() == a.ExprOperatorCall {
 		for _, o := range n.Args() {
 			if v := o.AsArg().Value(); g.couldHaveDerivedVar(v) {
 				if err := g.writeSaveDerivedVar(b, v); err != nil {
@@ -146,6 +146,10 @@ var Consts = [...]struct {
 	{t.IDU32, "0xA100BBBB", "PIXEL_FORMAT__RGBA_NONPREMUL_4X16LE"},
 	{t.IDU32, "0xA2008888", "PIXEL_FORMAT__RGBA_PREMUL"},
 	{t.IDU32, "0xA200BBBB", "PIXEL_FORMAT__RGBA_PREMUL_4X16LE"},
+	{t.IDU32, "0xA208BBBB", "PIXEL_FORMAT__RGBA_PREMUL_F16"},
+	{t.IDU32, "0xA228BBBB", "PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR"},
+	{t.IDU32, "0xA208DDDD", "PIXEL_FORMAT__RGBA_PREMUL_F32"},
+	{t.IDU32, "0xA228DDDD", "PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR"},
 	{t.IDU32, "0xA3008888", "PIXEL_FORMAT__RGBA_BINARY"},
 	{t.IDU32, "0xB0008888", "PIXEL_FORMAT__RGBX"},
 
@@ -604,6 +608,13 @@ var funcsOther = [...]string{
 
 	"token_writer.length() u64",
 
+	// ---- decode_frame_options
+
+	"decode_frame_options.crop_max_excl_x() u32",
+	"decode_frame_options.crop_max_excl_y() u32",
+	"decode_frame_options.crop_min_incl_x() u32",
+	"decode_frame_options.crop_min_incl_y() u32",
+
 	// ---- frame_config
 
 	"frame_config.blend() u8",
@@ -631,12 +642,14 @@ var funcsOther = [...]string{
 	// ---- pixel_format
 
 	"pixel_format.bits_per_pixel() u32[..= 256]",
+	"pixel_format.is_planar() bool",
 
 	// ---- pixel_swizzler
 
 	"pixel_swizzler.prepare!(" +
 		"dst_pixfmt: pixel_format, dst_palette: slice u8," +
 		"src_pixfmt: pixel_format, src_palette: roslice u8, blend: pixel_blend) status",
+	"pixel_swizzler.set_decode_frame_options!(dst: ptr pixel_buffer, opts: nptr decode_frame_options) status",
 
 	"pixel_swizzler.limited_swizzle_u32_interleaved_from_reader!(" +
 		"up_to_num_pixels: u32, dst: slice u8, dst_palette: slice u8, src: io_reader) u64",
@@ -651,6 +664,9 @@ var funcsOther = [...]string{
 		"dst_palette: slice u8," +
 		"width: u32[..= 0xFFFF]," +
 		"height: u32[..= 0xFFFF]," +
+		"y_min_incl: u32," +
+		"y_max_excl: u32," +
+		"src_y_offset: u32," +
 		"src0: slice u8," +
 		"src1: slice u8," +
 		"src2: slice u8," +
@@ -728,6 +744,7 @@ var funcsOther = [...]string{
 
 	"arm_neon_utility.make_u8x8_slice64(a: roslice base.u8) arm_neon_u8x8",
 	"arm_neon_utility.make_u8x16_slice128(a: roslice base.u8) arm_neon_u8x16",
+	"arm_neon_utility.make_u16x8_slice_u16lex8(a: roslice base.u16) arm_neon_u16x8",
 
 	// ---- arm_neon_uAxB.as_uCxD
 
@@ -739,9 +756,9 @@ var funcsOther = [...]string{
 	"arm_neon_u32x2.as_u8x8() arm_neon_u8x8",
 	"arm_neon_u64x1.as_u8x8() arm_neon_u8x8",
 
-	"arm_neon_u16x8.as_u16x8() arm_neon_u16x8",
-	"arm_neon_u16x8.as_u32x4() arm_neon_u32x4",
-	"arm_neon_u16x8.as_u64x2() arm_neon_u64x2",
+	"arm_neon_u8x16.as_u16x8() arm_neon_u16x8",
+	"arm_neon_u8x16.as_u32x4() arm_neon_u32x4",
+	"arm_neon_u8x16.as_u64x2() arm_neon_u64x2",
 
 	"arm_neon_u16x8.as_u8x16() arm_neon_u8x16",
 	"arm_neon_u32x4.as_u8x16() arm_neon_u8x16",
@@ -838,6 +855,7 @@ var funcsOther = [...]string{
 	"x86_m128i._mm_sub_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sub_epi64(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_sub_epi8(b: x86_m128i) x86_m128i",
+	"x86_m128i._mm_testz_si128(b: x86_m128i) u32",
 	"x86_m128i._mm_unpackhi_epi16(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi32(b: x86_m128i) x86_m128i",
 	"x86_m128i._mm_unpackhi_epi64(b: x86_m128i) x86_m128i",
@@ -896,11 +914,13 @@ var funcsOther = [...]string{
 	"x86_m256i._mm256_add_epi8(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_and_si256(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_castsi256_si128() x86_m128i",
+	"x86_m256i._mm256_cmpeq_epi8(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_extract_epi64(index: u32) u64",
 	"x86_m256i._mm256_extracti128_si256(imm8: u32) x86_m128i",
 	"x86_m256i._mm256_inserti128_si256(b: x86_m128i, imm8: u32) x86_m256i",
 	"x86_m256i._mm256_madd_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_maddubs_epi16(b: x86_m256i) x86_m256i",
+	"x86_m256i._mm256_max_epu8(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_mullo_epi16(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_or_si256(b: x86_m256i) x86_m256i",
 	"x86_m256i._mm256_packs_epi16(b: x86_m256i) x86_m256i",
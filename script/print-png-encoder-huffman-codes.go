@@ -0,0 +1,140 @@
+// Copyright 2026 The Wuffs Authors.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+//go:build ignore
+// +build ignore
+
+package main
+
+// print-png-encoder-huffman-codes.go prints the std/png encoder's Deflate
+// fixed Huffman code tables.
+//
+// Usage: go run print-png-encoder-huffman-codes.go
+//
+// Each table element is a u32 whose high 8 bits are the number of bits to
+// emit and whose low 24 bits are those bits, in Deflate's LSB-first order.
+// Huffman codes are bit-reversed and any extra bits follow the code.
+
+import (
+	"fmt"
+	"os"
+)
+
+func main() {
+	if err := main1(); err != nil {
+		os.Stderr.WriteString(err.Error() + "\n")
+		os.Exit(1)
+	}
+}
+
+var lengthBases = [29]uint32{
+	3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+	35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+}
+
+var lengthExtras = [29]uint32{
+	0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+	3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+}
+
+var distanceBases = [8]uint32{1, 2, 3, 4, 5, 7, 9, 13}
+
+var distanceExtras = [8]uint32{0, 0, 0, 0, 1, 1, 2, 2}
+
+func reverse(x uint32, n uint32) (y uint32) {
+	for i := uint32(0); i < n; i++ {
+		y = (y << 1) | (x & 1)
+		x >>= 1
+	}
+	return y
+}
+
+// fixedLitLen returns the RFC 1951 section 3.2.6 fixed Huffman code for the
+// given literal/length symbol, not yet bit-reversed.
+func fixedLitLen(sym uint32) (code uint32, n uint32) {
+	switch {
+	case sym < 144:
+		return 0x30 + sym, 8
+	case sym < 256:
+		return 0x190 + (sym - 144), 9
+	case sym < 280:
+		return sym - 256, 7
+	}
+	return 0xC0 + (sym - 280), 8
+}
+
+func pack(bits uint32, n uint32) uint32 {
+	return (n << 24) | bits
+}
+
+func printTable(name string, values []uint32) {
+	fmt.Printf("pri const %s : roarray[%d] base.u32 = [\n", name, len(values))
+	for i, v := range values {
+		if i%8 == 0 {
+			fmt.Printf("       ")
+		}
+		fmt.Printf(" 0x%04X_%04X,", v>>16, v&0xFFFF)
+		if i%8 == 7 {
+			fmt.Println()
+		}
+	}
+	if len(values)%8 != 0 {
+		fmt.Println()
+	}
+	fmt.Printf("]\n\n")
+}
+
+func main1() error {
+	literals := make([]uint32, 256)
+	for sym := uint32(0); sym < 256; sym++ {
+		code, n := fixedLitLen(sym)
+		literals[sym] = pack(reverse(code, n), n)
+	}
+	printTable("ENCODER_LITERAL_CODES", literals)
+
+	lengths := make([]uint32, 259)
+	for i := 0; i < 29; i++ {
+		code, n := fixedLitLen(257 + uint32(i))
+		rev := reverse(code, n)
+		hi := uint32(259)
+		if i+1 < 29 {
+			hi = lengthBases[i+1]
+		}
+		if lengthBases[i] == 258 {
+			hi = 259
+		} else if hi > 258 {
+			hi = 258
+		}
+		for length := lengthBases[i]; length < hi; length++ {
+			extra := length - lengthBases[i]
+			lengths[length] = pack(rev|(extra<<n), n+lengthExtras[i])
+		}
+	}
+	printTable("ENCODER_LENGTH_CODES", lengths)
+
+	distances := make([]uint32, 9)
+	for i := 0; i < 8; i++ {
+		rev := reverse(uint32(i), 5)
+		for d := distanceBases[i]; d < distanceBases[i]+(1<<distanceExtras[i]); d++ {
+			if d > 8 {
+				break
+			}
+			extra := d - distanceBases[i]
+			distances[d] = pack(rev|(extra<<5), 5+distanceExtras[i])
+		}
+	}
+	printTable("ENCODER_DISTANCE_CODES", distances)
+
+	return nil
+}
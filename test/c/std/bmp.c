@@ -129,6 +129,110 @@ test_wuffs_bmp_decode_truncated_input() {
   return NULL;
 }
 
+// flip_bmp_rows converts an uncompressed bottom-up BMP image to top-down (or
+// vice versa), negating its height and reversing the order of its rows.
+const char*  //
+flip_bmp_rows(wuffs_base__io_buffer* src) {
+  uint8_t* p = src->data.ptr;
+  if (src->meta.wi < 34) {
+    return "flip_bmp_rows: short header";
+  }
+  uint32_t offset = wuffs_base__peek_u32le__no_bounds_check(p + 10);
+  uint32_t width = wuffs_base__peek_u32le__no_bounds_check(p + 18);
+  uint32_t height = wuffs_base__peek_u32le__no_bounds_check(p + 22);
+  uint32_t bits_per_pixel = wuffs_base__peek_u16le__no_bounds_check(p + 28);
+  if ((int32_t)height < 0) {
+    height = 0 - height;
+  }
+  size_t row_len = 4 * (((width * bits_per_pixel) + 31) / 32);
+  uint8_t tmp[4096];
+  if ((row_len > sizeof(tmp)) ||
+      (src->meta.wi < (offset + (height * row_len)))) {
+    return "flip_bmp_rows: unsupported image";
+  }
+  wuffs_base__poke_u32le__no_bounds_check(
+      p + 22, 0 - wuffs_base__peek_u32le__no_bounds_check(p + 22));
+  for (uint32_t y = 0; y < (height / 2); y++) {
+    uint8_t* r0 = p + offset + (y * row_len);
+    uint8_t* r1 = p + offset + ((height - 1 - y) * row_len);
+    memcpy(tmp, r0, row_len);
+    memcpy(r0, r1, row_len);
+    memcpy(r1, tmp, row_len);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_bmp_decode_crop() {
+  CHECK_FOCUS(__func__);
+
+  // Only uncompressed BMP images honor the crop rectangle. The others (RLE,
+  // low bit depth and non-trivial bitfields) decode the whole frame. The
+  // hibiscus.primitive.bmp bitfields are trivial (equivalent to BGRX).
+  struct {
+    const char* filename;
+    bool flip_rows;
+    bool want_cropped;
+  } test_cases[] = {
+      {.filename = "test/data/bricks-dither.bmp",
+       .flip_rows = false,
+       .want_cropped = false},
+      {.filename = "test/data/hibiscus.primitive.bmp",
+       .flip_rows = false,
+       .want_cropped = true},
+      {.filename = "test/data/hibiscus.regular.bmp",
+       .flip_rows = false,
+       .want_cropped = true},
+      {.filename = "test/data/hippopotamus.bmp",
+       .flip_rows = false,
+       .want_cropped = true},
+      {.filename = "test/data/hippopotamus.bmp",
+       .flip_rows = true,
+       .want_cropped = true},
+      {.filename = "test/data/pjw-thumbnail.bmp",
+       .flip_rows = false,
+       .want_cropped = false},
+  };
+
+  wuffs_base__rect_ie_u32 crops[] = {
+      wuffs_base__make_rect_ie_u32(0, 0, 16, 16),
+      wuffs_base__make_rect_ie_u32(13, 27, 51, 48),
+      wuffs_base__make_rect_ie_u32(20, 5, 30, 1000),
+      wuffs_base__make_rect_ie_u32(40, 60, 1000, 1000),
+      wuffs_base__make_rect_ie_u32(1000, 1000, 2000, 2000),
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, test_cases[tc].filename));
+    if (test_cases[tc].flip_rows) {
+      CHECK_STRING(flip_bmp_rows(&src));
+    }
+
+    for (size_t c = 0; c < WUFFS_TESTLIB_ARRAY_SIZE(crops); c++) {
+      wuffs_bmp__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_bmp__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_crop_src(
+          wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_bmp__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          &src, crops[c], test_cases[tc].want_cropped);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), c=%zu: %s", tc, test_cases[tc].filename, c,
+                    z);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_bmp_decode_frame_config() {
   CHECK_FOCUS(__func__);
@@ -238,6 +342,7 @@ bench_wuffs_bmp_decode_40k() {
 
 proc g_tests[] = {
 
+    test_wuffs_bmp_decode_crop,
     test_wuffs_bmp_decode_frame_config,
     test_wuffs_bmp_decode_interface,
     test_wuffs_bmp_decode_io_redirect,
@@ -2253,6 +2253,24 @@ bench_wuffs_gif_decode_anim_screencap() {
       NULL, 0, "test/data/gifplayer-muybridge.gif", 0, SIZE_MAX, 1);
 }
 
+const char*  //
+bench_wuffs_gif_decode_anim_src_over_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      wuffs_gif_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/muybridge.gif", 0, SIZE_MAX, 5);
+}
+
+const char*  //
+bench_wuffs_gif_decode_anim_src_over_premul() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      wuffs_gif_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL),
+      NULL, 0, "test/data/muybridge.gif", 0, SIZE_MAX, 5);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -2428,6 +2446,8 @@ proc g_benches[] = {
     bench_wuffs_gif_decode_1000k_full_init,
     bench_wuffs_gif_decode_1000k_part_init,
     bench_wuffs_gif_decode_anim_screencap,
+    bench_wuffs_gif_decode_anim_src_over_nonpremul,
+    bench_wuffs_gif_decode_anim_src_over_premul,
 
 #ifdef WUFFS_MIMIC
 
@@ -763,6 +763,866 @@ test_wuffs_jpeg_decode_mcu() {
   return NULL;
 }
 
+// do_test_wuffs_jpeg_decode_restart_interval_partition checks that decoding
+// the image in num_parts parts, sharing one workbuf, and then calling
+// swizzle_frame gives the same pixels as decoding it in one go.
+const char*  //
+do_test_wuffs_jpeg_decode_restart_interval_partition(wuffs_base__io_buffer* src,
+                                                     uint32_t num_parts) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(&dec, &ic, src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+  uint64_t workbuf_len = wuffs_jpeg__decoder__workbuf_len(&dec).max_incl;
+  if ((n > g_want_slice_u8.len) || (n > g_have_slice_u8.len)) {
+    RETURN_FAIL("pixbuf_len: %" PRIu64 " is too large", n);
+  } else if (workbuf_len > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len: %" PRIu64 " is too large", workbuf_len);
+  }
+
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &want_pb, &ic.pixcfg, g_want_slice_u8));
+  CHECK_STATUS("decode_frame (want)",
+               wuffs_jpeg__decoder__decode_frame(
+                   &dec, &want_pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   g_work_slice_u8, NULL));
+
+  // Set the workbuf and destination to arbitrary non-zero bytes, so that any
+  // unwritten bytes are more likely to cause a test failure.
+  memset(g_work_slice_u8.ptr, 0x5A, workbuf_len);
+  memset(g_have_slice_u8.ptr, 0xA5, n);
+  wuffs_base__pixel_buffer have_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &have_pb, &ic.pixcfg, g_have_slice_u8));
+
+  // Decode the parts in reverse order, so that dec (used by swizzle_frame)
+  // holds part 0. Each part's decoder starts from the beginning of src.
+  for (uint32_t i = 0; i < num_parts; i++) {
+    uint32_t part = num_parts - 1 - i;
+    src->meta.ri = 0;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_restart_interval_partition",
+                 wuffs_jpeg__decoder__set_restart_interval_partition(
+                     &dec, num_parts, part));
+    CHECK_STATUS("decode_frame (have)",
+                 wuffs_jpeg__decoder__decode_frame(
+                     &dec, &have_pb, src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     g_work_slice_u8, NULL));
+    if (g_have_slice_u8.ptr[0] != 0xA5) {
+      RETURN_FAIL("part %" PRIu32 ": decode_frame wrote to the destination",
+                  part);
+    }
+  }
+  CHECK_STATUS("swizzle_frame",
+               wuffs_jpeg__decoder__swizzle_frame(
+                   &dec, &have_pb, WUFFS_BASE__PIXEL_BLEND__SRC,
+                   wuffs_base__make_slice_u8(g_work_slice_u8.ptr,
+                                             (size_t)workbuf_len)));
+
+  wuffs_base__io_buffer have =
+      wuffs_base__ptr_u8__reader(g_have_slice_u8.ptr, n, true);
+  wuffs_base__io_buffer want =
+      wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, n, true);
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_jpeg_decode_restart_interval_partition() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    const char* filename;
+    uint32_t num_parts;
+  } test_cases[] = {
+      {.filename = "test/data/bricks-color.restart-interval-3.jpeg",
+       .num_parts = 1},
+      {.filename = "test/data/bricks-color.restart-interval-3.jpeg",
+       .num_parts = 4},
+      {.filename = "test/data/bricks-color.restart-interval-3.jpeg",
+       .num_parts = 100},
+      {.filename = "test/data/bricks-gray.jpeg", .num_parts = 2},
+      {.filename = "test/data/peacock.progressive.jpeg", .num_parts = 3},
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, test_cases[tc].filename));
+    const char* z = do_test_wuffs_jpeg_decode_restart_interval_partition(
+        &src, test_cases[tc].num_parts);
+    if (z) {
+      RETURN_FAIL("tc=%zu (%s, %" PRIu32 " parts): %s", tc,
+                  test_cases[tc].filename, test_cases[tc].num_parts, z);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_restart_interval_partition_bad_argument() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    uint32_t num_parts;
+    uint32_t part;
+    bool ok;
+  } test_cases[] = {
+      {.num_parts = 0, .part = 0, .ok = true},
+      {.num_parts = 0, .part = 1, .ok = false},
+      {.num_parts = 1, .part = 0, .ok = true},
+      {.num_parts = 1, .part = 1, .ok = false},
+      {.num_parts = 4, .part = 3, .ok = true},
+      {.num_parts = 4, .part = 4, .ok = false},
+      {.num_parts = 4, .part = 0xFFFFFFFF, .ok = false},
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__status status =
+        wuffs_jpeg__decoder__set_restart_interval_partition(
+            &dec, test_cases[tc].num_parts, test_cases[tc].part);
+    const char* want =
+        test_cases[tc].ok ? NULL : wuffs_base__error__bad_argument;
+    if (status.repr != want) {
+      RETURN_FAIL("tc=%zu: have \"%s\", want \"%s\"", tc, status.repr, want);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_restart_interval_partition_truncated() {
+  CHECK_FOCUS(__func__);
+
+  const uint32_t num_parts = 3;
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(
+      read_file(&src, "test/data/bricks-color.restart-interval-3.jpeg"));
+  const size_t truncated_len = src.meta.wi / 2;
+
+  // Cutting the entropy-coded data short, but still ending with an EOI
+  // marker, implicitly zero-pads the scan. Every part's remaining MCUs are
+  // still written to the workbuf, so the pixels should match.
+  src.meta.wi = truncated_len;
+  src.data.ptr[src.meta.wi++] = 0xFF;
+  src.data.ptr[src.meta.wi++] = 0xD9;
+  CHECK_STRING(
+      do_test_wuffs_jpeg_decode_restart_interval_partition(&src, num_parts));
+
+  // Without the EOI marker, every part fails and swizzle_frame should not
+  // write anything.
+  src.meta.wi = truncated_len;
+  uint64_t workbuf_len = 0;
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  wuffs_jpeg__decoder dec;
+  for (uint32_t i = 0; i < num_parts; i++) {
+    uint32_t part = num_parts - 1 - i;
+    src.meta.ri = 0;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_restart_interval_partition",
+                 wuffs_jpeg__decoder__set_restart_interval_partition(
+                     &dec, num_parts, part));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+    uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    workbuf_len = wuffs_jpeg__decoder__workbuf_len(&dec).max_incl;
+    if (n > g_have_slice_u8.len) {
+      RETURN_FAIL("pixbuf_len: %" PRIu64 " is too large", n);
+    } else if (workbuf_len > g_work_slice_u8.len) {
+      RETURN_FAIL("workbuf_len: %" PRIu64 " is too large", workbuf_len);
+    }
+    memset(g_have_slice_u8.ptr, 0xA5, n);
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, g_have_slice_u8));
+    wuffs_base__status status = wuffs_jpeg__decoder__decode_frame(
+        &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, NULL);
+    if (status.repr != wuffs_jpeg__error__truncated_input) {
+      RETURN_FAIL("part %" PRIu32 ": decode_frame: have \"%s\", want \"%s\"",
+                  part, status.repr, wuffs_jpeg__error__truncated_input);
+    }
+  }
+  wuffs_base__status status = wuffs_jpeg__decoder__swizzle_frame(
+      &dec, &pb, WUFFS_BASE__PIXEL_BLEND__SRC,
+      wuffs_base__make_slice_u8(g_work_slice_u8.ptr, (size_t)workbuf_len));
+  if (wuffs_base__status__is_ok(&status)) {
+    RETURN_FAIL("swizzle_frame: have ok, want an error");
+  } else if (g_have_slice_u8.ptr[0] != 0xA5) {
+    RETURN_FAIL("swizzle_frame wrote to the destination");
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_restart_interval_partition_unscanned_component() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-gray.jpeg"));
+
+  // Patch the 1-component SOF0 marker (at offset 0x59) to declare 3
+  // components, sharing the same quantization table. The only scan still
+  // covers only the first one, so the Cb and Cr components are never
+  // decoded. An unpartitioned decode leaves them as 0x80 (medium gray).
+  static const uint8_t old_sof[13] = {
+      0xFF, 0xC0, 0x00, 0x0B, 0x08, 0x00, 0x78,
+      0x00, 0xA0, 0x01, 0x01, 0x11, 0x00,
+  };
+  static const uint8_t new_sof[19] = {
+      0xFF, 0xC0, 0x00, 0x11, 0x08, 0x00, 0x78, 0x00, 0xA0, 0x03,
+      0x01, 0x11, 0x00, 0x02, 0x11, 0x00, 0x03, 0x11, 0x00,
+  };
+  const size_t sof_offset = 0x59;
+  const size_t delta = sizeof(new_sof) - sizeof(old_sof);
+  if ((src.meta.wi < (sof_offset + sizeof(old_sof))) ||
+      memcmp(src.data.ptr + sof_offset, old_sof, sizeof(old_sof))) {
+    RETURN_FAIL("unexpected SOF marker");
+  } else if ((src.data.len - src.meta.wi) < delta) {
+    RETURN_FAIL("src buffer is too small");
+  }
+  memmove(src.data.ptr + sof_offset + sizeof(new_sof),
+          src.data.ptr + sof_offset + sizeof(old_sof),
+          src.meta.wi - (sof_offset + sizeof(old_sof)));
+  memcpy(src.data.ptr + sof_offset, new_sof, sizeof(new_sof));
+  src.meta.wi += delta;
+
+  return do_test_wuffs_jpeg_decode_restart_interval_partition(&src, 2);
+}
+
+// do_test_wuffs_jpeg_decode_scaled checks that decoding the image with the
+// QUIRK_SCALE_DENOMINATOR set gives the scaled-down dimensions and pixels
+// that are close to a box-filtered full-size decode. Chroma subsampled images
+// differ more, as their chroma is upsampled from fewer samples.
+const char*  //
+do_test_wuffs_jpeg_decode_scaled(const char* filename,
+                                 uint32_t denominator,
+                                 uint64_t max_mean_diff_x100) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__pixel_config pixcfgs[2];
+  uint32_t dens[2] = {1, denominator};
+  wuffs_base__slice_u8 dsts[2] = {g_want_slice_u8, g_have_slice_u8};
+  for (int i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_quirk",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_JPEG__QUIRK_SCALE_DENOMINATOR, dens[i]));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+    pixcfgs[i] = ic.pixcfg;
+
+    uint64_t workbuf_len = wuffs_jpeg__decoder__workbuf_len(&dec).max_incl;
+    if (wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg) > dsts[i].len) {
+      RETURN_FAIL("i=%d: pixbuf_len is too large", i);
+    } else if (workbuf_len > g_work_slice_u8.len) {
+      RETURN_FAIL("i=%d: workbuf_len is too large", i);
+    }
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, dsts[i]));
+    CHECK_STATUS("decode_frame",
+                 wuffs_jpeg__decoder__decode_frame(
+                     &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     g_work_slice_u8, NULL));
+  }
+
+  uint32_t full_w = wuffs_base__pixel_config__width(&pixcfgs[0]);
+  uint32_t full_h = wuffs_base__pixel_config__height(&pixcfgs[0]);
+  uint32_t have_w = wuffs_base__pixel_config__width(&pixcfgs[1]);
+  uint32_t have_h = wuffs_base__pixel_config__height(&pixcfgs[1]);
+  uint32_t want_w = (full_w + denominator - 1) / denominator;
+  uint32_t want_h = (full_h + denominator - 1) / denominator;
+  if ((have_w != want_w) || (have_h != want_h)) {
+    RETURN_FAIL("dimensions: have %" PRIu32 "x%" PRIu32 ", want %" PRIu32
+                "x%" PRIu32,
+                have_w, have_h, want_w, want_h);
+  }
+
+  // Compare each scaled pixel to the average of its full-size pixels.
+  uint64_t total_diff = 0;
+  for (uint32_t y = 0; y < have_h; y++) {
+    for (uint32_t x = 0; x < have_w; x++) {
+      for (uint32_t c = 0; c < 4; c++) {
+        uint32_t sum = 0;
+        uint32_t count = 0;
+        for (uint32_t fy = y * denominator;
+             (fy < full_h) && (fy < ((y + 1) * denominator)); fy++) {
+          for (uint32_t fx = x * denominator;
+               (fx < full_w) && (fx < ((x + 1) * denominator)); fx++) {
+            sum += g_want_slice_u8.ptr[(4 * ((fy * full_w) + fx)) + c];
+            count++;
+          }
+        }
+        int32_t want = (int32_t)((sum + (count / 2)) / count);
+        int32_t have = g_have_slice_u8.ptr[(4 * ((y * have_w) + x)) + c];
+        total_diff += (uint64_t)((have > want) ? (have - want) : (want - have));
+      }
+    }
+  }
+  uint64_t mean_diff_x100 = (100 * total_diff) / (4 * have_w * have_h);
+  if (mean_diff_x100 > max_mean_diff_x100) {
+    RETURN_FAIL("mean difference (x100): have %" PRIu64 ", want <= %" PRIu64,
+                mean_diff_x100, max_mean_diff_x100);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_scaled() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    const char* filename;
+    uint64_t max_mean_diff_x100;
+  } test_cases[] = {
+      {.filename = "test/data/bricks-color.jpeg", .max_mean_diff_x100 = 1000},
+      {.filename = "test/data/bricks-gray.jpeg", .max_mean_diff_x100 = 100},
+      {.filename = "test/data/hippopotamus.jpeg", .max_mean_diff_x100 = 300},
+      {.filename = "test/data/peacock.progressive.jpeg",
+       .max_mean_diff_x100 = 700},
+      {.filename = "test/data/peacock.s-very-weird.jpeg",
+       .max_mean_diff_x100 = 1200},
+      {.filename = "test/data/peacock.s1x1-444.jpeg",
+       .max_mean_diff_x100 = 100},
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    for (uint32_t d = 2; d <= 8; d *= 2) {
+      const char* z = do_test_wuffs_jpeg_decode_scaled(
+          test_cases[tc].filename, d, test_cases[tc].max_mean_diff_x100);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s, 1/%" PRIu32 "): %s", tc,
+                    test_cases[tc].filename, d, z);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_color_transform() {
+  CHECK_FOCUS(__func__);
+
+  uint8_t icc_array[1024];
+  wuffs_base__io_buffer icc = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(icc_array, sizeof icc_array),
+  });
+  CHECK_STRING(read_file(&icc, "test/data/DCI-P3-D65.icc"));
+  wuffs_base__color_transform t;
+  CHECK_STATUS("set_from_icc_profile",
+               wuffs_base__color_transform__set_from_icc_profile(
+                   &t, wuffs_base__io_buffer__reader_slice(&icc)));
+
+  const char* filenames[] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-gray.jpeg",
+      "test/data/hippopotamus.jpeg",
+      "test/data/peacock.progressive.jpeg",
+      "test/data/peacock.s1x3.jpeg",
+  };
+
+  uint32_t pixfmts[] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__RGBX,
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (size_t p = 0; p < WUFFS_TESTLIB_ARRAY_SIZE(pixfmts); p++) {
+      wuffs_jpeg__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_jpeg__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_color_transform(
+          wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          filenames[tc], pixfmts[p], &t);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), p=%zu: %s", tc, filenames[tc], p, z);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_crop() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-color.restart-interval-3.jpeg",
+      "test/data/bricks-gray.jpeg",
+      "test/data/hippopotamus.jpeg",
+      "test/data/peacock.progressive.jpeg",
+      "test/data/peacock.s-very-weird.jpeg",
+      "test/data/peacock.s1x3.jpeg",
+      "test/data/peacock.s2x2-420.jpeg",
+  };
+
+  wuffs_base__rect_ie_u32 crops[] = {
+      wuffs_base__make_rect_ie_u32(0, 0, 16, 16),
+      wuffs_base__make_rect_ie_u32(13, 27, 51, 48),
+      wuffs_base__make_rect_ie_u32(40, 60, 1000, 1000),
+      wuffs_base__make_rect_ie_u32(1000, 1000, 2000, 2000),
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (size_t c = 0; c < WUFFS_TESTLIB_ARRAY_SIZE(crops); c++) {
+      wuffs_jpeg__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_jpeg__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_crop(
+          wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_jpeg__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          filenames[tc], crops[c]);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), c=%zu: %s", tc, filenames[tc], c, z);
+      }
+    }
+  }
+  return NULL;
+}
+
+// do_test_wuffs_jpeg_decode_band_streaming checks that decoding the image
+// with the QUIRK_BAND_STREAMING set and the smallest workbuf gives the same
+// pixels as decoding with the largest workbuf.
+const char*  //
+do_test_wuffs_jpeg_decode_band_streaming(const char* filename,
+                                         uint32_t denominator) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__range_ii_u64 workbuf_lens[2];
+  wuffs_base__slice_u8 dsts[2] = {g_want_slice_u8, g_have_slice_u8};
+  size_t pixbuf_len = 0;
+  for (int i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_quirk #0",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_JPEG__QUIRK_SCALE_DENOMINATOR, denominator));
+    CHECK_STATUS("set_quirk #1",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_JPEG__QUIRK_BAND_STREAMING, i));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+
+    workbuf_lens[i] = wuffs_jpeg__decoder__workbuf_len(&dec);
+    pixbuf_len = (size_t)wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if (pixbuf_len > dsts[i].len) {
+      RETURN_FAIL("i=%d: pixbuf_len is too large", i);
+    } else if (workbuf_lens[i].max_incl > g_work_slice_u8.len) {
+      RETURN_FAIL("i=%d: workbuf_len is too large", i);
+    }
+    memset(dsts[i].ptr, 0, pixbuf_len);
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, dsts[i]));
+    CHECK_STATUS("decode_frame",
+                 wuffs_jpeg__decoder__decode_frame(
+                     &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     wuffs_base__make_slice_u8(g_work_slice_u8.ptr,
+                                               workbuf_lens[i].min_incl),
+                     NULL));
+  }
+
+  if (workbuf_lens[0].min_incl != workbuf_lens[0].max_incl) {
+    RETURN_FAIL("workbuf_len without the quirk: have [%" PRIu64 " ..= %" PRIu64
+                "], want equal bounds",
+                workbuf_lens[0].min_incl, workbuf_lens[0].max_incl);
+  } else if (workbuf_lens[1].max_incl != workbuf_lens[0].max_incl) {
+    RETURN_FAIL("workbuf_len.max_incl: have %" PRIu64 ", want %" PRIu64,
+                workbuf_lens[1].max_incl, workbuf_lens[0].max_incl);
+  } else if ((workbuf_lens[1].min_incl >= workbuf_lens[1].max_incl) &&
+             (strstr(filename, "progressive") == NULL)) {
+    RETURN_FAIL("workbuf_len.min_incl: have %" PRIu64 ", want < %" PRIu64,
+                workbuf_lens[1].min_incl, workbuf_lens[1].max_incl);
+  }
+
+  for (size_t j = 0; j < pixbuf_len; j++) {
+    if (g_have_slice_u8.ptr[j] != g_want_slice_u8.ptr[j]) {
+      RETURN_FAIL("pixels differ at byte offset %zu: have 0x%02X, want 0x%02X",
+                  j, g_have_slice_u8.ptr[j], g_want_slice_u8.ptr[j]);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_band_streaming() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/bricks-color.restart-interval-3.jpeg",
+      "test/data/bricks-gray.jpeg",
+      "test/data/hippopotamus.jpeg",
+      "test/data/peacock.progressive.jpeg",
+      "test/data/peacock.s-very-weird.jpeg",
+      "test/data/peacock.s1x1-444.jpeg",
+      "test/data/peacock.s1x3.jpeg",
+      "test/data/peacock.s2x1-422.jpeg",
+      "test/data/peacock.s2x2-420.jpeg",
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (uint32_t d = 1; d <= 8; d *= 2) {
+      const char* z =
+          do_test_wuffs_jpeg_decode_band_streaming(filenames[tc], d);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s, 1/%" PRIu32 "): %s", tc, filenames[tc], d, z);
+      }
+    }
+  }
+  return NULL;
+}
+
+// do_test_wuffs_jpeg_decode_planar checks that decoding the image to planar
+// YCbCr, with the native pixel subsampling, and then converting those planes
+// to BGRX gives the same pixels as decoding straight to BGRX.
+const char*  //
+do_test_wuffs_jpeg_decode_planar(const char* filename, bool band_streaming) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_base__pixel_buffer pbs[2];
+  size_t pixbuf_lens[2] = {0};
+  wuffs_base__slice_u8 dsts[2] = {g_want_slice_u8, g_have_slice_u8};
+  for (int i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_jpeg__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_jpeg__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("set_quirk",
+                 wuffs_jpeg__decoder__set_quirk(
+                     &dec, WUFFS_JPEG__QUIRK_BAND_STREAMING, band_streaming));
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+    uint32_t pixsub =
+        wuffs_base__pixel_config__pixel_subsampling(&ic.pixcfg).repr;
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg,
+        i ? WUFFS_BASE__PIXEL_FORMAT__YCBCR : WUFFS_BASE__PIXEL_FORMAT__BGRX,
+        i ? pixsub : WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+
+    wuffs_base__range_ii_u64 workbuf_len =
+        wuffs_jpeg__decoder__workbuf_len(&dec);
+    pixbuf_lens[i] = (size_t)wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if ((pixbuf_lens[i] == 0) || (pixbuf_lens[i] > dsts[i].len)) {
+      RETURN_FAIL("i=%d: bad pixbuf_len", i);
+    } else if (workbuf_len.max_incl > g_work_slice_u8.len) {
+      RETURN_FAIL("i=%d: workbuf_len is too large", i);
+    }
+    memset(dsts[i].ptr, 0, pixbuf_lens[i]);
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pbs[i], &ic.pixcfg, dsts[i]));
+    CHECK_STATUS("decode_frame",
+                 wuffs_jpeg__decoder__decode_frame(
+                     &dec, &pbs[i], &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                     wuffs_base__make_slice_u8(g_work_slice_u8.ptr,
+                                               workbuf_len.min_incl),
+                     NULL));
+  }
+
+  // The planes are tightly packed: the Y plane is width × height bytes.
+  uint32_t width = wuffs_base__pixel_config__width(&pbs[1].pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&pbs[1].pixcfg);
+  if ((pbs[1].private_impl.planes[0].width != width) ||
+      (pbs[1].private_impl.planes[0].height != height) ||
+      (pbs[1].private_impl.planes[1].ptr !=
+       (pbs[1].private_impl.planes[0].ptr + (width * height)))) {
+    RETURN_FAIL("Y plane: bad dimensions");
+  }
+
+  // Convert the planes to BGRX, re-using the workbuf memory.
+  wuffs_base__pixel_subsampling pixsub = pbs[1].pixcfg.private_impl.pixsub;
+  uint32_t max_incl_dx = 0;
+  uint32_t max_incl_dy = 0;
+  for (uint32_t p = 0; p < 3; p++) {
+    max_incl_dx = wuffs_base__u32__max(
+        max_incl_dx, wuffs_base__pixel_subsampling__denominator_x(&pixsub, p));
+    max_incl_dy = wuffs_base__u32__max(
+        max_incl_dy, wuffs_base__pixel_subsampling__denominator_y(&pixsub, p));
+  }
+  wuffs_base__slice_u8 planes[3];
+  uint8_t hs[3];
+  uint8_t vs[3];
+  for (uint32_t p = 0; p < 3; p++) {
+    wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pbs[1], p);
+    planes[p] = wuffs_base__make_slice_u8(tab.ptr, tab.width * tab.height);
+    hs[p] = (uint8_t)(max_incl_dx /
+                      wuffs_base__pixel_subsampling__denominator_x(&pixsub, p));
+    vs[p] = (uint8_t)(max_incl_dy /
+                      wuffs_base__pixel_subsampling__denominator_y(&pixsub, p));
+  }
+
+  wuffs_base__pixel_config bgrx_pixcfg;
+  wuffs_base__pixel_config__set(&bgrx_pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRX,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer bgrx_pb;
+  CHECK_STATUS("set_from_slice (BGRX)",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &bgrx_pb, &bgrx_pixcfg, g_work_slice_u8));
+  uint8_t scratch_buffer_2k[2048];
+  wuffs_base__pixel_swizzler swizzler = ((wuffs_base__pixel_swizzler){});
+  CHECK_STATUS(
+      "swizzle_ycck",
+      wuffs_base__pixel_swizzler__swizzle_ycck(
+          &swizzler, &bgrx_pb, wuffs_base__empty_slice_u8(), width, height, 0,
+          height, 0, planes[0], planes[1], planes[2],
+          wuffs_base__empty_slice_u8(),                                     //
+          (uint32_t)pbs[1].private_impl.planes[0].width,                    //
+          (uint32_t)pbs[1].private_impl.planes[1].width,                    //
+          (uint32_t)pbs[1].private_impl.planes[2].width, 0,                 //
+          (uint32_t)pbs[1].private_impl.planes[0].height,                   //
+          (uint32_t)pbs[1].private_impl.planes[1].height,                   //
+          (uint32_t)pbs[1].private_impl.planes[2].height, 0,                //
+          (uint32_t)pbs[1].private_impl.planes[0].stride,                   //
+          (uint32_t)pbs[1].private_impl.planes[1].stride,                   //
+          (uint32_t)pbs[1].private_impl.planes[2].stride, 0,                //
+          hs[0], hs[1], hs[2], 0, vs[0], vs[1], vs[2], 0, false, true,      //
+          wuffs_base__make_slice_u8(scratch_buffer_2k, 2048)));
+
+  for (size_t j = 0; j < pixbuf_lens[0]; j++) {
+    if (g_work_slice_u8.ptr[j] != g_want_slice_u8.ptr[j]) {
+      RETURN_FAIL("pixels differ at byte offset %zu: have 0x%02X, want 0x%02X",
+                  j, g_work_slice_u8.ptr[j], g_want_slice_u8.ptr[j]);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_jpeg_decode_planar() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[] = {
+      "test/data/bricks-color.jpeg",
+      "test/data/hippopotamus.jpeg",
+      "test/data/peacock.progressive.jpeg",
+      "test/data/peacock.s1x1-444.jpeg",
+      "test/data/peacock.s1x3.jpeg",
+      "test/data/peacock.s2x1-422.jpeg",
+      "test/data/peacock.s2x2-420.jpeg",
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (int b = 0; b < 2; b++) {
+      const char* z = do_test_wuffs_jpeg_decode_planar(filenames[tc], b);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), b=%d: %s", tc, filenames[tc], b, z);
+      }
+    }
+  }
+
+  // Grayscale JPEGs have no planar YCbCr form.
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/bricks-gray.jpeg"));
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_config__set(&ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__YCBCR,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__444,
+                                wuffs_base__pixel_config__width(&ic.pixcfg),
+                                wuffs_base__pixel_config__height(&ic.pixcfg));
+  wuffs_base__pixel_buffer pb;
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_have_slice_u8));
+  wuffs_base__status status = wuffs_jpeg__decoder__decode_frame(
+      &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, NULL);
+  if (status.repr != wuffs_base__error__unsupported_pixel_swizzler_option) {
+    RETURN_FAIL("decode_frame (gray): have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  return NULL;
+}
+
+// do_test_wuffs_jpeg_decode_preview decodes src into dst, with the given
+// QUIRK_PROGRESSIVE_PREVIEW_SCANS value, expecting want_status. It sets
+// *dirty to whether the frame_dirty_rect is non-empty afterwards and
+// *pixbuf_len to the number of dst bytes used.
+const char*  //
+do_test_wuffs_jpeg_decode_preview(wuffs_base__slice_u8 dst,
+                                  wuffs_base__io_buffer* src,
+                                  uint64_t preview_scans,
+                                  const char* want_status,
+                                  bool* dirty,
+                                  size_t* pixbuf_len) {
+  wuffs_jpeg__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_jpeg__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  CHECK_STATUS("set_quirk",
+               wuffs_jpeg__decoder__set_quirk(
+                   &dec, WUFFS_JPEG__QUIRK_PROGRESSIVE_PREVIEW_SCANS,
+                   preview_scans));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_jpeg__decoder__decode_image_config(&dec, &ic, src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  *pixbuf_len = (size_t)wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+  if (*pixbuf_len > dst.len) {
+    RETURN_FAIL("pixbuf_len is too large");
+  }
+  memset(dst.ptr, 0, *pixbuf_len);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(&pb, &ic.pixcfg, dst));
+
+  wuffs_base__status status = wuffs_jpeg__decoder__decode_frame(
+      &dec, &pb, src, WUFFS_BASE__PIXEL_BLEND__SRC, g_work_slice_u8, NULL);
+  if (status.repr != want_status) {
+    RETURN_FAIL("decode_frame: have \"%s\", want \"%s\"", status.repr,
+                want_status);
+  }
+  wuffs_base__rect_ie_u32 r = wuffs_jpeg__decoder__frame_dirty_rect(&dec);
+  *dirty = !wuffs_base__rect_ie_u32__is_empty(&r);
+  return NULL;
+}
+
+// test_wuffs_jpeg_decode_progressive_preview checks that, after each Scan, the
+// preview pixels for a partially received image match the pixels for the
+// peacock.progressive.scanNNN.jpeg file, which is the same image truncated
+// after that Scan (with an EOI marker appended).
+const char*  //
+test_wuffs_jpeg_decode_progressive_preview() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+
+  for (uint32_t n = 0; n < 9; n++) {
+    char filename[64];
+    snprintf(filename, sizeof filename,
+             "test/data/peacock.progressive.scan%03" PRIu32 ".jpeg", n);
+    src.meta = wuffs_base__empty_io_buffer_meta();
+    CHECK_STRING(read_file(&src, filename));
+    size_t prefix_len = src.meta.wi;
+    bool dirty = false;
+    size_t pixbuf_len = 0;
+    CHECK_STRING(do_test_wuffs_jpeg_decode_preview(
+        g_want_slice_u8, &src, 1ull << n, NULL, &dirty, &pixbuf_len));
+
+    // Feed the full image's first prefix_len bytes: the n'th Scan plus the
+    // two bytes of the next marker. That Scan is complete but the decoder
+    // needs more input to go any further.
+    src.meta = wuffs_base__empty_io_buffer_meta();
+    CHECK_STRING(read_file(&src, "test/data/peacock.progressive.jpeg"));
+    src.meta.wi = prefix_len;
+    src.meta.closed = false;
+    CHECK_STRING(do_test_wuffs_jpeg_decode_preview(
+        g_have_slice_u8, &src, 1ull << n, wuffs_base__suspension__short_read,
+        &dirty, &pixbuf_len));
+    if (!dirty) {
+      RETURN_FAIL("n=%" PRIu32 ": selected scan: have clean, want dirty", n);
+    }
+    for (size_t j = 0; j < pixbuf_len; j++) {
+      if (g_have_slice_u8.ptr[j] != g_want_slice_u8.ptr[j]) {
+        RETURN_FAIL("n=%" PRIu32 ": pixels differ at byte offset %zu", n, j);
+      }
+    }
+
+    // Select only a later Scan. No preview should be rendered yet.
+    src.meta.ri = 0;
+    CHECK_STRING(do_test_wuffs_jpeg_decode_preview(
+        g_have_slice_u8, &src, 2ull << n, wuffs_base__suspension__short_read,
+        &dirty, &pixbuf_len));
+    if (dirty) {
+      RETURN_FAIL("n=%" PRIu32 ": unselected scan: have dirty, want clean", n);
+    }
+  }
+  return NULL;
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -992,6 +1852,16 @@ proc g_tests[] = {
     test_wuffs_jpeg_decode_idct,
     test_wuffs_jpeg_decode_mcu,
     test_wuffs_jpeg_decode_interface,
+    test_wuffs_jpeg_decode_band_streaming,
+    test_wuffs_jpeg_decode_color_transform,
+    test_wuffs_jpeg_decode_crop,
+    test_wuffs_jpeg_decode_planar,
+    test_wuffs_jpeg_decode_progressive_preview,
+    test_wuffs_jpeg_decode_restart_interval_partition,
+    test_wuffs_jpeg_decode_restart_interval_partition_bad_argument,
+    test_wuffs_jpeg_decode_restart_interval_partition_truncated,
+    test_wuffs_jpeg_decode_restart_interval_partition_unscanned_component,
+    test_wuffs_jpeg_decode_scaled,
     test_wuffs_jpeg_decode_truncated_input,
 
 #ifdef WUFFS_MIMIC
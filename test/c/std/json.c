@@ -29,6 +29,14 @@ done
 
 Each edition should print "PASS", amongst other information, and exit(0).
 
+Compiling this file as C++ also runs the wuffs_aux tests. Also define
+WUFFS_CONFIG__ENABLE_THREADS to test wuffs_aux::DecodeJsonLinesParallel:
+
+for CXX in clang++ g++; do
+  $CXX -x c++ -DWUFFS_CONFIG__ENABLE_THREADS -pthread json.c && ./a.out
+  rm -f a.out
+done
+
 Add the "wuffs mimic cflags" (everything after the colon below) to the C
 compiler flags (after the .c file) to run the mimic tests.
 
@@ -55,6 +63,8 @@ the first "./a.out" with "./a.out -bench". Combine these changes with the
 // modules we use makes that process explicit. Preprocessing means that such
 // code simply isn't compiled.
 #define WUFFS_CONFIG__MODULES
+#define WUFFS_CONFIG__MODULE__AUX__BASE
+#define WUFFS_CONFIG__MODULE__AUX__JSON
 #define WUFFS_CONFIG__MODULE__BASE
 #define WUFFS_CONFIG__MODULE__JSON
 
@@ -4068,6 +4078,702 @@ test_wuffs_json_decode_string() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_json_decode_string_long() {
+  CHECK_FOCUS(__func__);
+
+  const char* bad_ccc = wuffs_json__error__bad_c0_control_code;
+  const char* bad_utf = wuffs_json__error__bad_utf_8;
+
+  // The SIMD code paths work on 16 or 32 bytes at a time, so vary where (if
+  // anywhere) the first special byte appears in a long string, as well as the
+  // length of the leading (space-only) indentation.
+  struct {
+    const char* want_status_repr;
+    const char* special;
+  } test_cases[] = {
+      {.want_status_repr = NULL, .special = ""},
+      {.want_status_repr = NULL, .special = "\\n"},
+      {.want_status_repr = NULL, .special = "\\\""},
+      {.want_status_repr = NULL, .special = "\xC2\x80"},
+      {.want_status_repr = NULL, .special = "\x7F"},
+      {.want_status_repr = bad_ccc, .special = "\t"},
+      {.want_status_repr = bad_ccc, .special = "\x1F"},
+      {.want_status_repr = bad_utf, .special = "\x80"},
+      {.want_status_repr = bad_utf, .special = "\xFF"},
+  };
+
+  char str[256];
+  wuffs_json__decoder dec;
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    size_t special_len = strlen(test_cases[tc].special);
+    for (size_t indent = 0; indent < 20; indent += 3) {
+      for (size_t n = 0; n < 100; n++) {
+        memset(str, ' ', indent);
+        str[indent] = '"';
+        memset(str + indent + 1, 'a', n);
+        memcpy(str + indent + 1 + n, test_cases[tc].special, special_len);
+        memset(str + indent + 1 + n + special_len, 'b', 40);
+        str[indent + 1 + n + special_len + 40] = '"';
+        size_t str_len = indent + 1 + n + special_len + 40 + 1;
+
+        CHECK_STATUS("initialize",
+                     wuffs_json__decoder__initialize(
+                         &dec, sizeof dec, WUFFS_VERSION,
+                         WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+        wuffs_base__token_buffer tok =
+            wuffs_base__slice_token__writer(g_have_slice_token);
+        wuffs_base__io_buffer src =
+            wuffs_base__ptr_u8__reader((uint8_t*)(void*)str, str_len, true);
+        wuffs_base__status have_status = wuffs_json__decoder__decode_tokens(
+            &dec, &tok, &src, g_work_slice_u8);
+
+        uint64_t total_length = 0;
+        for (size_t i = tok.meta.ri; i < tok.meta.wi; i++) {
+          wuffs_base__token* t = &tok.data.ptr[i];
+          total_length = wuffs_base__u64__sat_add(total_length,
+                                                  wuffs_base__token__length(t));
+        }
+
+        if (have_status.repr != test_cases[tc].want_status_repr) {
+          RETURN_FAIL("tc=%zu, indent=%zu, n=%zu: have \"%s\", want \"%s\"",
+                      tc, indent, n, have_status.repr,
+                      test_cases[tc].want_status_repr);
+        }
+
+        if (total_length != src.meta.ri) {
+          RETURN_FAIL("tc=%zu, indent=%zu, n=%zu: total length: have %" PRIu64
+                      ", want %zu",
+                      tc, indent, n, total_length, src.meta.ri);
+        }
+
+        if (!have_status.repr && (total_length != str_len)) {
+          RETURN_FAIL("tc=%zu, indent=%zu, n=%zu: total length: have %" PRIu64
+                      ", want %zu",
+                      tc, indent, n, total_length, str_len);
+        }
+      }
+    }
+  }
+
+  return NULL;
+}
+
+// ---------------- Auxiliary Tests
+
+// These tests are only built when this file is compiled as C++.
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+// AuxJsonRecorderBase logs its DecodeJsonCallbacks calls as a compact string.
+template <typename Callbacks>
+class AuxJsonRecorderBase : public Callbacks {
+ public:
+  std::string AppendNull() override {
+    log += "null,";
+    return "";
+  }
+
+  std::string AppendBool(bool val) override {
+    log += val ? "true," : "false,";
+    return "";
+  }
+
+  std::string AppendF64(double val) override {
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%gf,", val);
+    log += buf;
+    return "";
+  }
+
+  std::string AppendI64(int64_t val) override {
+    log += std::to_string(val) + ",";
+    return "";
+  }
+
+  std::string AppendTextString(std::string&& val) override {
+    log += "\"" + val + "\",";
+    return "";
+  }
+
+  std::string Push(uint32_t flags) override {
+    log += (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__TO_LIST) ? "[" : "{";
+    return "";
+  }
+
+  std::string Pop(uint32_t flags) override {
+    log += (flags & WUFFS_BASE__TOKEN__VBD__STRUCTURE__FROM_LIST) ? "]," : "},";
+    return "";
+  }
+
+  void Done(wuffs_aux::DecodeJsonResult& result,
+            wuffs_aux::sync_io::Input& input,
+            wuffs_aux::IOBuffer& buffer) override {
+    if (result.error_message == wuffs_aux::DecodeJson_NoMatch) {
+      log += "no-match";
+    } else {
+      log += result.error_message;
+    }
+    log += ";";
+  }
+
+  std::string log;
+};
+
+typedef AuxJsonRecorderBase<wuffs_aux::DecodeJsonCallbacks> AuxJsonRecorder;
+
+// AuxJsonViewRecorder also logs AppendTextStringView calls, as "view:etc,".
+// AppendTextString calls (the copying fallback) are logged as "\"etc\",".
+class AuxJsonViewRecorder : public AuxJsonRecorder {
+ public:
+  std::string AppendTextStringView(const char* ptr, size_t len) override {
+    log += "view:" + std::string(ptr, len) + ",";
+    return "";
+  }
+};
+
+// AuxJsonDribbleInput is like a MemoryInput, but it brings no IOBuffer of its
+// own and copies in at most n bytes at a time.
+class AuxJsonDribbleInput : public wuffs_aux::sync_io::Input {
+ public:
+  AuxJsonDribbleInput(const std::string& s0, size_t n0) : s(s0), i(0), n(n0) {}
+
+  std::string CopyIn(wuffs_aux::IOBuffer* dst) override {
+    size_t k = std::min(std::min(n, s.size() - i), dst->writer_length());
+    memcpy(dst->writer_pointer(), s.data() + i, k);
+    dst->meta.wi += k;
+    i += k;
+    dst->meta.closed = (i == s.size());
+    return "";
+  }
+
+  std::string s;
+  size_t i;
+  size_t n;
+};
+
+const char*  //
+test_wuffs_aux_json_decode_text_string_view() {
+  CHECK_FOCUS(__func__);
+
+  std::string long_str(0x10000, 'x');
+  struct {
+    std::string src;
+    size_t dribble;
+    std::string want_log;
+  } test_cases[] = {
+      {
+          // Escape-free strings (including dict keys) are passed as views.
+          // Strings with escapes take the copying fallback, as does the
+          // empty string (which has no string content token).
+          .src = "[\"abc\", \"a\\nb\", \"\", {\"key\": \"val\"}]",
+          .dribble = 0,
+          .want_log = "[view:abc,\"a\nb\",\"\",{view:key,view:val,},],;",
+      },
+      {
+          // The long string's content is split across multiple tokens.
+          .src = "[\"" + long_str + "\", \"y\"]",
+          .dribble = 0,
+          .want_log = "[\"" + long_str + "\",view:y,],;",
+      },
+      {
+          // Feeding the input 5 bytes at a time splits the first string
+          // across input buffer refills. The second string's content and
+          // closing '"' arrive together.
+          .src = "[\"abcdefghij\",\"k\"]",
+          .dribble = 5,
+          .want_log = "[\"abcdefghij\",view:k,],;",
+      },
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    AuxJsonViewRecorder callbacks;
+    wuffs_aux::DecodeJsonResult result("", 0);
+    if (test_cases[tc].dribble > 0) {
+      AuxJsonDribbleInput input(test_cases[tc].src, test_cases[tc].dribble);
+      result = wuffs_aux::DecodeJson(callbacks, input);
+    } else {
+      wuffs_aux::sync_io::MemoryInput input(test_cases[tc].src.data(),
+                                            test_cases[tc].src.size());
+      result = wuffs_aux::DecodeJson(callbacks, input);
+    }
+    if (!result.error_message.empty()) {
+      RETURN_FAIL("tc=%zu: error_message: \"%s\"", tc,
+                  result.error_message.c_str());
+    } else if (callbacks.log != test_cases[tc].want_log) {
+      RETURN_FAIL("tc=%zu: log: have \"%.200s\", want \"%.200s\"", tc,
+                  callbacks.log.c_str(), test_cases[tc].want_log.c_str());
+    }
+  }
+  return NULL;
+}
+
+// AuxJsonLinesRecorder logs each record as "record_index@position:" followed
+// by that record's AuxJsonRecorder log.
+class AuxJsonLinesRecorder : public wuffs_aux::DecodeJsonLinesCallbacks {
+ public:
+  wuffs_aux::DecodeJsonCallbacks* StartRecord(uint64_t record_index,
+                                              uint64_t position) override {
+    rec.log += std::to_string(record_index) + "@" + std::to_string(position) +
+               ":";
+    return &rec;
+  }
+
+  AuxJsonRecorder rec;
+};
+
+const char*  //
+test_wuffs_aux_json_decode_lines_blank_lines() {
+  CHECK_FOCUS(__func__);
+
+  // The final record has no trailing '\n'.
+  std::string src = "\n 1\n\n\t\r\n[2, true]\r\n\n  \n{\"k\":null}";
+  AuxJsonLinesRecorder callbacks;
+  wuffs_aux::DecodeJsonResult result = wuffs_aux::DecodeJsonLines(
+      callbacks, reinterpret_cast<const uint8_t*>(src.data()), src.size());
+  if (!result.error_message.empty()) {
+    RETURN_FAIL("error_message: \"%s\"", result.error_message.c_str());
+  } else if (result.cursor_position != src.size()) {
+    RETURN_FAIL("cursor_position: have %" PRIu64 ", want %zu",
+                result.cursor_position, src.size());
+  }
+  const char* want = "0@1:1,;1@8:[2,true,],;2@23:{\"k\",null,},;";
+  if (callbacks.rec.log != want) {
+    RETURN_FAIL("log: have \"%s\", want \"%s\"", callbacks.rec.log.c_str(),
+                want);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_aux_json_decode_lines_error_positions() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    const char* src;
+    const char* want_error_message;
+    uint64_t want_cursor_position;
+    uint64_t want_line_number;
+  } test_cases[] = {
+      {
+          .src = "1\n2 3\n",
+          .want_error_message = "json: bad input",
+          .want_cursor_position = 4,
+          .want_line_number = 2,
+      },
+      {
+          .src = "\n\nx\n",
+          .want_error_message = "json: bad input",
+          .want_cursor_position = 2,
+          .want_line_number = 3,
+      },
+      {
+          .src = "1\n2\n[3,\n4]\n",
+          .want_error_message = wuffs_aux::DecodeJsonLines_MultiLineRecord,
+          .want_cursor_position = 7,
+          .want_line_number = 3,
+      },
+      {
+          .src = "[1]\n\n{\"a\"\n:2}\n",
+          .want_error_message = wuffs_aux::DecodeJsonLines_MultiLineRecord,
+          .want_cursor_position = 9,
+          .want_line_number = 3,
+      },
+      {
+          // Truncated input (with no '\n') is not a multi-line record.
+          .src = "1\n[2,",
+          .want_error_message = "json: bad input",
+          .want_cursor_position = 5,
+          .want_line_number = 2,
+      },
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    std::string src = test_cases[tc].src;
+    AuxJsonLinesRecorder callbacks;
+    wuffs_aux::DecodeJsonResult result = wuffs_aux::DecodeJsonLines(
+        callbacks, reinterpret_cast<const uint8_t*>(src.data()), src.size());
+    if (result.error_message != test_cases[tc].want_error_message) {
+      RETURN_FAIL("tc=%zu: error_message: have \"%s\", want \"%s\"", tc,
+                  result.error_message.c_str(),
+                  test_cases[tc].want_error_message);
+    } else if (result.cursor_position != test_cases[tc].want_cursor_position) {
+      RETURN_FAIL("tc=%zu: cursor_position: have %" PRIu64 ", want %" PRIu64,
+                  tc, result.cursor_position,
+                  test_cases[tc].want_cursor_position);
+    }
+    uint64_t have_line_number =
+        1 + std::count(src.begin(), src.begin() + result.cursor_position, '\n');
+    if (have_line_number != test_cases[tc].want_line_number) {
+      RETURN_FAIL("tc=%zu: line number: have %" PRIu64 ", want %" PRIu64, tc,
+                  have_line_number, test_cases[tc].want_line_number);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_aux_json_decode_lines_no_match() {
+  CHECK_FOCUS(__func__);
+
+  std::string src = "{\"a\":1}\n{\"b\":2}\n3\n\n{\"a\":[4]}\n";
+  AuxJsonLinesRecorder callbacks;
+  wuffs_aux::DecodeJsonResult result = wuffs_aux::DecodeJsonLines(
+      callbacks, reinterpret_cast<const uint8_t*>(src.data()), src.size(),
+      wuffs_aux::DecodeJsonArgQuirks::DefaultValue(),
+      wuffs_aux::DecodeJsonArgJsonPointer("/a"));
+  if (!result.error_message.empty()) {
+    RETURN_FAIL("error_message: \"%s\"", result.error_message.c_str());
+  }
+  const char* want = "0@0:1,;1@8:no-match;2@16:no-match;3@19:[4,],;";
+  if (callbacks.rec.log != want) {
+    RETURN_FAIL("log: have \"%s\", want \"%s\"", callbacks.rec.log.c_str(),
+                want);
+  }
+  return NULL;
+}
+
+// AuxJsonMultiQueryRecorder also logs StartMatch and EndMatch calls, as "<q,"
+// and ">q,". StartMatch fails for the fail_query_index'th query.
+class AuxJsonMultiQueryRecorder
+    : public AuxJsonRecorderBase<wuffs_aux::DecodeJsonMultiQueryCallbacks> {
+ public:
+  explicit AuxJsonMultiQueryRecorder(size_t fail_query_index0)
+      : fail_query_index(fail_query_index0) {}
+
+  std::string StartMatch(size_t query_index) override {
+    if (query_index == fail_query_index) {
+      return "fail";
+    }
+    log += "<" + std::to_string(query_index) + ",";
+    return "";
+  }
+
+  std::string EndMatch(size_t query_index) override {
+    log += ">" + std::to_string(query_index) + ",";
+    return "";
+  }
+
+  size_t fail_query_index;
+};
+
+const char*  //
+test_wuffs_aux_json_decode_multi_query() {
+  CHECK_FOCUS(__func__);
+
+  struct {
+    std::vector<std::string> queries;
+    const char* src;
+    size_t fail_query_index;
+    const char* want_error_message;
+    uint64_t want_cursor_position;
+    const char* want_log;
+  } test_cases[] = {
+      {
+          // Prefix queries nest, whatever their order.
+          .queries = {"/a/b", "/a"},
+          .src = "{\"a\":{\"x\":0,\"b\":[1,2]},\"c\":3}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = "",
+          .want_cursor_position = 22,
+          .want_log = "<1,{\"x\",0,\"b\",<0,[1,2,],>0,},>1,",
+      },
+      {
+          // Duplicate queries start in order and end in reverse order.
+          .queries = {"/a", "/b", "/a"},
+          .src = "{\"a\":true,\"b\":null}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = "",
+          .want_cursor_position = 18,
+          .want_log = "<0,<2,true,>2,>0,<1,null,>1,",
+      },
+      {
+          // "1" and "0" are both dict keys and list indexes.
+          .queries = {"/0/1", "/1/0"},
+          .src = "[{\"1\":\"x\",\"0\":\"y\"},[5,6]]",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = "",
+          .want_cursor_position = 21,
+          .want_log = "<0,\"x\",>0,<1,5,>1,",
+      },
+      {
+          .queries = {"/0/1"},
+          .src = "{\"0\":[7,8]}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = "",
+          .want_cursor_position = 9,
+          .want_log = "<0,8,>0,",
+      },
+      {
+          // Only the first of repeated dict keys is followed, even if a
+          // later one would lead to a match.
+          .queries = {"/a/b", "/c"},
+          .src = "{\"a\":{\"c\":1},\"a\":{\"b\":2},\"c\":3,\"c\":4}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = "",
+          .want_cursor_position = 37,
+          .want_log = "<1,3,>1,",
+      },
+      {
+          // The empty query matches the root. A query with no match is not
+          // an error.
+          .queries = {"", "/z"},
+          .src = "[1] ",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = "",
+          .want_cursor_position = 3,
+          .want_log = "<0,[1,],>0,",
+      },
+      {
+          .queries = {"/a~1b", "/m~0n"},
+          .src = "{\"m~n\":1,\"a/b\":2}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = "",
+          .want_cursor_position = 16,
+          .want_log = "<1,1,>1,<0,2,>0,",
+      },
+      {
+          .queries = {"/a", "b"},
+          .src = "{}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = wuffs_aux::DecodeJson_BadJsonPointer,
+          .want_cursor_position = 0,
+          .want_log = "",
+      },
+      {
+          .queries = {"/~2"},
+          .src = "{}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = wuffs_aux::DecodeJson_BadJsonPointer,
+          .want_cursor_position = 0,
+          .want_log = "",
+      },
+      {
+          .queries = {"/a~"},
+          .src = "{}",
+          .fail_query_index = SIZE_MAX,
+          .want_error_message = wuffs_aux::DecodeJson_BadJsonPointer,
+          .want_cursor_position = 0,
+          .want_log = "",
+      },
+      {
+          // A callback error stops decoding.
+          .queries = {"/a", "/b"},
+          .src = "{\"a\":[1],\"b\":2,\"c\":3}",
+          .fail_query_index = 1,
+          .want_error_message = "fail",
+          .want_cursor_position = 14,
+          .want_log = "<0,[1,],>0,",
+      },
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    AuxJsonMultiQueryRecorder callbacks(test_cases[tc].fail_query_index);
+    wuffs_aux::sync_io::MemoryInput input(test_cases[tc].src,
+                                          strlen(test_cases[tc].src));
+    wuffs_aux::DecodeJsonResult result = wuffs_aux::DecodeJsonMultiQuery(
+        callbacks, input,
+        wuffs_aux::DecodeJsonArgJsonPointers(test_cases[tc].queries));
+    if (result.error_message != test_cases[tc].want_error_message) {
+      RETURN_FAIL("tc=%zu: error_message: have \"%s\", want \"%s\"", tc,
+                  result.error_message.c_str(),
+                  test_cases[tc].want_error_message);
+    } else if (result.cursor_position != test_cases[tc].want_cursor_position) {
+      RETURN_FAIL("tc=%zu: cursor_position: have %" PRIu64 ", want %" PRIu64,
+                  tc, result.cursor_position,
+                  test_cases[tc].want_cursor_position);
+    }
+    // Done always runs last and logs the error message (and a ";").
+    std::string want_log = std::string(test_cases[tc].want_log) +
+                           test_cases[tc].want_error_message + ";";
+    if (callbacks.log != want_log) {
+      RETURN_FAIL("tc=%zu: log: have \"%s\", want \"%s\"", tc,
+                  callbacks.log.c_str(), want_log.c_str());
+    }
+  }
+  return NULL;
+}
+
+#if defined(WUFFS_CONFIG__ENABLE_THREADS)
+
+// AuxJsonLinesParallelRecorder collects each FinishRecord call's position and
+// AuxJsonRecorder log.
+class AuxJsonLinesParallelRecorder
+    : public wuffs_aux::DecodeJsonLinesParallelCallbacks {
+ public:
+  explicit AuxJsonLinesParallelRecorder(size_t num_workers)
+      : per_worker(num_workers) {}
+
+  wuffs_aux::DecodeJsonCallbacks* StartRecord(size_t worker_index,
+                                              uint64_t position) override {
+    per_worker[worker_index].emplace_back(new AuxJsonRecorder);
+    return per_worker[worker_index].back().get();
+  }
+
+  void FinishRecord(uint64_t position,
+                    wuffs_aux::DecodeJsonCallbacks* record_callbacks) override {
+    finished.emplace_back(
+        position, static_cast<AuxJsonRecorder*>(record_callbacks)->log);
+  }
+
+  std::vector<std::vector<std::unique_ptr<AuxJsonRecorder>>> per_worker;
+  std::vector<std::pair<uint64_t, std::string>> finished;
+};
+
+// AuxJsonLinesSequentialRecorder is like AuxJsonLinesParallelRecorder but for
+// (single-threaded) DecodeJsonLines, providing the expected results.
+class AuxJsonLinesSequentialRecorder
+    : public wuffs_aux::DecodeJsonLinesCallbacks {
+ public:
+  wuffs_aux::DecodeJsonCallbacks* StartRecord(uint64_t record_index,
+                                              uint64_t position) override {
+    if (!recs.empty()) {
+      finished.emplace_back(positions.back(), recs.back()->log);
+    }
+    positions.push_back(position);
+    recs.emplace_back(new AuxJsonRecorder);
+    return recs.back().get();
+  }
+
+  // Flush records the final record, if it was successful.
+  void Flush(const wuffs_aux::DecodeJsonResult& result) {
+    if (!recs.empty() && result.error_message.empty()) {
+      finished.emplace_back(positions.back(), recs.back()->log);
+    }
+  }
+
+  std::vector<uint64_t> positions;
+  std::vector<std::unique_ptr<AuxJsonRecorder>> recs;
+  std::vector<std::pair<uint64_t, std::string>> finished;
+};
+
+// make_aux_json_lines_src returns newline-delimited JSON that is a few times
+// the DecodeJsonLinesParallel chunk size (64 KiB), with records of varying
+// length (one longer than a chunk), blank lines and some records that do not
+// match the "/i" query. If bad_record_index is non-negative, that record is
+// invalid. *boundary_crossings counts the records that straddle a multiple
+// of 64 KiB.
+std::string  //
+make_aux_json_lines_src(int bad_record_index, int* boundary_crossings) {
+  std::string s;
+  *boundary_crossings = 0;
+  for (int i = 0; i < 400; i++) {
+    size_t position = s.size();
+    if (i == bad_record_index) {
+      s += "{\"i\":" + std::to_string(i) + ",\"s\":\"unterminated}\n";
+    } else if ((i % 7) == 3) {
+      s += "[" + std::to_string(i) + "]\n";
+    } else if ((i % 11) == 5) {
+      s += " \n\n";
+      continue;
+    } else {
+      size_t n = (i == 200) ? 70000 : ((i * 997) % 3000);
+      s += "{\"s\":\"" + std::string(n, 'a' + (i % 26)) +
+           "\",\"i\":" + std::to_string(i) + "}\n";
+    }
+    if ((position / 65536) != ((s.size() - 1) / 65536)) {
+      (*boundary_crossings)++;
+    }
+  }
+  return s;
+}
+
+const char*  //
+test_wuffs_aux_json_decode_lines_parallel() {
+  CHECK_FOCUS(__func__);
+
+  for (int bad = 0; bad < 2; bad++) {
+    // Record 150 is in the second or third chunk, not the last one.
+    int bad_record_index = bad ? 150 : -1;
+    int boundary_crossings = 0;
+    std::string src =
+        make_aux_json_lines_src(bad_record_index, &boundary_crossings);
+    if (boundary_crossings < 3) {
+      RETURN_FAIL("bad=%d: boundary_crossings: have %d, want >= 3", bad,
+                  boundary_crossings);
+    }
+    const uint8_t* ptr = reinterpret_cast<const uint8_t*>(src.data());
+
+    AuxJsonLinesSequentialRecorder want;
+    wuffs_aux::DecodeJsonResult want_result = wuffs_aux::DecodeJsonLines(
+        want, ptr, src.size(), wuffs_aux::DecodeJsonArgQuirks::DefaultValue(),
+        wuffs_aux::DecodeJsonArgJsonPointer("/i"));
+    want.Flush(want_result);
+    if (want_result.error_message.empty() != (bad == 0)) {
+      RETURN_FAIL("bad=%d: DecodeJsonLines: \"%s\"", bad,
+                  want_result.error_message.c_str());
+    } else if (want.finished.size() < 100) {
+      RETURN_FAIL("bad=%d: DecodeJsonLines: too few records", bad);
+    }
+
+    size_t num_workers_values[] = {1, 3, 8};
+    for (size_t nw = 0; nw < WUFFS_TESTLIB_ARRAY_SIZE(num_workers_values);
+         nw++) {
+      size_t num_workers = num_workers_values[nw];
+      for (int ordered = 0; ordered < 2; ordered++) {
+        AuxJsonLinesParallelRecorder have(num_workers);
+        wuffs_aux::DecodeJsonResult have_result =
+            wuffs_aux::DecodeJsonLinesParallel(
+                have, ptr, src.size(), num_workers, ordered,
+                wuffs_aux::DecodeJsonArgQuirks::DefaultValue(),
+                wuffs_aux::DecodeJsonArgJsonPointer("/i"));
+        if ((have_result.error_message != want_result.error_message) ||
+            (have_result.cursor_position != want_result.cursor_position)) {
+          RETURN_FAIL("bad=%d, num_workers=%zu, ordered=%d: have \"%s\" @%" PRIu64
+                      ", want \"%s\" @%" PRIu64,
+                      bad, num_workers, ordered,
+                      have_result.error_message.c_str(),
+                      have_result.cursor_position,
+                      want_result.error_message.c_str(),
+                      want_result.cursor_position);
+        }
+
+        // Unordered delivery may also include records after a bad one. Its
+        // FinishRecord calls are in no particular order, so sort them. Every
+        // record has a unique position.
+        std::vector<std::pair<uint64_t, std::string>>& f = have.finished;
+        if (!ordered) {
+          std::sort(f.begin(), f.end());
+          if (bad) {
+            f.erase(std::lower_bound(
+                        f.begin(), f.end(),
+                        std::make_pair(want_result.cursor_position,
+                                       std::string())),
+                    f.end());
+          }
+        }
+
+        if (f.size() != want.finished.size()) {
+          RETURN_FAIL("bad=%d, num_workers=%zu, ordered=%d: "
+                      "records: have %zu, want %zu",
+                      bad, num_workers, ordered, f.size(),
+                      want.finished.size());
+        }
+        for (size_t i = 0; i < f.size(); i++) {
+          if (f[i] != want.finished[i]) {
+            RETURN_FAIL("bad=%d, num_workers=%zu, ordered=%d: record #%zu: "
+                        "have %" PRIu64 " \"%.40s\", want %" PRIu64
+                        " \"%.40s\"",
+                        bad, num_workers, ordered, i, f[i].first,
+                        f[i].second.c_str(), want.finished[i].first,
+                        want.finished[i].second.c_str());
+          }
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
+#endif  // defined(WUFFS_CONFIG__ENABLE_THREADS)
+
+#endif  // __cplusplus
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -4221,6 +4927,72 @@ bench_wuffs_json_decode_217k_stringy() {
       tcounter_src, &g_json_nobel_prizes_gt, UINT64_MAX, UINT64_MAX, 25);
 }
 
+// do_bench_wuffs_json_decode_long_strings decodes 1 MiB of JSON: a list of
+// 1 KiB strings whose bytes are mostly 'a' to 'j', with special (which can be
+// empty) repeated every 100 bytes.
+const char*  //
+do_bench_wuffs_json_decode_long_strings(const char* special,
+                                        uint64_t iters_unscaled) {
+  size_t special_len = strlen(special);
+  if (g_src_slice_u8.len < (1024 * 1024)) {
+    return "src buffer is too small";
+  }
+  uint8_t* p = g_src_slice_u8.ptr;
+  uint8_t* q = g_src_slice_u8.ptr + (1024 * 1024);
+  *p++ = '[';
+  while ((q - p) > (1000 + (10 * (ptrdiff_t)special_len) + 3)) {
+    *p++ = '"';
+    for (int i = 0; i < 10; i++) {
+      memset(p, 'a' + i, 100);
+      p += 100;
+      memcpy(p, special, special_len);
+      p += special_len;
+    }
+    *p++ = '"';
+    *p++ = ',';
+  }
+  p[-1] = ']';
+  size_t n = (size_t)(p - g_src_slice_u8.ptr);
+
+  wuffs_json__decoder dec;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  bench_start();
+  for (uint64_t i = 0; i < iters; i++) {
+    CHECK_STATUS("initialize",
+                 wuffs_json__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__io_buffer src =
+        wuffs_base__ptr_u8__reader(g_src_slice_u8.ptr, n, true);
+    while (true) {
+      wuffs_base__token_buffer tok =
+          wuffs_base__slice_token__writer(g_have_slice_token);
+      wuffs_base__status status = wuffs_json__decoder__decode_tokens(
+          &dec, &tok, &src, g_work_slice_u8);
+      if (status.repr != wuffs_base__suspension__short_write) {
+        CHECK_STATUS("decode_tokens", status);
+        break;
+      }
+    }
+  }
+  bench_finish(iters, n * iters);
+
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_json_decode_1m_long_strings_ascii() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_json_decode_long_strings("", 30);
+}
+
+const char*  //
+bench_wuffs_json_decode_1m_long_strings_utf_8() {
+  CHECK_FOCUS(__func__);
+  // "\xC3\xA9" is U+00E9 LATIN SMALL LETTER E WITH ACUTE.
+  return do_bench_wuffs_json_decode_long_strings("\xC3\xA9", 30);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -4269,8 +5041,22 @@ proc g_tests[] = {
     test_wuffs_json_decode_quirk_replace_invalid_unicode,
     test_wuffs_json_decode_src_io_buffer_length,
     test_wuffs_json_decode_string,
+    test_wuffs_json_decode_string_long,
     test_wuffs_json_decode_unicode4_escapes,
 
+#ifdef __cplusplus
+
+    test_wuffs_aux_json_decode_lines_blank_lines,
+    test_wuffs_aux_json_decode_lines_error_positions,
+    test_wuffs_aux_json_decode_lines_no_match,
+    test_wuffs_aux_json_decode_multi_query,
+    test_wuffs_aux_json_decode_text_string_view,
+#if defined(WUFFS_CONFIG__ENABLE_THREADS)
+    test_wuffs_aux_json_decode_lines_parallel,
+#endif  // defined(WUFFS_CONFIG__ENABLE_THREADS)
+
+#endif  // __cplusplus
+
 #ifdef WUFFS_MIMIC
 
 // No mimic tests.
@@ -4290,6 +5076,8 @@ proc g_benches[] = {
     bench_wuffs_strconv_render_number_f64_just_enough_small_integers,
 
     bench_wuffs_json_decode_1k,
+    bench_wuffs_json_decode_1m_long_strings_ascii,
+    bench_wuffs_json_decode_1m_long_strings_utf_8,
     bench_wuffs_json_decode_21k_formatted,
     bench_wuffs_json_decode_26k_compact,
     bench_wuffs_json_decode_217k_stringy,
@@ -110,6 +110,45 @@ test_wuffs_netpbm_decode_truncated_input() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_netpbm_decode_crop() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[] = {
+      "test/data/hippopotamus.pgm",
+      "test/data/hippopotamus.ppm",
+      "test/data/peacock.ppm",
+  };
+
+  wuffs_base__rect_ie_u32 crops[] = {
+      wuffs_base__make_rect_ie_u32(0, 0, 16, 16),
+      wuffs_base__make_rect_ie_u32(13, 27, 51, 48),
+      wuffs_base__make_rect_ie_u32(40, 60, 1000, 1000),
+      wuffs_base__make_rect_ie_u32(1000, 1000, 2000, 2000),
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (size_t c = 0; c < WUFFS_TESTLIB_ARRAY_SIZE(crops); c++) {
+      wuffs_netpbm__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_netpbm__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_crop(
+          wuffs_netpbm__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_netpbm__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          filenames[tc], crops[c]);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), c=%zu: %s", tc, filenames[tc], c, z);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_netpbm_decode_frame_config() {
   CHECK_FOCUS(__func__);
@@ -192,6 +231,7 @@ test_wuffs_netpbm_decode_image_config() {
 
 proc g_tests[] = {
 
+    test_wuffs_netpbm_decode_crop,
     test_wuffs_netpbm_decode_frame_config,
     test_wuffs_netpbm_decode_image_config,
     test_wuffs_netpbm_decode_interface,
@@ -152,6 +152,10 @@ do_wuffs_png_swizzle(uint32_t width,
   dec.private_impl.f_frame_rect_y0 = 0;
   dec.private_impl.f_frame_rect_x1 = width;
   dec.private_impl.f_frame_rect_y1 = height;
+  dec.private_impl.f_crop_rect_x0 = 0;
+  dec.private_impl.f_crop_rect_y0 = 0;
+  dec.private_impl.f_crop_rect_x1 = width;
+  dec.private_impl.f_crop_rect_y1 = height;
   dec.private_impl.f_width = width;
   dec.private_impl.f_height = height;
   dec.private_impl.f_pass_bytes_per_row = width;
@@ -242,6 +246,180 @@ test_wuffs_png_decode_bad_crc32_checksum_critical() {
       &wuffs_png_decode);
 }
 
+const char*  //
+test_wuffs_png_decode_color_transform() {
+  CHECK_FOCUS(__func__);
+
+  uint8_t icc_array[1024];
+  wuffs_base__io_buffer icc = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(icc_array, sizeof icc_array),
+  });
+  CHECK_STRING(read_file(&icc, "test/data/DCI-P3-D65.icc"));
+  wuffs_base__color_transform t;
+  CHECK_STATUS("set_from_icc_profile",
+               wuffs_base__color_transform__set_from_icc_profile(
+                   &t, wuffs_base__io_buffer__reader_slice(&icc)));
+
+  const char* filenames[] = {
+      "test/data/bricks-color.png",
+      "test/data/bricks-gray.png",
+      "test/data/hippopotamus.interlaced.png",
+      "test/data/red-blue-gradient.dcip3d65-no-chrm-no-gama.png",
+  };
+
+  uint32_t pixfmts[] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__RGBX,
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (size_t p = 0; p < WUFFS_TESTLIB_ARRAY_SIZE(pixfmts); p++) {
+      wuffs_png__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_png__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_color_transform(
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          filenames[tc], pixfmts[p], &t);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), p=%zu: %s", tc, filenames[tc], p, z);
+      }
+    }
+  }
+
+  // The color transform is applied before compositing, so SRC_OVER is
+  // unsupported.
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filenames[0]));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+  wuffs_base__pixel_config__set(
+      &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+      wuffs_base__pixel_config__width(&ic.pixcfg),
+      wuffs_base__pixel_config__height(&ic.pixcfg));
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_have_slice_u8));
+  wuffs_base__decode_frame_options opts =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_color_transform(&opts, &t);
+  wuffs_base__status status = wuffs_png__decoder__decode_frame(
+      &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC_OVER, g_work_slice_u8,
+      &opts);
+  if (status.repr != wuffs_base__error__unsupported_pixel_swizzler_option) {
+    RETURN_FAIL("decode_frame: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_crop() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[] = {
+      "test/data/bricks-color.png",
+      "test/data/bricks-gray.png",
+      "test/data/hippopotamus.interlaced.png",
+      "test/data/hippopotamus.regular.png",
+  };
+
+  wuffs_base__rect_ie_u32 crops[] = {
+      wuffs_base__make_rect_ie_u32(0, 0, 16, 16),
+      wuffs_base__make_rect_ie_u32(13, 27, 51, 48),
+      wuffs_base__make_rect_ie_u32(40, 60, 1000, 1000),
+      wuffs_base__make_rect_ie_u32(1000, 1000, 2000, 2000),
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (size_t c = 0; c < WUFFS_TESTLIB_ARRAY_SIZE(crops); c++) {
+      wuffs_png__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_png__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_crop(
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          filenames[tc], crops[c]);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), c=%zu: %s", tc, filenames[tc], c, z);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_decode_dither() {
+  CHECK_FOCUS(__func__);
+
+  const char* filenames[] = {
+      "test/data/bricks-color.png",
+      "test/data/bricks-gray.png",
+      "test/data/hibiscus.primitive.png",
+      "test/data/red-blue-gradient.vanilla.png",
+  };
+
+  wuffs_base__pixel_dither dithers[] = {
+      WUFFS_BASE__PIXEL_DITHER__NONE,
+      WUFFS_BASE__PIXEL_DITHER__ORDERED,
+      WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION,
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(filenames); tc++) {
+    for (size_t d = 0; d < WUFFS_TESTLIB_ARRAY_SIZE(dithers); d++) {
+      wuffs_png__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_png__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_dither(
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_png__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          filenames[tc], dithers[d]);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), d=%zu: %s", tc, filenames[tc], d, z);
+      }
+
+      // For the 256x256 gradient, dithering should change the BGR_565
+      // pixels. The NONE (d == 0) pixels are saved for comparison.
+      if (tc == 3) {
+        const size_t n = 2 * 256 * 256;
+        if (d == 0) {
+          memcpy(g_mimiclib_scratch_array_u8, g_have_array_u8, n);
+        } else if (!memcmp(g_mimiclib_scratch_array_u8, g_have_array_u8, n)) {
+          RETURN_FAIL("tc=%zu (%s), d=%zu: dithering was a no-op", tc,
+                      filenames[tc], d);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_png_decode_filters_golden() {
   CHECK_FOCUS(__func__);
@@ -977,6 +1155,280 @@ test_wuffs_png_decode_restart_frame() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_png_decode_restart_frame_animated() {
+  CHECK_FOCUS(__func__);
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, "test/data/animated-red-blue.apng"));
+
+  // Scan the frame configs (which skips, instead of decompresses, the pixel
+  // data) and then decode each frame, in sequential order, onto a cleared
+  // canvas. Save the resultant pixels as the want values.
+  wuffs_base__frame_config fcs[4];
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  size_t n = 0;
+  {
+    wuffs_png__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, g_pixel_slice_u8));
+    n = (size_t)wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if ((n * WUFFS_TESTLIB_ARRAY_SIZE(fcs)) > g_want_slice_u8.len) {
+      RETURN_FAIL("pixbuf_len: %zu is too large", n);
+    }
+
+    for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(fcs); i++) {
+      fcs[i] = ((wuffs_base__frame_config){});
+      CHECK_STATUS(
+          "decode_frame_config",
+          wuffs_png__decoder__decode_frame_config(&dec, &fcs[i], &src));
+    }
+    wuffs_base__status status =
+        wuffs_png__decoder__decode_frame_config(&dec, NULL, &src);
+    if (status.repr != wuffs_base__note__end_of_data) {
+      RETURN_FAIL("decode_frame_config EOD: have \"%s\", want \"%s\"",
+                  status.repr, wuffs_base__note__end_of_data);
+    }
+
+    for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(fcs); i++) {
+      uint64_t pos = wuffs_base__frame_config__io_position(&fcs[i]);
+      CHECK_STATUS("restart_frame",
+                   wuffs_png__decoder__restart_frame(&dec, i, pos));
+      src.meta.ri = pos;
+      memset(g_pixel_slice_u8.ptr, 0, n);
+      CHECK_STATUS("decode_frame",
+                   wuffs_png__decoder__decode_frame(
+                       &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                       g_work_slice_u8, NULL));
+      memcpy(g_want_slice_u8.ptr + (n * i), g_pixel_slice_u8.ptr, n);
+    }
+  }
+
+  // Decode each frame, in reverse order, using a fresh decoder that jumps
+  // straight to that frame, as concurrent decoders of the same source bytes
+  // would. This should match the sequential decoding.
+  for (size_t j = 0; j < WUFFS_TESTLIB_ARRAY_SIZE(fcs); j++) {
+    size_t i = WUFFS_TESTLIB_ARRAY_SIZE(fcs) - 1 - j;
+    src.meta.ri = 0;
+
+    wuffs_png__decoder dec;
+    CHECK_STATUS("initialize",
+                 wuffs_png__decoder__initialize(
+                     &dec, sizeof dec, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    CHECK_STATUS("decode_image_config",
+                 wuffs_png__decoder__decode_image_config(&dec, NULL, &src));
+
+    uint64_t pos = wuffs_base__frame_config__io_position(&fcs[i]);
+    CHECK_STATUS("restart_frame",
+                 wuffs_png__decoder__restart_frame(&dec, i, pos));
+    src.meta.ri = pos;
+
+    wuffs_base__frame_config fc = ((wuffs_base__frame_config){});
+    CHECK_STATUS("decode_frame_config",
+                 wuffs_png__decoder__decode_frame_config(&dec, &fc, &src));
+    wuffs_base__rect_ie_u32 have_bounds = wuffs_base__frame_config__bounds(&fc);
+    wuffs_base__rect_ie_u32 want_bounds =
+        wuffs_base__frame_config__bounds(&fcs[i]);
+    if (wuffs_base__frame_config__index(&fc) != i) {
+      RETURN_FAIL("index #%zu: have %" PRIu64, i,
+                  wuffs_base__frame_config__index(&fc));
+    } else if (!wuffs_base__rect_ie_u32__equals(&have_bounds, want_bounds)) {
+      RETURN_FAIL("bounds #%zu: not equal", i);
+    } else if (wuffs_base__frame_config__disposal(&fc) !=
+               wuffs_base__frame_config__disposal(&fcs[i])) {
+      RETURN_FAIL("disposal #%zu: not equal", i);
+    } else if (wuffs_base__frame_config__overwrite_instead_of_blend(&fc) !=
+               wuffs_base__frame_config__overwrite_instead_of_blend(&fcs[i])) {
+      RETURN_FAIL("overwrite_instead_of_blend #%zu: not equal", i);
+    }
+
+    memset(g_pixel_slice_u8.ptr, 0, n);
+    CHECK_STATUS("decode_frame", wuffs_png__decoder__decode_frame(
+                                     &dec, &pb, &src,
+                                     WUFFS_BASE__PIXEL_BLEND__SRC,
+                                     g_work_slice_u8, NULL));
+    if (memcmp(g_want_slice_u8.ptr + (n * i), g_pixel_slice_u8.ptr, n)) {
+      RETURN_FAIL("pixels #%zu: not equal", i);
+    }
+  }
+
+  return NULL;
+}
+
+// ---------------- PNG Encoder Tests
+
+// do_test_wuffs_png_encode_round_trip decodes filename to pixfmt pixels,
+// encodes those pixels (in bands of band_height rows, if non-zero) and then
+// decodes the encoded PNG, checking that the pixels survive the round trip.
+// The encoder's output is limited to wlimit bytes per encode call.
+const char*  //
+do_test_wuffs_png_encode_round_trip(const char* filename,
+                                    wuffs_base__pixel_format pixfmt,
+                                    uint32_t band_height,
+                                    uint64_t wlimit) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt.repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  uint64_t n = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+  if (n > g_want_slice_u8.len) {
+    RETURN_FAIL("pixbuf_len: %" PRIu64 " is too large", n);
+  }
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_want_slice_u8));
+  CHECK_STATUS("decode_frame", wuffs_png__decoder__decode_frame(
+                                   &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   g_work_slice_u8, NULL));
+
+  wuffs_png__encoder encs[2];
+  for (int i = 0; i < 2; i++) {
+    CHECK_STATUS("initialize",
+                 wuffs_png__encoder__initialize(
+                     &encs[i], sizeof encs[i], WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  }
+  wuffs_base__range_ii_u64 workbuf_len =
+      wuffs_png__encoder__workbuf_len(&encs[0], pixfmt, width);
+  if (workbuf_len.max_incl > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len: %" PRIu64 " is too large", workbuf_len.max_incl);
+  }
+  wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+      g_work_slice_u8.ptr, (size_t)workbuf_len.max_incl);
+
+  wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+      .data = g_have_slice_u8,
+  });
+  uint32_t y = 0;
+  while (true) {
+    // When encoding in bands, encs[0] encodes the first band (and the
+    // trailer) and encs[1] encodes every other band.
+    wuffs_png__encoder* enc = &encs[(y > 0) ? 1 : 0];
+    if (band_height > 0) {
+      wuffs_png__encoder__set_band(enc, y, y + band_height);
+    }
+    while (true) {
+      wuffs_base__io_buffer limited_have = make_limited_writer(have, wlimit);
+      wuffs_base__status status =
+          wuffs_png__encoder__encode_image(enc, &limited_have, &pb, workbuf);
+      have.meta.wi += limited_have.meta.wi;
+      if (status.repr == wuffs_base__suspension__short_write) {
+        if (limited_have.meta.wi == 0) {
+          RETURN_FAIL("encode_image: no progress");
+        }
+        continue;
+      }
+      CHECK_STATUS("encode_image", status);
+      break;
+    }
+    if (band_height == 0) {
+      break;
+    } else if (y > 0) {
+      wuffs_png__encoder__combine_band_checksum(
+          &encs[0], wuffs_png__encoder__band_checksum(&encs[1]),
+          wuffs_png__encoder__band_length(&encs[1]));
+    }
+    y += band_height;
+    if (y >= height) {
+      CHECK_STATUS("encode_trailer",
+                   wuffs_png__encoder__encode_trailer(&encs[0], &have));
+      break;
+    }
+  }
+
+  // The encoded file should hold exactly one IEND chunk, at its end. Decoding
+  // alone would not notice any bytes after the first IEND.
+  if ((have.meta.wi < 12) ||
+      memcmp(have.data.ptr + have.meta.wi - 12, "\x00\x00\x00\x00IEND", 8)) {
+    RETURN_FAIL("encoded file does not end with IEND");
+  }
+  for (size_t i = 0; i + 12 < have.meta.wi; i++) {
+    if (!memcmp(have.data.ptr + i, "\x00\x00\x00\x00IEND", 8)) {
+      RETURN_FAIL("IEND at %zu, before the end (%zu)", i, have.meta.wi);
+    }
+  }
+
+  // The original file is no longer needed, so re-use its buffer for the
+  // round-tripped pixels.
+  wuffs_base__io_buffer round_trip = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  have.meta.closed = true;
+  CHECK_STRING(
+      wuffs_png_decode(NULL, &round_trip, WUFFS_INITIALIZE__DEFAULT_OPTIONS,
+                       pixfmt, NULL, 0, &have));
+
+  wuffs_base__io_buffer want =
+      wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, (size_t)n, true);
+  return check_io_buffers_equal("", &round_trip, &want);
+}
+
+const char*  //
+test_wuffs_png_encode_bands() {
+  CHECK_FOCUS(__func__);
+  // hibiscus.regular.png is 442 pixels high. The last two entries each encode
+  // the whole image as a single band, which still needs encode_trailer.
+  uint32_t band_heights[] = {1, 7, 100, 442, 0x10000};
+  for (size_t i = 0; i < WUFFS_TESTLIB_ARRAY_SIZE(band_heights); i++) {
+    CHECK_STRING(do_test_wuffs_png_encode_round_trip(
+        "test/data/hibiscus.regular.png",
+        wuffs_base__make_pixel_format(
+            WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+        band_heights[i], UINT64_MAX));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_bgr() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/bricks-color.png",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGR), 0,
+      UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_bgra_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/hibiscus.regular.png",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      0, UINT64_MAX);
+}
+
+const char*  //
+test_wuffs_png_encode_round_trip_y() {
+  CHECK_FOCUS(__func__);
+  return do_test_wuffs_png_encode_round_trip(
+      "test/data/bricks-gray.png",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__Y), 0, 1000);
+}
+
 // ---------------- Mimic Tests
 
 #ifdef WUFFS_MIMIC
@@ -1066,6 +1518,24 @@ test_mimic_png_decode_bad_crc32_checksum_critical() {
 
 // ---------------- PNG Benches
 
+const char*  //
+bench_wuffs_png_decode_anim_src_over_nonpremul() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_png_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      NULL, 0, "test/data/muybridge.apng", 0, SIZE_MAX, 5);
+}
+
+const char*  //
+bench_wuffs_png_decode_anim_src_over_premul() {
+  CHECK_FOCUS(__func__);
+  return do_bench_image_decode(
+      &wuffs_png_decode, WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED,
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL),
+      NULL, 0, "test/data/muybridge.apng", 0, SIZE_MAX, 5);
+}
+
 const char*  //
 bench_wuffs_png_decode_image_19k_8bpp() {
   CHECK_FOCUS(__func__);
@@ -1155,6 +1625,10 @@ do_bench_wuffs_png_decode_filter(uint8_t filter,
   dec.private_impl.f_frame_rect_y0 = 0;
   dec.private_impl.f_frame_rect_x1 = width;
   dec.private_impl.f_frame_rect_y1 = height;
+  dec.private_impl.f_crop_rect_x0 = 0;
+  dec.private_impl.f_crop_rect_y0 = 0;
+  dec.private_impl.f_crop_rect_x1 = width;
+  dec.private_impl.f_crop_rect_y1 = height;
   dec.private_impl.f_width = width;
   dec.private_impl.f_height = height;
   dec.private_impl.f_pass_bytes_per_row = bytes_per_row;
@@ -1192,6 +1666,12 @@ do_bench_wuffs_png_decode_filter(uint8_t filter,
   return NULL;
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_1_dist_2() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(1, 2, 200);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_1_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1204,6 +1684,18 @@ bench_wuffs_png_decode_filt_1_dist_4() {
   return do_bench_wuffs_png_decode_filter(1, 4, 200);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_1_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(1, 6, 200);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_1_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(1, 8, 200);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_2_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1216,6 +1708,12 @@ bench_wuffs_png_decode_filt_2_dist_4() {
   return do_bench_wuffs_png_decode_filter(2, 4, 1000);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_3_dist_2() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(3, 2, 100);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_3_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1228,6 +1726,24 @@ bench_wuffs_png_decode_filt_3_dist_4() {
   return do_bench_wuffs_png_decode_filter(3, 4, 100);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_3_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(3, 6, 100);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_3_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(3, 8, 100);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_4_dist_2() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(4, 2, 20);
+}
+
 const char*  //
 bench_wuffs_png_decode_filt_4_dist_3() {
   CHECK_FOCUS(__func__);
@@ -1240,6 +1756,98 @@ bench_wuffs_png_decode_filt_4_dist_4() {
   return do_bench_wuffs_png_decode_filter(4, 4, 20);
 }
 
+const char*  //
+bench_wuffs_png_decode_filt_4_dist_6() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(4, 6, 20);
+}
+
+const char*  //
+bench_wuffs_png_decode_filt_4_dist_8() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_decode_filter(4, 8, 20);
+}
+
+// ---------------- PNG Encoder Benches
+
+const char*  //
+do_bench_wuffs_png_encode(const char* filename,
+                          wuffs_base__pixel_format pixfmt,
+                          uint64_t iters_unscaled) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, filename));
+
+  wuffs_png__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_png__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  CHECK_STATUS("decode_image_config",
+               wuffs_png__decoder__decode_image_config(&dec, &ic, &src));
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  wuffs_base__pixel_config__set(&ic.pixcfg, pixfmt.repr,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &pb, &ic.pixcfg, g_pixel_slice_u8));
+  CHECK_STATUS("decode_frame", wuffs_png__decoder__decode_frame(
+                                   &dec, &pb, &src, WUFFS_BASE__PIXEL_BLEND__SRC,
+                                   g_work_slice_u8, NULL));
+
+  wuffs_png__encoder enc;
+  CHECK_STATUS("initialize",
+               wuffs_png__encoder__initialize(
+                   &enc, sizeof enc, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  wuffs_base__range_ii_u64 workbuf_len =
+      wuffs_png__encoder__workbuf_len(&enc, pixfmt, width);
+  if (workbuf_len.max_incl > g_work_slice_u8.len) {
+    RETURN_FAIL("workbuf_len: %" PRIu64 " is too large", workbuf_len.max_incl);
+  }
+  wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+      g_work_slice_u8.ptr, (size_t)workbuf_len.max_incl);
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    CHECK_STATUS("initialize",
+                 wuffs_png__encoder__initialize(
+                     &enc, sizeof enc, WUFFS_VERSION,
+                     WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+    wuffs_base__io_buffer have = ((wuffs_base__io_buffer){
+        .data = g_have_slice_u8,
+    });
+    CHECK_STATUS("encode_image", wuffs_png__encoder__encode_image(
+                                     &enc, &have, &pb, workbuf));
+    n_bytes += wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_png_encode_image_40k_24bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_encode(
+      "test/data/bricks-color.png",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGR), 50);
+}
+
+const char*  //
+bench_wuffs_png_encode_image_552k_32bpp() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_png_encode(
+      "test/data/hibiscus.regular.png",
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+      4);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -1306,6 +1914,9 @@ bench_mimic_png_decode_image_4002k_24bpp() {
 proc g_tests[] = {
 
     test_wuffs_png_decode_bad_crc32_checksum_critical,
+    test_wuffs_png_decode_color_transform,
+    test_wuffs_png_decode_crop,
+    test_wuffs_png_decode_dither,
     test_wuffs_png_decode_filters_golden,
     test_wuffs_png_decode_filters_round_trip,
     test_wuffs_png_decode_frame_config,
@@ -1316,7 +1927,12 @@ proc g_tests[] = {
     test_wuffs_png_decode_metadata_kvp,
     test_wuffs_png_decode_multiple_idats,
     test_wuffs_png_decode_restart_frame,
+    test_wuffs_png_decode_restart_frame_animated,
     test_wuffs_png_decode_truncated_input,
+    test_wuffs_png_encode_bands,
+    test_wuffs_png_encode_round_trip_bgr,
+    test_wuffs_png_encode_round_trip_bgra_nonpremul,
+    test_wuffs_png_encode_round_trip_y,
 
 #ifdef WUFFS_MIMIC
 
@@ -1337,20 +1953,33 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
+    bench_wuffs_png_decode_anim_src_over_nonpremul,
+    bench_wuffs_png_decode_anim_src_over_premul,
+    bench_wuffs_png_decode_filt_1_dist_2,
     bench_wuffs_png_decode_filt_1_dist_3,
     bench_wuffs_png_decode_filt_1_dist_4,
+    bench_wuffs_png_decode_filt_1_dist_6,
+    bench_wuffs_png_decode_filt_1_dist_8,
     bench_wuffs_png_decode_filt_2_dist_3,
     bench_wuffs_png_decode_filt_2_dist_4,
+    bench_wuffs_png_decode_filt_3_dist_2,
     bench_wuffs_png_decode_filt_3_dist_3,
     bench_wuffs_png_decode_filt_3_dist_4,
+    bench_wuffs_png_decode_filt_3_dist_6,
+    bench_wuffs_png_decode_filt_3_dist_8,
+    bench_wuffs_png_decode_filt_4_dist_2,
     bench_wuffs_png_decode_filt_4_dist_3,
     bench_wuffs_png_decode_filt_4_dist_4,
+    bench_wuffs_png_decode_filt_4_dist_6,
+    bench_wuffs_png_decode_filt_4_dist_8,
     bench_wuffs_png_decode_image_19k_8bpp,
     bench_wuffs_png_decode_image_40k_24bpp,
     bench_wuffs_png_decode_image_77k_8bpp,
     bench_wuffs_png_decode_image_552k_32bpp_ignore_checksum,
     bench_wuffs_png_decode_image_552k_32bpp_verify_checksum,
     bench_wuffs_png_decode_image_4002k_24bpp,
+    bench_wuffs_png_encode_image_40k_24bpp,
+    bench_wuffs_png_encode_image_552k_32bpp,
 
 #ifdef WUFFS_MIMIC
 
@@ -86,6 +86,108 @@ wuffs_tga_decode(uint64_t* n_bytes_out,
       n_bytes_out, dst, pixfmt, quirks_ptr, quirks_len, src);
 }
 
+// flip_tga_rows converts an uncompressed top-to-bottom TGA image to
+// bottom-to-top (or vice versa), toggling its image descriptor's bit 5 and
+// reversing the order of its rows.
+const char*  //
+flip_tga_rows(wuffs_base__io_buffer* src) {
+  uint8_t* p = src->data.ptr;
+  if (src->meta.wi < 18) {
+    return "flip_tga_rows: short header";
+  } else if (p[2] & 8) {
+    return "flip_tga_rows: unsupported RLE image";
+  }
+  size_t offset = 18 + (size_t)(p[0]);
+  if (p[1] != 0) {
+    offset += wuffs_base__peek_u16le__no_bounds_check(p + 5) *
+              (size_t)((p[7] + 7) / 8);
+  }
+  uint32_t width = wuffs_base__peek_u16le__no_bounds_check(p + 12);
+  uint32_t height = wuffs_base__peek_u16le__no_bounds_check(p + 14);
+  size_t row_len = width * (size_t)((p[16] + 7) / 8);
+  uint8_t tmp[4096];
+  if ((row_len > sizeof(tmp)) ||
+      (src->meta.wi < (offset + (height * row_len)))) {
+    return "flip_tga_rows: unsupported image";
+  }
+  p[17] ^= 0x20;
+  for (uint32_t y = 0; y < (height / 2); y++) {
+    uint8_t* r0 = p + offset + (y * row_len);
+    uint8_t* r1 = p + offset + ((height - 1 - y) * row_len);
+    memcpy(tmp, r0, row_len);
+    memcpy(r0, r1, row_len);
+    memcpy(r1, tmp, row_len);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_tga_decode_crop() {
+  CHECK_FOCUS(__func__);
+
+  // Only uncompressed TGA images honor the crop rectangle. RLE images decode
+  // the whole frame.
+  struct {
+    const char* filename;
+    bool flip_rows;
+    bool want_cropped;
+  } test_cases[] = {
+      {.filename = "test/data/bricks-color.tga",
+       .flip_rows = false,
+       .want_cropped = true},
+      {.filename = "test/data/bricks-color.tga",
+       .flip_rows = true,
+       .want_cropped = true},
+      {.filename = "test/data/bricks-gray.tga",
+       .flip_rows = false,
+       .want_cropped = false},
+      {.filename = "test/data/bricks-nodither.tga",
+       .flip_rows = false,
+       .want_cropped = true},
+      {.filename = "test/data/bricks-nodither.tga",
+       .flip_rows = true,
+       .want_cropped = true},
+  };
+
+  wuffs_base__rect_ie_u32 crops[] = {
+      wuffs_base__make_rect_ie_u32(0, 0, 16, 16),
+      wuffs_base__make_rect_ie_u32(13, 27, 51, 48),
+      wuffs_base__make_rect_ie_u32(20, 5, 30, 1000),
+      wuffs_base__make_rect_ie_u32(40, 60, 1000, 1000),
+      wuffs_base__make_rect_ie_u32(1000, 1000, 2000, 2000),
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(test_cases); tc++) {
+    wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+        .data = g_src_slice_u8,
+    });
+    CHECK_STRING(read_file(&src, test_cases[tc].filename));
+    if (test_cases[tc].flip_rows) {
+      CHECK_STRING(flip_tga_rows(&src));
+    }
+
+    for (size_t c = 0; c < WUFFS_TESTLIB_ARRAY_SIZE(crops); c++) {
+      wuffs_tga__decoder decs[2];
+      for (int i = 0; i < 2; i++) {
+        CHECK_STATUS(
+            "initialize",
+            wuffs_tga__decoder__initialize(
+                &decs[i], sizeof decs[i], WUFFS_VERSION,
+                WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+      }
+      const char* z = do_test__wuffs_base__image_decoder_crop_src(
+          wuffs_tga__decoder__upcast_as__wuffs_base__image_decoder(&decs[0]),
+          wuffs_tga__decoder__upcast_as__wuffs_base__image_decoder(&decs[1]),
+          &src, crops[c], test_cases[tc].want_cropped);
+      if (z) {
+        RETURN_FAIL("tc=%zu (%s), c=%zu: %s", tc, test_cases[tc].filename, c,
+                    z);
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_tga_decode_interface() {
   CHECK_FOCUS(__func__);
@@ -168,6 +270,7 @@ bench_wuffs_tga_decode_77k_24bpp() {
 
 proc g_tests[] = {
 
+    test_wuffs_tga_decode_crop,
     test_wuffs_tga_decode_interface,
     test_wuffs_tga_decode_truncated_input,
 
@@ -114,6 +114,227 @@ colors_differ(wuffs_base__color_u32_argb_premul color0,
   return false;
 }
 
+// do_test_wuffs_color_transform_rgb checks converting RGB colors (want[i]
+// holds the src and then dst colors, in 0xRRGGBB form) with the given color
+// transform.
+const char*  //
+do_test_wuffs_color_transform_rgb(const wuffs_base__color_transform* t,
+                                  const uint32_t (*want)[2],
+                                  size_t want_len) {
+  for (size_t i = 0; i < want_len; i++) {
+    uint8_t pixel[3] = {
+        (uint8_t)(want[i][0] >> 16),
+        (uint8_t)(want[i][0] >> 8),
+        (uint8_t)(want[i][0] >> 0),
+    };
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+    wuffs_base__pixel_config__set(&pc, WUFFS_BASE__PIXEL_FORMAT__RGB,
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 1, 1);
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &pb, &pc, wuffs_base__make_slice_u8(pixel, 3)));
+    CHECK_STATUS("transform_pixel_buffer",
+                 wuffs_base__color_transform__transform_pixel_buffer(t, &pb));
+    uint32_t have = (((uint32_t)pixel[0]) << 16) |
+                    (((uint32_t)pixel[1]) << 8) | (((uint32_t)pixel[2]) << 0);
+    if (have != want[i][1]) {
+      RETURN_FAIL("i=%zu, src=0x%06" PRIX32 ": have 0x%06" PRIX32
+                  ", want 0x%06" PRIX32,
+                  i, want[i][0], have, want[i][1]);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_color_transform_set_from_gama_chrm() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__color_transform t;
+
+  // The sRGB transfer function, primaries and white point are the identity.
+  CHECK_STATUS("set_from_gama_chrm",
+               wuffs_base__color_transform__set_from_gama_chrm(&t, 0, NULL));
+  if (!wuffs_base__color_transform__is_identity(&t)) {
+    RETURN_FAIL("sRGB: is_identity: have false, want true");
+  }
+
+  // A linear (gamma = 1.0) transfer function brightens mid-tones.
+  static const uint32_t want_linear[][2] = {
+      {0x000000, 0x000000},  //
+      {0x808080, 0xBCBCBC},  //
+      {0x0AC85A, 0x38E5A0},  //
+      {0xFFFFFF, 0xFFFFFF},  //
+  };
+  CHECK_STATUS(
+      "set_from_gama_chrm",
+      wuffs_base__color_transform__set_from_gama_chrm(&t, 100000, NULL));
+  CHECK_STRING(do_test_wuffs_color_transform_rgb(
+      &t, want_linear, WUFFS_TESTLIB_ARRAY_SIZE(want_linear)));
+
+  // DCI-P3 primaries (with a D65 white point) and a 2.6 gamma. Compare with
+  // test_wuffs_color_transform_set_from_icc_profile.
+  static const int32_t p3_chrm[8] = {
+      31270, 32900, 68000, 32000, 26500, 69000, 15000, 6000,
+  };
+  static const uint32_t want_p3[][2] = {
+      {0x808080, 0x717172},  //
+      {0x0AC85A, 0x00C432},  //
+      {0xC86432, 0xD04A00},  //
+      {0x283CDC, 0x0F2BE0},  //
+      {0xFFFFFF, 0xFFFFFF},  //
+  };
+  CHECK_STATUS(
+      "set_from_gama_chrm",
+      wuffs_base__color_transform__set_from_gama_chrm(&t, 38462, p3_chrm));
+  CHECK_STRING(do_test_wuffs_color_transform_rgb(
+      &t, want_p3, WUFFS_TESTLIB_ARRAY_SIZE(want_p3)));
+
+  // sRGB primaries with a D50 white point: white stays white but other
+  // colors shift.
+  static const int32_t d50_chrm[8] = {
+      34570, 35850, 64000, 33000, 30000, 60000, 15000, 6000,
+  };
+  static const uint32_t want_d50[][2] = {
+      {0x808080, 0x808080},  //
+      {0x0AC85A, 0x00C85F},  //
+      {0xC86432, 0xCF6538},  //
+      {0xFFFFFF, 0xFFFFFF},  //
+  };
+  CHECK_STATUS(
+      "set_from_gama_chrm",
+      wuffs_base__color_transform__set_from_gama_chrm(&t, 0, d50_chrm));
+  CHECK_STRING(do_test_wuffs_color_transform_rgb(
+      &t, want_d50, WUFFS_TESTLIB_ARRAY_SIZE(want_d50)));
+  return NULL;
+}
+
+const char*  //
+test_wuffs_color_transform_set_from_icc_profile() {
+  CHECK_FOCUS(__func__);
+
+  uint8_t icc_array[1024];
+  wuffs_base__io_buffer icc = ((wuffs_base__io_buffer){
+      .data = wuffs_base__make_slice_u8(icc_array, sizeof icc_array),
+  });
+  CHECK_STRING(read_file(&icc, "test/data/DCI-P3-D65.icc"));
+  wuffs_base__slice_u8 s = wuffs_base__io_buffer__reader_slice(&icc);
+
+  wuffs_base__color_transform t;
+  CHECK_STATUS("set_from_icc_profile",
+               wuffs_base__color_transform__set_from_icc_profile(&t, s));
+  if (wuffs_base__color_transform__is_identity(&t)) {
+    RETURN_FAIL("is_identity: have true, want false");
+  }
+
+  // These are within ±1 of a floating point (not fixed point) calculation.
+  static const uint32_t want[][2] = {
+      {0x000000, 0x000000},  //
+      {0x808080, 0x717171},  //
+      {0x0AC85A, 0x00C432},  //
+      {0xC86432, 0xD04A00},  //
+      {0x283CDC, 0x0F2BE0},  //
+      {0xFFFFFF, 0xFFFFFF},  //
+  };
+  CHECK_STRING(do_test_wuffs_color_transform_rgb(
+      &t, want, WUFFS_TESTLIB_ARRAY_SIZE(want)));
+
+  // A truncated profile is malformed.
+  wuffs_base__status status = wuffs_base__color_transform__set_from_icc_profile(
+      &t, wuffs_base__make_slice_u8(s.ptr, s.len - 1));
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("truncated: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  } else if (!wuffs_base__color_transform__is_identity(&t)) {
+    RETURN_FAIL("truncated: is_identity: have false, want true");
+  }
+
+  // A "GRAY" (instead of "RGB ") profile is unsupported.
+  memcpy(s.ptr + 16, "GRAY", 4);
+  status = wuffs_base__color_transform__set_from_icc_profile(&t, s);
+  if (status.repr != wuffs_base__error__unsupported_option) {
+    RETURN_FAIL("GRAY: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__unsupported_option);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_color_transform_simd() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__color_transform__func simd_funcs[4] = {NULL};
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    simd_funcs[0] = wuffs_base__color_transform__transform_bgrx__x86_avx2;
+    simd_funcs[1] = wuffs_base__color_transform__transform_rgbx__x86_avx2;
+    simd_funcs[2] =
+        wuffs_base__color_transform__transform_bgra_premul__x86_avx2;
+    simd_funcs[3] =
+        wuffs_base__color_transform__transform_rgba_premul__x86_avx2;
+  }
+#endif
+  if (!simd_funcs[0]) {
+    return NULL;
+  }
+  wuffs_base__color_transform__func funcs[4] = {
+      wuffs_base__color_transform__transform_bgrx,
+      wuffs_base__color_transform__transform_rgbx,
+      wuffs_base__color_transform__transform_bgra_premul,
+      wuffs_base__color_transform__transform_rgba_premul,
+  };
+
+  // A wide gamut source, so that the matrix has negative coefficients and
+  // some colors clamp.
+  static const int32_t p3_chrm[8] = {
+      31270, 32900, 68000, 32000, 26500, 69000, 15000, 6000,
+  };
+  wuffs_base__color_transform t;
+  CHECK_STATUS(
+      "set_from_gama_chrm",
+      wuffs_base__color_transform__set_from_gama_chrm(&t, 45455, p3_chrm));
+
+  // Every 8th pixel is opaque, so that both the SIMD and the non-SIMD code
+  // paths get exercised for premultiplied alpha.
+  uint8_t src[4 * 200];
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < sizeof src; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    src[i] = (uint8_t)(x >> 24);
+  }
+  for (size_t i = 0; i < 200; i++) {
+    if (((i / 8) % 4) != 1) {
+      src[(4 * i) + 3] = 0xFF;
+    }
+    for (size_t j = 0; j < 3; j++) {
+      if (src[(4 * i) + j] > src[(4 * i) + 3]) {
+        src[(4 * i) + j] = src[(4 * i) + 3];
+      }
+    }
+  }
+
+  for (size_t f = 0; f < 4; f++) {
+    for (size_t len = 0; len <= 200; len += (len < 40) ? 1 : 13) {
+      memcpy(g_have_array_u8, src, sizeof src);
+      memcpy(g_want_array_u8, src, sizeof src);
+      (*simd_funcs[f])(&t, g_have_array_u8, 4 * len);
+      (*funcs[f])(&t, g_want_array_u8, 4 * len);
+
+      wuffs_base__io_buffer have =
+          wuffs_base__ptr_u8__reader(g_have_array_u8, sizeof src, true);
+      wuffs_base__io_buffer want =
+          wuffs_base__ptr_u8__reader(g_want_array_u8, sizeof src, true);
+      char prefix_buf[64];
+      snprintf(prefix_buf, sizeof prefix_buf, "f=%zu, len=%zu: ", f, len);
+      CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_color_ycc_as_color_u32() {
   CHECK_FOCUS(__func__);
@@ -298,6 +519,522 @@ test_wuffs_pixel_buffer_fill_rect() {
   return NULL;
 }
 
+const char*  //
+test_wuffs_pixel_buffer_swizzle_planar_from() {
+  CHECK_FOCUS(__func__);
+
+  const uint32_t width = 5;
+  const uint32_t height = 3;
+
+  // Tightly packed planes: 15 (Y) + 2 × 15 (Cb, Cr) bytes for 4:4:4 and 15 +
+  // 2 × (3 × 2) bytes for 4:2:0.
+  wuffs_base__pixel_config pixcfg444 = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pixcfg444, WUFFS_BASE__PIXEL_FORMAT__YCBCR,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__444, width,
+                                height);
+  wuffs_base__pixel_config pixcfg420 = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pixcfg420, WUFFS_BASE__PIXEL_FORMAT__YCBCR,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__420, width,
+                                height);
+  if (wuffs_base__pixel_config__pixbuf_len(&pixcfg444) != 45) {
+    RETURN_FAIL("pixbuf_len (444): have %" PRIu64 ", want 45",
+                wuffs_base__pixel_config__pixbuf_len(&pixcfg444));
+  } else if (wuffs_base__pixel_config__pixbuf_len(&pixcfg420) != 27) {
+    RETURN_FAIL("pixbuf_len (420): have %" PRIu64 ", want 27",
+                wuffs_base__pixel_config__pixbuf_len(&pixcfg420));
+  }
+
+  wuffs_base__pixel_buffer pb444 = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice (444)",
+               wuffs_base__pixel_buffer__set_from_slice(&pb444, &pixcfg444,
+                                                        g_have_slice_u8));
+  wuffs_base__pixel_buffer pb420 = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice (420)",
+               wuffs_base__pixel_buffer__set_from_slice(&pb420, &pixcfg420,
+                                                        g_want_slice_u8));
+  wuffs_base__table_u8 cr420 = wuffs_base__pixel_buffer__plane(&pb420, 2);
+  if ((cr420.width != 3) || (cr420.height != 2) ||
+      (cr420.ptr != (g_want_slice_u8.ptr + 21))) {
+    RETURN_FAIL("Cr plane (420): bad dimensions");
+  }
+
+  // 4:4:4 to 4:2:0 averages each 2×2 block, clamping at the edges.
+  for (uint32_t p = 0; p < 3; p++) {
+    wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pb444, p);
+    for (uint32_t y = 0; y < height; y++) {
+      for (uint32_t x = 0; x < width; x++) {
+        tab.ptr[(y * tab.stride) + x] =
+            (uint8_t)((p * 50) + (10 * x) + (40 * y));
+      }
+    }
+  }
+  CHECK_STATUS("swizzle_planar_from (444 to 420)",
+               wuffs_base__pixel_buffer__swizzle_planar_from(&pb420, &pb444));
+  const struct {
+    uint32_t p;
+    uint32_t i;
+    uint32_t j;
+    uint8_t want;
+  } down_tcs[] = {
+      {.p = 0, .i = 4, .j = 2, .want = 120},  // Y is copied.
+      {.p = 1, .i = 0, .j = 0, .want = 75},   // (50 + 60 + 90 + 100) / 4.
+      {.p = 1, .i = 2, .j = 0, .want = 110},  // (90 + 90 + 130 + 130) / 4.
+      {.p = 2, .i = 2, .j = 1, .want = 220},  // Just (4, 2): 100 + 40 + 80.
+  };
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(down_tcs); tc++) {
+    wuffs_base__table_u8 tab =
+        wuffs_base__pixel_buffer__plane(&pb420, down_tcs[tc].p);
+    uint8_t have = tab.ptr[(down_tcs[tc].j * tab.stride) + down_tcs[tc].i];
+    if (have != down_tcs[tc].want) {
+      RETURN_FAIL("down tc=%zu: have %d, want %d", tc, have, down_tcs[tc].want);
+    }
+  }
+
+  // 4:2:0 to 4:4:4 uses a 9:3:3:1 triangle filter.
+  for (uint32_t p = 0; p < 3; p++) {
+    wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pb420, p);
+    for (uint32_t j = 0; j < tab.height; j++) {
+      for (uint32_t i = 0; i < tab.width; i++) {
+        tab.ptr[(j * tab.stride) + i] = (uint8_t)((16 * i) + (64 * j));
+      }
+    }
+  }
+  CHECK_STATUS("swizzle_planar_from (420 to 444)",
+               wuffs_base__pixel_buffer__swizzle_planar_from(&pb444, &pb420));
+  const struct {
+    uint32_t p;
+    uint32_t x;
+    uint32_t y;
+    uint8_t want;
+  } up_tcs[] = {
+      {.p = 0, .x = 3, .y = 2, .want = 176},  // Y is copied.
+      {.p = 1, .x = 0, .y = 0, .want = 0},    // Clamped: just (0, 0).
+      {.p = 1, .x = 1, .y = 1, .want = 20},   // (9*0 + 3*16 + 3*64 + 80) / 16.
+      {.p = 2, .x = 4, .y = 2, .want = 76},   // (9*96 + 3*32 + 3*80 + 16) / 16.
+  };
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(up_tcs); tc++) {
+    wuffs_base__table_u8 tab =
+        wuffs_base__pixel_buffer__plane(&pb444, up_tcs[tc].p);
+    uint8_t have = tab.ptr[(up_tcs[tc].y * tab.stride) + up_tcs[tc].x];
+    if (have != up_tcs[tc].want) {
+      RETURN_FAIL("up tc=%zu: have %d, want %d", tc, have, up_tcs[tc].want);
+    }
+  }
+
+  // Unsupported conversions.
+  wuffs_base__pixel_config pixcfg411 = pixcfg444;
+  pixcfg411.private_impl.pixsub.repr = WUFFS_BASE__PIXEL_SUBSAMPLING__411;
+  wuffs_base__pixel_buffer pb411 = pb444;
+  pb411.pixcfg = pixcfg411;
+  wuffs_base__status status =
+      wuffs_base__pixel_buffer__swizzle_planar_from(&pb411, &pb444);
+  if (status.repr != wuffs_base__error__unsupported_pixel_swizzler_option) {
+    RETURN_FAIL("411: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__unsupported_pixel_swizzler_option);
+  }
+  wuffs_base__pixel_buffer pb_smaller = pb444;
+  pb_smaller.pixcfg.private_impl.height = height - 1;
+  status = wuffs_base__pixel_buffer__swizzle_planar_from(&pb_smaller, &pb420);
+  if (status.repr != wuffs_base__error__bad_argument) {
+    RETURN_FAIL("smaller: have \"%s\", want \"%s\"", status.repr,
+                wuffs_base__error__bad_argument);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_quantizer_build_palette() {
+  CHECK_FOCUS(__func__);
+
+  // The source image has four opaque colors, one per quadrant, and a few
+  // transparent pixels.
+  const uint32_t width = 16;
+  const uint32_t height = 16;
+  const uint32_t colors[4] = {
+      0xFF102030,
+      0xFFF0E0D0,
+      0xFF20C040,
+      0xFF8080FF,
+  };
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pc, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &pb, &pc, wuffs_base__make_slice_u8(g_src_array_u8,
+                                                       4 * width * height)));
+  for (uint32_t y = 0; y < height; y++) {
+    for (uint32_t x = 0; x < width; x++) {
+      uint32_t c = colors[((y / 8) * 2) + (x / 8)];
+      if ((x < 2) && (y < 2)) {
+        c = 0x00000000;
+      }
+      wuffs_base__poke_u32le__no_bounds_check(
+          g_src_array_u8 + (4 * ((y * width) + x)), c);
+    }
+  }
+
+  wuffs_base__pixel_quantizer q = ((wuffs_base__pixel_quantizer){});
+  wuffs_base__slice_u8 workbuf = wuffs_base__make_slice_u8(
+      g_work_array_u8,
+      (size_t)wuffs_base__pixel_quantizer__build_palette_workbuf_len());
+
+  // Check the bad arguments.
+  const uint32_t bad_max_colors[2] = {0, 257};
+  for (int i = 0; i < 2; i++) {
+    wuffs_base__status status = wuffs_base__pixel_quantizer__build_palette(
+        &q, &pb, bad_max_colors[i], workbuf);
+    if (status.repr != wuffs_base__error__bad_argument) {
+      RETURN_FAIL("max_colors=%" PRIu32 ": have \"%s\", want \"%s\"",
+                  bad_max_colors[i], status.repr,
+                  wuffs_base__error__bad_argument);
+    }
+  }
+  {
+    wuffs_base__status status = wuffs_base__pixel_quantizer__build_palette(
+        &q, &pb, 256, wuffs_base__make_slice_u8(workbuf.ptr, workbuf.len - 1));
+    if (status.repr != wuffs_base__error__bad_argument) {
+      RETURN_FAIL("short workbuf: have \"%s\", want \"%s\"", status.repr,
+                  wuffs_base__error__bad_argument);
+    }
+  }
+
+  // With enough colors, every source color is reproduced exactly and the
+  // transparent entry is last.
+  CHECK_STATUS("build_palette", wuffs_base__pixel_quantizer__build_palette(
+                                    &q, &pb, 256, workbuf));
+  if (wuffs_base__pixel_quantizer__num_colors(&q) != 5) {
+    RETURN_FAIL("num_colors: have %" PRIu32 ", want 5",
+                wuffs_base__pixel_quantizer__num_colors(&q));
+  }
+  wuffs_base__slice_u8 palette = wuffs_base__pixel_quantizer__palette(&q);
+  for (int i = 0; i < 4; i++) {
+    bool found = false;
+    for (int j = 0; j < 4; j++) {
+      found = found || (wuffs_base__peek_u32le__no_bounds_check(
+                            palette.ptr + (4 * j)) == colors[i]);
+    }
+    if (!found) {
+      RETURN_FAIL("i=%d: color 0x%08" PRIX32 " not found", i, colors[i]);
+    }
+  }
+  for (int j = 4; j < 256; j++) {
+    uint32_t have = wuffs_base__peek_u32le__no_bounds_check(palette.ptr +
+                                                            (4 * j));
+    if (have != 0) {
+      RETURN_FAIL("j=%d: have 0x%08" PRIX32 ", want 0x00000000", j, have);
+    }
+  }
+
+  // With fewer colors, max_colors is respected and the transparent entry is
+  // still last.
+  CHECK_STATUS("build_palette", wuffs_base__pixel_quantizer__build_palette(
+                                    &q, &pb, 3, workbuf));
+  if (wuffs_base__pixel_quantizer__num_colors(&q) != 3) {
+    RETURN_FAIL("num_colors: have %" PRIu32 ", want 3",
+                wuffs_base__pixel_quantizer__num_colors(&q));
+  }
+  for (int j = 0; j < 3; j++) {
+    uint32_t have_alpha = palette.ptr[(4 * j) + 3];
+    uint32_t want_alpha = (j < 2) ? 0xFF : 0x00;
+    if (have_alpha != want_alpha) {
+      RETURN_FAIL("j=%d: alpha: have 0x%02" PRIX32 ", want 0x%02" PRIX32, j,
+                  have_alpha, want_alpha);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_quantizer_simd() {
+  CHECK_FOCUS(__func__);
+
+  void (*simd_fill_cache_row)(uint8_t* dst_ptr, const int32_t* rga_scores,
+                              const int32_t* premul_bs,
+                              uint32_t num_colors) = NULL;
+  wuffs_base__pixel_swizzler__quantize_func simd_quantize_cached = NULL;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    simd_fill_cache_row = wuffs_base__pixel_quantizer__fill_cache_row__x86_avx2;
+    simd_quantize_cached =
+        wuffs_base__pixel_swizzler__quantize_cached__x86_avx2;
+  }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    simd_fill_cache_row = wuffs_base__pixel_quantizer__fill_cache_row__arm_neon;
+  }
+#endif
+  if (!simd_fill_cache_row) {
+    return NULL;
+  }
+
+  uint32_t r = 0x12345678;
+  int32_t rga_scores[256];
+  int32_t premul_bs[256];
+  for (uint32_t n = 1; n <= 256; n += (n < 20) ? 1 : 29) {
+    for (uint32_t i = 0; i < n; i++) {
+      r ^= r << 13;
+      r ^= r >> 17;
+      r ^= r << 5;
+      rga_scores[i] = (int32_t)(r & 0x1FFFF);
+      premul_bs[i] = (int32_t)(r >> 24);
+    }
+    uint8_t have[32];
+    uint8_t want[32];
+    (*simd_fill_cache_row)(have, rga_scores, premul_bs, n);
+    wuffs_base__pixel_quantizer__fill_cache_row(want, rga_scores, premul_bs,
+                                                n);
+    for (int b = 0; b < 32; b++) {
+      if (have[b] != want[b]) {
+        RETURN_FAIL("n=%" PRIu32 ", b=%d: fill_cache_row: have %" PRIu32
+                    ", want %" PRIu32,
+                    n, b, (uint32_t)have[b], (uint32_t)want[b]);
+      }
+    }
+  }
+
+  if (!simd_quantize_cached) {
+    return NULL;
+  }
+  wuffs_base__pixel_quantizer q = ((wuffs_base__pixel_quantizer){});
+  uint8_t palette[4 * 64];
+  for (size_t i = 0; i < sizeof palette; i++) {
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    palette[i] = ((i & 3) == 3) ? 0xFF : (uint8_t)(r >> 24);
+  }
+  CHECK_STATUS("set_palette",
+               wuffs_base__pixel_quantizer__set_palette(
+                   &q, wuffs_base__make_slice_u8(palette, sizeof palette)));
+
+  uint8_t src[4 * 80];
+  for (size_t i = 0; i < sizeof src; i++) {
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    src[i] = (uint8_t)(r >> 24);
+  }
+  for (size_t len = 0; len <= 80; len += (len < 20) ? 1 : 7) {
+    // Make the first len pixels either all opaque or (for odd len) all but
+    // one opaque.
+    for (size_t i = 0; i < len; i++) {
+      src[(4 * i) + 3] = ((len & 1) && (i == (len / 2))) ? 0x80 : 0xFF;
+    }
+    memset(g_have_array_u8, 0, 80);
+    memset(g_want_array_u8, 0, 80);
+    bool have_opaque = (*simd_quantize_cached)(&q, g_have_array_u8, src, len);
+    bool want_opaque = wuffs_base__pixel_swizzler__quantize_cached(
+        &q, g_want_array_u8, src, len);
+    if (have_opaque != want_opaque) {
+      RETURN_FAIL("len=%zu: opaque: have %d, want %d", len, have_opaque,
+                  want_opaque);
+    }
+
+    wuffs_base__io_buffer have =
+        wuffs_base__ptr_u8__reader(g_have_array_u8, 80, true);
+    wuffs_base__io_buffer want =
+        wuffs_base__ptr_u8__reader(g_want_array_u8, 80, true);
+    char prefix_buf[64];
+    snprintf(prefix_buf, sizeof prefix_buf, "len=%zu: ", len);
+    CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_resampler_resample() {
+  CHECK_FOCUS(__func__);
+
+  // A 2:1 box filter averages each 2×2 block, rounding halves up.
+  {
+    const uint8_t src_array[32] = {
+        0x0A, 0x00, 0x00, 0xFF, 0x14, 0x01, 0x00, 0xFF,  //
+        0x40, 0x80, 0x00, 0x80, 0x40, 0x80, 0x00, 0x80,  //
+        0x1E, 0x02, 0x00, 0xFF, 0x29, 0x02, 0x00, 0xFF,  //
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,  //
+    };
+    const uint8_t want_array[8] = {
+        0x19, 0x01, 0x00, 0xFF, 0x20, 0x40, 0x00, 0x40,  //
+    };
+
+    wuffs_base__pixel_config src_pixcfg = ((wuffs_base__pixel_config){});
+    wuffs_base__pixel_config__set(&src_pixcfg,
+                                  WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 4, 2);
+    wuffs_base__pixel_buffer src_pixbuf = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice (src)",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &src_pixbuf, &src_pixcfg,
+                     wuffs_base__make_slice_u8((uint8_t*)(void*)src_array,
+                                               sizeof src_array)));
+
+    wuffs_base__pixel_config dst_pixcfg = ((wuffs_base__pixel_config){});
+    wuffs_base__pixel_config__set(&dst_pixcfg,
+                                  WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 2, 1);
+    wuffs_base__pixel_buffer dst_pixbuf = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice (dst)",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &dst_pixbuf, &dst_pixcfg,
+                     wuffs_base__make_slice_u8(g_have_array_u8, 8)));
+
+    wuffs_base__pixel_resampler resampler;
+    CHECK_STATUS("prepare",
+                 wuffs_base__pixel_resampler__prepare(
+                     &resampler, src_pixcfg.private_impl.pixfmt, 2, 1, 4, 2,
+                     WUFFS_BASE__PIXEL_RESAMPLING_FILTER__BOX, g_work_slice_u8));
+    CHECK_STATUS("resample", wuffs_base__pixel_resampler__resample(
+                                 &resampler, &dst_pixbuf, &src_pixbuf));
+
+    wuffs_base__io_buffer have =
+        wuffs_base__ptr_u8__reader(g_have_array_u8, 8, true);
+    wuffs_base__io_buffer want =
+        wuffs_base__ptr_u8__reader((uint8_t*)(void*)want_array, 8, true);
+    CHECK_STRING(check_io_buffers_equal("box: ", &have, &want));
+  }
+
+  // The resampler picks a SIMD implementation (if the CPU supports one). Check
+  // that it matches the non-SIMD implementation, that flat images stay flat
+  // and that premultiplied colors stay no greater than their alpha.
+  const struct {
+    uint32_t dst_width;
+    uint32_t dst_height;
+    uint32_t src_width;
+    uint32_t src_height;
+    wuffs_base__pixel_resampling_filter filter;
+  } tcs[] = {
+      {37, 23, 100, 61, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3},
+      {150, 91, 61, 40, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3},
+      {40, 30, 80, 60, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__BOX},
+      {80, 17, 33, 60, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__MITCHELL},
+      {7, 5, 2, 3, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3},
+      {1, 1, 300, 1, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__MITCHELL},
+  };
+
+  uint32_t x = 0x12345678;
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    const uint32_t dw = tcs[tc].dst_width;
+    const uint32_t dh = tcs[tc].dst_height;
+    const uint32_t sw = tcs[tc].src_width;
+    const uint32_t sh = tcs[tc].src_height;
+    const size_t dst_len = 4 * ((size_t)dw) * dh;
+    const size_t src_len = 4 * ((size_t)sw) * sh;
+
+    for (int flat = 0; flat < 2; flat++) {
+      for (size_t i = 0; i < src_len; i += 4) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        uint32_t c = flat ? 0x80604020 : x;
+        uint8_t a = (uint8_t)(c >> 24);
+        for (size_t j = 0; j < 3; j++) {
+          uint8_t v = (uint8_t)(c >> (8 * j));
+          g_src_slice_u8.ptr[i + j] = (v < a) ? v : a;
+        }
+        g_src_slice_u8.ptr[i + 3] = a;
+      }
+
+      wuffs_base__pixel_config src_pixcfg = ((wuffs_base__pixel_config){});
+      wuffs_base__pixel_config__set(&src_pixcfg,
+                                    WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                    WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, sw, sh);
+      wuffs_base__pixel_buffer src_pixbuf = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice (src)",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &src_pixbuf, &src_pixcfg,
+                       wuffs_base__make_slice_u8(g_src_slice_u8.ptr, src_len)));
+
+      wuffs_base__pixel_config dst_pixcfg = ((wuffs_base__pixel_config){});
+      wuffs_base__pixel_config__set(&dst_pixcfg,
+                                    WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                    WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, dw, dh);
+      wuffs_base__pixel_buffer have_pixbuf = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice (have)",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &have_pixbuf, &dst_pixcfg,
+                       wuffs_base__make_slice_u8(g_have_slice_u8.ptr, dst_len)));
+      wuffs_base__pixel_buffer want_pixbuf = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice (want)",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &want_pixbuf, &dst_pixcfg,
+                       wuffs_base__make_slice_u8(g_want_slice_u8.ptr, dst_len)));
+
+      if (g_work_slice_u8.len < wuffs_base__pixel_resampler__workbuf_len(
+                                    dw, dh, sw, sh, tcs[tc].filter)) {
+        RETURN_FAIL("tc=%zu: work buffer is too short", tc);
+      }
+
+      // Push the rows one at a time, for the SIMD have.
+      wuffs_base__pixel_resampler resampler;
+      CHECK_STATUS("prepare",
+                   wuffs_base__pixel_resampler__prepare(
+                       &resampler, src_pixcfg.private_impl.pixfmt, dw, dh, sw,
+                       sh, tcs[tc].filter, g_work_slice_u8));
+      uint32_t prev_n = 0;
+      for (uint32_t y = 0; y < sh; y++) {
+        CHECK_STATUS("push_src_row",
+                     wuffs_base__pixel_resampler__push_src_row(
+                         &resampler, &have_pixbuf,
+                         wuffs_base__make_slice_u8(
+                             g_src_slice_u8.ptr + (4 * ((size_t)sw) * y),
+                             4 * ((size_t)sw))));
+        uint32_t n =
+            wuffs_base__pixel_resampler__num_dst_rows_written(&resampler);
+        if (n < prev_n) {
+          RETURN_FAIL("tc=%zu: num_dst_rows_written went backwards", tc);
+        }
+        prev_n = n;
+      }
+      if (prev_n != dh) {
+        RETURN_FAIL("tc=%zu: num_dst_rows_written: have %" PRIu32
+                    ", want %" PRIu32,
+                    tc, prev_n, dh);
+      }
+      wuffs_base__status extra_status =
+          wuffs_base__pixel_resampler__push_src_row(
+              &resampler, &have_pixbuf,
+              wuffs_base__make_slice_u8(g_src_slice_u8.ptr, 4 * ((size_t)sw)));
+      if (extra_status.repr != wuffs_base__error__bad_call_sequence) {
+        RETURN_FAIL("tc=%zu: extra push_src_row: have \"%s\", want \"%s\"", tc,
+                    extra_status.repr, wuffs_base__error__bad_call_sequence);
+      }
+
+      // Resample all at once, with the non-SIMD implementation, for the want.
+      CHECK_STATUS("prepare",
+                   wuffs_base__pixel_resampler__prepare(
+                       &resampler, src_pixcfg.private_impl.pixfmt, dw, dh, sw,
+                       sh, tcs[tc].filter, g_work_slice_u8));
+      resampler.private_impl.h_func = &wuffs_base__pixel_resampler__resample_h;
+      resampler.private_impl.v_func = &wuffs_base__pixel_resampler__resample_v;
+      CHECK_STATUS("resample", wuffs_base__pixel_resampler__resample(
+                                   &resampler, &want_pixbuf, &src_pixbuf));
+
+      char prefix_buf[64];
+      snprintf(prefix_buf, sizeof prefix_buf, "tc=%zu, flat=%d: ", tc, flat);
+      wuffs_base__io_buffer have =
+          wuffs_base__ptr_u8__reader(g_have_slice_u8.ptr, dst_len, true);
+      wuffs_base__io_buffer want =
+          wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, dst_len, true);
+      CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+
+      for (size_t i = 0; i < dst_len; i += 4) {
+        const uint8_t* p = g_have_slice_u8.ptr + i;
+        if ((p[0] > p[3]) || (p[1] > p[3]) || (p[2] > p[3])) {
+          RETURN_FAIL("%si=%zu: color exceeds alpha", prefix_buf, i);
+        } else if (flat && (wuffs_base__peek_u32le__no_bounds_check(p) !=
+                            0x80604020)) {
+          RETURN_FAIL("%si=%zu: flat image did not stay flat", prefix_buf, i);
+        }
+      }
+    }
+  }
+  return NULL;
+}
+
 const char*  //
 test_wuffs_pixel_swizzler_swizzle() {
   CHECK_FOCUS(__func__);
@@ -394,6 +1131,10 @@ test_wuffs_pixel_swizzler_swizzle() {
           .color = 0x80000040,
           .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
       },
+      {
+          .color = 0x80102040,
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE,
+      },
       {
           .color = 0xFF002233,
           .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGB,
@@ -406,6 +1147,26 @@ test_wuffs_pixel_swizzler_swizzle() {
           .color = 0x33002233,
           .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
       },
+      {
+          .color = 0x33221100,
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE,
+      },
+      {
+          .color = 0x80102040,
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16,
+      },
+      {
+          .color = 0x80102040,
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR,
+      },
+      {
+          .color = 0x33221100,
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32,
+      },
+      {
+          .color = 0x33221100,
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR,
+      },
   };
 
   const wuffs_base__pixel_blend blends[] = {
@@ -493,6 +1254,14 @@ test_wuffs_pixel_swizzler_swizzle() {
         if (blends[b] == WUFFS_BASE__PIXEL_BLEND__SRC) {
           want_dst_pixel = srcs[s].color;
         } else if (blends[b] == WUFFS_BASE__PIXEL_BLEND__SRC_OVER) {
+          // The _LINEAR pixel formats composite in linear light, which gives
+          // a different (but not wrong) result.
+          if ((dsts[d].pixfmt_repr ==
+               WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR) ||
+              (dsts[d].pixfmt_repr ==
+               WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR)) {
+            continue;
+          }
           tolerance += 1;
           want_dst_pixel = wuffs_base__composite_premul_premul_u32_axxx(
               dsts[d].color, srcs[s].color);
@@ -517,62 +1286,1215 @@ test_wuffs_pixel_swizzler_swizzle() {
 }
 
 const char*  //
-test_wuffs_upsample_inv_h2v1() {
+test_wuffs_pixel_swizzler_swizzle_tiles() {
   CHECK_FOCUS(__func__);
 
-  // src_array0 is "A lovely example".
-  const uint8_t src_array0[16] = {
-      0x41, 0x20, 0x6C, 0x6F, 0x76, 0x65, 0x6C, 0x79,  //
-      0x20, 0x65, 0x78, 0x61, 0x6D, 0x70, 0x6C, 0x65,  //
-  };
+  // Six 5x3 RGBA_NONPREMUL tiles, with either padded or contiguous rows, are
+  // converted either across or down a sprite sheet.
+  const uint32_t tile_width = 5;
+  const uint32_t tile_height = 3;
+  const size_t num_tiles = 6;
+  uint8_t src[8 * 5 * 3 * 6];
+  for (size_t i = 0; i < sizeof src; i++) {
+    src[i] = (uint8_t)((i * 0x35) + 7);
+  }
 
-  const uint8_t want_array[32] = {
-      // A box filter (nearest neighbor) would look like this:
-      //   0x41, 0x41, 0x20, 0x20, 0x6C, 0x6C, 0x6F, 0x6F,
-      //   0x76, 0x76, 0x65, 0x65, 0x6C, 0x6C, 0x79, 0x79,
-      //   0x20, 0x20, 0x65, 0x65, 0x78, 0x78, 0x61, 0x61,
-      //   0x6D, 0x6D, 0x70, 0x70, 0x6C, 0x6C, 0x65, 0x65,
-      // We use a triangle filter instead, matching libjpeg-turbo.
-      0x41, 0x39, 0x28, 0x33, 0x59, 0x6D, 0x6E, 0x71,  //
-      0x74, 0x72, 0x69, 0x67, 0x6A, 0x6F, 0x76, 0x63,  //
-      0x36, 0x31, 0x54, 0x6A, 0x73, 0x72, 0x67, 0x64,  //
-      0x6A, 0x6E, 0x6F, 0x6F, 0x6D, 0x6A, 0x67, 0x65,  //
+  const uint32_t dst_pixfmt_reprs[2] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGR_565,
   };
+  for (int d = 0; d < 2; d++) {
+    wuffs_base__pixel_format dst_pixfmt =
+        wuffs_base__make_pixel_format(dst_pixfmt_reprs[d]);
+    size_t dst_bpp = wuffs_base__pixel_format__bits_per_pixel(&dst_pixfmt) / 8;
+    for (int layout = 0; layout < 4; layout++) {
+      bool across = (layout & 1) != 0;
+      bool padded = (layout & 2) != 0;
+      size_t src_stride = (padded ? 8 : 4) * tile_width;
+      size_t src_tile_stride = src_stride * tile_height;
+      uint32_t sheet_width = across ? (tile_width * num_tiles) : tile_width;
+      uint32_t sheet_height = across ? tile_height : (tile_height * num_tiles);
+
+      wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+      wuffs_base__pixel_config__set(&pc, dst_pixfmt_reprs[d],
+                                    WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+                                    sheet_width, sheet_height);
+      wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+      CHECK_STATUS("set_from_slice",
+                   wuffs_base__pixel_buffer__set_from_slice(
+                       &pb, &pc,
+                       wuffs_base__make_slice_u8(
+                           g_have_array_u8,
+                           dst_bpp * sheet_width * sheet_height)));
+      wuffs_base__table_u8 sheet = wuffs_base__pixel_buffer__plane(&pb, 0);
+      size_t dst_tile_stride =
+          across ? (dst_bpp * tile_width) : (sheet.stride * tile_height);
+      size_t sheet_len = sheet.stride * sheet_height;
+
+      wuffs_base__pixel_swizzler swizzler;
+      CHECK_STATUS("prepare", wuffs_base__pixel_swizzler__prepare(
+                                  &swizzler, dst_pixfmt,
+                                  wuffs_base__empty_slice_u8(),
+                                  wuffs_base__make_pixel_format(
+                                      WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL),
+                                  wuffs_base__empty_slice_u8(),
+                                  WUFFS_BASE__PIXEL_BLEND__SRC));
+      // Ordered dithering (for BGR_565) depends on each pixel's position.
+      CHECK_STATUS("set_dither", wuffs_base__pixel_swizzler__set_dither(
+                                     &swizzler, &pb,
+                                     WUFFS_BASE__PIXEL_DITHER__ORDERED,
+                                     wuffs_base__empty_slice_u8()));
+
+      // The want pixels are converted one row at a time.
+      memset(sheet.ptr, 0, sheet_len);
+      for (size_t i = 0; i < num_tiles; i++) {
+        for (uint32_t y = 0; y < tile_height; y++) {
+          wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+              &swizzler,
+              wuffs_base__make_slice_u8(
+                  sheet.ptr + (i * dst_tile_stride) + (y * sheet.stride),
+                  dst_bpp * tile_width),
+              wuffs_base__empty_slice_u8(),
+              wuffs_base__make_slice_u8(
+                  src + (i * src_tile_stride) + (y * src_stride),
+                  4 * tile_width));
+        }
+      }
+      memcpy(g_want_array_u8, sheet.ptr, sheet_len);
+
+      for (int batch = 0; batch < 2; batch++) {
+        wuffs_base__table_u8 dst_tile = wuffs_base__make_table_u8(
+            sheet.ptr, dst_bpp * tile_width, tile_height, sheet.stride);
+        wuffs_base__table_u8 src_tile = wuffs_base__make_table_u8(
+            src, 4 * tile_width, tile_height, src_stride);
+        uint64_t have_n = 0;
+        memset(sheet.ptr, 0, sheet_len);
+        if (batch) {
+          have_n = wuffs_base__pixel_swizzler__swizzle_interleaved_tiles(
+              &swizzler, dst_tile, dst_tile_stride,
+              wuffs_base__empty_slice_u8(), src_tile, src_tile_stride,
+              num_tiles);
+        } else {
+          for (size_t i = 0; i < num_tiles; i++) {
+            have_n +=
+                wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+                    &swizzler, dst_tile, wuffs_base__empty_slice_u8(),
+                    src_tile);
+            dst_tile.ptr += dst_tile_stride;
+            src_tile.ptr += src_tile_stride;
+          }
+        }
+        uint64_t want_n = tile_width * tile_height * num_tiles;
+        if (have_n != want_n) {
+          RETURN_FAIL("d=%d, layout=%d, batch=%d: have %" PRIu64
+                      " pixels, want %" PRIu64,
+                      d, layout, batch, have_n, want_n);
+        }
 
-  const uint8_t* have_ptr =
-      wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle(
-          g_have_array_u8, src_array0, src_array0, 16, 0, true, true);
-
-  const bool closed = true;
-  wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(  //
-      (uint8_t*)(void*)have_ptr, 32, closed);
-  wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(  //
-      (uint8_t*)(void*)want_array, 32, closed);
-
-  return check_io_buffers_equal("", &have, &want);
+        wuffs_base__io_buffer have =
+            wuffs_base__ptr_u8__reader(sheet.ptr, sheet_len, true);
+        wuffs_base__io_buffer want =
+            wuffs_base__ptr_u8__reader(g_want_array_u8, sheet_len, true);
+        char prefix_buf[64];
+        snprintf(prefix_buf, sizeof prefix_buf,
+                 "d=%d, layout=%d, batch=%d: ", d, layout, batch);
+        CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+      }
+    }
+  }
+  return NULL;
 }
 
-// ---------------- WBMP Tests
-
 const char*  //
-test_wuffs_wbmp_decode_interface() {
+test_wuffs_pixel_swizzler_cache() {
   CHECK_FOCUS(__func__);
-  wuffs_wbmp__decoder dec;
-  CHECK_STATUS("initialize",
-               wuffs_wbmp__decoder__initialize(
-                   &dec, sizeof dec, WUFFS_VERSION,
-                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
-  return do_test__wuffs_base__image_decoder(
-      wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(&dec),
-      "test/data/muybridge-frame-000.wbmp", 0, SIZE_MAX, 30, 20, 0xFFFFFFFF);
-}
 
-const char*  //
-test_wuffs_wbmp_decode_truncated_input() {
-  CHECK_FOCUS(__func__);
+  uint8_t src[4 * 16];
+  for (size_t i = 0; i < sizeof src; i++) {
+    src[i] = (uint8_t)((i * 0x35) + 7);
+  }
+  wuffs_base__pixel_format src_pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL);
+
+  // Prepare more distinct pixel swizzlers (5 destination pixel formats times
+  // 2 blends) than the cache holds, then again in reverse order (so that the
+  // first 8 are cache hits), checking that each one converts like a freshly
+  // prepared one.
+  const uint32_t dst_pixfmt_reprs[5] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGR,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+  };
+  wuffs_base__pixel_swizzler_cache cache =
+      ((wuffs_base__pixel_swizzler_cache){});
+  for (int pass = 0; pass < 2; pass++) {
+    for (int j = 0; j < 10; j++) {
+      int k = pass ? (9 - j) : j;
+      int d = k / 2;
+      wuffs_base__pixel_blend blend = (wuffs_base__pixel_blend)(k & 1);
+      wuffs_base__pixel_format dst_pixfmt =
+          wuffs_base__make_pixel_format(dst_pixfmt_reprs[d]);
+      size_t dst_len =
+          16 * (wuffs_base__pixel_format__bits_per_pixel(&dst_pixfmt) / 8);
+
+      wuffs_base__pixel_swizzler have_swizzler;
+      CHECK_STATUS("cache.prepare",
+                   wuffs_base__pixel_swizzler_cache__prepare(
+                       &cache, &have_swizzler, dst_pixfmt,
+                       wuffs_base__empty_slice_u8(), src_pixfmt,
+                       wuffs_base__empty_slice_u8(), blend));
+      wuffs_base__pixel_swizzler want_swizzler;
+      CHECK_STATUS("prepare", wuffs_base__pixel_swizzler__prepare(
+                                  &want_swizzler, dst_pixfmt,
+                                  wuffs_base__empty_slice_u8(), src_pixfmt,
+                                  wuffs_base__empty_slice_u8(), blend));
+
+      // Configuring the returned pixel swizzler should not affect the cache's
+      // copy, which the next pass uses.
+      if ((pass == 0) && (blend == WUFFS_BASE__PIXEL_BLEND__SRC)) {
+        wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+        wuffs_base__pixel_config__set(&pc, dst_pixfmt_reprs[d],
+                                      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, 16,
+                                      1);
+        wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+        CHECK_STATUS("set_from_slice",
+                     wuffs_base__pixel_buffer__set_from_slice(
+                         &pb, &pc,
+                         wuffs_base__make_slice_u8(g_work_array_u8, dst_len)));
+        CHECK_STATUS("set_dither",
+                     wuffs_base__pixel_swizzler__set_dither(
+                         &have_swizzler, &pb,
+                         WUFFS_BASE__PIXEL_DITHER__ORDERED,
+                         wuffs_base__empty_slice_u8()));
+      }
+      if (pass == 0) {
+        continue;
+      }
 
-  wuffs_base__io_buffer src =
-      wuffs_base__ptr_u8__reader(g_src_array_u8, 0, false);
+      memset(g_have_array_u8, 0, dst_len);
+      memset(g_want_array_u8, 0, dst_len);
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &have_swizzler, wuffs_base__make_slice_u8(g_have_array_u8, dst_len),
+          wuffs_base__empty_slice_u8(),
+          wuffs_base__make_slice_u8(src, sizeof src));
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &want_swizzler, wuffs_base__make_slice_u8(g_want_array_u8, dst_len),
+          wuffs_base__empty_slice_u8(),
+          wuffs_base__make_slice_u8(src, sizeof src));
+
+      wuffs_base__io_buffer have =
+          wuffs_base__ptr_u8__reader(g_have_array_u8, dst_len, true);
+      wuffs_base__io_buffer want =
+          wuffs_base__ptr_u8__reader(g_want_array_u8, dst_len, true);
+      char prefix_buf[64];
+      snprintf(prefix_buf, sizeof prefix_buf, "k=%d: ", k);
+      CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+    }
+  }
+
+  // Failures are not cached.
+  for (int i = 0; i < 2; i++) {
+    wuffs_base__pixel_swizzler swizzler;
+    wuffs_base__status status = wuffs_base__pixel_swizzler_cache__prepare(
+        &cache, &swizzler,
+        wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL),
+        wuffs_base__empty_slice_u8(),
+        wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__YCBCR),
+        wuffs_base__empty_slice_u8(), WUFFS_BASE__PIXEL_BLEND__SRC);
+    if (status.repr != wuffs_base__error__unsupported_pixel_swizzler_option) {
+      RETURN_FAIL("i=%d: have \"%s\", want \"%s\"", i, status.repr,
+                  wuffs_base__error__unsupported_pixel_swizzler_option);
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_dither() {
+  CHECK_FOCUS(__func__);
+
+  const uint32_t width = 40;
+  const uint32_t height = 16;
+  // The want values are (v * 31 / 0xFFFF) or (v * 63 / 0xFFFF) for the
+  // BGRA_NONPREMUL_4X16LE source pixel's B, G and R channels.
+  const uint64_t src_pixel = 0xFFFFC0DE89AB4321u;
+  const double wants[3] = {
+      (0x4321 * 31.0) / 0xFFFF,
+      (0x89AB * 63.0) / 0xFFFF,
+      (0xC0DE * 31.0) / 0xFFFF,
+  };
+  uint8_t src[8 * 40];
+  for (uint32_t x = 0; x < width; x++) {
+    wuffs_base__poke_u64le__no_bounds_check(src + (8 * x), src_pixel);
+  }
+
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&pc, WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &pb, &pc, wuffs_base__make_slice_u8(g_have_array_u8,
+                                                       2 * width * height)));
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pb, 0);
+  uint8_t workbuf[64 + (12 * 40)];
+
+  wuffs_base__pixel_swizzler swizzler;
+  wuffs_base__pixel_dither dithers[2] = {
+      WUFFS_BASE__PIXEL_DITHER__ORDERED,
+      WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION,
+  };
+  for (int d = 0; d < 2; d++) {
+    CHECK_STATUS(
+        "prepare",
+        wuffs_base__pixel_swizzler__prepare(
+            &swizzler,
+            wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGR_565),
+            wuffs_base__empty_slice_u8(),
+            wuffs_base__make_pixel_format(
+                WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE),
+            wuffs_base__empty_slice_u8(), WUFFS_BASE__PIXEL_BLEND__SRC));
+
+    wuffs_base__status status = wuffs_base__pixel_swizzler__set_dither(
+        &swizzler, &pb, dithers[d],
+        wuffs_base__make_slice_u8(workbuf, sizeof workbuf - 1));
+    if (dithers[d] == WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION) {
+      if (status.repr != wuffs_base__error__bad_argument) {
+        RETURN_FAIL("d=%d: short workbuf: have \"%s\", want \"%s\"", d,
+                    status.repr, wuffs_base__error__bad_argument);
+      }
+    } else {
+      CHECK_STATUS("set_dither", status);
+    }
+    CHECK_STATUS("set_dither",
+                 wuffs_base__pixel_swizzler__set_dither(
+                     &swizzler, &pb, dithers[d],
+                     wuffs_base__make_slice_u8(workbuf, sizeof workbuf)));
+
+    // Convert each row in two parts, to check that error diffusion continues
+    // across swizzle calls.
+    for (uint32_t y = 0; y < height; y++) {
+      uint8_t* row = tab.ptr + (y * tab.stride);
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &swizzler, wuffs_base__make_slice_u8(row, 2 * 13),
+          wuffs_base__empty_slice_u8(),
+          wuffs_base__make_slice_u8(src, 8 * 13));
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &swizzler, wuffs_base__make_slice_u8(row + (2 * 13), 2 * 27),
+          wuffs_base__empty_slice_u8(),
+          wuffs_base__make_slice_u8(src + (8 * 13), 8 * 27));
+    }
+
+    // Every pixel should round the want value down or up, and on average
+    // the (dithered) pixels should be close to the want value.
+    uint32_t sums[3] = {0};
+    for (uint32_t y = 0; y < height; y++) {
+      for (uint32_t x = 0; x < width; x++) {
+        uint32_t c = wuffs_base__peek_u16le__no_bounds_check(
+            tab.ptr + (y * tab.stride) + (2 * x));
+        uint32_t channels[3] = {(c >> 0) & 0x1F, (c >> 5) & 0x3F,
+                                (c >> 11) & 0x1F};
+        for (int i = 0; i < 3; i++) {
+          if ((channels[i] != (uint32_t)(wants[i])) &&
+              (channels[i] != (uint32_t)(wants[i] + 1))) {
+            RETURN_FAIL("d=%d, x=%" PRIu32 ", y=%" PRIu32
+                        ", i=%d: have %" PRIu32 ", want %.3f",
+                        d, x, y, i, channels[i], wants[i]);
+          }
+          sums[i] += channels[i];
+        }
+      }
+    }
+    for (int i = 0; i < 3; i++) {
+      double mean = ((double)sums[i]) / (width * height);
+      if (((mean - wants[i]) > (1.0 / 16)) ||
+          ((wants[i] - mean) > (1.0 / 16))) {
+        RETURN_FAIL("d=%d, i=%d: mean: have %.3f, want %.3f", d, i, mean,
+                    wants[i]);
+      }
+    }
+
+    // Pixels outside of the pixel buffer are converted without dithering.
+    uint8_t outside[2 * 40];
+    wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+        &swizzler, wuffs_base__make_slice_u8(outside, sizeof outside),
+        wuffs_base__empty_slice_u8(),
+        wuffs_base__make_slice_u8(src, sizeof src));
+    uint16_t want_outside =
+        wuffs_base__color_u32_argb_premul__as__color_u16_rgb_565(
+            wuffs_base__color_u64_argb_nonpremul__as__color_u32_argb_premul(
+                src_pixel));
+    for (uint32_t x = 0; x < width; x++) {
+      uint16_t have_outside =
+          wuffs_base__peek_u16le__no_bounds_check(outside + (2 * x));
+      if (have_outside != want_outside) {
+        RETURN_FAIL("d=%d, x=%" PRIu32 ": outside: have 0x%04" PRIX16
+                    ", want 0x%04" PRIX16,
+                    d, x, have_outside, want_outside);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_dither_simd() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__pixel_swizzler__dither_func simd_func = NULL;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    simd_func = wuffs_base__pixel_swizzler__dither_ordered__bgr_565__x86_avx2;
+  }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    simd_func = wuffs_base__pixel_swizzler__dither_ordered__bgr_565__arm_neon;
+  }
+#endif
+  if (!simd_func) {
+    return NULL;
+  }
+
+  uint8_t src[8 * 80];
+  uint32_t r = 0x12345678;
+  for (size_t i = 0; i < sizeof src; i++) {
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    src[i] = (uint8_t)(r >> 24);
+  }
+  // Make some (but not all) pixels opaque.
+  for (size_t i = 0; i < 80; i += 3) {
+    src[(8 * i) + 6] = 0xFF;
+    src[(8 * i) + 7] = 0xFF;
+  }
+
+  for (uint32_t y = 0; y < 8; y++) {
+    for (uint32_t x = 0; x < 8; x += 3) {
+      for (size_t len = 0; len <= 80; len += (len < 20) ? 1 : 7) {
+        memset(g_have_array_u8, 0, 2 * 80);
+        memset(g_want_array_u8, 0, 2 * 80);
+        (*simd_func)(g_have_array_u8, src, len, x, y);
+        wuffs_base__pixel_swizzler__dither_ordered__bgr_565(g_want_array_u8,
+                                                            src, len, x, y);
+
+        wuffs_base__io_buffer have =
+            wuffs_base__ptr_u8__reader(g_have_array_u8, 2 * 80, true);
+        wuffs_base__io_buffer want =
+            wuffs_base__ptr_u8__reader(g_want_array_u8, 2 * 80, true);
+        char prefix_buf[64];
+        snprintf(prefix_buf, sizeof prefix_buf,
+                 "x=%" PRIu32 ", y=%" PRIu32 ", len=%zu: ", x, y, len);
+        CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_float() {
+  CHECK_FOCUS(__func__);
+
+  // Two BGRA_NONPREMUL pixels: opaque white and a half-transparent purple.
+  const uint8_t src[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x80, 0x80};
+
+  // The sRGB transfer function maps 0x80 (as 8-bit encoded) to 0.2158605 (as
+  // linear light). The alpha 0x80 is 0.5019608.
+  const struct {
+    uint32_t pixfmt_repr;
+    float want[8];
+  } tcs[] = {
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16,
+          .want = {1, 1, 1, 1, 0.2519646f, 0, 0.5019608f, 0.5019608f},
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR,
+          .want = {1, 1, 1, 1, 0.1083535f, 0, 0.5019608f, 0.5019608f},
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32,
+          .want = {1, 1, 1, 1, 0.2519646f, 0, 0.5019608f, 0.5019608f},
+      },
+      {
+          .pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR,
+          .want = {1, 1, 1, 1, 0.1083535f, 0, 0.5019608f, 0.5019608f},
+      },
+  };
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    wuffs_base__pixel_swizzler swizzler;
+    CHECK_STATUS("prepare",
+                 wuffs_base__pixel_swizzler__prepare(
+                     &swizzler,
+                     wuffs_base__make_pixel_format(tcs[tc].pixfmt_repr),
+                     wuffs_base__empty_slice_u8(),
+                     wuffs_base__make_pixel_format(
+                         WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+                     wuffs_base__empty_slice_u8(),
+                     WUFFS_BASE__PIXEL_BLEND__SRC));
+
+    bool f16 = (tcs[tc].pixfmt_repr ==
+                WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16) ||
+               (tcs[tc].pixfmt_repr ==
+                WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR);
+    size_t bytes_per_channel = f16 ? 2 : 4;
+    uint8_t dst[32] = {0};
+    uint64_t have_n = wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+        &swizzler, wuffs_base__make_slice_u8(dst, 8 * bytes_per_channel),
+        wuffs_base__empty_slice_u8(),
+        wuffs_base__make_slice_u8((uint8_t*)src, sizeof src));
+    if (have_n != 2) {
+      RETURN_FAIL("tc=%zu: n: have %" PRIu64 ", want 2", tc, have_n);
+    }
+
+    // f16 has 11 bits of precision. The sRGB transfer function is
+    // interpolated from a look-up table.
+    double tolerance = f16 ? (1.0 / 2048) : 2e-5;
+    for (int i = 0; i < 8; i++) {
+      double have =
+          f16 ? wuffs_base__ieee_754_bit_representation__from_u16_to_f64(
+                    wuffs_base__peek_u16le__no_bounds_check(dst + (2 * i)))
+              : wuffs_base__ieee_754_bit_representation__from_u32_to_f64(
+                    wuffs_base__peek_u32le__no_bounds_check(dst + (4 * i)));
+      double want = tcs[tc].want[i];
+      if (((have - want) > tolerance) || ((want - have) > tolerance)) {
+        RETURN_FAIL("tc=%zu, i=%d: have %.7f, want %.7f", tc, i, have, want);
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_quantize() {
+  CHECK_FOCUS(__func__);
+
+  uint32_t r = 0x12345678;
+  uint8_t palette[4 * 16];
+  for (size_t i = 0; i < sizeof palette; i++) {
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    palette[i] = ((i & 3) == 3) ? 0xFF : (uint8_t)(r >> 24);
+  }
+  wuffs_base__pixel_quantizer q = ((wuffs_base__pixel_quantizer){});
+  CHECK_STATUS("set_palette",
+               wuffs_base__pixel_quantizer__set_palette(
+                   &q, wuffs_base__make_slice_u8(palette, sizeof palette)));
+
+  // The source pixels are random BGRA_NONPREMUL colors, mostly opaque.
+  const uint32_t width = 200;
+  uint8_t src[4 * 200];
+  for (size_t i = 0; i < sizeof src; i++) {
+    r ^= r << 13;
+    r ^= r >> 17;
+    r ^= r << 5;
+    src[i] = (uint8_t)(r >> 24);
+  }
+  for (size_t i = 0; i < width; i++) {
+    if ((i % 5) != 0) {
+      src[(4 * i) + 3] = 0xFF;
+    }
+  }
+
+  const uint32_t dst_pixfmt_reprs[2] = {
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_PREMUL,
+  };
+  for (int d = 0; d < 2; d++) {
+    wuffs_base__pixel_format dst_pixfmt =
+        wuffs_base__make_pixel_format(dst_pixfmt_reprs[d]);
+    wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+    wuffs_base__pixel_config__set(&pc, dst_pixfmt_reprs[d],
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                  1);
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice",
+                 wuffs_base__pixel_buffer__set_from_slice(
+                     &pb, &pc,
+                     wuffs_base__make_slice_u8(g_have_array_u8, 1024 + width)));
+    wuffs_base__slice_u8 dst_palette = wuffs_base__pixel_buffer__palette(&pb);
+    memset(dst_palette.ptr, 0, dst_palette.len);
+    memcpy(dst_palette.ptr, palette, sizeof palette);
+    wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pb, 0);
+
+    wuffs_base__pixel_swizzler swizzler;
+    CHECK_STATUS("prepare",
+                 wuffs_base__pixel_swizzler__prepare(
+                     &swizzler, dst_pixfmt, dst_palette,
+                     wuffs_base__make_pixel_format(
+                         WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+                     wuffs_base__empty_slice_u8(),
+                     WUFFS_BASE__PIXEL_BLEND__SRC));
+
+    // Without a quantizer, each pixel maps to the closest element of the
+    // existing palette (all 256 entries). With one, the palette is the
+    // quantizer's (only its 16 colors) and opaque pixels map to the closest
+    // element to their 15-bit color's center.
+    for (int with_q = 0; with_q < 2; with_q++) {
+      CHECK_STATUS("set_quantizer",
+                   wuffs_base__pixel_swizzler__set_quantizer(
+                       &swizzler, &pb, with_q ? &q : NULL));
+      wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &swizzler, wuffs_base__make_slice_u8(tab.ptr, width), dst_palette,
+          wuffs_base__make_slice_u8(src, sizeof src));
+
+      for (uint32_t x = 0; x < width; x++) {
+        uint32_t c =
+            wuffs_base__color_u32_argb_nonpremul__as__color_u32_argb_premul(
+                wuffs_base__peek_u32le__no_bounds_check(src + (4 * x)));
+        if (with_q && ((c >> 24) == 0xFF)) {
+          c = (c & 0xFFF8F8F8) | 0x040404;
+        }
+        size_t n = with_q ? sizeof palette : dst_palette.len;
+        uint8_t want = wuffs_base__pixel_palette__closest_element(
+            wuffs_base__make_slice_u8(dst_palette.ptr, n), dst_pixfmt, c);
+        if (tab.ptr[x] != want) {
+          RETURN_FAIL("d=%d, with_q=%d, x=%" PRIu32 ": have %" PRIu32
+                      ", want %" PRIu32,
+                      d, with_q, x, (uint32_t)tab.ptr[x], (uint32_t)want);
+        }
+      }
+    }
+  }
+
+  // Error diffusion, to a black and white palette, of a flat dark gray should
+  // be mostly black, but on average should be close to the gray.
+  const uint32_t dither_width = 40;
+  const uint32_t dither_height = 16;
+  for (uint32_t x = 0; x < dither_width; x++) {
+    wuffs_base__poke_u32le__no_bounds_check(src + (4 * x), 0xFF404040);
+  }
+  const uint8_t bw_palette[8] = {0x00, 0x00, 0x00, 0xFF,
+                                 0xFF, 0xFF, 0xFF, 0xFF};
+  CHECK_STATUS("set_palette",
+               wuffs_base__pixel_quantizer__set_palette(
+                   &q, wuffs_base__make_slice_u8((uint8_t*)bw_palette,
+                                                 sizeof bw_palette)));
+  wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(
+      &pc, WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, dither_width, dither_height);
+  wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &pb, &pc,
+                   wuffs_base__make_slice_u8(
+                       g_have_array_u8,
+                       1024 + (dither_width * dither_height))));
+  wuffs_base__slice_u8 dst_palette = wuffs_base__pixel_buffer__palette(&pb);
+  wuffs_base__table_u8 tab = wuffs_base__pixel_buffer__plane(&pb, 0);
+  uint8_t workbuf[64 + (12 * 40)];
+
+  wuffs_base__decode_frame_options dfo =
+      wuffs_base__null_decode_frame_options();
+  wuffs_base__decode_frame_options__set_dither(
+      &dfo, WUFFS_BASE__PIXEL_DITHER__ERROR_DIFFUSION,
+      wuffs_base__make_slice_u8(workbuf, sizeof workbuf));
+  wuffs_base__decode_frame_options__set_quantizer(&dfo, &q);
+  wuffs_base__pixel_swizzler swizzler;
+  CHECK_STATUS(
+      "prepare",
+      wuffs_base__pixel_swizzler__prepare(
+          &swizzler, wuffs_base__pixel_buffer__pixel_format(&pb), dst_palette,
+          wuffs_base__make_pixel_format(
+              WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL),
+          wuffs_base__empty_slice_u8(), WUFFS_BASE__PIXEL_BLEND__SRC));
+  CHECK_STATUS("set_decode_frame_options",
+               wuffs_base__pixel_swizzler__set_decode_frame_options(
+                   &swizzler, &pb, &dfo));
+  if (memcmp(dst_palette.ptr, bw_palette, sizeof bw_palette) != 0) {
+    RETURN_FAIL("dst_palette: not the quantizer's palette");
+  }
+
+  uint32_t num_white = 0;
+  for (uint32_t y = 0; y < dither_height; y++) {
+    uint8_t* row = tab.ptr + (y * tab.stride);
+    wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+        &swizzler, wuffs_base__make_slice_u8(row, dither_width), dst_palette,
+        wuffs_base__make_slice_u8(src, 4 * dither_width));
+    for (uint32_t x = 0; x < dither_width; x++) {
+      if (row[x] > 1) {
+        RETURN_FAIL("x=%" PRIu32 ", y=%" PRIu32 ": have %" PRIu32
+                    ", want 0 or 1",
+                    x, y, (uint32_t)row[x]);
+      }
+      num_white += row[x];
+    }
+  }
+  double have_mean = ((double)num_white) / (dither_width * dither_height);
+  double want_mean = 0x40 / 255.0;
+  if (((have_mean - want_mean) > (1.0 / 64)) ||
+      ((want_mean - have_mean) > (1.0 / 64))) {
+    RETURN_FAIL("mean: have %.3f, want %.3f", have_mean, want_mean);
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_pixel_swizzler_simd() {
+  CHECK_FOCUS(__func__);
+
+  // The pixel_swizzler picks a SIMD implementation (if the CPU supports one)
+  // for these conversions. Check that it matches the non-SIMD implementation.
+  const struct {
+    uint32_t dst_pixfmt_repr;
+    uint32_t src_pixfmt_repr;
+    wuffs_base__pixel_blend blend;
+    wuffs_base__pixel_swizzler__func scalar_func;
+  } tcs[] = {
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func = wuffs_base__pixel_swizzler__swap_rgbx_bgrx,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGR,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func = wuffs_base__pixel_swizzler__bgrw__bgr,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRX,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func = wuffs_base__pixel_swizzler__bgrw__bgrx,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGB,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func = wuffs_base__pixel_swizzler__bgrw__rgb,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__Y,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func = wuffs_base__pixel_swizzler__xxxx__y,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRX,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func = wuffs_base__pixel_swizzler__bgrw__rgbx,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__rgba_nonpremul__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul_4x16le__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL_4X16LE,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul_4x16le__rgba_nonpremul__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_4X16LE,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__rgba_premul_4x16le__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__rgba_premul_f16__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F16_LINEAR,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__rgba_premul_f16_linear__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__rgba_premul_f32__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_PREMUL_F32_LINEAR,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__rgba_premul_f32_linear__bgra_nonpremul_4x16le__src,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_nonpremul__bgra_nonpremul__src_over,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .src_pixfmt_repr =
+              WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_nonpremul__index_bgra_nonpremul__src_over,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__bgra_nonpremul__src_over,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__bgra_premul__src_over,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr =
+              WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__index_bgra_nonpremul__src_over,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .src_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .blend = WUFFS_BASE__PIXEL_BLEND__SRC_OVER,
+          .scalar_func =
+              wuffs_base__pixel_swizzler__bgra_premul__rgba_nonpremul__src_over,
+      },
+  };
+
+  // Fill the src and the dst with pseudo-random bytes, so that every
+  // combination of (8-bit) color and alpha is likely to be exercised. For
+  // SRC_OVER, the have and want buffers start with the same dst pixels.
+  const size_t src_len = 0x40000;
+  if ((g_src_slice_u8.len < src_len) || (g_have_slice_u8.len < src_len) ||
+      (g_want_slice_u8.len < src_len)) {
+    return "test buffers are too short";
+  }
+  uint8_t dst_palette_array
+      [WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH];
+  uint8_t src_palette_array
+      [WUFFS_BASE__PIXEL_FORMAT__INDEXED__PALETTE_BYTE_LENGTH];
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < sizeof src_palette_array; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    src_palette_array[i] = (uint8_t)(x >> 24);
+  }
+
+  // An odd number of bytes also tests the SIMD implementations' tail loops.
+  const size_t lens[] = {0, 1, 15, 61, src_len - 1};
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    for (size_t i = 0; i < src_len; i++) {
+      x ^= x << 13;
+      x ^= x >> 17;
+      x ^= x << 5;
+      g_src_slice_u8.ptr[i] = (uint8_t)(x >> 24);
+    }
+    // Premultiplied alpha colors are no greater than their alpha.
+    if (tcs[tc].src_pixfmt_repr == WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL) {
+      for (size_t i = 0; (i + 3) < src_len; i += 4) {
+        uint8_t a = g_src_slice_u8.ptr[i + 3];
+        for (size_t j = 0; j < 3; j++) {
+          if (g_src_slice_u8.ptr[i + j] > a) {
+            g_src_slice_u8.ptr[i + j] = a;
+          }
+        }
+      }
+    }
+
+    wuffs_base__pixel_format src_pixfmt =
+        wuffs_base__make_pixel_format(tcs[tc].src_pixfmt_repr);
+    wuffs_base__slice_u8 dst_palette = wuffs_base__empty_slice_u8();
+    wuffs_base__slice_u8 src_palette = wuffs_base__empty_slice_u8();
+    if (wuffs_base__pixel_format__is_indexed(&src_pixfmt)) {
+      dst_palette = wuffs_base__make_slice_u8(dst_palette_array,
+                                              sizeof dst_palette_array);
+      src_palette = wuffs_base__make_slice_u8(src_palette_array,
+                                              sizeof src_palette_array);
+    }
+
+    wuffs_base__pixel_swizzler swizzler;
+    CHECK_STATUS("prepare",
+                 wuffs_base__pixel_swizzler__prepare(
+                     &swizzler,
+                     wuffs_base__make_pixel_format(tcs[tc].dst_pixfmt_repr),
+                     dst_palette,
+                     src_pixfmt, src_palette, tcs[tc].blend));
+
+    for (size_t l = 0; l < WUFFS_TESTLIB_ARRAY_SIZE(lens); l++) {
+      wuffs_base__slice_u8 src =
+          wuffs_base__make_slice_u8(g_src_slice_u8.ptr, lens[l]);
+      for (size_t i = 0; i < src_len; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        g_have_slice_u8.ptr[i] = (uint8_t)(x >> 24);
+      }
+      memcpy(g_want_slice_u8.ptr, g_have_slice_u8.ptr, src_len);
+
+      uint64_t have_n = wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+          &swizzler, wuffs_base__make_slice_u8(g_have_slice_u8.ptr, src_len),
+          dst_palette, src);
+      uint64_t want_n = (*tcs[tc].scalar_func)(
+          g_want_slice_u8.ptr, src_len, dst_palette.ptr, dst_palette.len,
+          src.ptr, src.len);
+      if (have_n != want_n) {
+        RETURN_FAIL("tc=%zu, l=%zu: n: have %" PRIu64 ", want %" PRIu64, tc,
+                    l, have_n, want_n);
+      }
+
+      wuffs_base__io_buffer have =
+          wuffs_base__ptr_u8__reader(g_have_slice_u8.ptr, src_len, true);
+      wuffs_base__io_buffer want =
+          wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, src_len, true);
+      char prefix_buf[64];
+      snprintf(prefix_buf, sizeof prefix_buf, "tc=%zu, l=%zu: ", tc, l);
+      CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_upsample_inv_h2v1() {
+  CHECK_FOCUS(__func__);
+
+  // src_array0 is "A lovely example".
+  const uint8_t src_array0[16] = {
+      0x41, 0x20, 0x6C, 0x6F, 0x76, 0x65, 0x6C, 0x79,  //
+      0x20, 0x65, 0x78, 0x61, 0x6D, 0x70, 0x6C, 0x65,  //
+  };
+
+  const uint8_t want_array[32] = {
+      // A box filter (nearest neighbor) would look like this:
+      //   0x41, 0x41, 0x20, 0x20, 0x6C, 0x6C, 0x6F, 0x6F,
+      //   0x76, 0x76, 0x65, 0x65, 0x6C, 0x6C, 0x79, 0x79,
+      //   0x20, 0x20, 0x65, 0x65, 0x78, 0x78, 0x61, 0x61,
+      //   0x6D, 0x6D, 0x70, 0x70, 0x6C, 0x6C, 0x65, 0x65,
+      // We use a triangle filter instead, matching libjpeg-turbo.
+      0x41, 0x39, 0x28, 0x33, 0x59, 0x6D, 0x6E, 0x71,  //
+      0x74, 0x72, 0x69, 0x67, 0x6A, 0x6F, 0x76, 0x63,  //
+      0x36, 0x31, 0x54, 0x6A, 0x73, 0x72, 0x67, 0x64,  //
+      0x6A, 0x6E, 0x6F, 0x6F, 0x6D, 0x6A, 0x67, 0x65,  //
+  };
+
+  const uint8_t* have_ptr =
+      wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle(
+          g_have_array_u8, src_array0, src_array0, 16, 0, true, true);
+
+  const bool closed = true;
+  wuffs_base__io_buffer have = wuffs_base__ptr_u8__reader(  //
+      (uint8_t*)(void*)have_ptr, 32, closed);
+  wuffs_base__io_buffer want = wuffs_base__ptr_u8__reader(  //
+      (uint8_t*)(void*)want_array, 32, closed);
+
+  return check_io_buffers_equal("", &have, &want);
+}
+
+const char*  //
+test_wuffs_upsample_triangle_simd() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__pixel_swizzler__swizzle_ycc__upsample_func simd_h1v2 = NULL;
+  wuffs_base__pixel_swizzler__swizzle_ycc__upsample_func simd_h2v1 = NULL;
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    simd_h1v2 =
+        wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_x86_avx2;
+    simd_h2v1 =
+        wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_x86_avx2;
+  }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    simd_h1v2 =
+        wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle_arm_neon;
+    simd_h2v1 =
+        wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle_arm_neon;
+  }
+#endif
+  if (!simd_h1v2 || !simd_h2v1) {
+    return NULL;
+  }
+
+  // The source rows have some slack before and after, as the upsample_func
+  // callers provide when first_column or last_column is false.
+  uint8_t major[512];
+  uint8_t minor[512];
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < 512; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    major[i] = (uint8_t)(x >> 24);
+    minor[i] = (uint8_t)(x >> 16);
+  }
+
+  // Check that the SIMD implementations match the non-SIMD ones, for every
+  // length up to the 480 maximum and every column edge case. The have and
+  // want buffers start equal, so that writing past 2*len is also caught.
+  for (size_t len = 1; len <= 480; len++) {
+    for (uint32_t flags = 0; flags < 8; flags++) {
+      bool first_column = flags & 1;
+      bool last_column = flags & 2;
+      uint32_t h1v2_bias = (flags & 4) ? 2 : 1;
+      for (int h2v1 = 0; h2v1 < 2; h2v1++) {
+        memset(g_have_array_u8, 0xAB, 1024);
+        memset(g_want_array_u8, 0xAB, 1024);
+        if (h2v1) {
+          (*simd_h2v1)(g_have_array_u8, major + 16, minor + 16, len,
+                       h1v2_bias, first_column, last_column);
+          wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h2v1_triangle(
+              g_want_array_u8, major + 16, minor + 16, len, h1v2_bias,
+              first_column, last_column);
+        } else {
+          (*simd_h1v2)(g_have_array_u8, major + 16, minor + 16, len,
+                       h1v2_bias, first_column, last_column);
+          wuffs_base__pixel_swizzler__swizzle_ycc__upsample_inv_h1v2_triangle(
+              g_want_array_u8, major + 16, minor + 16, len, h1v2_bias,
+              first_column, last_column);
+        }
+
+        wuffs_base__io_buffer have =
+            wuffs_base__ptr_u8__reader(g_have_array_u8, 1024, true);
+        wuffs_base__io_buffer want =
+            wuffs_base__ptr_u8__reader(g_want_array_u8, 1024, true);
+        char prefix_buf[64];
+        snprintf(prefix_buf, sizeof prefix_buf,
+                 "len=%zu, flags=%" PRIu32 ", h2v1=%d: ", len, flags, h2v1);
+        CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+      }
+    }
+  }
+  return NULL;
+}
+
+const char*  //
+test_wuffs_swizzle_cmyk_convert_4() {
+  CHECK_FOCUS(__func__);
+
+  typedef void (*convert_4_func)(wuffs_base__pixel_buffer * dst,  //
+                                 uint32_t x, uint32_t x_end, uint32_t y,
+                                 const uint8_t* up0, const uint8_t* up1,
+                                 const uint8_t* up2, const uint8_t* up3);
+
+  // The general_func is the (slow but simple) reference implementation. The
+  // scalar_func and simd_func (if the CPU supports one) should match it.
+  struct {
+    uint32_t dst_pixfmt_repr;
+    convert_4_func general_func;
+    convert_4_func scalar_func;
+    convert_4_func simd_func;
+  } tcs[] = {
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRX,
+          .general_func =
+              wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_general,
+          .scalar_func = wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx,
+          .simd_func = NULL,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL,
+          .general_func =
+              wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_general,
+          .scalar_func = wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx,
+          .simd_func = NULL,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+          .general_func =
+              wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_general,
+          .scalar_func = wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx,
+          .simd_func = NULL,
+      },
+      {
+          .dst_pixfmt_repr = WUFFS_BASE__PIXEL_FORMAT__RGBX,
+          .general_func =
+              wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_general,
+          .scalar_func = wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx,
+          .simd_func = NULL,
+      },
+  };
+
+#if defined(WUFFS_BASE__CPU_ARCH__X86_64)
+  if (wuffs_base__cpu_arch__have_x86_avx2()) {
+    tcs[0].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_x86_avx2;
+    tcs[1].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_x86_avx2;
+    tcs[2].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_x86_avx2;
+    tcs[3].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_x86_avx2;
+  }
+#endif
+#if defined(WUFFS_BASE__CPU_ARCH__ARM_NEON)
+  if (wuffs_base__cpu_arch__have_arm_neon()) {
+    tcs[0].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_bgrx_arm_neon;
+    tcs[1].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_cmyk__convert_4_rgbx_arm_neon;
+    tcs[2].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_bgrx_arm_neon;
+    tcs[3].simd_func =
+        wuffs_base__pixel_swizzler__swizzle_ycck__convert_4_rgbx_arm_neon;
+  }
+#endif
+
+  const uint32_t width = 480;
+  const uint32_t height = 2;
+  const size_t len = 4 * width * height;
+  if ((g_have_slice_u8.len < len) || (g_want_slice_u8.len < len)) {
+    return "test buffers are too short";
+  }
+
+  // Fill the four source component rows with pseudo-random bytes.
+  uint8_t up[4][480];
+  uint32_t r = 0x12345678;
+  for (size_t i = 0; i < 4; i++) {
+    for (size_t j = 0; j < width; j++) {
+      r ^= r << 13;
+      r ^= r >> 17;
+      r ^= r << 5;
+      up[i][j] = (uint8_t)(r >> 24);
+    }
+  }
+
+  // The x ranges also exercise the implementations' tail loops.
+  const uint32_t x_ranges[][2] = {{0, 480}, {3, 200}, {7, 12}};
+
+  for (size_t tc = 0; tc < WUFFS_TESTLIB_ARRAY_SIZE(tcs); tc++) {
+    wuffs_base__pixel_config pc = ((wuffs_base__pixel_config){});
+    wuffs_base__pixel_config__set(&pc, tcs[tc].dst_pixfmt_repr,
+                                  WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                  height);
+    wuffs_base__pixel_buffer have_pb;
+    wuffs_base__pixel_buffer want_pb;
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &have_pb, &pc, g_have_slice_u8));
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &want_pb, &pc, g_want_slice_u8));
+
+    for (size_t xr = 0; xr < WUFFS_TESTLIB_ARRAY_SIZE(x_ranges); xr++) {
+      uint32_t x0 = x_ranges[xr][0];
+      uint32_t x1 = x_ranges[xr][1];
+      memset(g_want_slice_u8.ptr, 0xAB, len);
+      (*tcs[tc].general_func)(&want_pb, x0, x1, 1, &up[0][x0], &up[1][x0],
+                              &up[2][x0], &up[3][x0]);
+
+      for (int f = 0; f < 2; f++) {
+        convert_4_func func = f ? tcs[tc].simd_func : tcs[tc].scalar_func;
+        if (!func) {
+          continue;
+        }
+        memset(g_have_slice_u8.ptr, 0xAB, len);
+        (*func)(&have_pb, x0, x1, 1, &up[0][x0], &up[1][x0], &up[2][x0],
+                &up[3][x0]);
+
+        wuffs_base__io_buffer have =
+            wuffs_base__ptr_u8__reader(g_have_slice_u8.ptr, len, true);
+        wuffs_base__io_buffer want =
+            wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, len, true);
+        char prefix_buf[64];
+        snprintf(prefix_buf, sizeof prefix_buf, "tc=%zu, xr=%zu, f=%d: ", tc,
+                 xr, f);
+        CHECK_STRING(check_io_buffers_equal(prefix_buf, &have, &want));
+      }
+    }
+  }
+  return NULL;
+}
+
+// ---------------- WBMP Tests
+
+const char*  //
+test_wuffs_wbmp_decode_interface() {
+  CHECK_FOCUS(__func__);
+  wuffs_wbmp__decoder dec;
+  CHECK_STATUS("initialize",
+               wuffs_wbmp__decoder__initialize(
+                   &dec, sizeof dec, WUFFS_VERSION,
+                   WUFFS_INITIALIZE__LEAVE_INTERNAL_BUFFERS_UNINITIALIZED));
+  return do_test__wuffs_base__image_decoder(
+      wuffs_wbmp__decoder__upcast_as__wuffs_base__image_decoder(&dec),
+      "test/data/muybridge-frame-000.wbmp", 0, SIZE_MAX, 30, 20, 0xFFFFFFFF);
+}
+
+const char*  //
+test_wuffs_wbmp_decode_truncated_input() {
+  CHECK_FOCUS(__func__);
+
+  wuffs_base__io_buffer src =
+      wuffs_base__ptr_u8__reader(g_src_array_u8, 0, false);
   wuffs_wbmp__decoder dec;
   CHECK_STATUS("initialize",
                wuffs_wbmp__decoder__initialize(
@@ -663,6 +2585,94 @@ test_wuffs_wbmp_decode_image_config() {
 
 // ---------------- WBMP Benches
 
+const char*  //
+do_bench_wuffs_pixel_resampler(uint32_t dst_width,
+                               uint32_t dst_height,
+                               uint32_t src_width,
+                               uint32_t src_height,
+                               wuffs_base__pixel_resampling_filter filter,
+                               uint64_t iters_unscaled) {
+  const size_t dst_len = 4 * ((size_t)dst_width) * dst_height;
+  const size_t src_len = 4 * ((size_t)src_width) * src_height;
+  if ((g_have_slice_u8.len < dst_len) || (g_src_slice_u8.len < src_len) ||
+      (g_work_slice_u8.len <
+       wuffs_base__pixel_resampler__workbuf_len(dst_width, dst_height,
+                                                src_width, src_height, filter))) {
+    return "test buffers are too short";
+  }
+  uint32_t x = 0x12345678;
+  for (size_t i = 0; i < src_len; i++) {
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    g_src_slice_u8.ptr[i] = (uint8_t)(x >> 24);
+  }
+
+  wuffs_base__pixel_config src_pixcfg = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&src_pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRX,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, src_width,
+                                src_height);
+  wuffs_base__pixel_buffer src_pixbuf = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice (src)",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &src_pixbuf, &src_pixcfg,
+                   wuffs_base__make_slice_u8(g_src_slice_u8.ptr, src_len)));
+  wuffs_base__pixel_config dst_pixcfg = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&dst_pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRX,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, dst_width,
+                                dst_height);
+  wuffs_base__pixel_buffer dst_pixbuf = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice (dst)",
+               wuffs_base__pixel_buffer__set_from_slice(
+                   &dst_pixbuf, &dst_pixcfg,
+                   wuffs_base__make_slice_u8(g_have_slice_u8.ptr, dst_len)));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    wuffs_base__pixel_resampler resampler;
+    CHECK_STATUS("prepare",
+                 wuffs_base__pixel_resampler__prepare(
+                     &resampler, src_pixcfg.private_impl.pixfmt, dst_width,
+                     dst_height, src_width, src_height, filter,
+                     g_work_slice_u8));
+    CHECK_STATUS("resample", wuffs_base__pixel_resampler__resample(
+                                 &resampler, &dst_pixbuf, &src_pixbuf));
+    n_bytes += dst_len;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_pixel_resampler_box_downscale() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_resampler(
+      200, 150, 800, 600, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__BOX, 20);
+}
+
+const char*  //
+bench_wuffs_pixel_resampler_lanczos3_downscale() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_resampler(
+      200, 150, 800, 600, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3, 5);
+}
+
+const char*  //
+bench_wuffs_pixel_resampler_lanczos3_upscale() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_resampler(
+      800, 600, 200, 150, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__LANCZOS3, 5);
+}
+
+const char*  //
+bench_wuffs_pixel_resampler_mitchell_downscale() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_resampler(
+      200, 150, 800, 600, WUFFS_BASE__PIXEL_RESAMPLING_FILTER__MITCHELL, 10);
+}
+
 const char*  //
 do_bench_wuffs_pixel_swizzler(uint32_t dst_pixfmt_repr,
                               uint32_t src_pixfmt_repr,
@@ -742,6 +2752,15 @@ bench_wuffs_pixel_swizzler_bgr_rgba_nonpremul_src() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC, 500);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_nonpremul_4x16le_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      WUFFS_BASE__PIXEL_BLEND__SRC, 3000);
+}
+
 const char*  //
 bench_wuffs_pixel_swizzler_bgra_nonpremul_rgba_nonpremul_src() {
   CHECK_FOCUS(__func__);
@@ -750,6 +2769,23 @@ bench_wuffs_pixel_swizzler_bgra_nonpremul_rgba_nonpremul_src() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC, 8000);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_4x16le_src() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      WUFFS_BASE__PIXEL_BLEND__SRC, 1000);
+}
+
 const char*  //
 bench_wuffs_pixel_swizzler_bgra_premul_y_src() {
   CHECK_FOCUS(__func__);
@@ -791,6 +2827,148 @@ bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src_over() {
                                        WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
 }
 
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_nonpremul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_nonpremul_indexed_bgra_nonpremul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_bgra_premul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+                                       WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_bgra_premul_indexed_bgra_nonpremul_src_over() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler(
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL,
+      WUFFS_BASE__PIXEL_FORMAT__INDEXED__BGRA_NONPREMUL,
+      WUFFS_BASE__PIXEL_BLEND__SRC_OVER, 300);
+}
+
+// do_bench_wuffs_pixel_swizzler_tiles converts 16 contiguous 32x32
+// RGBA_NONPREMUL tiles (icons) across a BGRA_PREMUL sprite sheet, preparing
+// and converting either one row at a time, one tile at a time (preparing via a
+// wuffs_base__pixel_swizzler_cache) or all tiles in one batch.
+const char*  //
+do_bench_wuffs_pixel_swizzler_tiles(int granularity, uint64_t iters_unscaled) {
+  const uint32_t tile_width = 32;
+  const uint32_t tile_height = 32;
+  const size_t num_tiles = 16;
+  const size_t src_tile_len = 4 * tile_width * tile_height;
+  const size_t sheet_stride = 4 * tile_width * num_tiles;
+
+  wuffs_base__io_buffer src = wuffs_base__slice_u8__writer(g_src_slice_u8);
+  CHECK_STRING(read_file(&src, "test/data/pi.txt"));
+  if (src.meta.wi < (src_tile_len * num_tiles)) {
+    return "src data is too short";
+  }
+  wuffs_base__pixel_format dst_pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__BGRA_PREMUL);
+  wuffs_base__pixel_format src_pixfmt =
+      wuffs_base__make_pixel_format(WUFFS_BASE__PIXEL_FORMAT__RGBA_NONPREMUL);
+  wuffs_base__table_u8 dst_tile = wuffs_base__make_table_u8(
+      g_have_slice_u8.ptr, 4 * tile_width, tile_height, sheet_stride);
+  wuffs_base__table_u8 src_tile = wuffs_base__make_table_u8(
+      g_src_slice_u8.ptr, 4 * tile_width, tile_height, 4 * tile_width);
+
+  wuffs_base__pixel_swizzler_cache cache =
+      ((wuffs_base__pixel_swizzler_cache){});
+  wuffs_base__pixel_swizzler swizzler;
+  CHECK_STATUS("prepare", wuffs_base__pixel_swizzler__prepare(
+                              &swizzler, dst_pixfmt,
+                              wuffs_base__empty_slice_u8(), src_pixfmt,
+                              wuffs_base__empty_slice_u8(),
+                              WUFFS_BASE__PIXEL_BLEND__SRC));
+
+  bench_start();
+  uint64_t n_bytes = 0;
+  uint64_t iters = iters_unscaled * g_flags.iterscale;
+  for (uint64_t i = 0; i < iters; i++) {
+    if (granularity == 2) {
+      wuffs_base__pixel_swizzler__swizzle_interleaved_tiles(
+          &swizzler, dst_tile, 4 * tile_width, wuffs_base__empty_slice_u8(),
+          src_tile, src_tile_len, num_tiles);
+      n_bytes += 4 * tile_width * tile_height * num_tiles;
+      continue;
+    }
+    for (size_t t = 0; t < num_tiles; t++) {
+      uint8_t* dst_ptr = dst_tile.ptr + (t * 4 * tile_width);
+      uint8_t* src_ptr = src_tile.ptr + (t * src_tile_len);
+      if (granularity == 1) {
+        wuffs_base__pixel_swizzler_cache__prepare(
+            &cache, &swizzler, dst_pixfmt, wuffs_base__empty_slice_u8(),
+            src_pixfmt, wuffs_base__empty_slice_u8(),
+            WUFFS_BASE__PIXEL_BLEND__SRC);
+        wuffs_base__pixel_swizzler__swizzle_interleaved_from_table(
+            &swizzler,
+            wuffs_base__make_table_u8(dst_ptr, dst_tile.width, dst_tile.height,
+                                      dst_tile.stride),
+            wuffs_base__empty_slice_u8(),
+            wuffs_base__make_table_u8(src_ptr, src_tile.width, src_tile.height,
+                                      src_tile.stride));
+        continue;
+      }
+      wuffs_base__pixel_swizzler__prepare(
+          &swizzler, dst_pixfmt, wuffs_base__empty_slice_u8(), src_pixfmt,
+          wuffs_base__empty_slice_u8(), WUFFS_BASE__PIXEL_BLEND__SRC);
+      for (uint32_t y = 0; y < tile_height; y++) {
+        wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+            &swizzler,
+            wuffs_base__make_slice_u8(dst_ptr + (y * sheet_stride),
+                                      4 * tile_width),
+            wuffs_base__empty_slice_u8(),
+            wuffs_base__make_slice_u8(src_ptr + (y * 4 * tile_width),
+                                      4 * tile_width));
+      }
+    }
+    n_bytes += 4 * tile_width * tile_height * num_tiles;
+  }
+  bench_finish(iters, n_bytes);
+  return NULL;
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_tiles_32x32_per_batch() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler_tiles(2, 1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_tiles_32x32_per_row() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler_tiles(0, 1000);
+}
+
+const char*  //
+bench_wuffs_pixel_swizzler_tiles_32x32_per_tile() {
+  CHECK_FOCUS(__func__);
+  return do_bench_wuffs_pixel_swizzler_tiles(1, 1000);
+}
+
 // ---------------- Mimic Benches
 
 #ifdef WUFFS_MIMIC
@@ -806,10 +2984,26 @@ proc g_tests[] = {
     // These pixel_buffer / pixel_swizzler tests are really testing the Wuffs
     // base library. They aren't specific to the std/wbmp code, but putting
     // them here is as good as any other place.
+    test_wuffs_color_transform_set_from_gama_chrm,
+    test_wuffs_color_transform_set_from_icc_profile,
+    test_wuffs_color_transform_simd,
     test_wuffs_color_ycc_as_color_u32,
     test_wuffs_pixel_buffer_fill_rect,
+    test_wuffs_pixel_buffer_swizzle_planar_from,
+    test_wuffs_pixel_quantizer_build_palette,
+    test_wuffs_pixel_quantizer_simd,
+    test_wuffs_pixel_resampler_resample,
+    test_wuffs_pixel_swizzler_cache,
+    test_wuffs_pixel_swizzler_dither,
+    test_wuffs_pixel_swizzler_dither_simd,
+    test_wuffs_pixel_swizzler_float,
+    test_wuffs_pixel_swizzler_quantize,
+    test_wuffs_pixel_swizzler_simd,
     test_wuffs_pixel_swizzler_swizzle,
+    test_wuffs_pixel_swizzler_swizzle_tiles,
+    test_wuffs_swizzle_cmyk_convert_4,
     test_wuffs_upsample_inv_h2v1,
+    test_wuffs_upsample_triangle_simd,
 
     test_wuffs_wbmp_decode_frame_config,
     test_wuffs_wbmp_decode_image_config,
@@ -827,14 +3021,30 @@ proc g_tests[] = {
 
 proc g_benches[] = {
 
+    bench_wuffs_pixel_resampler_box_downscale,
+    bench_wuffs_pixel_resampler_lanczos3_downscale,
+    bench_wuffs_pixel_resampler_lanczos3_upscale,
+    bench_wuffs_pixel_resampler_mitchell_downscale,
+
     bench_wuffs_pixel_swizzler_bgr_565_rgba_nonpremul_src,
     bench_wuffs_pixel_swizzler_bgr_rgba_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_nonpremul_4x16le_src,
     bench_wuffs_pixel_swizzler_bgra_nonpremul_rgba_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_src,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_4x16le_src,
     bench_wuffs_pixel_swizzler_bgra_premul_y_src,
     bench_wuffs_pixel_swizzler_bgra_premul_indexed_bgra_binary_src,
     bench_wuffs_pixel_swizzler_bgra_premul_rgb_src,
     bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src,
     bench_wuffs_pixel_swizzler_bgra_premul_rgba_nonpremul_src_over,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_bgra_nonpremul_src_over,
+    bench_wuffs_pixel_swizzler_bgra_nonpremul_indexed_bgra_nonpremul_src_over,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_nonpremul_src_over,
+    bench_wuffs_pixel_swizzler_bgra_premul_bgra_premul_src_over,
+    bench_wuffs_pixel_swizzler_bgra_premul_indexed_bgra_nonpremul_src_over,
+    bench_wuffs_pixel_swizzler_tiles_32x32_per_batch,
+    bench_wuffs_pixel_swizzler_tiles_32x32_per_row,
+    bench_wuffs_pixel_swizzler_tiles_32x32_per_tile,
 
 #ifdef WUFFS_MIMIC
 
@@ -1236,6 +1236,252 @@ do_test__wuffs_base__image_decoder(
   return NULL;
 }
 
+// do_test__wuffs_base__image_decoder_crop_src decodes the first frame twice,
+// once with b_full and once with b_crop (two freshly initialized decoders for
+// the same image format), the second time passing a decode_frame_options crop
+// rectangle. The pixels inside that rectangle (clipped to the frame) must be
+// equal. b_crop's frame_dirty_rect must be that clipped rectangle or, if
+// want_cropped_dirty_rect is false (for decoders or sub-formats that ignore
+// the crop), the whole frame.
+const char*  //
+do_test__wuffs_base__image_decoder_crop_src(wuffs_base__image_decoder* b_full,
+                                            wuffs_base__image_decoder* b_crop,
+                                            wuffs_base__io_buffer* src,
+                                            wuffs_base__rect_ie_u32 crop,
+                                            bool want_cropped_dirty_rect) {
+  wuffs_base__image_decoder* decoders[2] = {b_full, b_crop};
+  wuffs_base__slice_u8 dsts[2] = {g_want_slice_u8, g_have_slice_u8};
+  wuffs_base__image_config ic = ((wuffs_base__image_config){});
+  wuffs_base__rect_ie_u32 dirty_rect = wuffs_base__empty_rect_ie_u32();
+  for (int i = 0; i < 2; i++) {
+    src->meta.ri = 0;
+    CHECK_STATUS("decode_image_config",
+                 wuffs_base__image_decoder__decode_image_config(decoders[i],
+                                                                &ic, src));
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL,
+        WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+    uint64_t pixbuf_len = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if (pixbuf_len > dsts[i].len) {
+      RETURN_FAIL("i=%d: pixbuf_len is too large", i);
+    }
+    memset(dsts[i].ptr, 0, pixbuf_len);
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, dsts[i]));
+    wuffs_base__decode_frame_options opts =
+        wuffs_base__null_decode_frame_options();
+    if (i > 0) {
+      wuffs_base__decode_frame_options__set_crop_rect(&opts, crop);
+    }
+    CHECK_STATUS("decode_frame", wuffs_base__image_decoder__decode_frame(
+                                     decoders[i], &pb, src,
+                                     WUFFS_BASE__PIXEL_BLEND__SRC,
+                                     g_work_slice_u8, &opts));
+    dirty_rect = wuffs_base__image_decoder__frame_dirty_rect(decoders[i]);
+  }
+
+  uint32_t width = wuffs_base__pixel_config__width(&ic.pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&ic.pixcfg);
+  wuffs_base__rect_ie_u32 frame_rect =
+      wuffs_base__make_rect_ie_u32(0, 0, width, height);
+  wuffs_base__rect_ie_u32 r =
+      wuffs_base__rect_ie_u32__intersect(&crop, frame_rect);
+  wuffs_base__rect_ie_u32 want_dirty_rect =
+      want_cropped_dirty_rect ? r : frame_rect;
+  if (!wuffs_base__rect_ie_u32__equals(&dirty_rect, want_dirty_rect)) {
+    RETURN_FAIL("frame_dirty_rect: have (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                ", %" PRIu32 "), want (%" PRIu32 ", %" PRIu32 ")-(%" PRIu32
+                ", %" PRIu32 ")",
+                dirty_rect.min_incl_x, dirty_rect.min_incl_y,
+                dirty_rect.max_excl_x, dirty_rect.max_excl_y,
+                want_dirty_rect.min_incl_x, want_dirty_rect.min_incl_y,
+                want_dirty_rect.max_excl_x, want_dirty_rect.max_excl_y);
+  }
+
+  for (uint32_t y = r.min_incl_y; y < r.max_excl_y; y++) {
+    for (uint32_t x = r.min_incl_x; x < r.max_excl_x; x++) {
+      size_t j = 4 * ((y * (size_t)width) + x);
+      if (memcmp(g_have_slice_u8.ptr + j, g_want_slice_u8.ptr + j, 4)) {
+        RETURN_FAIL("pixels differ at (%" PRIu32 ", %" PRIu32 ")", x, y);
+      }
+    }
+  }
+  return NULL;
+}
+
+// do_test__wuffs_base__image_decoder_crop is like
+// do_test__wuffs_base__image_decoder_crop_src, reading the source from a file
+// and wanting a cropped frame_dirty_rect.
+const char*  //
+do_test__wuffs_base__image_decoder_crop(wuffs_base__image_decoder* b_full,
+                                        wuffs_base__image_decoder* b_crop,
+                                        const char* src_filename,
+                                        wuffs_base__rect_ie_u32 crop) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+  return do_test__wuffs_base__image_decoder_crop_src(b_full, b_crop, &src, crop,
+                                                     true);
+}
+
+// do_test__wuffs_base__image_decoder_color_transform decodes the first frame
+// twice, once with b_plain (applying the color transform afterwards, as a
+// separate pass over the pixel buffer) and once with b_transform (passing the
+// color transform as a decode_frame_options). The two results must be equal.
+const char*  //
+do_test__wuffs_base__image_decoder_color_transform(
+    wuffs_base__image_decoder* b_plain,
+    wuffs_base__image_decoder* b_transform,
+    const char* src_filename,
+    uint32_t dst_pixfmt_repr,
+    const wuffs_base__color_transform* t) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+
+  wuffs_base__image_decoder* decoders[2] = {b_plain, b_transform};
+  wuffs_base__slice_u8 dsts[2] = {g_want_slice_u8, g_have_slice_u8};
+  uint64_t pixbuf_len = 0;
+  for (int i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_base__image_decoder__decode_image_config(decoders[i],
+                                                                &ic, &src));
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, dst_pixfmt_repr, WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+    pixbuf_len = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if (pixbuf_len > dsts[i].len) {
+      RETURN_FAIL("i=%d: pixbuf_len is too large", i);
+    }
+    memset(dsts[i].ptr, 0, pixbuf_len);
+    wuffs_base__pixel_buffer pb = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pb, &ic.pixcfg, dsts[i]));
+    wuffs_base__decode_frame_options opts =
+        wuffs_base__null_decode_frame_options();
+    if (i > 0) {
+      wuffs_base__decode_frame_options__set_color_transform(&opts, t);
+    }
+    CHECK_STATUS("decode_frame", wuffs_base__image_decoder__decode_frame(
+                                     decoders[i], &pb, &src,
+                                     WUFFS_BASE__PIXEL_BLEND__SRC,
+                                     g_work_slice_u8, &opts));
+    if (i == 0) {
+      CHECK_STATUS("transform_pixel_buffer",
+                   wuffs_base__color_transform__transform_pixel_buffer(t, &pb));
+    }
+  }
+
+  wuffs_base__io_buffer have =
+      wuffs_base__ptr_u8__reader(g_have_slice_u8.ptr, pixbuf_len, true);
+  wuffs_base__io_buffer want =
+      wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, pixbuf_len, true);
+  return check_io_buffers_equal("", &have, &want);
+}
+
+// do_test__wuffs_base__image_decoder_dither decodes the first frame twice.
+// It decodes once with b_plain to BGRA_NONPREMUL_4X16LE, dithering to BGR_565
+// afterwards (as a separate pass, one row at a time), and once with b_dither
+// to BGR_565, passing the dither mode as a decode_frame_options. The two
+// results must be equal.
+const char*  //
+do_test__wuffs_base__image_decoder_dither(wuffs_base__image_decoder* b_plain,
+                                          wuffs_base__image_decoder* b_dither,
+                                          const char* src_filename,
+                                          wuffs_base__pixel_dither dither) {
+  wuffs_base__io_buffer src = ((wuffs_base__io_buffer){
+      .data = g_src_slice_u8,
+  });
+  CHECK_STRING(read_file(&src, src_filename));
+
+  // The ERROR_DIFFUSION work buffer is the last 1 MiB of g_pixel_slice_u8.
+  const size_t dither_workbuf_len = 1024 * 1024;
+  wuffs_base__slice_u8 dither_workbuf = wuffs_base__make_slice_u8(
+      g_pixel_slice_u8.ptr + g_pixel_slice_u8.len - dither_workbuf_len,
+      dither_workbuf_len);
+  wuffs_base__slice_u8 wide_slice = wuffs_base__make_slice_u8(
+      g_pixel_slice_u8.ptr, g_pixel_slice_u8.len - dither_workbuf_len);
+
+  wuffs_base__image_decoder* decoders[2] = {b_plain, b_dither};
+  uint32_t pixfmts[2] = {
+      WUFFS_BASE__PIXEL_FORMAT__BGRA_NONPREMUL_4X16LE,
+      WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+  };
+  wuffs_base__slice_u8 dsts[2] = {wide_slice, g_have_slice_u8};
+  wuffs_base__pixel_buffer pbs[2];
+  for (int i = 0; i < 2; i++) {
+    src.meta.ri = 0;
+    wuffs_base__image_config ic = ((wuffs_base__image_config){});
+    CHECK_STATUS("decode_image_config",
+                 wuffs_base__image_decoder__decode_image_config(decoders[i],
+                                                                &ic, &src));
+    wuffs_base__pixel_config__set(
+        &ic.pixcfg, pixfmts[i], WUFFS_BASE__PIXEL_SUBSAMPLING__NONE,
+        wuffs_base__pixel_config__width(&ic.pixcfg),
+        wuffs_base__pixel_config__height(&ic.pixcfg));
+    uint64_t pixbuf_len = wuffs_base__pixel_config__pixbuf_len(&ic.pixcfg);
+    if (pixbuf_len > dsts[i].len) {
+      RETURN_FAIL("i=%d: pixbuf_len is too large", i);
+    }
+    memset(dsts[i].ptr, 0, pixbuf_len);
+    pbs[i] = ((wuffs_base__pixel_buffer){});
+    CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                       &pbs[i], &ic.pixcfg, dsts[i]));
+    wuffs_base__decode_frame_options opts =
+        wuffs_base__null_decode_frame_options();
+    if (i > 0) {
+      wuffs_base__decode_frame_options__set_dither(&opts, dither,
+                                                   dither_workbuf);
+    }
+    CHECK_STATUS("decode_frame", wuffs_base__image_decoder__decode_frame(
+                                     decoders[i], &pbs[i], &src,
+                                     WUFFS_BASE__PIXEL_BLEND__SRC,
+                                     g_work_slice_u8, &opts));
+  }
+
+  uint32_t width = wuffs_base__pixel_config__width(&pbs[0].pixcfg);
+  uint32_t height = wuffs_base__pixel_config__height(&pbs[0].pixcfg);
+  wuffs_base__pixel_config want_pc = ((wuffs_base__pixel_config){});
+  wuffs_base__pixel_config__set(&want_pc, WUFFS_BASE__PIXEL_FORMAT__BGR_565,
+                                WUFFS_BASE__PIXEL_SUBSAMPLING__NONE, width,
+                                height);
+  wuffs_base__pixel_buffer want_pb = ((wuffs_base__pixel_buffer){});
+  CHECK_STATUS("set_from_slice", wuffs_base__pixel_buffer__set_from_slice(
+                                     &want_pb, &want_pc, g_want_slice_u8));
+  wuffs_base__pixel_swizzler swizzler;
+  CHECK_STATUS("prepare",
+               wuffs_base__pixel_swizzler__prepare(
+                   &swizzler, want_pc.private_impl.pixfmt,
+                   wuffs_base__empty_slice_u8(),
+                   pbs[0].pixcfg.private_impl.pixfmt,
+                   wuffs_base__empty_slice_u8(), WUFFS_BASE__PIXEL_BLEND__SRC));
+  CHECK_STATUS("set_dither", wuffs_base__pixel_swizzler__set_dither(
+                                 &swizzler, &want_pb, dither, dither_workbuf));
+  wuffs_base__table_u8 wide_tab = wuffs_base__pixel_buffer__plane(&pbs[0], 0);
+  wuffs_base__table_u8 want_tab = wuffs_base__pixel_buffer__plane(&want_pb, 0);
+  for (uint32_t y = 0; y < height; y++) {
+    wuffs_base__pixel_swizzler__swizzle_interleaved_from_slice(
+        &swizzler, wuffs_base__table_u8__row_u32(want_tab, y),
+        wuffs_base__empty_slice_u8(),
+        wuffs_base__table_u8__row_u32(wide_tab, y));
+  }
+
+  size_t pixbuf_len = 2 * ((size_t)width) * ((size_t)height);
+  wuffs_base__io_buffer have =
+      wuffs_base__ptr_u8__reader(g_have_slice_u8.ptr, pixbuf_len, true);
+  wuffs_base__io_buffer want =
+      wuffs_base__ptr_u8__reader(g_want_slice_u8.ptr, pixbuf_len, true);
+  return check_io_buffers_equal("", &have, &want);
+}
+
 const char*  //
 do_test__wuffs_base__io_transformer(wuffs_base__io_transformer* b,
                                     const char* src_filename,